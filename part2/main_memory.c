@@ -31,6 +31,9 @@
  * In this demo, 3 tasks are created with different stack sizes.
  * Using a print function, the demo will show the heap size before and after
  * each creation and before and after each deletion.
+ * With configUSE_HEAP_INSTRUMENTATION set to 1 in FreeRTOSConfig.h it also
+ * prints what heap_4.c measured once the tasks are created and as tasks 3 and
+ * 6 finish.
  *  
  * Running in QEMU:
  * Use the following commands to start the application running in a way that
@@ -60,11 +63,26 @@ required UART registers. */
 #define UART0_BAUDDIV (*(((volatile uint32_t *)(UART0_ADDRESS + 16UL))))
 #define TX_BUFFER_MASK (1UL)
 
+/* The CMSDK TIMER1 registers.  FreeRTOSConfig.h reads the count of TIMER1 to
+time heap calls. */
+#define TIMER1_ADDRESS (0x40001000UL)
+#define TIMER1_CTRL (*(((volatile uint32_t *)(TIMER1_ADDRESS + 0UL))))
+#define TIMER1_VALUE (*(((volatile uint32_t *)(TIMER1_ADDRESS + 4UL))))
+#define TIMER1_RELOAD (*(((volatile uint32_t *)(TIMER1_ADDRESS + 8UL))))
+
 /*
  * Printf() output is sent to the serial port.  Initialise the serial hardware.
  */
 static void prvUARTInit(void);
 
+#if (configUSE_HEAP_INSTRUMENTATION == 1)
+/*
+ * Start TIMER1 counting every CPU clock cycle, without interrupts, for
+ * configHEAP_TIMESTAMP().
+ */
+static void prvHeapTimerInit(void);
+#endif
+
 /* The period of each task. The times are converted from
 milliseconds to ticks using the pdMS_TO_TICKS() macro. */
 #define mainTASK_FREQUENCY1_MS pdMS_TO_TICKS(4000UL) /* 2 seconds. */
@@ -94,11 +112,61 @@ void printFreeHeapSize(const char *label)
     printf("%s: Free heap size = %u bytes\n", label, (unsigned int)freeHeapSize);
 }
 
+#if (configUSE_HEAP_INSTRUMENTATION == 1)
+// Function to print what heap_4.c measured: the latency histograms, the free
+// blocks over time and the allocations of each caller. The caller addresses
+// can be turned into source lines with arm-none-eabi-addr2line -e RTOSDemo.out.
+void printHeapInstrumentation(void)
+{
+    static HeapInstrumentation_t xHeap;
+    UBaseType_t i;
+
+    vPortGetHeapInstrumentation(&xHeap);
+
+    printf("Latency in CPU cycles (bucket: malloc calls / free calls), max %u / %u\n",
+           (unsigned int)xHeap.ulMaximumMallocLatency, (unsigned int)xHeap.ulMaximumFreeLatency);
+    for (i = 0; i < configHEAP_LATENCY_BUCKETS; i++)
+    {
+        if ((xHeap.ulMallocLatency[i] != 0) || (xHeap.ulFreeLatency[i] != 0))
+        {
+            printf("  < %lu: %u / %u\n", 1UL << i, (unsigned int)xHeap.ulMallocLatency[i], (unsigned int)xHeap.ulFreeLatency[i]);
+        }
+    }
+
+    printf("Samples (tick, calls: free bytes, largest free block, free blocks)\n");
+    for (i = 0; i < xHeap.uxNumberOfSamples; i++)
+    {
+        printf("  %u, %u: %u, %u, %u\n", (unsigned int)xHeap.xSamples[i].xTimeInTicks,
+               (unsigned int)xHeap.xSamples[i].xNumberOfCalls,
+               (unsigned int)xHeap.xSamples[i].xAvailableHeapSpaceInBytes,
+               (unsigned int)xHeap.xSamples[i].xSizeOfLargestFreeBlockInBytes,
+               (unsigned int)xHeap.xSamples[i].xNumberOfFreeBlocks);
+    }
+    printf("Smallest largest free block %u, most free blocks %u\n",
+           (unsigned int)xHeap.xMinimumEverLargestFreeBlockInBytes, (unsigned int)xHeap.xMaximumEverNumberOfFreeBlocks);
+
+    printf("Callers (address: allocations, failures, bytes)\n");
+    for (i = 0; i < xHeap.uxNumberOfCallers; i++)
+    {
+        printf("  %p: %u, %u, %u\n", xHeap.xCallers[i].pvCaller,
+               (unsigned int)xHeap.xCallers[i].xNumberOfAllocations,
+               (unsigned int)xHeap.xCallers[i].xNumberOfFailedAllocations,
+               (unsigned int)xHeap.xCallers[i].xBytesAllocated);
+    }
+    printf("  untracked: %u\n", (unsigned int)xHeap.xUntrackedAllocations);
+}
+#endif
+
 void main(void)
 {
     /* Hardware initialisation.  printf() output uses the UART for IO. */
     prvUARTInit();
 
+#if (configUSE_HEAP_INSTRUMENTATION == 1)
+    /* The heap calls are timed from the first one. */
+    prvHeapTimerInit();
+#endif
+
     /* Create the tasks and print heap size after each creation */
     xTaskCreate(vTask1, "Task 1", configMINIMAL_STACK_SIZE * 3, (void *)pcText1, 1, NULL);
     printFreeHeapSize("Heap size after Task 1 creation");
@@ -118,6 +186,10 @@ void main(void)
     xTaskCreate(vTask3, "Task 6", configMINIMAL_STACK_SIZE * 4, (void *)pcText6, 6, NULL);
     printFreeHeapSize("Heap size after Task 6 creation");
 
+#if (configUSE_HEAP_INSTRUMENTATION == 1)
+    printHeapInstrumentation();
+#endif
+
     /* Start the scheduler. */
     vTaskStartScheduler();
 
@@ -207,6 +279,9 @@ static void vTask3(void *pvParameters)
         }
         i++;
     }
+#if (configUSE_HEAP_INSTRUMENTATION == 1)
+    printHeapInstrumentation();
+#endif
     vTaskDelete(NULL);
 }
 
@@ -370,6 +445,20 @@ static void prvUARTInit(void)
 }
 /*-----------------------------------------------------------*/
 
+#if (configUSE_HEAP_INSTRUMENTATION == 1)
+static void prvHeapTimerInit(void)
+{
+	/* Counting down from the largest reload value, the count wraps every 2 ^ 32
+	cycles, so the difference of two inverted counts is the cycles between
+	them. */
+	TIMER1_CTRL = 0;
+	TIMER1_RELOAD = 0xFFFFFFFFUL;
+	TIMER1_VALUE = 0xFFFFFFFFUL;
+	TIMER1_CTRL = 1; /* Enable, with the interrupt left disabled. */
+}
+/*-----------------------------------------------------------*/
+#endif
+
 int __write(int iFile, char *pcString, int iStringLength)
 {
 	int iNextChar;
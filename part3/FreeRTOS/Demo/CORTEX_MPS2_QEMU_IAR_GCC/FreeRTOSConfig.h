@@ -43,6 +43,9 @@
 #define configGENERATE_RUN_TIME_STATS 0
 
 #define configUSE_RM 		1
+#define configUSE_RM_ADMISSION_CONTROL	1
+#define configUSE_DEADLINE_MISS_DETECTION	1
+#define configDEADLINE_MISS_POLICY	pdDEADLINE_MISS_NOTIFY
 
 #define configUSE_TICKLESS_IDLE         0
 #define configUSE_PREEMPTION			1
@@ -62,6 +65,18 @@
 #define configUSE_QUEUE_SETS			1
 #define configUSE_COUNTING_SEMAPHORES	1
 
+/* Set configUSE_HEAP_INSTRUMENTATION to 1 to have heap_4.c measure itself, as
+main_memory.c prints.  A call takes far less than a tick, so calls are timed in
+CPU clock cycles with the CMSDK TIMER1, which the application starts free
+running from its full 32 bit reload value before the first allocation.  It
+counts down, so its value is inverted.  The full demo uses TIMER1 for
+IntQueueTimer.c, so it does not enable the instrumentation.  The tasks of
+main_memory.c are all created on tick 0, so the heap is also sampled every
+two calls, a task's TCB and stack. */
+#define configUSE_HEAP_INSTRUMENTATION	0
+#define configHEAP_TIMESTAMP()			( ~( *( ( volatile uint32_t * ) 0x40001004UL ) ) )
+#define configHEAP_HISTORY_CALLS		2
+
 #define configMAX_PRIORITIES			( 15UL )
 #define configQUEUE_REGISTRY_SIZE		10
 #define configSUPPORT_STATIC_ALLOCATION	1
@@ -146,10 +146,8 @@ static TimerHandle_t xTimer = NULL;
 /*********************************************************************************************************
  *									   LOCAL FUNCTION PROTOTYPES
  *********************************************************************************************************/
-// Function prototypes for task functions and timer callback
-static void vTask1(void *pvParameters);
-static void vTask2(void *pvParameters);
-static void vTask3(void *pvParameters);
+// Function prototypes for the periodic job and timer callback
+static void vPeriodicJob(void *pvParameters);
 /**********************************************************************************************************/
 void main(void)
 {
@@ -157,18 +155,19 @@ void main(void)
 
 	BaseType_t xReturned_1, xReturned_2, xReturned_3;
 
-	// Task creation
-	xReturned_1 = xTaskCreate(vTask1,		 // Pointer to the task entry function (name of function)
-							  "vTask1",		 // Name for the task
-							  STACK_SIZE,	 // The number of words (not bytes!) to allocate for use as the task's stack
-							  (void *)1,	 // A value that is passed as the paramater to the created task
-							  TASK_PRIORITY, // Priority at which the task is created
-							  &xHandle_1,	 // Used to pass out the created task's handle
-							  8,			 // Estimation of task's CPU Burst in seconds
-							  2);			 // Period of a task. It is expressed in tenths of a second and it is limited to 100.
+	// Task creation. Each task is created once and the kernel releases one job per period.
+	xReturned_1 = xTaskCreatePeriodic(vPeriodicJob,	 // Function run once per release of the task
+									  "vTask1",		 // Name for the task
+									  STACK_SIZE,	 // The number of words (not bytes!) to allocate for use as the task's stack
+									  NULL,			 // A value that is passed to every job of the task
+									  TASK_PRIORITY, // Priority at which the task is created
+									  &xHandle_1,	 // Used to pass out the created task's handle
+									  pdMS_TO_TICKS(8000),  // Estimation of task's CPU Burst in ticks
+									  pdMS_TO_TICKS(20000), // Period of a task in ticks
+									  0);					// Deadline, 0 for the end of the period
 
-	xReturned_2 = xTaskCreate(vTask2, "vTask2", STACK_SIZE, (void *)1, TASK_PRIORITY, &xHandle_2, 8, 3);
-	xReturned_3 = xTaskCreate(vTask3, "vTask3", STACK_SIZE, (void *)1, TASK_PRIORITY, &xHandle_3, 7, 4);
+	xReturned_2 = xTaskCreatePeriodic(vPeriodicJob, "vTask2", STACK_SIZE, NULL, TASK_PRIORITY, &xHandle_2, pdMS_TO_TICKS(8000), pdMS_TO_TICKS(30000), 0);
+	xReturned_3 = xTaskCreatePeriodic(vPeriodicJob, "vTask3", STACK_SIZE, NULL, TASK_PRIORITY, &xHandle_3, pdMS_TO_TICKS(7000), pdMS_TO_TICKS(40000), 0);
 
 	if (xReturned_1 == pdPASS && xReturned_2 == pdPASS && xReturned_3 == pdPASS)
 	{
@@ -188,164 +187,38 @@ void main(void)
 }
 
 /**********************************************************************************************************/
-void vTask1(void *pvParameters)
+void vPeriodicJob(void *pvParameters)
 {
-	TickType_t xNextWakeTime;
-
-	xNextWakeTime = xTaskGetTickCount();
-
-	const TickType_t xBlockTime = pdMS_TO_TICKS(10000 * uxTaskPeriodGet(NULL));
-
-	int timeSpent = 0;
-
-	int runTime = uxTaskCpuBurstGet(NULL);
-
-	// Obtain the tick count corresponding to one second
-	const TickType_t xOneSecondTicks = pdMS_TO_TICKS(1000);
-
-	for (;;)
-	{
-
-		// Run until the specified time has elapsed
-		printf("%s is running. Start time: %d\n", uxTaskNameGet(NULL), xTaskGetTickCount()/1000);
-
-		while (timeSpent < runTime)
-		{
-			TickType_t xStartTick = xTaskGetTickCount();
-
-			// Busy-wait for one second (tick count equivalent to one second)
-			while ((xTaskGetTickCount() - xStartTick) < xOneSecondTicks)
-			{
-				// Ensure the task does not yield the CPU during this period
-				// (This loop will keep running until one second has passed)
-			}
-
-			// One second has passed, increment timeSpent
-			timeSpent++;
-		}
-
-		printf("%s finished at time %d.\n", uxTaskNameGet(NULL), xTaskGetTickCount()/1000);
-
-		/* Place this task in the blocked state until it is time to run again.
-		The block time is specified in ticks, pdMS_TO_TICKS() was used to
-		convert a time specified in milliseconds into a time specified in ticks.
-		While in the Blocked state this task will not consume any CPU time. */
-		vTaskDelayUntil(&xNextWakeTime, ((int)pvParameters * xBlockTime) - xNextWakeTime);
-
-		xTaskCreate(vTask1, "vTask1", STACK_SIZE, (void *)pvParameters + 1, TASK_PRIORITY, &xHandle_1, 8, 2);
-
-		break;
-	}
-
-	vTaskDelete(NULL);
-}
-/*-----------------------------------------------------------*/
-
-void vTask2(void *pvParameters)
-{
-	TickType_t xNextWakeTime;
-
-	xNextWakeTime = xTaskGetTickCount();
-
-	const TickType_t xBlockTime = pdMS_TO_TICKS(10000 * uxTaskPeriodGet(NULL));
+	/* One job of a periodic task. The kernel releases it once per period and
+	blocks the task again when it returns, so nothing is re-created here. */
+	(void)pvParameters;
 
 	int timeSpent = 0;
 
-	int runTime = uxTaskCpuBurstGet(NULL);
-
 	// Obtain the tick count corresponding to one second
 	const TickType_t xOneSecondTicks = pdMS_TO_TICKS(1000);
 
-	for (;;)
-	{
-
-		// Run until the specified time has elapsed
-		printf("%s is running. Start time: %d\n", uxTaskNameGet(NULL), xTaskGetTickCount()/1000);
-
-		while (timeSpent < runTime)
-		{
-			TickType_t xStartTick = xTaskGetTickCount();
-
-			// Busy-wait for one second (tick count equivalent to one second)
-			while ((xTaskGetTickCount() - xStartTick) < xOneSecondTicks)
-			{
-				// Ensure the task does not yield the CPU during this period
-				// (This loop will keep running until one second has passed)
-			}
-
-			// One second has passed, increment timeSpent
-			timeSpent++;
-		}
-
-		printf("%s finished at time %d.\n", uxTaskNameGet(NULL), xTaskGetTickCount()/1000);
-
-		/* Place this task in the blocked state until it is time to run again.
-		The block time is specified in ticks, pdMS_TO_TICKS() was used to
-		convert a time specified in milliseconds into a time specified in ticks.
-		While in the Blocked state this task will not consume any CPU time. */
-
-		vTaskDelayUntil(&xNextWakeTime, ((int)pvParameters * xBlockTime) - xNextWakeTime);
-
-		xTaskCreate(vTask2, "vTask2", STACK_SIZE, (void *)pvParameters + 1, TASK_PRIORITY, &xHandle_2, 8, 3);
-
-		break;
-	}
-
-	vTaskDelete(NULL);
-}
-/*-----------------------------------------------------------*/
-
-void vTask3(void *pvParameters)
-{
-	TickType_t xNextWakeTime;
-
-	xNextWakeTime = xTaskGetTickCount();
-
-	const TickType_t xBlockTime = pdMS_TO_TICKS(10000 * uxTaskPeriodGet(NULL));
+	int runTime = xTaskCpuBurstGet(NULL) / xOneSecondTicks;
 
-	int timeSpent = 0;
-
-	int runTime = uxTaskCpuBurstGet(NULL);
-
-	// Obtain the tick count corresponding to one second
-	const TickType_t xOneSecondTicks = pdMS_TO_TICKS(1000);
+	// Run until the specified time has elapsed
+	printf("%s is running. Start time: %d\n", uxTaskNameGet(NULL), xTaskGetTickCount()/1000);
 
-	for (;;)
+	while (timeSpent < runTime)
 	{
+		TickType_t xStartTick = xTaskGetTickCount();
 
-		// Run until the specified time has elapsed
-		printf("%s is running. Start time: %d\n", uxTaskNameGet(NULL), xTaskGetTickCount()/1000);
-
-		while (timeSpent < runTime)
+		// Busy-wait for one second (tick count equivalent to one second)
+		while ((xTaskGetTickCount() - xStartTick) < xOneSecondTicks)
 		{
-			TickType_t xStartTick = xTaskGetTickCount();
-
-			// Busy-wait for one second (tick count equivalent to one second)
-			while ((xTaskGetTickCount() - xStartTick) < xOneSecondTicks)
-			{
-				// Ensure the task does not yield the CPU during this period
-				// (This loop will keep running until one second has passed)
-			}
-
-			// One second has passed, increment timeSpent
-			timeSpent++;
+			// Ensure the task does not yield the CPU during this period
+			// (This loop will keep running until one second has passed)
 		}
 
-		printf("%s finished at time %d.\n", uxTaskNameGet(NULL), xTaskGetTickCount()/1000);
-
-		/* Place this task in the blocked state until it is time to run again.
-		The block time is specified in ticks, pdMS_TO_TICKS() was used to
-		convert a time specified in milliseconds into a time specified in ticks.
-		While in the Blocked state this task will not consume any CPU time. */
-
-		vTaskDelayUntil(&xNextWakeTime, ((int)pvParameters * xBlockTime) - xNextWakeTime);
-
-		xTaskCreate(vTask3, "vTask3", STACK_SIZE, (void *)pvParameters + 1, TASK_PRIORITY, &xHandle_3, 7, 4);
-
-		break;
+		// One second has passed, increment timeSpent
+		timeSpent++;
 	}
 
-	vTaskDelete(NULL);
+	printf("%s finished at time %d.\n", uxTaskNameGet(NULL), xTaskGetTickCount()/1000);
 }
 /* -------------------------------------------------- */
 static void timerCallback(TimerHandle_t xTimerHandle)
@@ -414,6 +287,14 @@ void vApplicationStackOverflowHook(TaskHandle_t pxTask, char *pcTaskName)
 }
 /*-----------------------------------------------------------*/
 
+void vApplicationDeadlineMissedHook(TaskHandle_t xTask)
+{
+	/* Called from the tick interrupt when a job of xTask is still running
+	after its deadline.  The job is left to finish. */
+	printf("%s missed its deadline at time %d.\n", uxTaskNameGet(xTask), xTaskGetTickCountFromISR()/1000);
+}
+/*-----------------------------------------------------------*/
+
 void vApplicationTickHook(void)
 {
 	/* This function will be called by each tick interrupt if
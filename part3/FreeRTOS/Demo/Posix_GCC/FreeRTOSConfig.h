@@ -0,0 +1,123 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions should be adjusted for your particular hardware and
+ * application requirements.
+ *
+ * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
+ * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
+ *
+ * See http://www.freertos.org/a00110.html
+ *----------------------------------------------------------*/
+
+#include <limits.h>
+
+/* The benchmark is built once per scheduler, so the Makefile passes
+configUSE_RM on the command line. */
+#ifndef configUSE_RM
+	#define configUSE_RM 				1
+#endif
+#define configUSE_RM_ADMISSION_CONTROL	0
+
+#define configUSE_TRACE_FACILITY 0
+#define configGENERATE_RUN_TIME_STATS 0
+
+#define configUSE_TICKLESS_IDLE         0
+#define configUSE_PREEMPTION			1
+#define configUSE_IDLE_HOOK				0
+#define configUSE_TICK_HOOK				1
+#define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
+#define configMINIMAL_STACK_SIZE		( ( unsigned short ) PTHREAD_STACK_MIN )
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 64 * 1024 * 1024 ) )
+#define configMAX_TASK_NAME_LEN			( 12 )
+#define configUSE_16_BIT_TICKS			0
+#define configIDLE_SHOULD_YIELD			1
+#define configUSE_MUTEXES				1
+#define configUSE_RECURSIVE_MUTEXES		1
+#define configCHECK_FOR_STACK_OVERFLOW	0
+#define configUSE_MALLOC_FAILED_HOOK	1
+#define configUSE_COUNTING_SEMAPHORES	1
+
+#define configMAX_PRIORITIES			( 8UL )
+#define configQUEUE_REGISTRY_SIZE		0
+#define configSUPPORT_STATIC_ALLOCATION	0
+#define configSUPPORT_DYNAMIC_ALLOCATION	1
+
+/* The timer task would only add switches that are not being measured. */
+#define configUSE_TIMERS				0
+
+#define configUSE_TASK_NOTIFICATIONS	1
+
+/* Used by the queue benchmark and the queue test. */
+#define configUSE_QUEUE_BATCHING		1
+#define configUSE_QUEUE_ZERO_COPY		1
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+
+#define INCLUDE_vTaskPrioritySet				1
+#define INCLUDE_uxTaskPriorityGet				1
+#define INCLUDE_vTaskDelete						1
+#define INCLUDE_vTaskCleanUpResources			0
+#define INCLUDE_vTaskSuspend					1
+#define INCLUDE_vTaskDelayUntil					1
+#define INCLUDE_vTaskDelay						1
+#define INCLUDE_xTaskGetSchedulerState			1
+#define INCLUDE_xTaskGetIdleTaskHandle			1
+#define INCLUDE_xTaskGetCurrentTaskHandle		1
+#define INCLUDE_eTaskGetState					1
+
+#define configUSE_STATS_FORMATTING_FUNCTIONS	0
+
+/* The simulator has no priority bits, and the generic task selection is the
+only one it has. */
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+
+void vAssertCalled( const char *pcFileName, uint32_t ulLine );
+#define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ );
+
+/* The scheduler benchmark times the kernel through its trace hooks.  Task
+selection runs between the switched out and switched in hooks of
+vTaskSwitchContext(), and the tick from the increment tick hook to the tick
+hook.  The heap benchmark is built with benchHEAP set to the heap_x.c it links,
+the queue benchmark and queue test with benchQUEUE, and the EDF test with
+testEDF, and they do not use them. */
+#if !defined( benchHEAP ) && !defined( benchQUEUE ) && !defined( testEDF )
+	void vBenchmarkSwitchedOut( void );
+	void vBenchmarkSwitchedIn( void );
+	void vBenchmarkTickStart( void );
+	#define traceTASK_SWITCHED_OUT()			vBenchmarkSwitchedOut()
+	#define traceTASK_SWITCHED_IN()				vBenchmarkSwitchedIn()
+	#define traceTASK_INCREMENT_TICK( xTickCount )	vBenchmarkTickStart()
+#endif
+
+#endif /* FREERTOS_CONFIG_H */
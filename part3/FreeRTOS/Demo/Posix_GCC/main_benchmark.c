@@ -0,0 +1,433 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/******************************************************************************
+ * Scheduler overhead benchmark for the Linux simulator
+ * (portable/ThirdParty/GCC/Posix).
+ *
+ * Measures, for a growing number of tasks:
+ *  - context_switch: half the time of a taskYIELD() round trip between two
+ *    tasks of the same priority, while the other tasks wait in the ready lists.
+ *  - select:         the time vTaskSwitchContext() spends choosing the next
+ *    task, taken between the traceTASK_SWITCHED_OUT() and
+ *    traceTASK_SWITCHED_IN() hooks during the round trips above.
+ *  - create/delete:  xTaskCreate() and vTaskDelete() of a task that never
+ *    runs.
+ *  - tick:           xTaskIncrementTick(), from traceTASK_INCREMENT_TICK() to
+ *    the tick hook, while every task sleeps for 1 to 4 ticks in turn.
+ *
+ * The times are host nanoseconds and include the cost of the simulator, which
+ * switches tasks with pthread condition variables.  They are only meant to be
+ * compared between builds of the kernel on the same machine, for example
+ * configUSE_RM set to 0 and to 1:
+ *	make compare
+ *
+ * The results are printed as CSV lines:
+ * scheduler,benchmark,tasks,samples,min_ns,avg_ns,max_ns
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The control task outranks the tasks it measures. */
+#define benchCONTROL_PRIORITY		( tskIDLE_PRIORITY + 3 )
+#define benchPING_PRIORITY			( tskIDLE_PRIORITY + 2 )
+#define benchLOAD_PRIORITY			( tskIDLE_PRIORITY + 1 )
+
+#define benchSTACK_SIZE				configMINIMAL_STACK_SIZE
+
+/* Round trips, create/delete pairs and ticks measured for each task count. */
+#define benchSWITCH_SAMPLES			10000
+#define benchCREATE_SAMPLES			200
+#define benchTICK_SAMPLES			1000
+
+/* The periods of the load tasks cycle through this many values, so they fit
+the period classes Rate Monotonic scheduling has at one priority. */
+#define benchDISTINCT_PERIODS		8
+
+#define benchMAX_TASKS				64
+
+#if ( configUSE_RM == 1 )
+	#define benchSCHEDULER			"rm"
+#elif ( configUSE_EDF == 1 )
+	#define benchSCHEDULER			"edf"
+#else
+	#define benchSCHEDULER			"fixed_priority"
+#endif
+
+typedef struct BENCH_STATS
+{
+	uint64_t ullSamples;
+	uint64_t ullTotalNs;
+	uint64_t ullMinNs;
+	uint64_t ullMaxNs;
+} BenchStats_t;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters );
+static void prvPingTask( void *pvParameters );
+static void prvPongTask( void *pvParameters );
+static void prvLoadTask( void *pvParameters );
+static void prvSleepTask( void *pvParameters );
+static TaskHandle_t prvCreateTask( TaskFunction_t pxTaskCode, UBaseType_t uxPriority, void *pvParameters, TickType_t xPeriod );
+
+static uint64_t prvNowNs( void );
+static uint64_t prvElapsedNs( uint64_t ullStartNs );
+static void prvResetStats( BenchStats_t *pxStats );
+static void prvAddSample( BenchStats_t *pxStats, uint64_t ullNs );
+static void prvPrintStats( const char *pcBenchmark, UBaseType_t uxTasks, const BenchStats_t *pxStats );
+
+/*-----------------------------------------------------------*/
+
+static const UBaseType_t uxTaskCounts[] = { 1, 2, 4, 8, 16, 32, benchMAX_TASKS };
+
+static TaskHandle_t xControlTask = NULL;
+static TaskHandle_t xTasks[ benchMAX_TASKS ];
+
+/* The cost of reading the clock, taken off every sample. */
+static uint64_t ullClockOverheadNs = 0;
+
+static BenchStats_t xSwitchStats, xSelectStats, xTickStats;
+
+/* Set while the trace hooks are to take samples. */
+static volatile BaseType_t xRecordSelect = pdFALSE;
+static volatile BaseType_t xRecordTick = pdFALSE;
+static uint64_t ullSwitchedOutNs = 0;
+static uint64_t ullTickStartNs = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	uint64_t ullStartNs;
+	UBaseType_t x;
+
+	/* Take the fastest of many back to back reads as the clock overhead. */
+	ullClockOverheadNs = UINT64_MAX;
+	for( x = 0; x < 1000; x++ )
+	{
+		ullStartNs = prvNowNs();
+		ullStartNs = prvNowNs() - ullStartNs;
+
+		if( ullStartNs < ullClockOverheadNs )
+		{
+			ullClockOverheadNs = ullStartNs;
+		}
+	}
+
+	if( xTaskCreate( prvControlTask, "Control", benchSTACK_SIZE, NULL, benchCONTROL_PRIORITY, &xControlTask, 0, 0 ) == pdPASS )
+	{
+		vTaskStartScheduler();
+	}
+	else
+	{
+		printf( "Error creating the control task.\n" );
+	}
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	BenchStats_t xCreateStats, xDeleteStats;
+	TaskHandle_t xPing, xPong, xTask;
+	uint64_t ullStartNs;
+	UBaseType_t uxCount, uxTasks, x;
+
+	( void ) pvParameters;
+
+	printf( "scheduler,benchmark,tasks,samples,min_ns,avg_ns,max_ns\n" );
+
+	for( uxCount = 0; uxCount < sizeof( uxTaskCounts ) / sizeof( uxTaskCounts[ 0 ] ); uxCount++ )
+	{
+		uxTasks = uxTaskCounts[ uxCount ];
+
+		/* Ready tasks the scheduler has to look past, spread over the period
+		classes of their priority. */
+		for( x = 0; x < uxTasks; x++ )
+		{
+			xTasks[ x ] = prvCreateTask( prvLoadTask, benchLOAD_PRIORITY, NULL, ( x % benchDISTINCT_PERIODS + 1 ) * 10 );
+		}
+
+		/* Context switch and task selection. */
+		prvResetStats( &xSwitchStats );
+		prvResetStats( &xSelectStats );
+		ullSwitchedOutNs = 0;
+		xRecordSelect = pdTRUE;
+
+		xPing = prvCreateTask( prvPingTask, benchPING_PRIORITY, NULL, 0 );
+		xPong = prvCreateTask( prvPongTask, benchPING_PRIORITY, NULL, 0 );
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		xRecordSelect = pdFALSE;
+		vTaskDelete( xPing );
+		vTaskDelete( xPong );
+
+		prvPrintStats( "context_switch", uxTasks, &xSwitchStats );
+		prvPrintStats( "select", uxTasks, &xSelectStats );
+
+		/* Task creation and deletion.  The new task is below this one, so it
+		does not run before it is deleted. */
+		prvResetStats( &xCreateStats );
+		prvResetStats( &xDeleteStats );
+
+		for( x = 0; x < benchCREATE_SAMPLES; x++ )
+		{
+			ullStartNs = prvNowNs();
+			xTask = prvCreateTask( prvLoadTask, benchLOAD_PRIORITY, NULL, 10 );
+			prvAddSample( &xCreateStats, prvElapsedNs( ullStartNs ) );
+
+			ullStartNs = prvNowNs();
+			vTaskDelete( xTask );
+			prvAddSample( &xDeleteStats, prvElapsedNs( ullStartNs ) );
+		}
+
+		prvPrintStats( "create", uxTasks, &xCreateStats );
+		prvPrintStats( "delete", uxTasks, &xDeleteStats );
+
+		for( x = 0; x < uxTasks; x++ )
+		{
+			vTaskDelete( xTasks[ x ] );
+		}
+
+		/* The tick, with the same number of tasks waking on it. */
+		for( x = 0; x < uxTasks; x++ )
+		{
+			xTasks[ x ] = prvCreateTask( prvSleepTask, benchPING_PRIORITY, ( void * ) x, 0 );
+		}
+
+		prvResetStats( &xTickStats );
+		ullTickStartNs = 0;
+		xRecordTick = pdTRUE;
+		vTaskDelay( benchTICK_SAMPLES );
+		xRecordTick = pdFALSE;
+
+		for( x = 0; x < uxTasks; x++ )
+		{
+			vTaskDelete( xTasks[ x ] );
+		}
+
+		prvPrintStats( "tick", uxTasks, &xTickStats );
+	}
+
+	fflush( stdout );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvPingTask( void *pvParameters )
+{
+	uint64_t ullStartNs;
+	UBaseType_t x;
+
+	( void ) pvParameters;
+
+	/* The pong task is ready at the same priority, so every yield switches to
+	it and its yield switches back. */
+	for( x = 0; x < benchSWITCH_SAMPLES; x++ )
+	{
+		ullStartNs = prvNowNs();
+		taskYIELD();
+		prvAddSample( &xSwitchStats, prvElapsedNs( ullStartNs ) / 2 );
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPongTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		taskYIELD();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvLoadTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	/* Ready, but always below a task that is being measured, so it never gets
+	to run. */
+	for( ;; )
+	{
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSleepTask( void *pvParameters )
+{
+	const TickType_t xSleep = ( TickType_t ) ( ( UBaseType_t ) pvParameters % 4 ) + 1;
+
+	for( ;; )
+	{
+		vTaskDelay( xSleep );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvCreateTask( TaskFunction_t pxTaskCode, UBaseType_t uxPriority, void *pvParameters, TickType_t xPeriod )
+{
+	TaskHandle_t xTask = NULL;
+	BaseType_t xReturned;
+
+	xReturned = xTaskCreate( pxTaskCode, "Bench", benchSTACK_SIZE, pvParameters, uxPriority, &xTask, 0, xPeriod );
+	configASSERT( xReturned == pdPASS );
+	( void ) xReturned;
+
+	return xTask;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNowNs( void )
+{
+	struct timespec xTime;
+
+	clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+	return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvElapsedNs( uint64_t ullStartNs )
+{
+	uint64_t ullElapsedNs = prvNowNs() - ullStartNs;
+
+	return ( ullElapsedNs > ullClockOverheadNs ) ? ( ullElapsedNs - ullClockOverheadNs ) : 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvResetStats( BenchStats_t *pxStats )
+{
+	pxStats->ullSamples = 0;
+	pxStats->ullTotalNs = 0;
+	pxStats->ullMinNs = UINT64_MAX;
+	pxStats->ullMaxNs = 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddSample( BenchStats_t *pxStats, uint64_t ullNs )
+{
+	pxStats->ullSamples++;
+	pxStats->ullTotalNs += ullNs;
+
+	if( ullNs < pxStats->ullMinNs )
+	{
+		pxStats->ullMinNs = ullNs;
+	}
+
+	if( ullNs > pxStats->ullMaxNs )
+	{
+		pxStats->ullMaxNs = ullNs;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintStats( const char *pcBenchmark, UBaseType_t uxTasks, const BenchStats_t *pxStats )
+{
+	if( pxStats->ullSamples == 0 )
+	{
+		printf( "%s,%s,%lu,0,0,0,0\n", benchSCHEDULER, pcBenchmark, ( unsigned long ) uxTasks );
+	}
+	else
+	{
+		printf( "%s,%s,%lu,%llu,%llu,%llu,%llu\n", benchSCHEDULER, pcBenchmark, ( unsigned long ) uxTasks,
+				( unsigned long long ) pxStats->ullSamples, ( unsigned long long ) pxStats->ullMinNs,
+				( unsigned long long ) ( pxStats->ullTotalNs / pxStats->ullSamples ), ( unsigned long long ) pxStats->ullMaxNs );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkSwitchedOut( void )
+{
+	if( xRecordSelect != pdFALSE )
+	{
+		ullSwitchedOutNs = prvNowNs();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkSwitchedIn( void )
+{
+	if( ( xRecordSelect != pdFALSE ) && ( ullSwitchedOutNs != 0 ) )
+	{
+		prvAddSample( &xSelectStats, prvElapsedNs( ullSwitchedOutNs ) );
+		ullSwitchedOutNs = 0;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkTickStart( void )
+{
+	if( xRecordTick != pdFALSE )
+	{
+		ullTickStartNs = prvNowNs();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	/* Called at the end of xTaskIncrementTick(). */
+	if( ( xRecordTick != pdFALSE ) && ( ullTickStartNs != 0 ) )
+	{
+		prvAddSample( &xTickStats, prvElapsedNs( ullTickStartNs ) );
+		ullTickStartNs = 0;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	printf( "Malloc failed\n" );
+	portDISABLE_INTERRUPTS();
+	for( ;; )
+	{
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char *pcFileName, uint32_t ulLine )
+{
+	printf( "ASSERT! Line %lu, file %s\n", ( unsigned long ) ulLine, pcFileName );
+	fflush( stdout );
+	portDISABLE_INTERRUPTS();
+	for( ;; )
+	{
+	}
+}
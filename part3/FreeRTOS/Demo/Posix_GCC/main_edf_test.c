@@ -0,0 +1,220 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/******************************************************************************
+ * Earliest Deadline First late release test for the Linux simulator
+ * (portable/ThirdParty/GCC/Posix), built with configUSE_EDF set to 1:
+ *	make edf-test
+ *
+ * Two periodic tasks share a priority:
+ *  - Overrun: period 10, deadline 10.  Its first job runs until tick 15, past
+ *    its next release at tick 10, so its second job is released late, when
+ *    the first completes.  That job's deadline is tick 20.
+ *  - Short:   period 12, deadline 5.  Its second job is released at tick 12
+ *    with a deadline of tick 17, while the first Overrun job, whose deadline
+ *    of tick 10 is earlier still, keeps running.
+ *
+ * When the first Overrun job completes at tick 15 the second Short job has the
+ * earliest deadline and must run before the second Overrun job.
+ *
+ * The result is printed as a line short_job,overrun_job,PASS or FAIL, the
+ * order in which the second job of each task started among all the jobs
+ * started.  The exit status is 1 if the test failed.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if ( configUSE_EDF != 1 )
+	#error configUSE_EDF must be set to 1 to build the EDF test
+#endif
+
+/* The control task outranks the periodic tasks, so it can stop the test while
+they are running. */
+#define testCONTROL_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define testPERIODIC_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+#define testSTACK_SIZE				configMINIMAL_STACK_SIZE
+
+#define testOVERRUN_PERIOD			( ( TickType_t ) 10 )
+#define testOVERRUN_FIRST_JOB_END	( ( TickType_t ) 15 )
+#define testOVERRUN_JOB_TICKS		( ( TickType_t ) 3 )
+#define testSHORT_PERIOD			( ( TickType_t ) 12 )
+#define testSHORT_DEADLINE			( ( TickType_t ) 5 )
+
+/* Long enough for both second jobs to complete. */
+#define testRUN_TICKS				( ( TickType_t ) 40 )
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters );
+static void prvOverrunJob( void *pvParameters );
+static void prvShortJob( void *pvParameters );
+static void prvBusyUntil( TickType_t xTick );
+
+/*-----------------------------------------------------------*/
+
+/* The tick at which the periodic tasks were first released. */
+static TickType_t xStartTick = 0;
+
+/* The jobs started by both tasks, the jobs started by each, and when its
+second job started, counted in jobs started by both. */
+static volatile UBaseType_t uxJobs = 0;
+static volatile UBaseType_t uxOverrunJobs = 0;
+static volatile UBaseType_t uxShortJobs = 0;
+static volatile UBaseType_t uxOverrunSecondJob = 0;
+static volatile UBaseType_t uxShortSecondJob = 0;
+
+static int iFailures = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	BaseType_t xReturned;
+
+	xReturned = xTaskCreate( prvControlTask, "Control", testSTACK_SIZE, NULL, testCONTROL_PRIORITY, NULL, 0, 0 );
+
+	if( xReturned == pdPASS )
+	{
+		xReturned = xTaskCreatePeriodic( prvOverrunJob, "Overrun", testSTACK_SIZE, NULL, testPERIODIC_PRIORITY, NULL, testOVERRUN_PERIOD, testOVERRUN_PERIOD, 0 );
+	}
+
+	if( xReturned == pdPASS )
+	{
+		xReturned = xTaskCreatePeriodic( prvShortJob, "Short", testSTACK_SIZE, NULL, testPERIODIC_PRIORITY, NULL, 1, testSHORT_PERIOD, testSHORT_DEADLINE );
+	}
+
+	if( xReturned == pdPASS )
+	{
+		xStartTick = xTaskGetTickCount();
+		vTaskStartScheduler();
+	}
+	else
+	{
+		printf( "Error creating the tasks.\n" );
+		iFailures = 1;
+	}
+
+	return iFailures;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	vTaskDelay( testRUN_TICKS );
+
+	printf( "short_job,overrun_job,result\n" );
+
+	if( ( uxShortSecondJob != 0 ) && ( uxOverrunSecondJob != 0 ) && ( uxShortSecondJob < uxOverrunSecondJob ) )
+	{
+		printf( "%lu,%lu,PASS\n", ( unsigned long ) uxShortSecondJob, ( unsigned long ) uxOverrunSecondJob );
+	}
+	else
+	{
+		printf( "%lu,%lu,FAIL\n", ( unsigned long ) uxShortSecondJob, ( unsigned long ) uxOverrunSecondJob );
+		iFailures = 1;
+	}
+
+	fflush( stdout );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvOverrunJob( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	uxJobs++;
+	uxOverrunJobs++;
+
+	if( uxOverrunJobs == 1 )
+	{
+		/* Run past the next release. */
+		prvBusyUntil( xStartTick + testOVERRUN_FIRST_JOB_END );
+	}
+	else if( uxOverrunJobs == 2 )
+	{
+		uxOverrunSecondJob = uxJobs;
+		prvBusyUntil( xTaskGetTickCount() + testOVERRUN_JOB_TICKS );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvShortJob( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	uxJobs++;
+	uxShortJobs++;
+
+	if( uxShortJobs == 2 )
+	{
+		uxShortSecondJob = uxJobs;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBusyUntil( TickType_t xTick )
+{
+	while( ( TickType_t ) ( xTaskGetTickCount() - xTick ) > testRUN_TICKS )
+	{
+		/* Spin. */
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	/* Nothing is measured on the tick. */
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	printf( "Malloc failed\n" );
+	portDISABLE_INTERRUPTS();
+	for( ;; )
+	{
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char *pcFileName, uint32_t ulLine )
+{
+	printf( "ASSERT! Line %lu, file %s\n", ( unsigned long ) ulLine, pcFileName );
+	fflush( stdout );
+	portDISABLE_INTERRUPTS();
+	for( ;; )
+	{
+	}
+}
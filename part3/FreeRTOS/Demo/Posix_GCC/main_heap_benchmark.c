@@ -0,0 +1,326 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/******************************************************************************
+ * Heap latency benchmark for the Linux simulator
+ * (portable/ThirdParty/GCC/Posix).
+ *
+ * The Makefile builds this file once per heap implementation, with benchHEAP
+ * set to the number of the heap_x.c it links:
+ *	make heap-compare
+ *
+ * Each round replays the allocations made by part2/main_memory.c: six tasks
+ * are created, three with a stack of three times and three with a stack of four
+ * times the minimal stack size of the QEMU demo, then deleted in the order they
+ * finish there - tasks 1 and 4, 2 and 5, then 3 and 6.  As xTaskCreate() and
+ * vTaskDelete() do, each task allocates its stack then its TCB, and frees its
+ * stack then its TCB.
+ *
+ * The rounds are repeated with a growing number of holes left in the heap
+ * beforehand: small free blocks between blocks that stay allocated, as left
+ * by queues and timers that come and go.  heap_2.c, heap_4.c and heap_5.c
+ * search their free lists, so their latency grows with the holes, while
+ * heap_6.c should not change.
+ *
+ * The results are printed as CSV lines:
+ * heap,benchmark,holes,samples,min_ns,avg_ns,max_ns,free_blocks,largest_free_block
+ * where benchmark is malloc or free, and the last two columns are read with
+ * vPortGetHeapStats() once the rounds are done.  heap_2.c has no
+ * vPortGetHeapStats(), so they are left empty for it.  heap_2.c also never
+ * merges free blocks, so its holes add up from one hole count to the next.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifndef benchHEAP
+	#error benchHEAP must be set to the number of the heap_x.c being linked
+#endif
+
+/* configMINIMAL_STACK_SIZE of the QEMU demo main_memory.c runs on, in bytes. */
+#define benchMINIMAL_STACK_BYTES	( 80 * 4 )
+
+#define benchTASKS					6
+#define benchROUNDS					1000
+#define benchMAX_HOLES				1024
+
+typedef struct BENCH_STATS
+{
+	uint64_t ullSamples;
+	uint64_t ullTotalNs;
+	uint64_t ullMinNs;
+	uint64_t ullMaxNs;
+} BenchStats_t;
+
+/*-----------------------------------------------------------*/
+
+static void prvRunRounds( UBaseType_t uxHoles );
+static void *prvTimedMalloc( size_t xSize );
+static void prvTimedFree( void *pv );
+
+static uint64_t prvNowNs( void );
+static uint64_t prvElapsedNs( uint64_t ullStartNs );
+static void prvResetStats( BenchStats_t *pxStats );
+static void prvAddSample( BenchStats_t *pxStats, uint64_t ullNs );
+static void prvPrintStats( const char *pcBenchmark, UBaseType_t uxHoles, const BenchStats_t *pxStats, const char *pcHeapStats );
+
+/*-----------------------------------------------------------*/
+
+static const UBaseType_t uxHoleCounts[] = { 0, 16, 64, 256, benchMAX_HOLES };
+
+/* The stack sizes of the tasks of main_memory.c, and the order they are
+deleted in. */
+static const size_t xStackSizes[ benchTASKS ] =
+{
+	benchMINIMAL_STACK_BYTES * 3, benchMINIMAL_STACK_BYTES * 3, benchMINIMAL_STACK_BYTES * 3,
+	benchMINIMAL_STACK_BYTES * 4, benchMINIMAL_STACK_BYTES * 4, benchMINIMAL_STACK_BYTES * 4
+};
+static const UBaseType_t uxDeleteOrder[ benchTASKS ] = { 0, 3, 1, 4, 2, 5 };
+
+/* The blocks that stay allocated between the holes. */
+static void *pvKeepers[ benchMAX_HOLES ];
+
+/* The cost of reading the clock, taken off every sample. */
+static uint64_t ullClockOverheadNs = 0;
+
+static BenchStats_t xMallocStats, xFreeStats;
+
+#if ( benchHEAP == 5 )
+	/* heap_5.c has no array of its own. */
+	static uint8_t ucHeapRegion[ configTOTAL_HEAP_SIZE ];
+#endif
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	uint64_t ullStartNs;
+	UBaseType_t x;
+
+	#if ( benchHEAP == 5 )
+	{
+		const HeapRegion_t xHeapRegions[] =
+		{
+			{ ucHeapRegion, sizeof( ucHeapRegion ) },
+			{ NULL, 0 }
+		};
+
+		vPortDefineHeapRegions( xHeapRegions );
+	}
+	#endif
+
+	/* Take the fastest of many back to back reads as the clock overhead. */
+	ullClockOverheadNs = UINT64_MAX;
+	for( x = 0; x < 1000; x++ )
+	{
+		ullStartNs = prvNowNs();
+		ullStartNs = prvNowNs() - ullStartNs;
+
+		if( ullStartNs < ullClockOverheadNs )
+		{
+			ullClockOverheadNs = ullStartNs;
+		}
+	}
+
+	/* The heaps are used without starting the scheduler, so no tick or task
+	switch is timed with them. */
+	printf( "heap,benchmark,holes,samples,min_ns,avg_ns,max_ns,free_blocks,largest_free_block\n" );
+
+	for( x = 0; x < sizeof( uxHoleCounts ) / sizeof( uxHoleCounts[ 0 ] ); x++ )
+	{
+		prvRunRounds( uxHoleCounts[ x ] );
+	}
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunRounds( UBaseType_t uxHoles )
+{
+	void *pvHoles[ benchMAX_HOLES ];
+	void *pvStacks[ benchTASKS ], *pvTCBs[ benchTASKS ];
+	UBaseType_t uxRound, x;
+	char cHeapStats[ 48 ] = ",";
+
+	/* Leave a hole of 64 to 176 bytes in front of every kept block. */
+	for( x = 0; x < uxHoles; x++ )
+	{
+		pvHoles[ x ] = pvPortMalloc( 64 + ( x % 8 ) * 16 );
+		pvKeepers[ x ] = pvPortMalloc( 64 );
+		configASSERT( ( pvHoles[ x ] != NULL ) && ( pvKeepers[ x ] != NULL ) );
+	}
+
+	for( x = 0; x < uxHoles; x++ )
+	{
+		vPortFree( pvHoles[ x ] );
+	}
+
+	prvResetStats( &xMallocStats );
+	prvResetStats( &xFreeStats );
+
+	for( uxRound = 0; uxRound < benchROUNDS; uxRound++ )
+	{
+		for( x = 0; x < benchTASKS; x++ )
+		{
+			pvStacks[ x ] = prvTimedMalloc( xStackSizes[ x ] );
+			pvTCBs[ x ] = prvTimedMalloc( sizeof( StaticTask_t ) );
+		}
+
+		for( x = 0; x < benchTASKS; x++ )
+		{
+			prvTimedFree( pvStacks[ uxDeleteOrder[ x ] ] );
+			prvTimedFree( pvTCBs[ uxDeleteOrder[ x ] ] );
+		}
+	}
+
+	#if ( benchHEAP != 2 )
+	{
+		HeapStats_t xHeapStats;
+
+		vPortGetHeapStats( &xHeapStats );
+		snprintf( cHeapStats, sizeof( cHeapStats ), "%lu,%lu", ( unsigned long ) xHeapStats.xNumberOfFreeBlocks,
+				  ( unsigned long ) xHeapStats.xSizeOfLargestFreeBlockInBytes );
+	}
+	#endif
+
+	prvPrintStats( "malloc", uxHoles, &xMallocStats, cHeapStats );
+	prvPrintStats( "free", uxHoles, &xFreeStats, cHeapStats );
+
+	for( x = 0; x < uxHoles; x++ )
+	{
+		vPortFree( pvKeepers[ x ] );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTimedMalloc( size_t xSize )
+{
+	uint64_t ullStartNs;
+	void *pv;
+
+	ullStartNs = prvNowNs();
+	pv = pvPortMalloc( xSize );
+	prvAddSample( &xMallocStats, prvElapsedNs( ullStartNs ) );
+	configASSERT( pv != NULL );
+
+	return pv;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimedFree( void *pv )
+{
+	uint64_t ullStartNs;
+
+	ullStartNs = prvNowNs();
+	vPortFree( pv );
+	prvAddSample( &xFreeStats, prvElapsedNs( ullStartNs ) );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNowNs( void )
+{
+	struct timespec xTime;
+
+	clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+	return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvElapsedNs( uint64_t ullStartNs )
+{
+	uint64_t ullElapsedNs = prvNowNs() - ullStartNs;
+
+	return ( ullElapsedNs > ullClockOverheadNs ) ? ( ullElapsedNs - ullClockOverheadNs ) : 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvResetStats( BenchStats_t *pxStats )
+{
+	pxStats->ullSamples = 0;
+	pxStats->ullTotalNs = 0;
+	pxStats->ullMinNs = UINT64_MAX;
+	pxStats->ullMaxNs = 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddSample( BenchStats_t *pxStats, uint64_t ullNs )
+{
+	pxStats->ullSamples++;
+	pxStats->ullTotalNs += ullNs;
+
+	if( ullNs < pxStats->ullMinNs )
+	{
+		pxStats->ullMinNs = ullNs;
+	}
+
+	if( ullNs > pxStats->ullMaxNs )
+	{
+		pxStats->ullMaxNs = ullNs;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintStats( const char *pcBenchmark, UBaseType_t uxHoles, const BenchStats_t *pxStats, const char *pcHeapStats )
+{
+	printf( "heap_%d,%s,%lu,%llu,%llu,%llu,%llu,%s\n", benchHEAP, pcBenchmark, ( unsigned long ) uxHoles,
+			( unsigned long long ) pxStats->ullSamples, ( unsigned long long ) pxStats->ullMinNs,
+			( unsigned long long ) ( pxStats->ullTotalNs / pxStats->ullSamples ), ( unsigned long long ) pxStats->ullMaxNs,
+			pcHeapStats );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	/* The scheduler is not started, so there are no ticks. */
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	printf( "Malloc failed\n" );
+	portDISABLE_INTERRUPTS();
+	for( ;; )
+	{
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char *pcFileName, uint32_t ulLine )
+{
+	printf( "ASSERT! Line %lu, file %s\n", ( unsigned long ) ulLine, pcFileName );
+	fflush( stdout );
+	portDISABLE_INTERRUPTS();
+	for( ;; )
+	{
+	}
+}
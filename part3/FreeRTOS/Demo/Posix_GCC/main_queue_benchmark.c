@@ -0,0 +1,389 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/******************************************************************************
+ * Queue throughput benchmark for the Linux simulator
+ * (portable/ThirdParty/GCC/Posix).
+ *
+ * Moves the same number of items through a queue with xQueueSend() and
+ * xQueueReceive(), one item per call, and with xQueueSendMultiple() and
+ * xQueueReceiveMultiple(), a batch of items per call:
+ *	make queue-run
+ *
+ * Two tests are run for each item size and batch size:
+ *  - same_task:         one task posts a batch then receives it back, so no
+ *    task ever blocks and only the calls themselves are timed.
+ *  - producer_consumer: a producer posts to a consumer of lower priority.  The
+ *    producer fills the queue and blocks, the consumer empties it and blocks,
+ *    and each wakes the other, once per item with the single item calls and
+ *    at most once per batch with the others.
+ *
+ * Every item is numbered when it is sent, and checked byte for byte when it is
+ * received, so an item lost, repeated, reordered or copied wrongly is counted
+ * as an error.  A batch of 10 does not divide the queue length, so batches
+ * also wrap around the end of the queue storage area, where they are copied
+ * in two parts.  Numbering and checking take the same time per item for both
+ * APIs, and are included in the times.
+ *
+ * The times are host nanoseconds and include the cost of the simulator, whose
+ * critical sections mask signals with system calls, so only compare results
+ * taken on the same machine.
+ *
+ * The results are printed as CSV lines:
+ * api,test,item_size,batch,items,ns,items_per_second,errors
+ * where api is single or multiple.  The exit status is 1 if any test had
+ * errors.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#if ( configUSE_QUEUE_BATCHING != 1 )
+	#error configUSE_QUEUE_BATCHING must be set to 1 to build the queue benchmark
+#endif
+
+/* The control task outranks the producer, which outranks the consumer. */
+#define benchCONTROL_PRIORITY		( tskIDLE_PRIORITY + 3 )
+#define benchPRODUCER_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define benchCONSUMER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+#define benchSTACK_SIZE				configMINIMAL_STACK_SIZE
+
+/* Items moved by each test. */
+#define benchITEMS					200000UL
+
+#define benchQUEUE_LENGTH			64
+#define benchMAX_ITEM_SIZE			128
+
+typedef struct BENCH_RUN
+{
+	QueueHandle_t xQueue;
+	BaseType_t xMultiple;		/* pdTRUE to use the calls that move batches. */
+	UBaseType_t uxItemSize;
+	UBaseType_t uxBatch;
+} BenchRun_t;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters );
+static void prvProducerTask( void *pvParameters );
+static void prvConsumerTask( void *pvParameters );
+static uint64_t prvRunSameTask( const BenchRun_t *pxRun );
+static uint64_t prvRunProducerConsumer( const BenchRun_t *pxRun );
+static UBaseType_t prvSend( const BenchRun_t *pxRun, const uint8_t *pucItems, UBaseType_t uxItems );
+static UBaseType_t prvReceive( const BenchRun_t *pxRun, uint8_t *pucItems, UBaseType_t uxItems );
+static void prvNumberItems( const BenchRun_t *pxRun, uint8_t *pucItems, unsigned long ulFirst, UBaseType_t uxItems );
+static unsigned long prvCheckItems( const BenchRun_t *pxRun, const uint8_t *pucItems, unsigned long ulFirst, UBaseType_t uxItems );
+
+static uint64_t prvNowNs( void );
+static void prvPrintResult( const BenchRun_t *pxRun, const char *pcTest, uint64_t ullNs );
+
+/*-----------------------------------------------------------*/
+
+static const UBaseType_t uxItemSizes[] = { 4, 32, benchMAX_ITEM_SIZE };
+/* 10 does not divide benchQUEUE_LENGTH, so its batches wrap. */
+static const UBaseType_t uxBatches[] = { 1, 4, 10, 16, benchQUEUE_LENGTH };
+
+static TaskHandle_t xControlTask = NULL;
+
+/* Items received out of sequence or with the wrong contents, in the current
+test and in all of them. */
+static unsigned long ulErrors = 0;
+static unsigned long ulTotalErrors = 0;
+
+static uint8_t ucProducerItems[ benchQUEUE_LENGTH * benchMAX_ITEM_SIZE ];
+static uint8_t ucConsumerItems[ benchQUEUE_LENGTH * benchMAX_ITEM_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	if( xTaskCreate( prvControlTask, "Control", benchSTACK_SIZE, NULL, benchCONTROL_PRIORITY, &xControlTask, 0, 0 ) == pdPASS )
+	{
+		vTaskStartScheduler();
+	}
+	else
+	{
+		printf( "Error creating the control task.\n" );
+	}
+
+	return ( ulTotalErrors != 0 ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	BenchRun_t xRun;
+	UBaseType_t uxSize, uxBatch;
+
+	( void ) pvParameters;
+
+	printf( "api,test,item_size,batch,items,ns,items_per_second,errors\n" );
+
+	for( uxSize = 0; uxSize < sizeof( uxItemSizes ) / sizeof( uxItemSizes[ 0 ] ); uxSize++ )
+	{
+		xRun.uxItemSize = uxItemSizes[ uxSize ];
+		xRun.xQueue = xQueueCreate( benchQUEUE_LENGTH, xRun.uxItemSize );
+		configASSERT( xRun.xQueue != NULL );
+
+		/* The single item calls, which have no batch size of their own. */
+		xRun.xMultiple = pdFALSE;
+		xRun.uxBatch = 1;
+		prvPrintResult( &xRun, "same_task", prvRunSameTask( &xRun ) );
+		prvPrintResult( &xRun, "producer_consumer", prvRunProducerConsumer( &xRun ) );
+
+		xRun.xMultiple = pdTRUE;
+
+		for( uxBatch = 0; uxBatch < sizeof( uxBatches ) / sizeof( uxBatches[ 0 ] ); uxBatch++ )
+		{
+			xRun.uxBatch = uxBatches[ uxBatch ];
+			prvPrintResult( &xRun, "same_task", prvRunSameTask( &xRun ) );
+			prvPrintResult( &xRun, "producer_consumer", prvRunProducerConsumer( &xRun ) );
+		}
+
+		vQueueDelete( xRun.xQueue );
+	}
+
+	fflush( stdout );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvRunSameTask( const BenchRun_t *pxRun )
+{
+	uint64_t ullStartNs;
+	unsigned long ulItems;
+	UBaseType_t uxSent, uxReceived, uxItems;
+
+	ulErrors = 0;
+	ullStartNs = prvNowNs();
+
+	for( ulItems = 0; ulItems < benchITEMS; ulItems += uxSent )
+	{
+		prvNumberItems( pxRun, ucProducerItems, ulItems, pxRun->uxBatch );
+		uxSent = prvSend( pxRun, ucProducerItems, pxRun->uxBatch );
+
+		for( uxReceived = 0; uxReceived < uxSent; uxReceived += uxItems )
+		{
+			uxItems = prvReceive( pxRun, ucConsumerItems, uxSent - uxReceived );
+			ulErrors += prvCheckItems( pxRun, ucConsumerItems, ulItems + uxReceived, uxItems );
+		}
+	}
+
+	return prvNowNs() - ullStartNs;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvRunProducerConsumer( const BenchRun_t *pxRun )
+{
+	TaskHandle_t xProducer, xConsumer;
+	uint64_t ullStartNs;
+	BaseType_t xReturned;
+
+	ulErrors = 0;
+	ullStartNs = prvNowNs();
+
+	/* Both tasks are below this one, so they start when it waits for the
+	consumer to finish. */
+	xReturned = xTaskCreate( prvConsumerTask, "Consumer", benchSTACK_SIZE, ( void * ) pxRun, benchCONSUMER_PRIORITY, &xConsumer, 0, 0 );
+	configASSERT( xReturned == pdPASS );
+	xReturned = xTaskCreate( prvProducerTask, "Producer", benchSTACK_SIZE, ( void * ) pxRun, benchPRODUCER_PRIORITY, &xProducer, 0, 0 );
+	configASSERT( xReturned == pdPASS );
+	( void ) xReturned;
+
+	ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	ullStartNs = prvNowNs() - ullStartNs;
+
+	vTaskDelete( xProducer );
+	vTaskDelete( xConsumer );
+
+	return ullStartNs;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void *pvParameters )
+{
+	const BenchRun_t *pxRun = ( const BenchRun_t * ) pvParameters;
+	unsigned long ulItems;
+	UBaseType_t uxBatch;
+
+	for( ulItems = 0; ulItems < benchITEMS; )
+	{
+		uxBatch = ( benchITEMS - ulItems < pxRun->uxBatch ) ? ( UBaseType_t ) ( benchITEMS - ulItems ) : pxRun->uxBatch;
+		prvNumberItems( pxRun, ucProducerItems, ulItems, uxBatch );
+		ulItems += prvSend( pxRun, ucProducerItems, uxBatch );
+	}
+
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void *pvParameters )
+{
+	const BenchRun_t *pxRun = ( const BenchRun_t * ) pvParameters;
+	unsigned long ulItems;
+	UBaseType_t uxItems;
+
+	for( ulItems = 0; ulItems < benchITEMS; ulItems += uxItems )
+	{
+		uxItems = prvReceive( pxRun, ucConsumerItems, pxRun->uxBatch );
+		ulErrors += prvCheckItems( pxRun, ucConsumerItems, ulItems, uxItems );
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvSend( const BenchRun_t *pxRun, const uint8_t *pucItems, UBaseType_t uxItems )
+{
+	UBaseType_t uxSent = 0;
+
+	if( pxRun->xMultiple != pdFALSE )
+	{
+		uxSent = xQueueSendMultiple( pxRun->xQueue, pucItems, uxItems, portMAX_DELAY );
+	}
+	else if( xQueueSend( pxRun->xQueue, pucItems, portMAX_DELAY ) == pdPASS )
+	{
+		uxSent = 1;
+	}
+
+	return uxSent;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvReceive( const BenchRun_t *pxRun, uint8_t *pucItems, UBaseType_t uxItems )
+{
+	UBaseType_t uxReceived = 0;
+
+	if( pxRun->xMultiple != pdFALSE )
+	{
+		uxReceived = xQueueReceiveMultiple( pxRun->xQueue, pucItems, uxItems, portMAX_DELAY );
+	}
+	else if( xQueueReceive( pxRun->xQueue, pucItems, portMAX_DELAY ) == pdPASS )
+	{
+		uxReceived = 1;
+	}
+
+	return uxReceived;
+}
+/*-----------------------------------------------------------*/
+
+static void prvNumberItems( const BenchRun_t *pxRun, uint8_t *pucItems, unsigned long ulFirst, UBaseType_t uxItems )
+{
+	UBaseType_t uxItem, uxByte;
+	uint32_t ulNumber;
+	uint8_t *pucItem;
+
+	/* The item number goes in the first four bytes, and the rest of the item
+	is filled with bytes derived from it. */
+	for( uxItem = 0; uxItem < uxItems; uxItem++ )
+	{
+		ulNumber = ( uint32_t ) ( ulFirst + uxItem );
+		pucItem = &( pucItems[ uxItem * pxRun->uxItemSize ] );
+		memcpy( pucItem, &ulNumber, sizeof( ulNumber ) );
+
+		for( uxByte = sizeof( ulNumber ); uxByte < pxRun->uxItemSize; uxByte++ )
+		{
+			pucItem[ uxByte ] = ( uint8_t ) ( ulNumber ^ uxByte );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvCheckItems( const BenchRun_t *pxRun, const uint8_t *pucItems, unsigned long ulFirst, UBaseType_t uxItems )
+{
+	static uint8_t ucExpected[ benchMAX_ITEM_SIZE ];
+	unsigned long ulItemErrors = 0;
+	UBaseType_t uxItem;
+
+	for( uxItem = 0; uxItem < uxItems; uxItem++ )
+	{
+		prvNumberItems( pxRun, ucExpected, ulFirst + uxItem, 1 );
+
+		if( memcmp( &( pucItems[ uxItem * pxRun->uxItemSize ] ), ucExpected, pxRun->uxItemSize ) != 0 )
+		{
+			ulItemErrors++;
+		}
+	}
+
+	return ulItemErrors;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNowNs( void )
+{
+	struct timespec xTime;
+
+	clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+	return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintResult( const BenchRun_t *pxRun, const char *pcTest, uint64_t ullNs )
+{
+	printf( "%s,%s,%lu,%lu,%lu,%llu,%llu,%lu\n", ( pxRun->xMultiple != pdFALSE ) ? "multiple" : "single", pcTest,
+			( unsigned long ) pxRun->uxItemSize, ( unsigned long ) pxRun->uxBatch, benchITEMS,
+			( unsigned long long ) ullNs, ( unsigned long long ) ( ( benchITEMS * 1000000000ULL ) / ( ullNs ? ullNs : 1 ) ), ulErrors );
+
+	ulTotalErrors += ulErrors;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	/* Nothing is measured on the tick. */
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	printf( "Malloc failed\n" );
+	portDISABLE_INTERRUPTS();
+	for( ;; )
+	{
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char *pcFileName, uint32_t ulLine )
+{
+	printf( "ASSERT! Line %lu, file %s\n", ( unsigned long ) ulLine, pcFileName );
+	fflush( stdout );
+	portDISABLE_INTERRUPTS();
+	for( ;; )
+	{
+	}
+}
@@ -0,0 +1,352 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/******************************************************************************
+ * Queue wakeup test for the Linux simulator
+ * (portable/ThirdParty/GCC/Posix).
+ *
+ * Checks that no task is left blocked on a queue it could use when more than
+ * one task is waiting on it:
+ *	make queue-test
+ *
+ *  - release: an item is held by pvQueuePeekInPlace() while two readers block
+ *    on the queue and two more items are sent.  Both readers must receive an
+ *    item once the peeked item is released.
+ *  - commit:  a slot is held by pvQueueReserve() while two writers block on
+ *    the queue.  Both writers must send their item once the slot is committed.
+ *  - send_multiple:    two readers block on an empty queue and two items are
+ *    sent with one xQueueSendMultiple().  It wakes one reader, which must pass
+ *    the wakeup on to the other.
+ *  - receive_multiple: two writers block on a full queue and every item is
+ *    received with one xQueueReceiveMultiple().  It wakes one writer, which
+ *    must pass the wakeup on to the other.
+ *
+ * Each test prints a line test,waiters,done,PASS or test,waiters,done,FAIL,
+ * where done is the number of waiters that went on.  The exit status is the
+ * number of tests that failed.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdint.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#if ( configUSE_QUEUE_ZERO_COPY != 1 ) || ( configUSE_QUEUE_BATCHING != 1 )
+	#error configUSE_QUEUE_ZERO_COPY and configUSE_QUEUE_BATCHING must be set to 1 to build the queue test
+#endif
+
+/* The control task outranks the waiters, so it runs until it delays to let
+them block or go on. */
+#define testCONTROL_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define testWAITER_PRIORITY			( tskIDLE_PRIORITY + 1 )
+
+#define testSTACK_SIZE				configMINIMAL_STACK_SIZE
+
+#define testQUEUE_LENGTH			4
+#define testWAITERS					2
+
+/* Long enough for every waiter that is ready to run to block again or finish. */
+#define testSETTLE_TICKS			pdMS_TO_TICKS( 10 )
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters );
+static void prvReaderTask( void *pvParameters );
+static void prvWriterTask( void *pvParameters );
+static BaseType_t prvTestRelease( void );
+static BaseType_t prvTestCommit( void );
+static BaseType_t prvTestSendMultiple( void );
+static BaseType_t prvTestReceiveMultiple( void );
+static void prvCreateWaiters( TaskFunction_t pxWaiter, TaskHandle_t *pxWaiters );
+static void prvDeleteWaiters( TaskHandle_t *pxWaiters );
+static BaseType_t prvPrintResult( const char *pcTest, UBaseType_t uxDone );
+
+/*-----------------------------------------------------------*/
+
+static QueueHandle_t xQueue = NULL;
+
+/* The number of waiters that went on. */
+static volatile UBaseType_t uxWaitersDone = 0;
+
+static int iFailures = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	if( xTaskCreate( prvControlTask, "Control", testSTACK_SIZE, NULL, testCONTROL_PRIORITY, NULL, 0, 0 ) == pdPASS )
+	{
+		vTaskStartScheduler();
+	}
+	else
+	{
+		printf( "Error creating the control task.\n" );
+		iFailures = 1;
+	}
+
+	return iFailures;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	xQueue = xQueueCreate( testQUEUE_LENGTH, sizeof( uint32_t ) );
+	configASSERT( xQueue != NULL );
+
+	printf( "test,waiters,done,result\n" );
+
+	if( prvTestRelease() == pdFAIL )
+	{
+		iFailures++;
+	}
+
+	if( prvTestCommit() == pdFAIL )
+	{
+		iFailures++;
+	}
+
+	if( prvTestSendMultiple() == pdFAIL )
+	{
+		iFailures++;
+	}
+
+	if( prvTestReceiveMultiple() == pdFAIL )
+	{
+		iFailures++;
+	}
+
+	vQueueDelete( xQueue );
+
+	fflush( stdout );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestRelease( void )
+{
+	TaskHandle_t xWaiters[ testWAITERS ];
+	uint32_t ulItem;
+	UBaseType_t uxItem;
+	void *pvItem;
+
+	xQueueReset( xQueue );
+	uxWaitersDone = 0;
+
+	ulItem = 0;
+	xQueueSend( xQueue, &ulItem, 0 );
+	pvItem = pvQueuePeekInPlace( xQueue, 0 );
+	configASSERT( pvItem != NULL );
+	( void ) pvItem;
+
+	prvCreateWaiters( prvReaderTask, xWaiters );
+
+	/* Each item sent wakes a reader, which finds the head item still held and
+	blocks again. */
+	for( uxItem = 1; uxItem <= testWAITERS; uxItem++ )
+	{
+		ulItem = ( uint32_t ) uxItem;
+		xQueueSend( xQueue, &ulItem, 0 );
+		vTaskDelay( testSETTLE_TICKS );
+	}
+
+	xQueueRelease( xQueue );
+	vTaskDelay( testSETTLE_TICKS );
+
+	prvDeleteWaiters( xWaiters );
+
+	return prvPrintResult( "release", uxWaitersDone );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestCommit( void )
+{
+	TaskHandle_t xWaiters[ testWAITERS ];
+	uint32_t *pulSlot;
+
+	xQueueReset( xQueue );
+	uxWaitersDone = 0;
+
+	pulSlot = ( uint32_t * ) pvQueueReserve( xQueue, 0 );
+	configASSERT( pulSlot != NULL );
+
+	/* Both writers find the slot held and block, though there is space. */
+	prvCreateWaiters( prvWriterTask, xWaiters );
+
+	*pulSlot = 0;
+	xQueueCommit( xQueue );
+	vTaskDelay( testSETTLE_TICKS );
+
+	prvDeleteWaiters( xWaiters );
+
+	return prvPrintResult( "commit", uxWaitersDone );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestSendMultiple( void )
+{
+	TaskHandle_t xWaiters[ testWAITERS ];
+	uint32_t ulItems[ testWAITERS ] = { 0 };
+	UBaseType_t uxSent;
+
+	xQueueReset( xQueue );
+	uxWaitersDone = 0;
+
+	prvCreateWaiters( prvReaderTask, xWaiters );
+
+	uxSent = xQueueSendMultiple( xQueue, ulItems, testWAITERS, 0 );
+	configASSERT( uxSent == testWAITERS );
+	( void ) uxSent;
+	vTaskDelay( testSETTLE_TICKS );
+
+	prvDeleteWaiters( xWaiters );
+
+	return prvPrintResult( "send_multiple", uxWaitersDone );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestReceiveMultiple( void )
+{
+	TaskHandle_t xWaiters[ testWAITERS ];
+	uint32_t ulItems[ testQUEUE_LENGTH ] = { 0 };
+	UBaseType_t uxReceived;
+
+	xQueueReset( xQueue );
+	uxWaitersDone = 0;
+
+	( void ) xQueueSendMultiple( xQueue, ulItems, testQUEUE_LENGTH, 0 );
+
+	prvCreateWaiters( prvWriterTask, xWaiters );
+
+	uxReceived = xQueueReceiveMultiple( xQueue, ulItems, testQUEUE_LENGTH, 0 );
+	configASSERT( uxReceived == testQUEUE_LENGTH );
+	( void ) uxReceived;
+	vTaskDelay( testSETTLE_TICKS );
+
+	prvDeleteWaiters( xWaiters );
+
+	return prvPrintResult( "receive_multiple", uxWaitersDone );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateWaiters( TaskFunction_t pxWaiter, TaskHandle_t *pxWaiters )
+{
+	UBaseType_t uxWaiter;
+	BaseType_t xReturned;
+
+	for( uxWaiter = 0; uxWaiter < testWAITERS; uxWaiter++ )
+	{
+		xReturned = xTaskCreate( pxWaiter, "Waiter", testSTACK_SIZE, NULL, testWAITER_PRIORITY, &( pxWaiters[ uxWaiter ] ), 0, 0 );
+		configASSERT( xReturned == pdPASS );
+		( void ) xReturned;
+	}
+
+	/* The waiters run and block. */
+	vTaskDelay( testSETTLE_TICKS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeleteWaiters( TaskHandle_t *pxWaiters )
+{
+	UBaseType_t uxWaiter;
+
+	for( uxWaiter = 0; uxWaiter < testWAITERS; uxWaiter++ )
+	{
+		vTaskDelete( pxWaiters[ uxWaiter ] );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void *pvParameters )
+{
+	uint32_t ulItem;
+
+	( void ) pvParameters;
+
+	if( xQueueReceive( xQueue, &ulItem, portMAX_DELAY ) == pdPASS )
+	{
+		uxWaitersDone++;
+	}
+
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriterTask( void *pvParameters )
+{
+	const uint32_t ulItem = 1;
+
+	( void ) pvParameters;
+
+	if( xQueueSend( xQueue, &ulItem, portMAX_DELAY ) == pdPASS )
+	{
+		uxWaitersDone++;
+	}
+
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPrintResult( const char *pcTest, UBaseType_t uxDone )
+{
+	BaseType_t xReturn = ( uxDone == testWAITERS ) ? pdPASS : pdFAIL;
+
+	printf( "%s,%d,%lu,%s\n", pcTest, testWAITERS, ( unsigned long ) uxDone, ( xReturn == pdPASS ) ? "PASS" : "FAIL" );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	/* Nothing is measured on the tick. */
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	printf( "Malloc failed\n" );
+	portDISABLE_INTERRUPTS();
+	for( ;; )
+	{
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char *pcFileName, uint32_t ulLine )
+{
+	printf( "ASSERT! Line %lu, file %s\n", ( unsigned long ) ulLine, pcFileName );
+	fflush( stdout );
+	portDISABLE_INTERRUPTS();
+	for( ;; )
+	{
+	}
+}
@@ -411,8 +411,14 @@
 #ifndef traceTASK_SWITCHED_IN
 
 /* Called after a task has been selected to run.  pxCurrentTCB holds a pointer
- * to the task control block of the selected task. */
-    #define traceTASK_SWITCHED_IN()
+ * to the task control block of the selected task.  The schedule trace records
+ * the switch from here, so a definition provided by the application must call
+ * vTaskScheduleTraceSwitchedIn() when configUSE_SCHEDULE_TRACE is 1. */
+    #if ( defined( configUSE_SCHEDULE_TRACE ) && ( configUSE_SCHEDULE_TRACE == 1 ) )
+        #define traceTASK_SWITCHED_IN()    vTaskScheduleTraceSwitchedIn()
+    #else
+        #define traceTASK_SWITCHED_IN()
+    #endif
 #endif
 
 #ifndef traceINCREASE_TICK_COUNT
@@ -435,8 +441,14 @@
 #ifndef traceTASK_SWITCHED_OUT
 
 /* Called before a task has been selected to run.  pxCurrentTCB holds a pointer
- * to the task control block of the task being switched out. */
-    #define traceTASK_SWITCHED_OUT()
+ * to the task control block of the task being switched out.  A definition
+ * provided by the application must call vTaskScheduleTraceSwitchedOut() when
+ * configUSE_SCHEDULE_TRACE is 1. */
+    #if ( defined( configUSE_SCHEDULE_TRACE ) && ( configUSE_SCHEDULE_TRACE == 1 ) )
+        #define traceTASK_SWITCHED_OUT()    vTaskScheduleTraceSwitchedOut()
+    #else
+        #define traceTASK_SWITCHED_OUT()
+    #endif
 #endif
 
 #ifndef traceTASK_PRIORITY_INHERIT
@@ -619,6 +631,34 @@
     #define traceTASK_DELAY_UNTIL( x )
 #endif
 
+#ifndef traceTASK_JOB_COMPLETE
+    #define traceTASK_JOB_COMPLETE( pxTCB )
+#endif
+
+#ifndef traceTASK_JOB_RELEASED
+    #define traceTASK_JOB_RELEASED( pxTCB )
+#endif
+
+#ifndef traceTASK_ADMISSION_FAILED
+    #define traceTASK_ADMISSION_FAILED( pcName )
+#endif
+
+#ifndef traceTASK_DEADLINE_MISSED
+    #define traceTASK_DEADLINE_MISSED( pxTCB )
+#endif
+
+#ifndef traceTASK_BUDGET_EXHAUSTED
+    #define traceTASK_BUDGET_EXHAUSTED( pxTCB )
+#endif
+
+#ifndef traceTASK_PRIORITY_CEILING
+    #define traceTASK_PRIORITY_CEILING( pxTCB, uxCeilingPriority )
+#endif
+
+#ifndef traceRM_PERIOD_CLASSES_FULL
+    #define traceRM_PERIOD_CLASSES_FULL( xPeriod )
+#endif
+
 #ifndef traceTASK_DELAY
     #define traceTASK_DELAY()
 #endif
@@ -853,6 +893,12 @@
     #error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than 2
 #endif
 
+/* Tickless idle stops the tick only while the idle task runs.  The sleep ends
+ * on the next tick on which a task wakes, a job is released or a missed job
+ * deadline is due to be detected.  The tick keeps running while any other task
+ * runs, job or not, as time slicing, budget enforcement and tasks that time
+ * their work with xTaskGetTickCount() all rely on it, so a job budget running
+ * out never has to end a sleep. */
 #ifndef configUSE_TICKLESS_IDLE
     #define configUSE_TICKLESS_IDLE    0
 #endif
@@ -889,6 +935,231 @@
     #define configUSE_TIME_SLICING    1
 #endif
 
+#ifndef configUSE_RM
+    #define configUSE_RM    0
+#endif
+
+/* Set to 1, with configUSE_RM left at 0, to run the ready tasks of each
+ * priority in Earliest Deadline First order instead of Rate Monotonic order.
+ * Each ready list is kept sorted by deadline, so a task made ready, and the
+ * running task on every context switch, is inserted by walking the ready list
+ * of its priority from the head.  That walk is done with interrupts disabled
+ * and in the worst case visits every ready task at the priority, so keep the
+ * number of tasks that can be ready at one priority small, or spread them over
+ * several priorities, when interrupt latency matters. */
+#ifndef configUSE_EDF
+    #define configUSE_EDF    0
+#endif
+
+/* Set to 1, with configUSE_RM and configUSE_EDF left at 0, to schedule tasks
+ * that have a period in Rate Monotonic order using the native priorities.  The
+ * priority passed when such a task is created is ignored.  Instead the
+ * shortest period in use runs at configRM_AUTO_PRIORITY_HIGHEST, the next at
+ * one priority less and so on down to configRM_AUTO_PRIORITY_LOWEST.  So at
+ * most ( configRM_AUTO_PRIORITY_HIGHEST - configRM_AUTO_PRIORITY_LOWEST + 1 )
+ * distinct periods can be in use at once.  Creating a task with a further
+ * period fails configASSERT(), and with configASSERT() not defined the longer
+ * periods share configRM_AUTO_PRIORITY_LOWEST and run in the order they became
+ * ready rather than in Rate Monotonic order.  The priorities are assigned
+ * again each time a task with a period is created or deleted.  Tasks without a
+ * period, such as the Idle and timer tasks, keep the priority they were
+ * created with. */
+#ifndef configUSE_RM_AUTO_PRIORITY
+    #define configUSE_RM_AUTO_PRIORITY    0
+#endif
+
+#ifndef configRM_AUTO_PRIORITY_LOWEST
+    #define configRM_AUTO_PRIORITY_LOWEST    1
+#endif
+
+#ifndef configRM_AUTO_PRIORITY_HIGHEST
+    #define configRM_AUTO_PRIORITY_HIGHEST    ( configMAX_PRIORITIES - 1 )
+#endif
+
+/* Under Rate Monotonic scheduling each priority level has one ready list per
+ * distinct period in use, so this is the number of different periods tasks can
+ * have at once.  One is kept for tasks created without a period.  Creating a
+ * task with a further period once all are in use fails configASSERT(), and is
+ * rejected by the admission control of xTaskCreatePeriodic().  With
+ * configASSERT() not defined the task runs as if it had no period, below every
+ * task that has one. */
+#ifndef configRM_MAX_DISTINCT_PERIODS
+    #define configRM_MAX_DISTINCT_PERIODS    10
+#endif
+
+/* Set to 1 to have xTaskCreatePeriodic() reject a task that would make the set
+ * of periodic tasks unschedulable. */
+#ifndef configUSE_RM_ADMISSION_CONTROL
+    #define configUSE_RM_ADMISSION_CONTROL    0
+#endif
+
+/* Set to 1 to have the tick interrupt check the deadline of every job of the
+ * tasks created by xTaskCreatePeriodic(). */
+#ifndef configUSE_DEADLINE_MISS_DETECTION
+    #define configUSE_DEADLINE_MISS_DETECTION    0
+#endif
+
+/* What the kernel does when a job misses its deadline.
+ * pdDEADLINE_MISS_NOTIFY calls vApplicationDeadlineMissedHook().
+ * pdDEADLINE_MISS_SKIP lets the late job finish, then drops the releases that
+ * passed while it ran.
+ * pdDEADLINE_MISS_ABORT ends any wait the job is in, and the job is expected
+ * to return once xTaskJobDeadlineMissed() reports the miss. */
+#ifndef configDEADLINE_MISS_POLICY
+    #define configDEADLINE_MISS_POLICY    pdDEADLINE_MISS_NOTIFY
+#endif
+
+/* Set to 1 to hold each job of a periodic task to its CpuBurst.  A job that
+ * runs for longer is suspended until the next release of its task, at which
+ * point it continues with a fresh budget.  Execution time is measured with the
+ * run time stats counter, so configGENERATE_RUN_TIME_STATS must be 1 and
+ * configRUN_TIME_COUNTS_PER_TICK must be defined. */
+#ifndef configUSE_BUDGET_ENFORCEMENT
+    #define configUSE_BUDGET_ENFORCEMENT    0
+#endif
+
+/* Set to 1 to allow mutexes to be created with xSemaphoreCreateMutexWithCeiling().
+ * A task that takes such a mutex runs at its ceiling, a priority and under
+ * Rate Monotonic scheduling a period, until it holds no mutexes.  A job is then
+ * blocked by at most one critical section of a task it can delay, and with
+ * configUSE_RM_ADMISSION_CONTROL set that blocking is part of the admission
+ * test. */
+#ifndef configUSE_MUTEX_CEILING
+    #define configUSE_MUTEX_CEILING    0
+#endif
+
+/* Set to 1 to include pvQueueReserve(), xQueueCommit(), pvQueuePeekInPlace()
+ * and xQueueRelease(), with which a task writes an item into, or reads an item
+ * from, the queue storage area itself instead of copying it in and out. */
+#ifndef configUSE_QUEUE_ZERO_COPY
+    #define configUSE_QUEUE_ZERO_COPY    0
+#endif
+
+/* Set to 1 to include xQueueSendMultiple(), xQueueReceiveMultiple() and their
+ * FromISR versions, which move a number of items to or from a queue in one
+ * critical section and wake at most one task. */
+#ifndef configUSE_QUEUE_BATCHING
+    #define configUSE_QUEUE_BATCHING    0
+#endif
+
+/* Set to 1 to record, for each task created by xTaskCreatePeriodic(), how many
+ * ticks after its nominal release time each job was made ready.  The figures
+ * are read with vTaskGetReleaseJitter(). */
+#ifndef configUSE_RELEASE_JITTER_STATS
+    #define configUSE_RELEASE_JITTER_STATS    0
+#endif
+
+/* Set to 1 to count, for each task created by xTaskCreatePeriodic(), the jobs
+ * released and completed, the times the task was preempted and the longest
+ * response time of a job.  The counts are returned in TaskStatus_t by
+ * vTaskGetInfo() and uxTaskGetSystemState().  Each count is written from one
+ * place only and is no wider than a word, so no critical section is added to
+ * the paths that update them. */
+#ifndef configUSE_JOB_STATS
+    #define configUSE_JOB_STATS    0
+#endif
+
+/* Set to 1 to count the ticks during which the idle task was running, in
+ * total and over a window of the most recent configIDLE_TIME_WINDOW_TICKS
+ * ticks.  The figures, and the CPU load they give, are read with
+ * vTaskGetIdleTime().  The idle time is measured with the run time counter
+ * when configGENERATE_RUN_TIME_STATS is 1, and sampled on each tick
+ * otherwise. */
+#ifndef configUSE_IDLE_TIME_STATS
+    #define configUSE_IDLE_TIME_STATS    0
+#endif
+
+#ifndef configIDLE_TIME_WINDOW_TICKS
+    #define configIDLE_TIME_WINDOW_TICKS    1000
+#endif
+
+/* Set to 1 to include xTaskCreateAperiodicServer().  An aperiodic server is a
+ * periodic task that runs jobs submitted at any time, up to a budget in each
+ * period, so aperiodic work gets a fixed share of the processor at the Rate
+ * Monotonic rank of the server's period.  Requires configUSE_BUDGET_ENFORCEMENT
+ * to stop the server at the end of its budget. */
+#ifndef configUSE_APERIODIC_SERVER
+    #define configUSE_APERIODIC_SERVER    0
+#endif
+
+/* Set to 1 to include xTaskCreateSporadic().  A sporadic task runs a job each
+ * time it is notified, but no sooner than a minimum inter-arrival time after
+ * its previous job, so it can be scheduled and admitted as a periodic task
+ * with that period. */
+#ifndef configUSE_SPORADIC_TASKS
+    #define configUSE_SPORADIC_TASKS    0
+#endif
+
+/* Set to 1 to hold the tasks that are blocked with a timeout in a hierarchical
+ * timing wheel rather than in a list sorted by wake time, so blocking a task
+ * and unblocking it when its timeout expires take the same time however many
+ * tasks are blocked.  The wheel has configDELAY_WHEEL_LEVELS levels of 32
+ * slots, each slot spanning 32 times as many ticks as a slot of the level
+ * below, so it holds timeouts of up to 32 ^ configDELAY_WHEEL_LEVELS ticks.
+ * Longer timeouts wait in the sorted list until they come within range. */
+#ifndef configUSE_DELAY_WHEEL
+    #define configUSE_DELAY_WHEEL    0
+#endif
+
+#ifndef configDELAY_WHEEL_LEVELS
+    #define configDELAY_WHEEL_LEVELS    3
+#endif
+
+/* Set to 1 to record when each task was switched in and out, and when its
+ * jobs were released, completed or missed their deadline, in a ring of the
+ * last configSCHEDULE_TRACE_LENGTH events.  The events are read with
+ * uxTaskGetScheduleTrace().  They are timestamped in ticks unless
+ * configSCHEDULE_TRACE_TIMESTAMP() is defined to read a finer clock, such as a
+ * cycle counter.  Switches are recorded by the default traceTASK_SWITCHED_OUT()
+ * and traceTASK_SWITCHED_IN() macros. */
+#ifndef configUSE_SCHEDULE_TRACE
+    #define configUSE_SCHEDULE_TRACE    0
+#endif
+
+#ifndef configSCHEDULE_TRACE_LENGTH
+    #define configSCHEDULE_TRACE_LENGTH    512
+#endif
+
+/* Set to 1 to have xTaskCreate() take the TCB and stack of a task from fixed
+ * block pools instead of the heap, and prvDeleteTCB() give them back, both in
+ * constant time.  There are configTASK_POOL_TCBS TCBs and up to three classes
+ * of stack, class n holding configTASK_POOL_STACKS_n stacks of
+ * configTASK_POOL_STACK_DEPTH_n words, in ascending order of depth.  A task
+ * takes the smallest free stack at least as deep as it asks for.  When no
+ * block fits the heap is used as before, so the pools should be sized for the
+ * tasks that are created and deleted at run time. */
+#ifndef configUSE_TASK_POOLS
+    #define configUSE_TASK_POOLS    0
+#endif
+
+#ifndef configTASK_POOL_TCBS
+    #define configTASK_POOL_TCBS    8
+#endif
+
+#ifndef configTASK_POOL_STACK_DEPTH_1
+    #define configTASK_POOL_STACK_DEPTH_1    configMINIMAL_STACK_SIZE
+#endif
+
+#ifndef configTASK_POOL_STACKS_1
+    #define configTASK_POOL_STACKS_1    8
+#endif
+
+#ifndef configTASK_POOL_STACK_DEPTH_2
+    #define configTASK_POOL_STACK_DEPTH_2    ( configMINIMAL_STACK_SIZE * 2 )
+#endif
+
+#ifndef configTASK_POOL_STACKS_2
+    #define configTASK_POOL_STACKS_2    0
+#endif
+
+#ifndef configTASK_POOL_STACK_DEPTH_3
+    #define configTASK_POOL_STACK_DEPTH_3    ( configMINIMAL_STACK_SIZE * 4 )
+#endif
+
+#ifndef configTASK_POOL_STACKS_3
+    #define configTASK_POOL_STACKS_3    0
+#endif
+
 #ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
     #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS    0
 #endif
@@ -1003,6 +1274,26 @@
     #error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if ( ( configUSE_MUTEX_CEILING == 1 ) && ( ( configUSE_MUTEXES != 1 ) || ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) ) )
+    #error configUSE_MUTEXES and configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use mutex ceilings
+#endif
+
+#if ( ( configUSE_RELEASE_JITTER_STATS == 1 ) && ( ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) || ( INCLUDE_xTaskDelayUntil != 1 ) ) )
+    #error configSUPPORT_DYNAMIC_ALLOCATION and INCLUDE_xTaskDelayUntil must be set to 1 to record release jitter, as only periodic tasks are released
+#endif
+
+#if ( ( configUSE_JOB_STATS == 1 ) && ( ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) || ( INCLUDE_xTaskDelayUntil != 1 ) || ( configUSE_TRACE_FACILITY != 1 ) ) )
+    #error configSUPPORT_DYNAMIC_ALLOCATION, INCLUDE_xTaskDelayUntil and configUSE_TRACE_FACILITY must be set to 1 to count jobs, as only periodic tasks have jobs and the counts are read through TaskStatus_t
+#endif
+
+#if ( ( configUSE_SCHEDULE_TRACE == 1 ) && ( configUSE_TRACE_FACILITY != 1 ) )
+    #error configUSE_TRACE_FACILITY must be set to 1 to record the schedule trace, as tasks are identified by the xTaskNumber of their TaskStatus_t
+#endif
+
+#if ( ( configUSE_TASK_POOLS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
+    #error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use task pools, as they replace the allocations made by xTaskCreate()
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
     #define configINITIAL_TICK_COUNT    0
 #endif
@@ -1301,8 +1592,46 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
-    int CpuBurst;
-    int urgency;
+    TickType_t xDummy23[ 3 ];
+    #if ( configUSE_RM == 1 )
+        UBaseType_t uxDummy24;
+    #endif
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
+        void * pxDummy25;
+        TickType_t xDummy26;
+    #endif
+    #if ( configUSE_RM_ADMISSION_CONTROL == 1 )
+        StaticListItem_t xDummy27;
+    #endif
+    #if ( configUSE_RM_AUTO_PRIORITY == 1 )
+        StaticListItem_t xDummy40;
+    #endif
+    #if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+        StaticListItem_t xDummy28;
+        UBaseType_t uxDummy29;
+        uint8_t ucDummy30;
+    #endif
+    #if ( configUSE_BUDGET_ENFORCEMENT == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy31;
+    #endif
+    #if ( ( configUSE_RM == 1 ) && ( configUSE_MUTEX_CEILING == 1 ) )
+        UBaseType_t uxDummy32;
+    #endif
+    #if ( configUSE_RELEASE_JITTER_STATS == 1 )
+        UBaseType_t uxDummy33;
+        TickType_t xDummy34[ 2 ];
+        uint64_t ullDummy35;
+    #endif
+    #if ( configUSE_JOB_STATS == 1 )
+        UBaseType_t uxDummy36[ 3 ];
+        TickType_t xDummy37;
+    #endif
+    #if ( configUSE_APERIODIC_SERVER == 1 )
+        void * pvDummy38;
+    #endif
+    #if ( configUSE_SPORADIC_TASKS == 1 )
+        uint8_t ucDummy39;
+    #endif
 } StaticTask_t;
 
 /*
@@ -1345,6 +1674,14 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_MUTEX_CEILING == 1 )
+        void * pvDummy10;
+    #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        void * pvDummy11[ 2 ];
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -90,6 +90,59 @@
     #define configSTACK_ALLOCATION_FROM_SEPARATE_HEAP    0
 #endif
 
+/* Set to 1 to have heap_4.c and heap_5.c measure themselves, for
+ * vPortGetHeapInstrumentation() to read at run time:
+ * - the time each pvPortMalloc() and vPortFree() call took, in a histogram of
+ *   configHEAP_LATENCY_BUCKETS power of two buckets.  Calls are timed with the
+ *   tick count unless configHEAP_TIMESTAMP() is defined to read a finer clock.
+ * - the free bytes, the largest free block and the number of free blocks,
+ *   sampled once configHEAP_HISTORY_PERIOD ticks or configHEAP_HISTORY_CALLS
+ *   pvPortMalloc() and vPortFree() calls have passed since the last sample,
+ *   and whenever an allocation fails, into a ring of the last
+ *   configHEAP_HISTORY_LENGTH samples.  Counting calls keeps a burst of
+ *   allocations within one tick, such as creating tasks before the scheduler
+ *   starts, from being seen as a single sample.  Set configHEAP_HISTORY_CALLS
+ *   to 0 to sample on time only.
+ * - the allocations made from each of up to configHEAP_CALLERS call sites,
+ *   told apart by the address configHEAP_CALLER_ADDRESS() returns from within
+ *   pvPortMalloc(), which defaults to the return address where the compiler
+ *   provides it. */
+#ifndef configUSE_HEAP_INSTRUMENTATION
+    #define configUSE_HEAP_INSTRUMENTATION    0
+#endif
+
+#ifndef configHEAP_LATENCY_BUCKETS
+    #define configHEAP_LATENCY_BUCKETS    16
+#endif
+
+#ifndef configHEAP_HISTORY_LENGTH
+    #define configHEAP_HISTORY_LENGTH    32
+#endif
+
+#ifndef configHEAP_HISTORY_PERIOD
+    #define configHEAP_HISTORY_PERIOD    100
+#endif
+
+#ifndef configHEAP_HISTORY_CALLS
+    #define configHEAP_HISTORY_CALLS    16
+#endif
+
+#ifndef configHEAP_CALLERS
+    #define configHEAP_CALLERS    16
+#endif
+
+#ifndef configHEAP_TIMESTAMP
+    #define configHEAP_TIMESTAMP()    ( ( uint32_t ) xTaskGetTickCount() )
+#endif
+
+#ifndef configHEAP_CALLER_ADDRESS
+    #if defined( __GNUC__ )
+        #define configHEAP_CALLER_ADDRESS()    __builtin_return_address( 0 )
+    #else
+        #define configHEAP_CALLER_ADDRESS()    NULL
+    #endif
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     extern "C" {
@@ -150,6 +203,46 @@ typedef struct xHeapStats
     size_t xNumberOfSuccessfulFrees;        /* The number of calls to vPortFree() that has successfully freed a block of memory. */
 } HeapStats_t;
 
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/* The allocations made from one call site, used in HeapInstrumentation_t. */
+    typedef struct xHeapCaller
+    {
+        void * pvCaller;                   /* The address configHEAP_CALLER_ADDRESS() returned for the call site. */
+        size_t xNumberOfAllocations;       /* The number of calls from there that returned a valid memory block. */
+        size_t xNumberOfFailedAllocations; /* The number of calls from there that returned NULL. */
+        size_t xBytesAllocated;            /* The bytes taken from the heap by the successful calls, including block headers and alignment. */
+    } HeapCaller_t;
+
+/* The state of the heap at one point in time, used in HeapInstrumentation_t. */
+    typedef struct xHeapSample
+    {
+        TickType_t xTimeInTicks;                /* The tick count when the sample was taken. */
+        size_t xNumberOfCalls;                  /* The pvPortMalloc() and vPortFree() calls made before the sample was taken, which orders the samples taken within one tick. */
+        size_t xAvailableHeapSpaceInBytes;      /* The sum of all the free blocks. */
+        size_t xSizeOfLargestFreeBlockInBytes;  /* The largest allocation that could have succeeded, plus its block header. */
+        size_t xNumberOfFreeBlocks;             /* The number of free blocks, which grows as the heap fragments. */
+    } HeapSample_t;
+
+/* Used to pass the measurements of configUSE_HEAP_INSTRUMENTATION out of
+ * vPortGetHeapInstrumentation(). */
+    typedef struct xHeapInstrumentation
+    {
+        uint32_t ulMallocLatency[ configHEAP_LATENCY_BUCKETS ]; /* Bucket 0 counts the pvPortMalloc() calls that took no time on configHEAP_TIMESTAMP(), bucket n > 0 those that took from 2 ^ ( n - 1 ) to 2 ^ n - 1, and the last bucket also counts all longer calls. */
+        uint32_t ulFreeLatency[ configHEAP_LATENCY_BUCKETS ];   /* The same for vPortFree(). */
+        uint32_t ulMaximumMallocLatency;                        /* The longest pvPortMalloc() call. */
+        uint32_t ulMaximumFreeLatency;                          /* The longest vPortFree() call. */
+        HeapSample_t xSamples[ configHEAP_HISTORY_LENGTH ];     /* The samples of the heap, oldest first. */
+        UBaseType_t uxNumberOfSamples;                          /* The number of valid entries in xSamples. */
+        size_t xMinimumEverLargestFreeBlockInBytes;             /* The smallest largest free block any sample saw. */
+        size_t xMaximumEverNumberOfFreeBlocks;                  /* The largest number of free blocks any sample saw. */
+        HeapCaller_t xCallers[ configHEAP_CALLERS ];            /* The call sites, in the order they first allocated. */
+        UBaseType_t uxNumberOfCallers;                          /* The number of valid entries in xCallers. */
+        size_t xUntrackedAllocations;                           /* The allocations from call sites found once xCallers was full. */
+    } HeapInstrumentation_t;
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
 /*
  * Used to define multiple heap regions for use by heap_5.c.  This function
  * must be called before any calls to pvPortMalloc() - not creating a task,
@@ -169,6 +262,16 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEG
  */
 void vPortGetHeapStats( HeapStats_t * pxHeapStats );
 
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/*
+ * Copies the measurements heap_4.c and heap_5.c take when
+ * configUSE_HEAP_INSTRUMENTATION is 1 into pxHeapInstrumentation.  The heap
+ * is sampled once more first, so the last sample is the current state.
+ */
+    void vPortGetHeapInstrumentation( HeapInstrumentation_t * pxHeapInstrumentation );
+#endif
+
 /*
  * Map to the memory management routines required for the port.
  */
@@ -54,6 +54,12 @@ typedef void (* TaskFunction_t)( void * );
 #define errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY    ( -1 )
 #define errQUEUE_BLOCKED                         ( -4 )
 #define errQUEUE_YIELD                           ( -5 )
+#define errTASK_NOT_SCHEDULABLE                  ( -6 )
+
+/* Values for configDEADLINE_MISS_POLICY. */
+#define pdDEADLINE_MISS_NOTIFY                   ( 0 )
+#define pdDEADLINE_MISS_SKIP                     ( 1 )
+#define pdDEADLINE_MISS_ABORT                    ( 2 )
 
 /* Macros used for basic data corruption checks. */
 #ifndef configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES
@@ -1418,6 +1418,332 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
                                  void * const pvBuffer,
                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * void *pvQueueReserve(
+ *                       QueueHandle_t xQueue,
+ *                       TickType_t xTicksToWait
+ *                     );
+ * @endcode
+ *
+ * Reserve the slot at the back of a queue so an item can be written straight
+ * into the queue storage area instead of being built in a buffer and copied
+ * in by xQueueSendToBack().  The item becomes visible to readers when
+ * xQueueCommit() is called.
+ *
+ * Only one slot of a queue can be reserved at a time.  Until it is committed
+ * the queue appears full to other writers, which block as they would on a full
+ * queue.  The slot must be committed by the task that reserved it.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  It cannot be used on a semaphore.
+ *
+ * @param xQueue The handle to the queue in which to reserve a slot.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a slot, should the queue be full or a slot already be reserved.
+ *
+ * @return A pointer to uxItemSize bytes of the queue storage area, or NULL if
+ * no slot could be reserved within xTicksToWait.
+ *
+ * Example usage:
+ * @code{c}
+ * struct AFrame
+ * {
+ *  uint16_t usLength;
+ *  uint8_t ucData[ 256 ];
+ * };
+ *
+ * void vAProducerTask( void *pvParameters )
+ * {
+ * struct AFrame *pxFrame;
+ *
+ *  for( ;; )
+ *  {
+ *      pxFrame = ( struct AFrame * ) pvQueueReserve( xFrameQueue, portMAX_DELAY );
+ *      pxFrame->usLength = usReadFrame( pxFrame->ucData );
+ *      xQueueCommit( xFrameQueue );
+ *  }
+ * }
+ * @endcode
+ * \defgroup pvQueueReserve pvQueueReserve
+ * \ingroup QueueManagement
+ */
+void * pvQueueReserve( QueueHandle_t xQueue,
+                       TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueCommit( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Add the item written into the slot returned by pvQueueReserve() to the back
+ * of the queue.  As with xQueueSendToBack(), the highest priority task waiting
+ * to receive from the queue, or the queue set the queue is a member of, is
+ * woken.  Writers were held off while the slot was reserved, so one task
+ * waiting to write to the queue is also woken for each slot still free.
+ *
+ * @param xQueue The handle to the queue in which a slot was reserved.
+ *
+ * @return pdPASS if the item was added, or pdFAIL if no slot was reserved.
+ *
+ * \defgroup xQueueCommit xQueueCommit
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueCommit( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * void *pvQueuePeekInPlace(
+ *                           QueueHandle_t xQueue,
+ *                           TickType_t xTicksToWait
+ *                         );
+ * @endcode
+ *
+ * Get a pointer to the item at the head of a queue, so it can be read where
+ * it is instead of being copied out by xQueueReceive().  The item is removed
+ * from the queue when xQueueRelease() is called.
+ *
+ * Only one item of a queue can be peeked in place at a time.  Until it is
+ * released the queue appears empty to xQueueReceive() in other tasks, which
+ * block as they would on an empty queue, and items cannot be written to the
+ * front of the queue.  xQueuePeek() still copies the item out.  The item must
+ * be released by the task that peeked it.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  It cannot be used on a semaphore.
+ *
+ * @param xQueue The handle to the queue from which the item is to be read.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item, should the queue be empty or its head item already be
+ * peeked in place.
+ *
+ * @return A pointer to the uxItemSize bytes of the item in the queue storage
+ * area, or NULL if no item was available within xTicksToWait.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAConsumerTask( void *pvParameters )
+ * {
+ * const struct AFrame *pxFrame;
+ *
+ *  for( ;; )
+ *  {
+ *      pxFrame = ( const struct AFrame * ) pvQueuePeekInPlace( xFrameQueue, portMAX_DELAY );
+ *      vProcessFrame( pxFrame->ucData, pxFrame->usLength );
+ *      xQueueRelease( xFrameQueue );
+ *  }
+ * }
+ * @endcode
+ * \defgroup pvQueuePeekInPlace pvQueuePeekInPlace
+ * \ingroup QueueManagement
+ */
+void * pvQueuePeekInPlace( QueueHandle_t xQueue,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueRelease( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Remove the item returned by pvQueuePeekInPlace() from the queue.  As with
+ * xQueueReceive(), a task waiting to write to the queue is woken, or one for
+ * each free slot if writes to the front of the queue were held off.  Readers
+ * were held off while the item was peeked, so one task waiting to receive from
+ * the queue is also woken for each item still in the queue.
+ *
+ * @param xQueue The handle to the queue from which an item was peeked.
+ *
+ * @return pdPASS if the item was removed, or pdFAIL if no item was peeked.
+ *
+ * \defgroup xQueueRelease xQueueRelease
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueRelease( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueSendMultiple(
+ *                                 QueueHandle_t xQueue,
+ *                                 const void *pvItems,
+ *                                 UBaseType_t uxItemCount,
+ *                                 TickType_t xTicksToWait
+ *                               );
+ * @endcode
+ *
+ * Post up to uxItemCount items to the back of a queue.  As many of the items
+ * as there is space for are copied in one critical section, and at most one
+ * task waiting to receive from the queue is woken for all of them, where
+ * xQueueSendToBack() enters a critical section and may wake a task for every
+ * item.  If the queue is a member of a queue set, the set is still notified
+ * once per item.
+ *
+ * When configUSE_QUEUE_BATCHING is 1, a task that receives from the queue
+ * and leaves items in it wakes the next task waiting to receive, so the other
+ * readers are woken one after another instead of all at once.  A batch read
+ * by a single task, for example with xQueueReceiveMultiple(), still costs a
+ * single wakeup.  Likewise a task that posts to the queue and leaves space
+ * wakes the next task waiting to post.
+ *
+ * configUSE_QUEUE_BATCHING must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  It cannot be used on a semaphore.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to uxItemCount items, one after another, each the
+ * size defined when the queue was created.
+ *
+ * @param uxItemCount The number of items at pvItems.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space for at least one item, should the queue be full.  The
+ * call does not block for the items that do not fit once some were posted.
+ *
+ * @return The number of items posted, from the start of pvItems, which is 0
+ * if the queue stayed full for xTicksToWait.
+ *
+ * Example usage:
+ * @code{c}
+ * void vASamplerTask( void *pvParameters )
+ * {
+ * uint16_t usSamples[ 32 ];
+ * UBaseType_t uxSent;
+ *
+ *  for( ;; )
+ *  {
+ *      vReadSamples( usSamples, 32 );
+ *
+ *      for( uxSent = 0; uxSent < 32; )
+ *      {
+ *          uxSent += xQueueSendMultiple( xSampleQueue, &( usSamples[ uxSent ] ), 32 - uxSent, portMAX_DELAY );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                                const void * const pvItems,
+                                const UBaseType_t uxItemCount,
+                                TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueSendMultipleFromISR(
+ *                                        QueueHandle_t xQueue,
+ *                                        const void *pvItems,
+ *                                        UBaseType_t uxItemCount,
+ *                                        BaseType_t *pxHigherPriorityTaskWoken
+ *                                      );
+ * @endcode
+ *
+ * A version of xQueueSendMultiple() that can be called from an interrupt
+ * service routine (ISR).
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to uxItemCount items, one after another.
+ *
+ * @param uxItemCount The number of items at pvItems.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the items
+ * unblocked a task with a priority higher than the running task, in which
+ * case a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items posted, from the start of pvItems.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                       const void * const pvItems,
+                                       const UBaseType_t uxItemCount,
+                                       BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueReceiveMultiple(
+ *                                    QueueHandle_t xQueue,
+ *                                    void *pvBuffer,
+ *                                    UBaseType_t uxItemCount,
+ *                                    TickType_t xTicksToWait
+ *                                  );
+ * @endcode
+ *
+ * Receive up to uxItemCount items from the front of a queue.  As many of the
+ * items as are in the queue are copied out in one critical section, and one
+ * task waiting to post to the queue is woken for all of them.  That task wakes
+ * the next one if it leaves space, as described for xQueueSendMultiple().
+ *
+ * configUSE_QUEUE_BATCHING must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  It cannot be used on a semaphore.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the items are copied, one
+ * after another.  It must have room for uxItemCount items.
+ *
+ * @param uxItemCount The most items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for at least one item, should the queue be empty.
+ *
+ * @return The number of items received, which is 0 if the queue stayed empty
+ * for xTicksToWait.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                   void * const pvBuffer,
+                                   const UBaseType_t uxItemCount,
+                                   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueReceiveMultipleFromISR(
+ *                                           QueueHandle_t xQueue,
+ *                                           void *pvBuffer,
+ *                                           UBaseType_t uxItemCount,
+ *                                           BaseType_t *pxHigherPriorityTaskWoken
+ *                                         );
+ * @endcode
+ *
+ * A version of xQueueReceiveMultiple() that can be called from an interrupt
+ * service routine (ISR).
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the items are copied.
+ *
+ * @param uxItemCount The most items to receive.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving the items
+ * unblocked a task with a priority higher than the running task, in which
+ * case a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                          void * const pvBuffer,
+                                          const UBaseType_t uxItemCount,
+                                          BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from within an ISR, or within a critical section.
@@ -1456,6 +1782,9 @@ BaseType_t xQueueCRReceive( QueueHandle_t xQueue,
 QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType,
                                        StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeiling( const UBaseType_t uxCeilingPriority,
+                                            const TickType_t xCeilingPeriod,
+                                            const TickType_t xLongestHold ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
                                              const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
@@ -798,6 +798,56 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateMutexStatic( pxMutexBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeiling( UBaseType_t uxCeilingPriority,
+ *                                                     TickType_t xCeilingPeriod,
+ *                                                     TickType_t xLongestHold );
+ * @endcode
+ *
+ * Creates a mutex that uses a priority ceiling instead of priority
+ * inheritance.  configUSE_MUTEX_CEILING must be set to 1 in FreeRTOSConfig.h
+ * for this macro to be available.
+ *
+ * The ceiling is the highest priority, and under Rate Monotonic scheduling the
+ * shortest period at that priority, of any task that takes the mutex.  A task
+ * runs at the ceiling from the moment it takes the mutex until it no longer
+ * holds any mutex, so no task that shares the mutex can preempt it in the
+ * meantime.  A job is therefore blocked by at most one critical section, of a
+ * task it would otherwise delay.  Priority inheritance under Rate Monotonic
+ * scheduling only changes the priority, so it does not help when the holder
+ * and the waiter share a priority but not a period.
+ *
+ * When configUSE_RM_ADMISSION_CONTROL is set to 1 xLongestHold is counted as
+ * blocking in the admission test of every periodic task the ceiling can delay.
+ * The mutex is not created if that would make an admitted task miss its
+ * deadline, and tasks created later are admitted with the blocking included.
+ *
+ * Mutexes created using this function are accessed using the xSemaphoreTake()
+ * and xSemaphoreGive() macros, and must not be taken by a task above the
+ * ceiling.
+ *
+ * @param uxCeilingPriority The highest priority of the tasks that take the
+ * mutex.
+ *
+ * @param xCeilingPeriod The shortest period, in ticks, of the tasks at
+ * uxCeilingPriority that take the mutex.  portMAX_DELAY if none of them has a
+ * period.
+ *
+ * @param xLongestHold The longest time, in ticks, that any task holds the mutex,
+ * including the time spent holding mutexes taken while it is held.
+ *
+ * @return A handle to the mutex, or NULL if there was not enough heap or the
+ * blocking would make an admitted task miss its deadline.
+ *
+ * \defgroup xSemaphoreCreateMutexWithCeiling xSemaphoreCreateMutexWithCeiling
+ * \ingroup Semaphores
+ */
+#if ( configUSE_MUTEX_CEILING == 1 )
+    #define xSemaphoreCreateMutexWithCeiling( uxCeilingPriority, xCeilingPeriod, xLongestHold )    xQueueCreateMutexWithCeiling( ( uxCeilingPriority ), ( xCeilingPeriod ), ( xLongestHold ) )
+#endif
+
 
 /**
  * semphr. h
@@ -166,8 +166,57 @@ typedef struct xTASK_STATUS
         StackType_t * pxEndOfStack;               /* Points to the end address of the task's stack area. */
     #endif
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
+    #if ( configUSE_JOB_STATS == 1 )
+        UBaseType_t uxJobsReleased;               /* The number of jobs of a periodic task that have been released, including the first.  Zero for other tasks. */
+        UBaseType_t uxJobsCompleted;              /* The number of jobs of a periodic task that have called xTaskJobComplete(). */
+        UBaseType_t uxDeadlineMisses;             /* The number of jobs that missed their deadline.  Only valid if configUSE_DEADLINE_MISS_DETECTION is defined as 1 in FreeRTOSConfig.h. */
+        UBaseType_t uxPreemptions;                /* The number of times the task was switched out while it was still Ready for a task that comes before it. */
+        TickType_t xWorstResponseTime;            /* The most ticks from the release of a job to its completion. */
+    #endif
 } TaskStatus_t;
 
+/* Used with the vTaskGetReleaseJitter() function to return how late the jobs
+ * of a periodic task were made ready, in ticks after their nominal release. */
+typedef struct xTASK_RELEASE_JITTER
+{
+    UBaseType_t uxReleases;    /* The number of releases measured.  The first job, which is released when the task is created, is not counted. */
+    TickType_t xMinJitter;     /* The smallest delay of a release.  portMAX_DELAY if no release has been measured. */
+    TickType_t xAverageJitter; /* The mean delay of a release, rounded down. */
+    TickType_t xMaxJitter;     /* The largest delay of a release. */
+} TaskReleaseJitter_t;
+
+/* Used with the vTaskGetIdleTime() function to return the time the idle task
+ * was running.  Times are in ticks.  If configGENERATE_RUN_TIME_STATS is 1 the
+ * idle time is measured with the run time counter and converted to ticks,
+ * otherwise a tick is counted as idle if the idle task was running when it
+ * occurred. */
+typedef struct xTASK_IDLE_TIME
+{
+    TickType_t xIdleTicks;       /* The idle ticks since the scheduler started.  Wraps with the tick count. */
+    TickType_t xWindowTicks;     /* The length of the window, configIDLE_TIME_WINDOW_TICKS rounded down to a whole number of slots.  Shorter until the scheduler has run that long. */
+    TickType_t xWindowIdleTicks; /* The idle ticks within the window, which is the slack left by the other tasks. */
+    UBaseType_t uxLoadPercent;   /* The percentage of the window during which the idle task was not running. */
+} TaskIdleTime_t;
+
+/* The events recorded by the schedule trace. */
+typedef enum
+{
+    eTraceSwitchedIn = 0, /* The task started running. */
+    eTraceSwitchedOut,    /* The task stopped running. */
+    eTraceJobReleased,    /* A job of the task was released. */
+    eTraceJobCompleted,   /* A job of the task completed. */
+    eTraceDeadlineMissed  /* A job of the task missed its deadline. */
+} eScheduleTraceEvent;
+
+/* One event of the schedule trace, as returned by uxTaskGetScheduleTrace(). */
+typedef struct xSCHEDULE_TRACE_ENTRY
+{
+    uint32_t ulTimestamp;  /* The tick count, or the clock read by configSCHEDULE_TRACE_TIMESTAMP(), when the event happened. */
+    uint16_t usTaskNumber; /* The low 16 bits of the xTaskNumber of the task, as reported in its TaskStatus_t. */
+    uint8_t ucEvent;       /* An eScheduleTraceEvent. */
+    uint8_t ucReserved;    /* Always zero.  Pads the entry to eight bytes. */
+} ScheduleTraceEntry_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -267,8 +316,8 @@ typedef enum
  *                            void *pvParameters,
  *                            UBaseType_t uxPriority,
  *                            TaskHandle_t *pxCreatedTask,
- *                            int pxCpuBurst,
- *                            int period);
+ *                            TickType_t xCpuBurst,
+ *                            TickType_t xPeriod);
  * @endcode
  *
  * Create a new task and add it to the list of tasks that are ready to run.
@@ -315,9 +364,13 @@ typedef enum
  * @param pxCreatedTask Used to pass back a handle by which the created task
  * can be referenced.
  *
- * @param pxCpuBurst The time of CPU needed by the task.
+ * @param xCpuBurst The worst case execution time of one job of the task, in
+ * ticks.  Can be 0 if it is not known.
  *
- * @param period The period of a task after which a new task arrives.
+ * @param xPeriod The time between releases of the task, in ticks.  Under Rate
+ * Monotonic scheduling tasks of the same priority run shortest period first.
+ * Pass 0 for a task that is not periodic, which then runs after every periodic
+ * task of its priority.  The deadline of the task is the end of its period.
  *
  * @return pdPASS if the task was successfully created and added to a ready
  * list, otherwise an error code defined in the file projdefs.h
@@ -343,7 +396,7 @@ typedef enum
  *   // must exist for the lifetime of the task, so in this case is declared static.  If it was just an
  *   // an automatic stack variable it might no longer exist, or at least have been corrupted, by the time
  *   // the new task attempts to access it.
- *   xTaskCreate( vTaskCode, "NAME", STACK_SIZE, &ucParameterToPass, tskIDLE_PRIORITY, &xHandle, 1, 1 );
+ *   xTaskCreate( vTaskCode, "NAME", STACK_SIZE, &ucParameterToPass, tskIDLE_PRIORITY, &xHandle, 0, 0 );
  *   configASSERT( xHandle );
  *
  *   // Use the handle to delete the task.
@@ -363,8 +416,294 @@ typedef enum
                             void * const pvParameters,
                             UBaseType_t uxPriority,
                             TaskHandle_t * const pxCreatedTask,
-                            int pxCpuBurst,
-                            int period ) PRIVILEGED_FUNCTION;
+                            TickType_t xCpuBurst,
+                            TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreatePeriodic( TaskFunction_t pxJobCode,
+ *                                 const char * const pcName,
+ *                                 const configSTACK_DEPTH_TYPE usStackDepth,
+ *                                 void * const pvParameters,
+ *                                 UBaseType_t uxPriority,
+ *                                 TaskHandle_t * const pxCreatedTask,
+ *                                 TickType_t xCpuBurst,
+ *                                 TickType_t xPeriod,
+ *                                 TickType_t xDeadline );
+ * @endcode
+ *
+ * Create a periodic task.  The parameters are the same as for xTaskCreate(),
+ * but pxJobCode is a function that runs once for each release of the task and
+ * then returns.  The first job is released when the task is created and the
+ * following ones every xPeriod ticks after it, which must not be 0.  xDeadline
+ * is the time after each release by which the job must complete.  Pass 0 for
+ * a deadline at the end of the period.
+ *
+ * The task and its stack are allocated once.  Between jobs the task is held in
+ * the Blocked state, so releasing a job does not create or delete anything.
+ * Waiting tasks are kept in order of release time and the tick interrupt makes
+ * each one ready on the tick of its release.
+ *
+ * If configUSE_RM_ADMISSION_CONTROL is set to 1 the task is only created if
+ * every task created by xTaskCreatePeriodic(), including the new one, still
+ * completes each job by its deadline.  xCpuBurst must then be the worst case
+ * execution time of one job, and the deadline no longer than the period.  The
+ * test assumes the priorities of those tasks are not changed after they are
+ * created.  A task whose period differs from every period in use is also
+ * rejected once configRM_MAX_DISTINCT_PERIODS periods are in use, as it could
+ * not be run in rate monotonic order.
+ *
+ * If configUSE_RM_AUTO_PRIORITY is set to 1 uxPriority is ignored and the task
+ * is given a priority from its period, as is any task created by xTaskCreate()
+ * with a period.  Shorter periods are given higher priorities.  Creating or
+ * deleting such a task can change the priority of the others, so a priority
+ * set with vTaskPrioritySet() only lasts until then.
+ *
+ * INCLUDE_xTaskDelayUntil must be defined as 1 for this function to be
+ * available.
+ *
+ * @return pdPASS if the task was created, errTASK_NOT_SCHEDULABLE if admission
+ * control rejected it, otherwise an error code defined in the file projdefs.h
+ *
+ * Example usage:
+ * @code{c}
+ * // Runs every 2 ms and takes at most 500 us.
+ * void vJobCode( void * pvParameters )
+ * {
+ *  // Do the work of one job, then return.
+ * }
+ *
+ * void vOtherFunction( void )
+ * {
+ *  xTaskCreatePeriodic( vJobCode, "JOB", STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL, pdMS_TO_TICKS( 1 ) / 2, pdMS_TO_TICKS( 2 ), 0 );
+ * }
+ * @endcode
+ * \defgroup xTaskCreatePeriodic xTaskCreatePeriodic
+ * \ingroup Tasks
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
+    BaseType_t xTaskCreatePeriodic( TaskFunction_t pxJobCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    const configSTACK_DEPTH_TYPE usStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    TaskHandle_t * const pxCreatedTask,
+                                    TickType_t xCpuBurst,
+                                    TickType_t xPeriod,
+                                    TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreateSporadic( TaskFunction_t pxJobCode,
+ *                                 const char * const pcName,
+ *                                 const configSTACK_DEPTH_TYPE usStackDepth,
+ *                                 void * const pvParameters,
+ *                                 UBaseType_t uxPriority,
+ *                                 TaskHandle_t * const pxCreatedTask,
+ *                                 TickType_t xCpuBurst,
+ *                                 TickType_t xMinInterArrival,
+ *                                 TickType_t xDeadline );
+ * @endcode
+ *
+ * Create a sporadic task.  The parameters are the same as for
+ * xTaskCreatePeriodic(), but a job of the task is released each time the task
+ * is notified, rather than every period.  A job is requested by incrementing
+ * the task's notification value at index tskDEFAULT_INDEX_TO_NOTIFY, for
+ * example with xTaskNotifyGive() or, from an interrupt, vTaskNotifyGiveFromISR()
+ * or xTaskNotifyFromISR() with eIncrement.  The jobs must not use that
+ * notification themselves.  A notification that leaves the value at zero, or
+ * xTaskAbortDelay(), does not release a job.
+ *
+ * Jobs are released at least xMinInterArrival ticks apart.  A request made
+ * sooner than that after the previous release is held until the time has
+ * passed, and a burst of requests is released one job at a time, so the task
+ * never takes more of the processor than a periodic task with a period of
+ * xMinInterArrival.  Under Rate Monotonic scheduling it runs at the rank of
+ * that period, and if configUSE_RM_ADMISSION_CONTROL is set to 1 it is
+ * admitted as such a periodic task.  xDeadline is counted from the release of
+ * each job, and 0 gives a deadline of xMinInterArrival.
+ *
+ * configUSE_SPORADIC_TASKS must be defined as 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @return pdPASS if the task was created, errTASK_NOT_SCHEDULABLE if admission
+ * control rejected it, otherwise an error code defined in the file projdefs.h
+ *
+ * Example usage:
+ * @code{c}
+ * TaskHandle_t xSensorTask;
+ *
+ * // Runs for at most 200 us after each sample, and samples come no more
+ * // often than every 5 ms.
+ * void vReadSample( void * pvParameters )
+ * {
+ *  // Handle one sample, then return.
+ * }
+ *
+ * void vSensorHandler( void )
+ * {
+ *  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  vTaskNotifyGiveFromISR( xSensorTask, &xHigherPriorityTaskWoken );
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void vOtherFunction( void )
+ * {
+ *  xTaskCreateSporadic( vReadSample, "SNS", STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xSensorTask, pdMS_TO_TICKS( 1 ) / 5, pdMS_TO_TICKS( 5 ), 0 );
+ * }
+ * @endcode
+ * \defgroup xTaskCreateSporadic xTaskCreateSporadic
+ * \ingroup Tasks
+ */
+#if ( configUSE_SPORADIC_TASKS == 1 )
+    BaseType_t xTaskCreateSporadic( TaskFunction_t pxJobCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    const configSTACK_DEPTH_TYPE usStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    TaskHandle_t * const pxCreatedTask,
+                                    TickType_t xCpuBurst,
+                                    TickType_t xMinInterArrival,
+                                    TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreateAperiodicServer( const char * const pcName,
+ *                                        const configSTACK_DEPTH_TYPE usStackDepth,
+ *                                        UBaseType_t uxPriority,
+ *                                        TaskHandle_t * const pxCreatedTask,
+ *                                        TickType_t xBudget,
+ *                                        TickType_t xPeriod,
+ *                                        UBaseType_t uxQueueLength );
+ * @endcode
+ *
+ * Create a deferrable server: a periodic task that runs the aperiodic jobs
+ * passed to xTaskSubmitAperiodicJob() and xTaskSubmitAperiodicJobFromISR(), in
+ * the order they were submitted.  The server can run jobs for xBudget ticks in
+ * each period of xPeriod ticks.  Under Rate Monotonic scheduling it runs at the
+ * rank of xPeriod, so a short period gives aperiodic work a short response
+ * time without it taking more than its budget from the periodic tasks.
+ *
+ * The server keeps what is left of its budget while it waits for jobs, so a
+ * job submitted part way through a period starts at once if the server
+ * outranks the running task.  The budget is refilled at the start of each
+ * period.  A job that outlasts the budget is stopped by budget enforcement and
+ * finishes in the following periods.
+ *
+ * If configUSE_RM_ADMISSION_CONTROL is set to 1 the server is admitted as a
+ * periodic task with a CpuBurst of xBudget.  Because the budget is kept, a
+ * whole budget can be used at the end of one period and again at the start
+ * of the next, and the test counts that against the tasks it can delay.
+ *
+ * Each period is one job of the server, which lasts until the period ends, so
+ * the server is not watched by deadline miss detection.
+ *
+ * Jobs run in the server task, which waits on its notification at index
+ * tskDEFAULT_INDEX_TO_NOTIFY, so jobs must not use that notification.
+ *
+ * configUSE_APERIODIC_SERVER must be defined as 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param pcName A descriptive name for the server task.
+ *
+ * @param usStackDepth The size of the server's stack, in words.  It must be
+ * large enough for the deepest job.
+ *
+ * @param uxPriority The priority of the server task.
+ *
+ * @param pxCreatedTask Used to pass back the handle of the server, which is
+ * passed to xTaskSubmitAperiodicJob().
+ *
+ * @param xBudget The ticks of jobs the server can run in each period.
+ *
+ * @param xPeriod The period of the server, in ticks.
+ *
+ * @param uxQueueLength The number of jobs that can wait for the server.
+ *
+ * @return pdPASS if the server was created, errTASK_NOT_SCHEDULABLE if
+ * admission control rejected it, otherwise an error code defined in the file
+ * projdefs.h
+ *
+ * Example usage:
+ * @code{c}
+ * TaskHandle_t xServer;
+ *
+ * void vParseCommand( void * pvParameters )
+ * {
+ *  // Handle the command in pvParameters.
+ * }
+ *
+ * void vUARTHandler( void )
+ * {
+ *  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  xTaskSubmitAperiodicJobFromISR( xServer, vParseCommand, pcLine, &xHigherPriorityTaskWoken );
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void vOtherFunction( void )
+ * {
+ *  // 2 ms of aperiodic work in every 10 ms.
+ *  xTaskCreateAperiodicServer( "SRV", STACK_SIZE, tskIDLE_PRIORITY + 1, &xServer, pdMS_TO_TICKS( 2 ), pdMS_TO_TICKS( 10 ), 8 );
+ * }
+ * @endcode
+ * \defgroup xTaskCreateAperiodicServer xTaskCreateAperiodicServer
+ * \ingroup Tasks
+ */
+#if ( configUSE_APERIODIC_SERVER == 1 )
+    BaseType_t xTaskCreateAperiodicServer( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                           const configSTACK_DEPTH_TYPE usStackDepth,
+                                           UBaseType_t uxPriority,
+                                           TaskHandle_t * const pxCreatedTask,
+                                           TickType_t xBudget,
+                                           TickType_t xPeriod,
+                                           UBaseType_t uxQueueLength ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskSubmitAperiodicJob( TaskHandle_t xServer, TaskFunction_t pxJobCode, void * pvParameters );
+ * BaseType_t xTaskSubmitAperiodicJobFromISR( TaskHandle_t xServer, TaskFunction_t pxJobCode, void * pvParameters, BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Queue a job for a server created by xTaskCreateAperiodicServer().  The
+ * server calls pxJobCode( pvParameters ) once, when the jobs submitted before
+ * it have run and it has budget.  The functions do not block.
+ *
+ * xTaskSubmitAperiodicJobFromISR() is the version that can be called from an
+ * interrupt.  *pxHigherPriorityTaskWoken is set to pdTRUE if the server
+ * should run before the interrupted task, in which case a context switch
+ * should be requested before the interrupt exits.
+ *
+ * @param xServer The handle of the server.
+ *
+ * @param pxJobCode The function that does the work of the job.
+ *
+ * @param pvParameters Passed to pxJobCode.  It must still be valid when the
+ * job runs.
+ *
+ * @return pdPASS if the job was queued, or errQUEUE_FULL if uxQueueLength jobs
+ * are already waiting.
+ *
+ * \defgroup xTaskSubmitAperiodicJob xTaskSubmitAperiodicJob
+ * \ingroup Tasks
+ */
+#if ( configUSE_APERIODIC_SERVER == 1 )
+    BaseType_t xTaskSubmitAperiodicJob( TaskHandle_t xServer,
+                                        TaskFunction_t pxJobCode,
+                                        void * pvParameters ) PRIVILEGED_FUNCTION;
+    BaseType_t xTaskSubmitAperiodicJobFromISR( TaskHandle_t xServer,
+                                               TaskFunction_t pxJobCode,
+                                               void * pvParameters,
+                                               BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 #endif
 
 /**
@@ -877,6 +1216,118 @@ BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
         ( void ) xTaskDelayUntil( ( pxPreviousWakeTime ), ( xTimeIncrement ) ); \
     } while( 0 )
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskJobComplete( void );
+ * @endcode
+ *
+ * Marks the end of the current job of a task created with
+ * xTaskCreatePeriodic() and places the task in the Blocked state until its
+ * next release.  The task function of a periodic task calls this automatically
+ * each time its job function returns.  A sporadic task is held until the
+ * earliest time its next job can be released.
+ *
+ * @return pdFALSE if the job finished after its next release was already due,
+ * in which case the task does not block, otherwise pdTRUE.
+ *
+ * \defgroup xTaskJobComplete xTaskJobComplete
+ * \ingroup TaskCtrl
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
+    BaseType_t xTaskJobComplete( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskJobDeadlineMissed( void );
+ * @endcode
+ *
+ * configUSE_DEADLINE_MISS_DETECTION must be defined as 1 in FreeRTOSConfig.h
+ * for this function to be available.
+ *
+ * Query whether the current job of the calling periodic task has already
+ * missed its deadline.  When configDEADLINE_MISS_POLICY is
+ * pdDEADLINE_MISS_ABORT the job function should call this after any blocking
+ * call, and at convenient points of long computations, and return as soon as
+ * it reports pdTRUE.
+ *
+ * @return pdTRUE if the deadline of the current job has passed, otherwise
+ * pdFALSE.
+ *
+ * \defgroup xTaskJobDeadlineMissed xTaskJobDeadlineMissed
+ * \ingroup TaskCtrl
+ */
+BaseType_t xTaskJobDeadlineMissed( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetDeadlineMisses( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_DEADLINE_MISS_DETECTION must be defined as 1 in FreeRTOSConfig.h
+ * for this function to be available.
+ *
+ * @param xTask Handle of the periodic task to be queried.  Passing a NULL
+ * handle queries the calling task.
+ *
+ * @return The number of jobs of xTask that have missed their deadline since
+ * the task was created.
+ *
+ * \defgroup uxTaskGetDeadlineMisses uxTaskGetDeadlineMisses
+ * \ingroup TaskCtrl
+ */
+UBaseType_t uxTaskGetDeadlineMisses( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetJobRunTimeCounter( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_BUDGET_ENFORCEMENT must be defined as 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param xTask Handle of the periodic task to be queried.  Passing a NULL
+ * handle queries the calling task.
+ *
+ * @return The run time counter increments used so far by the current job of
+ * xTask.  A job is suspended until the next release of its task once this
+ * exceeds its CpuBurst by a tick.
+ *
+ * \defgroup ulTaskGetJobRunTimeCounter ulTaskGetJobRunTimeCounter
+ * \ingroup TaskCtrl
+ */
+configRUN_TIME_COUNTER_TYPE ulTaskGetJobRunTimeCounter( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetReleaseJitter( const TaskHandle_t xTask, TaskReleaseJitter_t * pxReleaseJitter );
+ * @endcode
+ *
+ * configUSE_RELEASE_JITTER_STATS must be defined as 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * The jobs of a periodic task are made ready by the tick interrupt on the tick
+ * of their release.  A job is released late if the previous job finished after
+ * that tick, or if the tick count stepped past it, for example after a period
+ * of tickless idle.
+ *
+ * @param xTask Handle of the periodic task to be queried.  Passing a NULL
+ * handle queries the calling task.
+ *
+ * @param pxReleaseJitter The structure to fill with the release jitter of
+ * xTask since it was created.
+ *
+ * \defgroup vTaskGetReleaseJitter vTaskGetReleaseJitter
+ * \ingroup TaskCtrl
+ */
+void vTaskGetReleaseJitter( const TaskHandle_t xTask,
+                            TaskReleaseJitter_t * pxReleaseJitter ) PRIVILEGED_FUNCTION;
+
 
 /**
  * task. h
@@ -895,6 +1346,10 @@ BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
  * task will leave the Blocked state, and return from whichever function call
  * placed the task into the Blocked state.
  *
+ * A task created by xTaskCreatePeriodic() that is waiting for the release of
+ * its next job is reported as Blocked, but is not removed from that wait, as
+ * doing so would release the job early.  pdFAIL is returned for such a task.
+ *
  * There is no 'FromISR' version of this function as an interrupt would need to
  * know which object a task was blocked on in order to know which actions to
  * take.  For example, if the task was blocked on a queue the interrupt handler
@@ -959,9 +1414,11 @@ BaseType_t xTaskAbortDelay( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
  */
 UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
-int uxTaskCpuBurstGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+TickType_t xTaskCpuBurstGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+TickType_t xTaskPeriodGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
-int uxTaskPeriodGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+TickType_t xTaskDeadlineGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
 const char* uxTaskNameGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
@@ -1169,6 +1626,9 @@ void vTaskSuspend( TaskHandle_t xTaskToSuspend ) PRIVILEGED_FUNCTION;
  * will be made available for running again by a single call to
  * vTaskResume ().
  *
+ * A task created by xTaskCreatePeriodic() that was suspended between two of
+ * its jobs is not made ready before the release of its next job.
+ *
  * @param xTaskToResume Handle to the task being readied.
  *
  * Example usage:
@@ -1662,6 +2122,24 @@ configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVIL
 
 #endif
 
+#if ( ( configUSE_DEADLINE_MISS_DETECTION == 1 ) && ( configDEADLINE_MISS_POLICY == pdDEADLINE_MISS_NOTIFY ) )
+
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationDeadlineMissedHook( TaskHandle_t xTask );
+ * @endcode
+ *
+ * Called from the tick interrupt when a job of a periodic task misses its
+ * deadline, so it must not call any API function that might block.  The job
+ * itself keeps running.
+ *
+ * @param xTask The task whose job missed its deadline.
+ */
+    void vApplicationDeadlineMissedHook( TaskHandle_t xTask );
+
+#endif
+
 #if  ( configUSE_TICK_HOOK > 0 )
 
 /**
@@ -1731,6 +2209,13 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
  * of run time consumed by the task.  See the TaskStatus_t structure
  * definition in this file for the full member list.
  *
+ * If configUSE_JOB_STATS is set to 1 in FreeRTOSConfig.h the structures of
+ * periodic tasks also hold the jobs released and completed, the deadline
+ * misses, the preemptions and the worst response time.  The kernel updates
+ * these without entering a critical section, so a monitor task can sample
+ * them often without changing when the tasks it watches run.  Each is copied
+ * whole, but the counts of one task may be taken either side of an update.
+ *
  * NOTE:  This function is intended for debugging use only as its use results in
  * the scheduler remaining suspended for an extended period.
  *
@@ -1970,6 +2455,76 @@ void vTaskGetRunTimeStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetIdleTime( TaskIdleTime_t * pxIdleTime );
+ * @endcode
+ *
+ * configUSE_IDLE_TIME_STATS must be defined as 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * If configGENERATE_RUN_TIME_STATS is 1 the time the idle task runs is added
+ * up on each context switch from the run time counter, and the window and the
+ * CPU load are measured in run time counter increments.  A task that always
+ * runs between two ticks is then still counted.  xIdleTicks is updated each
+ * time the window slides.
+ *
+ * Otherwise the tick interrupt adds one to the idle time when it finds the idle
+ * task running, so the cost is a comparison per tick.  The resolution is then
+ * one tick, and a task that runs for part of each tick but is never running
+ * when the tick occurs is not seen at all.
+ *
+ * Either way ticks skipped by tickless idle are idle, the idle task does no
+ * extra work, and the window slides in steps of one tenth of
+ * configIDLE_TIME_WINDOW_TICKS.
+ *
+ * @param pxIdleTime The structure to fill with the idle time and the CPU load
+ * over the window.
+ *
+ * \defgroup vTaskGetIdleTime vTaskGetIdleTime
+ * \ingroup TaskUtils
+ */
+void vTaskGetIdleTime( TaskIdleTime_t * pxIdleTime ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetScheduleTrace( ScheduleTraceEntry_t * const pxTraceArray, const UBaseType_t uxArraySize, UBaseType_t * const puxEntriesLost );
+ * @endcode
+ *
+ * configUSE_SCHEDULE_TRACE must be defined as 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Moves the oldest events of the schedule trace into pxTraceArray, so calling
+ * it periodically drains the trace without losing events.  Each event costs
+ * one eight byte store inside code that already runs with interrupts masked.
+ * The events are moved a few at a time, each group in its own critical
+ * section, so interrupts are only masked briefly however many are moved.
+ * When more than configSCHEDULE_TRACE_LENGTH events are recorded between two
+ * calls the oldest ones are overwritten.
+ *
+ * The array is meant to be dumped as raw bytes and decoded off target, where
+ * tasks are matched to the xTaskNumber values returned by
+ * uxTaskGetSystemState().  part4/trace_to_gantt.py turns such a dump into a
+ * Gantt chart.
+ *
+ * @param pxTraceArray The array the events are copied to, oldest first.
+ *
+ * @param uxArraySize The number of entries pxTraceArray can hold.
+ *
+ * @param puxEntriesLost If not NULL, set to the number of events overwritten
+ * since the previous call.
+ *
+ * @return The number of events copied into pxTraceArray.
+ *
+ * \defgroup uxTaskGetScheduleTrace uxTaskGetScheduleTrace
+ * \ingroup TaskUtils
+ */
+UBaseType_t uxTaskGetScheduleTrace( ScheduleTraceEntry_t * const pxTraceArray,
+                                    const UBaseType_t uxArraySize,
+                                    UBaseType_t * const puxEntriesLost ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -3026,6 +3581,21 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
  */
 portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE CALLED BY
+ * THE traceTASK_SWITCHED_OUT() AND traceTASK_SWITCHED_IN() MACROS, WHICH AN
+ * APPLICATION THAT DEFINES THEM ITSELF MUST HAVE CALL THEM.
+ *
+ * Record a switch from the task that was running when
+ * vTaskScheduleTraceSwitchedOut() was called to the task that is running when
+ * vTaskScheduleTraceSwitchedIn() is called in the schedule trace.  Nothing is
+ * recorded if the same task is selected again.
+ */
+#if ( configUSE_SCHEDULE_TRACE == 1 )
+    void vTaskScheduleTraceSwitchedOut( void ) PRIVILEGED_FUNCTION;
+    void vTaskScheduleTraceSwitchedIn( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
  * THE EVENT BITS MODULE.
@@ -3116,6 +3686,29 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Record the ceiling of a mutex created by
+ * xSemaphoreCreateMutexWithCeiling().  xLongestHold is the longest time, in
+ * ticks, any task holds the mutex, and is the blocking the mutex can add to a
+ * job.  Returns NULL if there is not enough heap, or if admission control is
+ * used and that blocking would make an admitted task miss its deadline.
+ */
+void * pvTaskCreateMutexCeiling( UBaseType_t uxCeilingPriority,
+                                 TickType_t xCeilingPeriod,
+                                 TickType_t xLongestHold ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Free a ceiling returned by pvTaskCreateMutexCeiling().
+ */
+void vTaskDeleteMutexCeiling( void * pvCeiling ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Raise the calling task, which has just taken a mutex,
+ * to the ceiling of that mutex.  xTaskPriorityDisinherit() lowers it again once
+ * it holds no mutexes.
+ */
+void vTaskRaiseToMutexCeiling( void * pvCeiling ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critical
  * section.
@@ -134,6 +134,34 @@ typedef struct A_BLOCK_LINK
  */
 static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert );
 
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/*
+ * Adds the time since ulStartTime to the latency histogram pulHistogram, and
+ * to *pulMaximum if it is the longest call yet.  Called once for every
+ * pvPortMalloc() and vPortFree() call, so also counts the calls.
+ */
+    static void prvRecordLatency( uint32_t * pulHistogram,
+                                  uint32_t * pulMaximum,
+                                  uint32_t ulStartTime );
+
+/*
+ * Adds an allocation of xBlockSize bytes, that returned pvReturn, to the totals
+ * of the call site pvCaller.
+ */
+    static void prvRecordCaller( void * pvCaller,
+                                 size_t xBlockSize,
+                                 const void * pvReturn );
+
+/*
+ * Adds a sample of the free blocks to the history if xForce is pdTRUE or
+ * configHEAP_HISTORY_PERIOD ticks or configHEAP_HISTORY_CALLS calls have
+ * passed since the last sample.
+ */
+    static void prvSampleHeap( BaseType_t xForce );
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -151,6 +179,17 @@ static size_t xMinimumEverFreeBytesRemaining = 0U;
 static size_t xNumberOfSuccessfulAllocations = 0;
 static size_t xNumberOfSuccessfulFrees = 0;
 
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/* The measurements, with the samples kept in a ring that uxNextHeapSample
+ * indexes.  vPortGetHeapInstrumentation() copies them out oldest first. */
+    static HeapInstrumentation_t xInstrumentation;
+    static UBaseType_t uxNextHeapSample = 0;
+    static TickType_t xLastHeapSampleTime = 0;
+    static size_t xHeapCalls = 0;
+    static size_t xLastHeapSampleCalls = 0;
+#endif
+
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
@@ -161,6 +200,10 @@ void * pvPortMalloc( size_t xWantedSize )
     void * pvReturn = NULL;
     size_t xAdditionalRequiredSize;
 
+    #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+        const uint32_t ulStartTime = configHEAP_TIMESTAMP();
+    #endif
+
     /* The heap must be initialised before the first call to
      * prvPortMalloc(). */
     configASSERT( pxEnd );
@@ -275,6 +318,17 @@ void * pvPortMalloc( size_t xWantedSize )
         }
 
         traceMALLOC( pvReturn, xWantedSize );
+
+        #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+        {
+            prvRecordLatency( xInstrumentation.ulMallocLatency, &( xInstrumentation.ulMaximumMallocLatency ), ulStartTime );
+            prvRecordCaller( configHEAP_CALLER_ADDRESS(), xWantedSize, pvReturn );
+
+            /* A failed allocation is always sampled, to show how fragmented
+             * the heap was at the time. */
+            prvSampleHeap( ( pvReturn == NULL ) ? pdTRUE : pdFALSE );
+        }
+        #endif
     }
     ( void ) xTaskResumeAll();
 
@@ -300,6 +354,10 @@ void vPortFree( void * pv )
     uint8_t * puc = ( uint8_t * ) pv;
     BlockLink_t * pxLink;
 
+    #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+        const uint32_t ulStartTime = configHEAP_TIMESTAMP();
+    #endif
+
     if( pv != NULL )
     {
         /* The memory being freed will have an BlockLink_t structure immediately
@@ -332,6 +390,13 @@ void vPortFree( void * pv )
                     traceFREE( pv, pxLink->xBlockSize );
                     prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
                     xNumberOfSuccessfulFrees++;
+
+                    #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+                    {
+                        prvRecordLatency( xInstrumentation.ulFreeLatency, &( xInstrumentation.ulMaximumFreeLatency ), ulStartTime );
+                        prvSampleHeap( pdFALSE );
+                    }
+                    #endif
                 }
                 ( void ) xTaskResumeAll();
             }
@@ -592,3 +657,184 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
     taskEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+    static void prvRecordLatency( uint32_t * pulHistogram,
+                                  uint32_t * pulMaximum,
+                                  uint32_t ulStartTime )
+    {
+        const uint32_t ulElapsed = configHEAP_TIMESTAMP() - ulStartTime;
+        uint32_t ulRemaining = ulElapsed;
+        UBaseType_t uxBucket = 0;
+
+        xHeapCalls++;
+
+        /* The bucket is the number of significant bits in the time taken. */
+        while( ( ulRemaining != 0U ) && ( uxBucket < ( UBaseType_t ) ( configHEAP_LATENCY_BUCKETS - 1 ) ) )
+        {
+            ulRemaining >>= 1;
+            uxBucket++;
+        }
+
+        pulHistogram[ uxBucket ]++;
+
+        if( ulElapsed > *pulMaximum )
+        {
+            *pulMaximum = ulElapsed;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRecordCaller( void * pvCaller,
+                                 size_t xBlockSize,
+                                 const void * pvReturn )
+    {
+        HeapCaller_t * pxCaller = NULL;
+        UBaseType_t x = 0;
+
+        while( ( pxCaller == NULL ) && ( x < xInstrumentation.uxNumberOfCallers ) )
+        {
+            if( xInstrumentation.xCallers[ x ].pvCaller == pvCaller )
+            {
+                pxCaller = &( xInstrumentation.xCallers[ x ] );
+            }
+
+            x++;
+        }
+
+        /* A call site seen for the first time takes the next free entry, if
+         * there is one. */
+        if( ( pxCaller == NULL ) && ( xInstrumentation.uxNumberOfCallers < ( UBaseType_t ) configHEAP_CALLERS ) )
+        {
+            pxCaller = &( xInstrumentation.xCallers[ xInstrumentation.uxNumberOfCallers ] );
+            pxCaller->pvCaller = pvCaller;
+            xInstrumentation.uxNumberOfCallers++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxCaller == NULL )
+        {
+            if( pvReturn != NULL )
+            {
+                xInstrumentation.xUntrackedAllocations++;
+            }
+        }
+        else if( pvReturn != NULL )
+        {
+            pxCaller->xNumberOfAllocations++;
+            pxCaller->xBytesAllocated += xBlockSize;
+        }
+        else
+        {
+            pxCaller->xNumberOfFailedAllocations++;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSampleHeap( BaseType_t xForce )
+    {
+        const TickType_t xTimeNow = xTaskGetTickCount();
+
+        #if ( configHEAP_HISTORY_CALLS > 0 )
+            const BaseType_t xCallsDue = ( ( xHeapCalls - xLastHeapSampleCalls ) >= ( size_t ) configHEAP_HISTORY_CALLS ) ? pdTRUE : pdFALSE;
+        #else
+            const BaseType_t xCallsDue = pdFALSE;
+        #endif
+
+        HeapSample_t * pxSample;
+        BlockLink_t * pxBlock;
+        size_t xBlocks = 0, xMaxSize = 0;
+
+        /* Nothing to sample before the heap is initialised. */
+        if( pxEnd != NULL )
+        {
+            if( ( xForce != pdFALSE ) ||
+                ( xInstrumentation.uxNumberOfSamples == 0 ) ||
+                ( ( xTimeNow - xLastHeapSampleTime ) >= ( TickType_t ) configHEAP_HISTORY_PERIOD ) ||
+                ( xCallsDue != pdFALSE ) )
+            {
+                for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    xBlocks++;
+
+                    if( pxBlock->xBlockSize > xMaxSize )
+                    {
+                        xMaxSize = pxBlock->xBlockSize;
+                    }
+                }
+
+                pxSample = &( xInstrumentation.xSamples[ uxNextHeapSample ] );
+                pxSample->xTimeInTicks = xTimeNow;
+                pxSample->xNumberOfCalls = xHeapCalls;
+                pxSample->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+                pxSample->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+                pxSample->xNumberOfFreeBlocks = xBlocks;
+
+                if( ( xInstrumentation.uxNumberOfSamples == 0 ) || ( xMaxSize < xInstrumentation.xMinimumEverLargestFreeBlockInBytes ) )
+                {
+                    xInstrumentation.xMinimumEverLargestFreeBlockInBytes = xMaxSize;
+                }
+
+                if( xBlocks > xInstrumentation.xMaximumEverNumberOfFreeBlocks )
+                {
+                    xInstrumentation.xMaximumEverNumberOfFreeBlocks = xBlocks;
+                }
+
+                if( xInstrumentation.uxNumberOfSamples < ( UBaseType_t ) configHEAP_HISTORY_LENGTH )
+                {
+                    xInstrumentation.uxNumberOfSamples++;
+                }
+
+                uxNextHeapSample++;
+
+                if( uxNextHeapSample == ( UBaseType_t ) configHEAP_HISTORY_LENGTH )
+                {
+                    uxNextHeapSample = 0;
+                }
+
+                xLastHeapSampleTime = xTimeNow;
+                xLastHeapSampleCalls = xHeapCalls;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetHeapInstrumentation( HeapInstrumentation_t * pxHeapInstrumentation )
+    {
+        UBaseType_t x, uxOldest;
+
+        vTaskSuspendAll();
+        {
+            prvSampleHeap( pdTRUE );
+            *pxHeapInstrumentation = xInstrumentation;
+
+            /* Once the ring is full the oldest sample is the one that is
+             * written next. */
+            uxOldest = ( xInstrumentation.uxNumberOfSamples < ( UBaseType_t ) configHEAP_HISTORY_LENGTH ) ? 0 : uxNextHeapSample;
+
+            for( x = 0; x < xInstrumentation.uxNumberOfSamples; x++ )
+            {
+                pxHeapInstrumentation->xSamples[ x ] = xInstrumentation.xSamples[ ( uxOldest + x ) % ( UBaseType_t ) configHEAP_HISTORY_LENGTH ];
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
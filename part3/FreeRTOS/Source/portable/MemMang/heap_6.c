@@ -0,0 +1,844 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that, like
+ * heap_4.c, combines (coalescences) adjacent memory blocks as they are freed,
+ * but allocates and frees in constant time using two-level segregated fit
+ * (TLSF).
+ *
+ * heap_4.c keeps a single list of free blocks in address order, so both
+ * pvPortMalloc() and vPortFree() walk that list with the scheduler suspended,
+ * taking longer the more fragmented the heap is.  Here the free blocks are
+ * instead kept in one list per size class.  The first level classes are powers
+ * of two, and each of them is split into heapSECOND_LEVEL_INDEX_COUNT linear
+ * second level classes.  A bitmap records which lists are not empty, so the
+ * smallest class that is guaranteed to satisfy a request is found with two
+ * bit scans.  Every block records the block physically before it, so the
+ * neighbours of a block being freed are found without a search.
+ *
+ * Requests are rounded up to the next second level class, so the memory wasted
+ * by that rounding is below 1 / heapSECOND_LEVEL_INDEX_COUNT of the request.
+ *
+ * Setting configHEAP_MAX_BLOCK_SIZE_LOG2 in FreeRTOSConfig.h to just above the
+ * log2 of configTOTAL_HEAP_SIZE reduces the RAM taken by the free lists.  Any
+ * part of the heap beyond 2 ^ configHEAP_MAX_BLOCK_SIZE_LOG2 bytes is not used.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* Blocks must be smaller than 2 ^ configHEAP_MAX_BLOCK_SIZE_LOG2 bytes. */
+#ifndef configHEAP_MAX_BLOCK_SIZE_LOG2
+    #define configHEAP_MAX_BLOCK_SIZE_LOG2    30
+#endif
+
+/* Each power of two size range is split into this many free lists. */
+#define heapSECOND_LEVEL_INDEX_LOG2     4
+#define heapSECOND_LEVEL_INDEX_COUNT    ( 1 << heapSECOND_LEVEL_INDEX_LOG2 )
+
+/* Block sizes are multiples of portBYTE_ALIGNMENT, so the block sizes below
+ * heapSECOND_LEVEL_INDEX_COUNT * portBYTE_ALIGNMENT each get their own list in
+ * first level class 0.  The first level classes above it are powers of two. */
+#if portBYTE_ALIGNMENT == 32
+    #define heapALIGNMENT_LOG2    5
+#elif portBYTE_ALIGNMENT == 16
+    #define heapALIGNMENT_LOG2    4
+#elif portBYTE_ALIGNMENT == 8
+    #define heapALIGNMENT_LOG2    3
+#elif portBYTE_ALIGNMENT == 4
+    #define heapALIGNMENT_LOG2    2
+#elif portBYTE_ALIGNMENT == 2
+    #define heapALIGNMENT_LOG2    1
+#else
+    #define heapALIGNMENT_LOG2    0
+#endif
+
+#define heapFIRST_LEVEL_SHIFT          ( heapSECOND_LEVEL_INDEX_LOG2 + heapALIGNMENT_LOG2 )
+#define heapSMALL_BLOCK_SIZE           ( ( size_t ) 1 << heapFIRST_LEVEL_SHIFT )
+#define heapFIRST_LEVEL_INDEX_COUNT    ( configHEAP_MAX_BLOCK_SIZE_LOG2 - heapFIRST_LEVEL_SHIFT + 1 )
+
+/* The bitmap of first level classes is 32 bits wide. */
+#if ( heapFIRST_LEVEL_INDEX_COUNT > 32 ) || ( heapFIRST_LEVEL_INDEX_COUNT < 2 )
+    #error configHEAP_MAX_BLOCK_SIZE_LOG2 is out of range for heap_6.c
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* The largest block the free lists can hold. */
+#define heapMAX_BLOCK_SIZE        ( ( ( ( size_t ) 1 ) << configHEAP_MAX_BLOCK_SIZE_LOG2 ) - portBYTE_ALIGNMENT )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )         ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* MSB of the xBlockSize member of an BlockLink_t structure is used to track
+ * the allocation status of a block.  When MSB of the xBlockSize member of
+ * an BlockLink_t structure is set then the block belongs to the application.
+ * When the bit is free the block is still part of the free heap space. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_SIZE_IS_VALID( xBlockSize )    ( ( ( xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) == 0 )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )        ( ( ( pxBlock->xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
+#define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
+#define heapBLOCK_SIZE( pxBlock )                ( ( pxBlock->xBlockSize ) & ~heapBLOCK_ALLOCATED_BITMASK )
+
+/* The block that starts directly after pxBlock in memory. */
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock )       ( ( BlockLink_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/*-----------------------------------------------------------*/
+
+/* Allocate the memory for the heap. */
+#if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+/* The application writer has already defined the array used for the RTOS
+* heap - probably so it can be placed in a special segment or address. */
+    extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+    PRIVILEGED_DATA static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* The header of every block.  Only the first two members are kept while a
+ * block is allocated - the free list links overlay the start of the memory
+ * returned to the application. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxPreviousPhysicalBlock; /*<< The block that ends where this one starts, NULL for the first block. */
+    size_t xBlockSize;                             /*<< The size of the block, including this header. */
+    struct A_BLOCK_LINK * pxNextFreeBlock;         /*<< The next free block in the same size class. */
+    struct A_BLOCK_LINK * pxPreviousFreeBlock;     /*<< The previous free block in the same size class. */
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Adds a free block to the head of the list of its size class.
+ */
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes a free block out of the list of its size class.
+ */
+static void prvRemoveBlockFromFreeList( BlockLink_t * pxBlockToRemove ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the first and second level class that holds blocks of xBlockSize
+ * bytes.
+ */
+static void prvMapBlockSize( size_t xBlockSize,
+                             UBaseType_t * puxFirstLevel,
+                             UBaseType_t * puxSecondLevel ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes and returns a free block of at least xWantedSize bytes, or returns
+ * NULL if there is none.
+ */
+static BlockLink_t * prvTakeSuitableBlock( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the index of the most and least significant bits set in a non zero
+ * value.
+ */
+static UBaseType_t prvHighestBitSet( size_t xValue ) PRIVILEGED_FUNCTION;
+static UBaseType_t prvLowestBitSet( uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The size of the header placed at the beginning of each allocated memory
+ * block must by correctly byte aligned. */
+static const size_t xHeapStructSize = ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Block sizes must not get too small - a free block has to hold the whole
+ * BlockLink_t structure. */
+static const size_t xHeapMinimumBlockSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The free lists of every size class, and the bitmaps that record which of
+ * them hold blocks.  Bit n of ulFirstLevelBitmap is set when any second level
+ * list of first level class n is not empty. */
+PRIVILEGED_DATA static BlockLink_t * pxFreeLists[ heapFIRST_LEVEL_INDEX_COUNT ][ heapSECOND_LEVEL_INDEX_COUNT ];
+PRIVILEGED_DATA static uint32_t ulFirstLevelBitmap = 0U;
+PRIVILEGED_DATA static uint32_t ulSecondLevelBitmaps[ heapFIRST_LEVEL_INDEX_COUNT ];
+
+/* Marks the end of the heap.  It is a zero sized block that is always
+ * allocated, so the last real block never merges past it. */
+PRIVILEGED_DATA static BlockLink_t * pxEnd = NULL;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes and blocks remaining. */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xNumberOfFreeBlocks = 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = 0;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = 0;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+
+    vTaskSuspendAll();
+    {
+        /* If this is the first call to malloc then the heap will require
+         * initialisation to setup the free lists. */
+        if( pxEnd == NULL )
+        {
+            prvHeapInit();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xWantedSize > 0 )
+        {
+            /* The wanted size must be increased so it can contain the block
+             * header in addition to the requested amount of bytes. Some
+             * additional increment may also be needed for alignment. */
+            xAdditionalRequiredSize = xHeapStructSize + portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+            if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+            {
+                xWantedSize += xAdditionalRequiredSize;
+
+                if( xWantedSize < xHeapMinimumBlockSize )
+                {
+                    xWantedSize = xHeapMinimumBlockSize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xWantedSize = 0;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Blocks larger than the largest size class can never exist, which
+         * also ensures the top bit of the size, that marks a block as
+         * allocated, is free. */
+        if( ( xWantedSize > 0 ) && ( xWantedSize <= heapMAX_BLOCK_SIZE ) && ( xWantedSize <= xFreeBytesRemaining ) )
+        {
+            pxBlock = prvTakeSuitableBlock( xWantedSize );
+
+            if( pxBlock != NULL )
+            {
+                /* Return the memory space pointed to - jumping over the
+                 * block header at its start. */
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+
+                /* If the block is larger than required it can be split into
+                 * two. */
+                if( ( pxBlock->xBlockSize - xWantedSize ) >= xHeapMinimumBlockSize )
+                {
+                    /* This block is to be split into two.  Create a new
+                     * block following the number of bytes requested. The void
+                     * cast is used to prevent byte alignment warnings from the
+                     * compiler. */
+                    pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                    configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                    /* Calculate the sizes of two blocks split from the
+                     * single block, and link the new block in between the
+                     * block and its old physical neighbour. */
+                    pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                    pxNewBlockLink->pxPreviousPhysicalBlock = pxBlock;
+                    heapNEXT_PHYSICAL_BLOCK( pxNewBlockLink )->pxPreviousPhysicalBlock = pxNewBlockLink;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    /* Insert the new block into the free lists. */
+                    prvInsertBlockIntoFreeList( pxNewBlockLink );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The block is being returned - it is allocated and owned
+                 * by the application. */
+                heapALLOCATE_BLOCK( pxBlock );
+                xNumberOfSuccessfulAllocations++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    BlockLink_t * pxNeighbour;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have a block header immediately before
+         * it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+
+        if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
+        {
+            /* The block is being returned to the heap - it is no longer
+             * allocated. */
+            heapFREE_BLOCK( pxLink );
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( puc + xHeapStructSize, 0, pxLink->xBlockSize - xHeapStructSize );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                xFreeBytesRemaining += pxLink->xBlockSize;
+                traceFREE( pv, pxLink->xBlockSize );
+
+                /* Merge with the block in front of this one if it is free. */
+                pxNeighbour = pxLink->pxPreviousPhysicalBlock;
+
+                if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 ) )
+                {
+                    prvRemoveBlockFromFreeList( pxNeighbour );
+                    pxNeighbour->xBlockSize += pxLink->xBlockSize;
+                    pxLink = pxNeighbour;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Merge with the block behind this one if it is free.  pxEnd
+                 * is always allocated, so this stops at the end of the heap. */
+                pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxLink );
+
+                if( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 )
+                {
+                    prvRemoveBlockFromFreeList( pxNeighbour );
+                    pxLink->xBlockSize += pxNeighbour->xBlockSize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                heapNEXT_PHYSICAL_BLOCK( pxLink )->pxPreviousPhysicalBlock = pxLink;
+
+                /* Add the merged block to the free lists. */
+                prvInsertBlockIntoFreeList( pxLink );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxFirstFreeBlock;
+    uint8_t * pucAlignedHeap;
+    portPOINTER_SIZE_TYPE uxAddress;
+    size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+    /* Ensure the heap starts on a correctly aligned boundary. */
+    uxAddress = ( portPOINTER_SIZE_TYPE ) ucHeap;
+
+    if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+    {
+        uxAddress += ( portBYTE_ALIGNMENT - 1 );
+        uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+        xTotalHeapSize -= uxAddress - ( portPOINTER_SIZE_TYPE ) ucHeap;
+    }
+
+    pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+    /* The whole heap is one block to start with, so it must fit the largest
+     * size class. */
+    if( xTotalHeapSize > heapMAX_BLOCK_SIZE )
+    {
+        xTotalHeapSize = heapMAX_BLOCK_SIZE;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* pxEnd is used to mark the end of the heap and is inserted at the end of
+     * the heap space. */
+    uxAddress = ( ( portPOINTER_SIZE_TYPE ) pucAlignedHeap ) + xTotalHeapSize;
+    uxAddress -= xHeapStructSize;
+    uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+    pxEnd = ( BlockLink_t * ) uxAddress;
+
+    /* To start with there is a single free block that is sized to take up the
+     * entire heap space, minus the space taken by pxEnd. */
+    pxFirstFreeBlock = ( BlockLink_t * ) pucAlignedHeap;
+    pxFirstFreeBlock->xBlockSize = ( size_t ) ( uxAddress - ( portPOINTER_SIZE_TYPE ) pxFirstFreeBlock );
+    pxFirstFreeBlock->pxPreviousPhysicalBlock = NULL;
+
+    pxEnd->xBlockSize = 0;
+    pxEnd->pxPreviousPhysicalBlock = pxFirstFreeBlock;
+    heapALLOCATE_BLOCK( pxEnd );
+
+    prvInsertBlockIntoFreeList( pxFirstFreeBlock );
+
+    /* Only one block exists - and it covers the entire usable heap space. */
+    xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+    xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvHighestBitSet( size_t xValue ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxBit;
+
+    #if defined( __GNUC__ )
+    {
+        uxBit = ( UBaseType_t ) ( ( sizeof( unsigned long long ) * heapBITS_PER_BYTE ) - 1U - ( size_t ) __builtin_clzll( ( unsigned long long ) xValue ) );
+    }
+    #else
+    {
+        size_t xShift = ( sizeof( size_t ) * heapBITS_PER_BYTE ) / 2U;
+
+        /* Binary search, so the time taken does not depend on the value. */
+        uxBit = 0;
+
+        while( xShift > 0U )
+        {
+            if( ( xValue >> xShift ) != 0U )
+            {
+                xValue >>= xShift;
+                uxBit += ( UBaseType_t ) xShift;
+            }
+
+            xShift /= 2U;
+        }
+    }
+    #endif /* if defined( __GNUC__ ) */
+
+    return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvLowestBitSet( uint32_t ulValue ) /* PRIVILEGED_FUNCTION */
+{
+    /* Isolate the lowest set bit, which is then the only one set. */
+    return prvHighestBitSet( ( size_t ) ( ulValue & ( ~ulValue + 1U ) ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapBlockSize( size_t xBlockSize,
+                             UBaseType_t * puxFirstLevel,
+                             UBaseType_t * puxSecondLevel ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxHighestBit;
+
+    if( xBlockSize < heapSMALL_BLOCK_SIZE )
+    {
+        /* Small blocks are kept in linear classes one alignment unit apart. */
+        *puxFirstLevel = 0;
+        *puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> heapALIGNMENT_LOG2 );
+    }
+    else
+    {
+        /* The first level is the power of two below the size, and the second
+         * level the next heapSECOND_LEVEL_INDEX_LOG2 bits of the size. */
+        uxHighestBit = prvHighestBitSet( xBlockSize );
+        *puxFirstLevel = uxHighestBit - ( UBaseType_t ) heapFIRST_LEVEL_SHIFT + 1U;
+        *puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> ( uxHighestBit - heapSECOND_LEVEL_INDEX_LOG2 ) ) - heapSECOND_LEVEL_INDEX_COUNT;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvTakeSuitableBlock( size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock = NULL;
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    size_t xRoundedSize = xWantedSize;
+    uint32_t ulMap;
+
+    /* Round the size up to the start of the next size class, so any block in
+     * that class or above is large enough. */
+    if( xWantedSize >= heapSMALL_BLOCK_SIZE )
+    {
+        xRoundedSize += ( ( ( size_t ) 1 ) << ( prvHighestBitSet( xWantedSize ) - heapSECOND_LEVEL_INDEX_LOG2 ) ) - 1U;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    prvMapBlockSize( xRoundedSize, &uxFirstLevel, &uxSecondLevel );
+
+    if( uxFirstLevel < ( UBaseType_t ) heapFIRST_LEVEL_INDEX_COUNT )
+    {
+        /* Look for a non empty list at or above the second level class... */
+        ulMap = ulSecondLevelBitmaps[ uxFirstLevel ] & ( ~( ( uint32_t ) 0U ) << uxSecondLevel );
+
+        if( ulMap == 0U )
+        {
+            /* ...else in any first level class above it. */
+            if( ( uxFirstLevel + 1U ) < 32U )
+            {
+                ulMap = ulFirstLevelBitmap & ( ~( ( uint32_t ) 0U ) << ( uxFirstLevel + 1U ) );
+            }
+
+            if( ulMap != 0U )
+            {
+                uxFirstLevel = prvLowestBitSet( ulMap );
+                ulMap = ulSecondLevelBitmaps[ uxFirstLevel ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulMap != 0U )
+        {
+            uxSecondLevel = prvLowestBitSet( ulMap );
+            pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlock == NULL )
+    {
+        /* Nothing larger is free, but the class the size itself falls in may
+         * still hold a block that is big enough.  Only the first block of it
+         * is tried, so the time taken stays constant. */
+        prvMapBlockSize( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+        if( uxFirstLevel < ( UBaseType_t ) heapFIRST_LEVEL_INDEX_COUNT )
+        {
+            pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+
+            if( ( pxBlock != NULL ) && ( pxBlock->xBlockSize < xWantedSize ) )
+            {
+                pxBlock = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlock != NULL )
+    {
+        prvRemoveBlockFromFreeList( pxBlock );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    BlockLink_t * pxHead;
+
+    prvMapBlockSize( pxBlockToInsert->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+    configASSERT( uxFirstLevel < ( UBaseType_t ) heapFIRST_LEVEL_INDEX_COUNT );
+
+    pxHead = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+    pxBlockToInsert->pxNextFreeBlock = pxHead;
+    pxBlockToInsert->pxPreviousFreeBlock = NULL;
+
+    if( pxHead != NULL )
+    {
+        pxHead->pxPreviousFreeBlock = pxBlockToInsert;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlockToInsert;
+    ulFirstLevelBitmap |= ( ( uint32_t ) 1U ) << uxFirstLevel;
+    ulSecondLevelBitmaps[ uxFirstLevel ] |= ( ( uint32_t ) 1U ) << uxSecondLevel;
+    xNumberOfFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveBlockFromFreeList( BlockLink_t * pxBlockToRemove ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+
+    prvMapBlockSize( pxBlockToRemove->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+    if( pxBlockToRemove->pxNextFreeBlock != NULL )
+    {
+        pxBlockToRemove->pxNextFreeBlock->pxPreviousFreeBlock = pxBlockToRemove->pxPreviousFreeBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlockToRemove->pxPreviousFreeBlock != NULL )
+    {
+        pxBlockToRemove->pxPreviousFreeBlock->pxNextFreeBlock = pxBlockToRemove->pxNextFreeBlock;
+    }
+    else
+    {
+        /* The block was the head of its list.  Clear the bitmaps if the list
+         * is now empty. */
+        pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlockToRemove->pxNextFreeBlock;
+
+        if( pxBlockToRemove->pxNextFreeBlock == NULL )
+        {
+            ulSecondLevelBitmaps[ uxFirstLevel ] &= ~( ( ( uint32_t ) 1U ) << uxSecondLevel );
+
+            if( ulSecondLevelBitmaps[ uxFirstLevel ] == 0U )
+            {
+                ulFirstLevelBitmap &= ~( ( ( uint32_t ) 1U ) << uxFirstLevel );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    xNumberOfFreeBlocks--;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    UBaseType_t uxFirstLevel;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        /* The bitmaps are empty if the heap has not been initialised.  The
+         * heap is initialised automatically when the first allocation is
+         * made.  The largest and smallest blocks are in the highest and lowest
+         * non empty classes, so only those two lists are walked. */
+        if( ulFirstLevelBitmap != 0U )
+        {
+            xBlocks = xNumberOfFreeBlocks;
+
+            uxFirstLevel = prvHighestBitSet( ( size_t ) ulFirstLevelBitmap );
+            pxBlock = pxFreeLists[ uxFirstLevel ][ prvHighestBitSet( ( size_t ) ulSecondLevelBitmaps[ uxFirstLevel ] ) ];
+
+            while( pxBlock != NULL )
+            {
+                if( pxBlock->xBlockSize > xMaxSize )
+                {
+                    xMaxSize = pxBlock->xBlockSize;
+                }
+
+                pxBlock = pxBlock->pxNextFreeBlock;
+            }
+
+            uxFirstLevel = prvLowestBitSet( ulFirstLevelBitmap );
+            pxBlock = pxFreeLists[ uxFirstLevel ][ prvLowestBitSet( ulSecondLevelBitmaps[ uxFirstLevel ] ) ];
+
+            while( pxBlock != NULL )
+            {
+                if( pxBlock->xBlockSize < xMinSize )
+                {
+                    xMinSize = pxBlock->xBlockSize;
+                }
+
+                pxBlock = pxBlock->pxNextFreeBlock;
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
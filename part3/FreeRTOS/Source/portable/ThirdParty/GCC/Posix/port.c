@@ -386,6 +386,74 @@ void prvSetupTimerInterrupt( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+/* The longest time the tick is suppressed for, which keeps the timer value
+ * well inside the range setitimer() accepts. */
+    #define portMAX_SUPPRESSED_TICKS    ( ( TickType_t ) configTICK_RATE_HZ * ( TickType_t ) 3600 )
+
+    void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+    {
+        struct itimerval itimer;
+        sigset_t xTickSignal;
+        int iSignal;
+        int iRet;
+
+        if( xExpectedIdleTime > portMAX_SUPPRESSED_TICKS )
+        {
+            xExpectedIdleTime = portMAX_SUPPRESSED_TICKS;
+        }
+
+        /* Stop the tick ISR running while the timer is reprogrammed. */
+        vPortEnterCritical();
+
+        /* A task might have been readied since the scheduler was suspended, or
+         * a tick might be waiting for the critical section to end. */
+        sigpending( &xTickSignal );
+
+        if( ( eTaskConfirmSleepModeStatus() == eAbortSleep ) || ( sigismember( &xTickSignal, SIGALRM ) == 1 ) )
+        {
+            vPortExitCritical();
+            return;
+        }
+
+        /* A single expiry ends the sleep.  Whatever was left of the current
+         * tick period is dropped, which the simulator can afford. */
+        itimer.it_interval.tv_sec = 0;
+        itimer.it_interval.tv_usec = 0;
+        itimer.it_value.tv_sec = ( time_t ) ( xExpectedIdleTime / configTICK_RATE_HZ );
+        itimer.it_value.tv_usec = ( suseconds_t ) ( ( xExpectedIdleTime % configTICK_RATE_HZ ) * portTICK_RATE_MICROSECONDS );
+
+        iRet = setitimer( ITIMER_REAL, &itimer, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "setitimer", errno );
+        }
+
+        /* SIGALRM is the only interrupt the simulator has, so nothing but the
+         * timer can end the sleep.  It is blocked in every thread, so it is
+         * taken here rather than by the tick handler. */
+        sigemptyset( &xTickSignal );
+        sigaddset( &xTickSignal, SIGALRM );
+        ( void ) sigwait( &xTickSignal, &iSignal );
+
+        /* Restart the tick from the end of the sleep, however late the host
+         * delivered the expiry. */
+        prvSetupTimerInterrupt();
+
+        /* The expiry stands for the last tick of the sleep, which is processed
+         * as the tick ISR would have done.  The scheduler is suspended, so it
+         * is only pended. */
+        vTaskStepTick( xExpectedIdleTime - ( TickType_t ) 1 );
+        ( void ) xTaskIncrementTick();
+
+        vPortExitCritical();
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
 static void vPortSystemTickHandler( int sig )
 {
     Thread_t * pxThreadToSuspend;
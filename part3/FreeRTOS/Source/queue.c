@@ -92,6 +92,21 @@ typedef struct SemaphoreData
     #define queueYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
 #endif
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/* A slot reserved by pvQueueReserve() is written in place, so no other item can
+ * be written until it is committed.  An item peeked by pvQueuePeekInPlace() is
+ * read in place, so it cannot be received by another task, or moved from the
+ * head of the queue by an item written to the front, until it is released. */
+    #define queueWRITE_HELD( pxQueue, xPosition )                                          \
+    ( ( ( ( pxQueue )->pcReservedSlot != NULL ) ||                                         \
+        ( ( ( xPosition ) != queueSEND_TO_BACK ) && ( ( pxQueue )->pcPeekedItem != NULL ) ) ) ? pdTRUE : pdFALSE )
+    #define queueREAD_HELD( pxQueue )    ( ( ( pxQueue )->pcPeekedItem != NULL ) ? pdTRUE : pdFALSE )
+#else
+    #define queueWRITE_HELD( pxQueue, xPosition )    ( pdFALSE )
+    #define queueREAD_HELD( pxQueue )                ( pdFALSE )
+#endif
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -130,6 +145,15 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_MUTEX_CEILING == 1 )
+        void * pvMutexCeiling; /*< The ceiling of a mutex created by xQueueCreateMutexWithCeiling(), otherwise NULL. */
+    #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        int8_t * pcReservedSlot; /*< The slot returned by pvQueueReserve() until it is committed, otherwise NULL. */
+        int8_t * pcPeekedItem;   /*< The item returned by pvQueuePeekInPlace() until it is released, otherwise NULL. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -212,6 +236,54 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
     static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+/*
+ * Copies as many of uxItemCount items as there is space for to the back of a
+ * queue, or from the front of a queue into pvBuffer, and returns how many were
+ * copied.
+ */
+    static UBaseType_t prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                            const void * pvItems,
+                                            UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+    static UBaseType_t prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                              void * const pvBuffer,
+                                              UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * A batch wakes only one task waiting on the other side of the queue, so each
+ * task that writes to or reads from the queue passes the wakeup on to the next
+ * writer while there is still space, or the next reader while there are still
+ * items.  Returns pdTRUE if a task that should preempt the caller unblocked.
+ */
+    static BaseType_t prvWakeNextWriter( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvWakeNextReader( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_QUEUE_ZERO_COPY == 1 ) || ( configUSE_QUEUE_BATCHING == 1 ) )
+
+/*
+ * Tells a reader that uxItemCount items were added to an unlocked queue: the
+ * queue set the queue is a member of, once per item, if there is one,
+ * otherwise the highest priority task waiting to receive.  Returns pdTRUE if a
+ * task that should preempt the caller unblocked.
+ */
+    static BaseType_t prvNotifyItemsAdded( const Queue_t * const pxQueue,
+                                           UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/*
+ * Unblocks up to uxMaxTasks of the tasks in pxEventList, highest priority
+ * first.  Used when a reserved slot or a peeked item is given back, as every
+ * task it held off, not only one, may now be able to go on.  Returns pdTRUE if
+ * a task that should preempt the caller unblocked.
+ */
+    static BaseType_t prvUnblockHeldTasks( List_t * const pxEventList,
+                                           UBaseType_t uxMaxTasks ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Called after a Queue_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -315,6 +387,13 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            {
+                pxQueue->pcReservedSlot = NULL;
+                pxQueue->pcPeekedItem = NULL;
+            }
+            #endif
+
             if( xNewQueue == pdFALSE )
             {
                 /* If there are tasks blocked waiting to read from the queue, then
@@ -553,6 +632,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             /* In case this is a recursive mutex. */
             pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+            #if ( configUSE_MUTEX_CEILING == 1 )
+            {
+                pxNewQueue->pvMutexCeiling = NULL;
+            }
+            #endif
+
             traceCREATE_MUTEX( pxNewQueue );
 
             /* Start with the semaphore in the expected state. */
@@ -583,6 +668,42 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_CEILING == 1 )
+
+    QueueHandle_t xQueueCreateMutexWithCeiling( const UBaseType_t uxCeilingPriority,
+                                                const TickType_t xCeilingPeriod,
+                                                const TickType_t xLongestHold )
+    {
+        Queue_t * pxNewQueue;
+
+        pxNewQueue = ( Queue_t * ) xQueueCreateMutex( queueQUEUE_TYPE_MUTEX );
+
+        if( pxNewQueue != NULL )
+        {
+            /* The mutex is only handed out once its ceiling is recorded. */
+            pxNewQueue->pvMutexCeiling = pvTaskCreateMutexCeiling( uxCeilingPriority, xCeilingPeriod, xLongestHold );
+
+            if( pxNewQueue->pvMutexCeiling == NULL )
+            {
+                vQueueDelete( pxNewQueue );
+                pxNewQueue = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxNewQueue;
+    }
+
+#endif /* configUSE_MUTEX_CEILING */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
     QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType,
@@ -861,7 +982,8 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
              * highest priority task wanting to access the queue.  If the head item
              * in the queue is to be overwritten then it does not matter if the
              * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+            if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) ) &&
+                ( queueWRITE_HELD( pxQueue, xCopyPosition ) == pdFALSE ) )
             {
                 traceQUEUE_SEND( pxQueue );
 
@@ -961,6 +1083,19 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                 }
                 #endif /* configUSE_QUEUE_SETS */
 
+                #if ( configUSE_QUEUE_BATCHING == 1 )
+                {
+                    if( prvWakeNextWriter( pxQueue ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_BATCHING */
+
                 taskEXIT_CRITICAL();
                 return pdPASS;
             }
@@ -1002,7 +1137,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
         /* Update the timeout state to see if it has expired yet. */
         if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            if( ( prvIsQueueFull( pxQueue ) != pdFALSE ) || ( queueWRITE_HELD( pxQueue, xCopyPosition ) != pdFALSE ) )
             {
                 traceBLOCKING_ON_QUEUE_SEND( pxQueue );
                 vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
@@ -1080,7 +1215,8 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
      * post). */
     uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
     {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+        if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) ) &&
+            ( queueWRITE_HELD( pxQueue, xCopyPosition ) == pdFALSE ) )
         {
             const int8_t cTxLock = pxQueue->cTxLock;
             const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1408,7 +1544,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 
             /* Is there data in the queue now?  To be running the calling task
              * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueREAD_HELD( pxQueue ) == pdFALSE ) )
             {
                 /* Data available, remove one item. */
                 prvCopyDataFromQueue( pxQueue, pvBuffer );
@@ -1434,6 +1570,19 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                     mtCOVERAGE_TEST_MARKER();
                 }
 
+                #if ( configUSE_QUEUE_BATCHING == 1 )
+                {
+                    if( prvWakeNextReader( pxQueue ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_BATCHING */
+
                 taskEXIT_CRITICAL();
                 return pdPASS;
             }
@@ -1474,7 +1623,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
         {
             /* The timeout has not expired.  If the queue is still empty place
              * the task on the list of tasks waiting to receive from the queue. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            if( ( prvIsQueueEmpty( pxQueue ) != pdFALSE ) || ( queueREAD_HELD( pxQueue ) != pdFALSE ) )
             {
                 traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
                 vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
@@ -1571,6 +1720,19 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                         /* Record the information required to implement
                          * priority inheritance should it become necessary. */
                         pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                        #if ( configUSE_MUTEX_CEILING == 1 )
+                        {
+                            if( pxQueue->pvMutexCeiling != NULL )
+                            {
+                                vTaskRaiseToMutexCeiling( pxQueue->pvMutexCeiling );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif /* configUSE_MUTEX_CEILING */
                     }
                     else
                     {
@@ -1645,7 +1807,14 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
 
                 #if ( configUSE_MUTEXES == 1 )
                 {
-                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    #if ( configUSE_MUTEX_CEILING == 1 )
+                        /* The holder of a mutex with a ceiling already runs
+                         * at or above the priority of any task that can wait
+                         * for it, so there is nothing to inherit. */
+                        if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->pvMutexCeiling == NULL ) )
+                    #else
+                        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    #endif
                     {
                         taskENTER_CRITICAL();
                         {
@@ -1911,7 +2080,7 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
         /* Cannot block in an ISR, so check there is data available. */
-        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueREAD_HELD( pxQueue ) == pdFALSE ) )
         {
             const int8_t cRxLock = pxQueue->cRxLock;
 
@@ -2027,131 +2196,921 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-
-    configASSERT( xQueue );
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
 
-    taskENTER_CRITICAL();
+    void * pvQueueReserve( QueueHandle_t xQueue,
+                           TickType_t xTicksToWait )
     {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        void * pvSlot;
+        Queue_t * const pxQueue = xQueue;
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores hold no data to write in place. */
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
 
-    configASSERT( pxQueue );
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* The slot an item sent to the back of the queue would be
+                 * copied into is handed out, so it has to be free and not
+                 * already reserved. */
+                if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) &&
+                    ( queueWRITE_HELD( pxQueue, queueSEND_TO_BACK ) == pdFALSE ) )
+                {
+                    pxQueue->pcReservedSlot = pxQueue->pcWriteTo;
+                    pvSlot = ( void * ) pxQueue->pcReservedSlot;
 
-    taskENTER_CRITICAL();
-    {
-        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
+                    taskEXIT_CRITICAL();
+                    return pvSlot;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                        return NULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                /* Wait with the tasks blocked in xQueueSend(), so the slot goes
+                 * to whichever writer has the highest priority. */
+                if( ( prvIsQueueFull( pxQueue ) != pdFALSE ) || ( queueWRITE_HELD( pxQueue, queueSEND_TO_BACK ) != pdFALSE ) )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
 
-    configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+                traceQUEUE_SEND_FAILED( pxQueue );
+                return NULL;
+            }
+        } /*lint -restore */
+    }
 
-void vQueueDelete( QueueHandle_t xQueue )
-{
-    Queue_t * const pxQueue = xQueue;
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
 
-    configASSERT( pxQueue );
-    traceQUEUE_DELETE( pxQueue );
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
 
-    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    BaseType_t xQueueCommit( QueueHandle_t xQueue )
     {
-        vQueueUnregisterQueue( pxQueue );
-    }
-    #endif
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
 
-    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-    {
-        /* The queue can only have been allocated dynamically - free it
-         * again. */
-        vPortFree( pxQueue );
-    }
-    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-    {
-        /* The queue could have been allocated statically or dynamically, so
-         * check before attempting to free the memory. */
-        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
-        {
-            vPortFree( pxQueue );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
-    {
-        /* The queue must have been statically allocated, so is not going to be
-         * deleted.  Avoid compiler warnings about the unused parameter. */
-        ( void ) pxQueue;
-    }
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-}
-/*-----------------------------------------------------------*/
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->pcReservedSlot != NULL );
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+        taskENTER_CRITICAL();
+        {
+            if( pxQueue->pcReservedSlot != NULL )
+            {
+                traceQUEUE_SEND( pxQueue );
 
-    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
-    {
-        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
-    }
+                /* The item is already in the slot pcWriteTo points to, so only
+                 * the write position moves on, as in prvCopyDataToQueue(). */
+                pxQueue->pcReservedSlot = NULL;
+                pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+                if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+                {
+                    pxQueue->pcWriteTo = pxQueue->pcHead;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+                pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1;
 
-    void vQueueSetQueueNumber( QueueHandle_t xQueue,
-                               UBaseType_t uxQueueNumber )
-    {
-        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
-    }
+                if( prvNotifyItemsAdded( pxQueue, ( UBaseType_t ) 1 ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+                /* Every writer was held off while the slot was reserved, so
+                 * one can go on for each slot that is still free. */
+                if( prvUnblockHeldTasks( &( pxQueue->xTasksWaitingToSend ), pxQueue->uxLength - pxQueue->uxMessagesWaiting ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL();
 
-    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
-    {
-        return ( ( Queue_t * ) xQueue )->ucQueueType;
+        return xReturn;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_QUEUE_ZERO_COPY */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
 
-    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    void * pvQueuePeekInPlace( QueueHandle_t xQueue,
+                               TickType_t xTicksToWait )
     {
-        UBaseType_t uxHighestPriorityOfWaitingTasks;
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        int8_t * pcItem;
+        Queue_t * const pxQueue = xQueue;
 
-        /* If a task waiting for a mutex causes the mutex holder to inherit a
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores hold no data to read in place. */
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904  This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueREAD_HELD( pxQueue ) == pdFALSE ) )
+                {
+                    /* The head item is the one after pcReadFrom, the slot
+                     * prvCopyDataFromQueue() would copy out of. */
+                    pcItem = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+                    if( pcItem >= pxQueue->u.xQueue.pcTail )
+                    {
+                        pcItem = pxQueue->pcHead;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceQUEUE_PEEK( pxQueue );
+                    pxQueue->pcPeekedItem = pcItem;
+
+                    taskEXIT_CRITICAL();
+                    return ( void * ) pcItem;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_PEEK_FAILED( pxQueue );
+                        return NULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                /* Wait with the tasks blocked in xQueueReceive(), so the item
+                 * goes to whichever reader has the highest priority. */
+                if( ( prvIsQueueEmpty( pxQueue ) != pdFALSE ) || ( queueREAD_HELD( pxQueue ) != pdFALSE ) )
+                {
+                    traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_PEEK_FAILED( pxQueue );
+                return NULL;
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueRelease( QueueHandle_t xQueue )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->pcPeekedItem != NULL );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxQueue->pcPeekedItem != NULL )
+            {
+                traceQUEUE_RECEIVE( pxQueue );
+
+                /* The peeked item was the head, so it becomes the last place
+                 * read from, as in prvCopyDataFromQueue(). */
+                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcPeekedItem;
+                pxQueue->pcPeekedItem = NULL;
+                pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1;
+
+                /* A slot is now free, and writers to the front of the queue
+                 * were held off while the item was peeked, so one writer can
+                 * go on for each free slot. */
+                if( prvUnblockHeldTasks( &( pxQueue->xTasksWaitingToSend ), pxQueue->uxLength - pxQueue->uxMessagesWaiting ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Every reader was held off while the item was peeked, so one
+                 * can go on for each item that is left. */
+                if( prvUnblockHeldTasks( &( pxQueue->xTasksWaitingToReceive ), pxQueue->uxMessagesWaiting ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                                    const void * const pvItems,
+                                    const UBaseType_t uxItemCount,
+                                    TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        UBaseType_t uxItemsSent;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores are given with xSemaphoreGive(). */
+        configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        if( uxItemCount == ( UBaseType_t ) 0U )
+        {
+            return ( UBaseType_t ) 0U;
+        }
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Is there room for at least one item?  As many items as fit
+                 * are copied in together, then one reader is woken for all of
+                 * them, and passes the wakeup on if it leaves items. */
+                if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) &&
+                    ( queueWRITE_HELD( pxQueue, queueSEND_TO_BACK ) == pdFALSE ) )
+                {
+                    traceQUEUE_SEND( pxQueue );
+
+                    uxItemsSent = prvCopyItemsToQueue( pxQueue, pvItems, uxItemCount );
+
+                    if( prvNotifyItemsAdded( pxQueue, uxItemsSent ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( prvWakeNextWriter( pxQueue ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    taskEXIT_CRITICAL();
+                    return uxItemsSent;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        /* The queue was full and no block time is specified (or
+                         * the block time has expired) so leave now. */
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                        return ( UBaseType_t ) 0U;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( ( prvIsQueueFull( pxQueue ) != pdFALSE ) || ( queueWRITE_HELD( pxQueue, queueSEND_TO_BACK ) != pdFALSE ) )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_SEND_FAILED( pxQueue );
+                return ( UBaseType_t ) 0U;
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                           const void * const pvItems,
+                                           const UBaseType_t uxItemCount,
+                                           BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxItemsSent = ( UBaseType_t ) 0U;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+
+        /* See the comment in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( ( uxItemCount > ( UBaseType_t ) 0U ) &&
+                ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) &&
+                ( queueWRITE_HELD( pxQueue, queueSEND_TO_BACK ) == pdFALSE ) )
+            {
+                int8_t cTxLock = pxQueue->cTxLock;
+
+                traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+                uxItemsSent = prvCopyItemsToQueue( pxQueue, pvItems, uxItemCount );
+
+                /* The event list is not altered if the queue is locked.  This
+                 * can only happen when a task is using the queue. */
+                if( cTxLock == queueUNLOCKED )
+                {
+                    if( prvNotifyItemsAdded( pxQueue, uxItemsSent ) != pdFALSE )
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The task that unlocks the queue wakes one reader for the
+                     * whole batch, but a queue set has to be notified once per
+                     * item. */
+                    prvIncrementQueueTxLock( pxQueue, cTxLock );
+
+                    #if ( configUSE_QUEUE_SETS == 1 )
+                    {
+                        UBaseType_t ux;
+
+                        if( pxQueue->pxQueueSetContainer != NULL )
+                        {
+                            for( ux = ( UBaseType_t ) 1U; ux < uxItemsSent; ux++ )
+                            {
+                                cTxLock = pxQueue->cTxLock;
+                                prvIncrementQueueTxLock( pxQueue, cTxLock );
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configUSE_QUEUE_SETS */
+                }
+            }
+            else
+            {
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return uxItemsSent;
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                       void * const pvBuffer,
+                                       const UBaseType_t uxItemCount,
+                                       TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        UBaseType_t uxItemsReceived;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores are taken with xSemaphoreTake(). */
+        configASSERT( !( ( pvBuffer == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904  This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        if( uxItemCount == ( UBaseType_t ) 0U )
+        {
+            return ( UBaseType_t ) 0U;
+        }
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Is there at least one item?  As many items as are wanted and
+                 * available are copied out together, then one writer is woken
+                 * for all of them, and passes the wakeup on if it leaves
+                 * space. */
+                if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueREAD_HELD( pxQueue ) == pdFALSE ) )
+                {
+                    uxItemsReceived = prvCopyItemsFromQueue( pxQueue, pvBuffer, uxItemCount );
+                    traceQUEUE_RECEIVE( pxQueue );
+
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                        {
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( prvWakeNextReader( pxQueue ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    taskEXIT_CRITICAL();
+                    return uxItemsReceived;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        /* The queue was empty and no block time is specified (or
+                         * the block time has expired) so leave now. */
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        return ( UBaseType_t ) 0U;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( ( prvIsQueueEmpty( pxQueue ) != pdFALSE ) || ( queueREAD_HELD( pxQueue ) != pdFALSE ) )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The queue contains data again.  Loop back to try and read
+                     * the data. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  If there is no data in the queue exit, otherwise
+                 * loop back and attempt to read the data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return ( UBaseType_t ) 0U;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                              void * const pvBuffer,
+                                              const UBaseType_t uxItemCount,
+                                              BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxItemsReceived = ( UBaseType_t ) 0U;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( !( ( pvBuffer == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+
+        /* See the comment in xQueueReceiveFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( ( uxItemCount > ( UBaseType_t ) 0U ) &&
+                ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) &&
+                ( queueREAD_HELD( pxQueue ) == pdFALSE ) )
+            {
+                const int8_t cRxLock = pxQueue->cRxLock;
+
+                traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+                uxItemsReceived = prvCopyItemsFromQueue( pxQueue, pvBuffer, uxItemCount );
+
+                /* If the queue is locked the event list will not be modified.
+                 * Instead the lock count is updated once for the batch, so the
+                 * task that unlocks the queue wakes one writer. */
+                if( cRxLock == queueUNLOCKED )
+                {
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                        {
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    prvIncrementQueueRxLock( pxQueue, cRxLock );
+                }
+            }
+            else
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return uxItemsReceived;
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+
+    configASSERT( xQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    uxReturn = pxQueue->uxMessagesWaiting;
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    traceQUEUE_DELETE( pxQueue );
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    {
+        vQueueUnregisterQueue( pxQueue );
+    }
+    #endif
+
+    #if ( configUSE_MUTEX_CEILING == 1 )
+    {
+        if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->pvMutexCeiling != NULL ) )
+        {
+            vTaskDeleteMutexCeiling( pxQueue->pvMutexCeiling );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        /* The queue can only have been allocated dynamically - free it
+         * again. */
+        vPortFree( pxQueue );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    {
+        /* The queue could have been allocated statically or dynamically, so
+         * check before attempting to free the memory. */
+        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            vPortFree( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+    {
+        /* The queue must have been statically allocated, so is not going to be
+         * deleted.  Avoid compiler warnings about the unused parameter. */
+        ( void ) pxQueue;
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vQueueSetQueueNumber( QueueHandle_t xQueue,
+                               UBaseType_t uxQueueNumber )
+    {
+        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->ucQueueType;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+        /* If a task waiting for a mutex causes the mutex holder to inherit a
          * priority, but the waiting task times out, then the holder should
          * disinherit the priority - but only down to the highest priority of any
          * other tasks that are waiting for the same mutex.  For this purpose,
@@ -2276,6 +3235,159 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    static UBaseType_t prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                            const void * pvItems,
+                                            UBaseType_t uxItemCount )
+    {
+        const UBaseType_t uxSpaces = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+        const size_t xBytesToTail = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo );
+        size_t xBytes, xFirstBytes;
+
+        /* This function is called from a critical section. */
+
+        if( uxItemCount > uxSpaces )
+        {
+            uxItemCount = uxSpaces;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The free slots run from pcWriteTo to the end of the storage area,
+         * then on from its start, so the items go in with at most two copies. */
+        xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+        xFirstBytes = ( xBytes < xBytesToTail ) ? xBytes : xBytesToTail;
+
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItems, xFirstBytes ); /*lint !e961 !e418 !e9087 Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        pxQueue->pcWriteTo += xFirstBytes;                                        /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        {
+            ( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) ( ( const uint8_t * ) pvItems + xFirstBytes ), xBytes - xFirstBytes ); /*lint !e961 !e418 !e9087 !e9016 As above. */
+            pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xFirstBytes );                                                                      /*lint !e9016 As above. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting + uxItemCount;
+
+        return uxItemCount;
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    static UBaseType_t prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                              void * const pvBuffer,
+                                              UBaseType_t uxItemCount )
+    {
+        int8_t * pcFirstItem;
+        size_t xBytesToTail, xBytes, xFirstBytes;
+
+        /* This function is called from a critical section. */
+
+        if( uxItemCount > pxQueue->uxMessagesWaiting )
+        {
+            uxItemCount = pxQueue->uxMessagesWaiting;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The items run from the one after pcReadFrom to the end of the storage
+         * area, then on from its start, so they come out with at most two
+         * copies. */
+        pcFirstItem = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pcFirstItem >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+        {
+            pcFirstItem = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xBytesToTail = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcFirstItem );
+        xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+        xFirstBytes = ( xBytes < xBytesToTail ) ? xBytes : xBytesToTail;
+
+        ( void ) memcpy( pvBuffer, ( void * ) pcFirstItem, xFirstBytes ); /*lint !e961 !e418 !e9087 Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+
+        if( xBytes > xFirstBytes )
+        {
+            ( void ) memcpy( ( void * ) ( ( uint8_t * ) pvBuffer + xFirstBytes ), ( void * ) pxQueue->pcHead, xBytes - xFirstBytes ); /*lint !e961 !e418 !e9087 !e9016 As above. */
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( xBytes - xFirstBytes ) - pxQueue->uxItemSize;                     /*lint !e9016 As above. */
+        }
+        else
+        {
+            pxQueue->u.xQueue.pcReadFrom = pcFirstItem + xFirstBytes - pxQueue->uxItemSize; /*lint !e9016 As above. */
+        }
+
+        pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - uxItemCount;
+
+        return uxItemCount;
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    static BaseType_t prvWakeNextWriter( const Queue_t * const pxQueue )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        /* This function must be called from a critical section. */
+
+        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) &&
+            ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+        {
+            xReturn = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCHING == 1 )
+
+    static BaseType_t prvWakeNextReader( const Queue_t * const pxQueue )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        /* This function must be called from a critical section. */
+
+        if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) &&
+            ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+        {
+            xReturn = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -3085,3 +4197,92 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     }
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_ZERO_COPY == 1 ) || ( configUSE_QUEUE_BATCHING == 1 ) )
+
+    static BaseType_t prvNotifyItemsAdded( const Queue_t * const pxQueue,
+                                           UBaseType_t uxItemCount )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        /* This function must be called from a critical section. */
+
+        #if ( configUSE_QUEUE_SETS == 1 )
+        {
+            if( pxQueue->pxQueueSetContainer != NULL )
+            {
+                /* A queue set holds the handle of a member queue once for each
+                 * item in it, so every item is notified. */
+                while( uxItemCount > ( UBaseType_t ) 0 )
+                {
+                    if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                    {
+                        xReturn = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    uxItemCount--;
+                }
+            }
+            else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+            {
+                xReturn = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* configUSE_QUEUE_SETS */
+        {
+            ( void ) uxItemCount;
+
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+            {
+                xReturn = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_QUEUE_SETS */
+
+        return xReturn;
+    }
+
+#endif /* ( ( configUSE_QUEUE_ZERO_COPY == 1 ) || ( configUSE_QUEUE_BATCHING == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static BaseType_t prvUnblockHeldTasks( List_t * const pxEventList,
+                                           UBaseType_t uxMaxTasks )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        /* This function must be called from a critical section.  A task that
+         * unblocks but then finds nothing to do only loops back and blocks
+         * again, so waking more tasks than can go on is safe. */
+        while( ( uxMaxTasks > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( pxEventList ) == pdFALSE ) )
+        {
+            if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxMaxTasks--;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
@@ -29,7 +29,6 @@
 /* Standard includes. */
 #include <stdlib.h>
 #include <string.h>
-#include <stdio.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
  * all the API functions to use the MPU wrappers.  That should only be done when
@@ -116,6 +115,109 @@
     #define configIDLE_TASK_NAME    "IDLE"
 #endif
 
+#if ( configUSE_RM == 1 )
+
+/* Under Rate Monotonic scheduling each priority level is split into one FIFO
+ * ready list per period class.  A period class groups the tasks that share a
+ * period, and its rank orders it against the other classes in use: the shorter
+ * the period the higher the rank.  uxReadyPeriods[] holds, for each priority, a
+ * bitmap of the ranks that contain ready tasks, so the shortest ready period is
+ * found the same way as the highest ready priority, and selection does not
+ * depend on the number of ready tasks or on the range of the periods. */
+    #if ( configRM_MAX_DISTINCT_PERIODS > 32 )
+        #error configRM_MAX_DISTINCT_PERIODS must be less than or equal to 32 as the ready periods of each priority are held in a bitmap.
+    #endif
+
+    #if ( configRM_MAX_DISTINCT_PERIODS < 2 )
+        #error configRM_MAX_DISTINCT_PERIODS must be at least 2 as one period class is reserved for tasks without a period.
+    #endif
+
+/* Class 0 holds the tasks created without a period, including the Idle and
+ * timer tasks.  It is never released and always has the lowest rank. */
+    #define taskRM_NO_PERIOD_CLASS          ( ( UBaseType_t ) 0U )
+
+/* A mutex ceiling takes its period class the first time the mutex is taken, as
+ * the classes are only set up along with the first task. */
+    #define taskRM_CEILING_CLASS_UNSET      ( ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS )
+
+    #define taskRM_PERIOD_INDEX( pxTCB )    ( xPeriodClasses[ ( pxTCB )->uxPeriodClass ].uxRank )
+
+/* The ready list a task is referenced from while it is Ready at uxPriority. */
+    #define taskREADY_LIST( uxPriority, pxTCB )    ( &( pxReadyTasksLists[ ( uxPriority ) ][ taskRM_PERIOD_INDEX( pxTCB ) ] ) )
+
+    #define taskRECORD_READY_PERIOD( pxTCB )    ( uxReadyPeriods[ ( pxTCB )->uxPriority ] |= ( ( UBaseType_t ) 1U << taskRM_PERIOD_INDEX( pxTCB ) ) )
+
+/* Clear the period bit once the task's period list is empty, and the priority
+ * bit once no period list at that priority holds a ready task. */
+    #define taskRESET_READY_TASK( pxTCB, uxPriority )                                                          \
+    {                                                                                                          \
+        if( listCURRENT_LIST_LENGTH( taskREADY_LIST( ( uxPriority ), ( pxTCB ) ) ) == ( UBaseType_t ) 0 )      \
+        {                                                                                                      \
+            uxReadyPeriods[ ( uxPriority ) ] &= ~( ( UBaseType_t ) 1U << taskRM_PERIOD_INDEX( pxTCB ) );        \
+                                                                                                               \
+            if( uxReadyPeriods[ ( uxPriority ) ] == ( UBaseType_t ) 0 )                                        \
+            {                                                                                                  \
+                portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );                            \
+            }                                                                                                  \
+        }                                                                                                      \
+    }
+
+/* The number of Ready state tasks at uxPriority, across all its periods. */
+    #define taskREADY_TASKS_AT_PRIORITY( uxPriority )    prvReadyTasksAtPriority( uxPriority )
+
+/* pdTRUE if pxTCB comes before pxOther in the order taskSELECT_TASK_RM()
+ * uses: a higher priority, or the same priority and the rank of a shorter
+ * period. */
+    #define taskRANKS_ABOVE( pxTCB, pxOther )                               \
+    ( ( ( pxTCB )->uxPriority > ( pxOther )->uxPriority ) ||                \
+      ( ( ( pxTCB )->uxPriority == ( pxOther )->uxPriority ) &&             \
+        ( taskRM_PERIOD_INDEX( pxTCB ) > taskRM_PERIOD_INDEX( pxOther ) ) ) )
+
+#else /* configUSE_RM */
+
+    #if ( configUSE_EDF == 1 )
+
+/* Under Earliest Deadline First scheduling each priority level has a single
+ * ready list kept in order of absolute deadline, so the task at its head is
+ * the one to run.  The deadline of a ready task is held in the item value of
+ * its state list item, which is otherwise unused while the task is Ready. */
+
+/* Deadlines are compared after subtracting a point half the tick range before
+ * the current tick count.  The order then survives the tick count wrapping,
+ * and a job that is already late still sorts ahead of one that is not.  Tasks
+ * without a deadline are placed after every task that has one. */
+        #define taskEDF_SORT_KEY( pxTCB )                                                             \
+    ( ( ( pxTCB )->xDeadline == portMAX_DELAY ) ? portMAX_DELAY :                                     \
+      ( TickType_t ) ( listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) ) - xTickCount + ( portMAX_DELAY >> 1 ) ) )
+
+/* pdTRUE if pxTCB comes before pxOther: a higher priority, or the same
+ * priority and an earlier deadline.  Neither comes first on a tie. */
+        #define taskRANKS_ABOVE( pxTCB, pxOther )                              \
+    ( ( ( pxTCB )->uxPriority > ( pxOther )->uxPriority ) ||                   \
+      ( ( ( pxTCB )->uxPriority == ( pxOther )->uxPriority ) &&                \
+        ( taskEDF_SORT_KEY( pxTCB ) < taskEDF_SORT_KEY( pxOther ) ) ) )
+
+    #else /* configUSE_EDF */
+
+/* pdTRUE if pxTCB has a priority above pxOther. */
+        #define taskRANKS_ABOVE( pxTCB, pxOther )    ( ( pxTCB )->uxPriority > ( pxOther )->uxPriority )
+
+    #endif /* configUSE_EDF */
+
+    #define taskREADY_LIST( uxPriority, pxTCB )          ( &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+    #define taskRECORD_READY_PERIOD( pxTCB )
+    #define taskRESET_READY_TASK( pxTCB, uxPriority )    taskRESET_READY_PRIORITY( uxPriority )
+    #define taskREADY_TASKS_AT_PRIORITY( uxPriority )    listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+
+#endif /* configUSE_RM */
+
+/* pdTRUE if pxTCB, which has just been made Ready, comes before the running
+ * task, which keeps the processor on a tie.  Every path that readies a task
+ * uses this to decide whether to yield. */
+#define taskPREEMPTS_CURRENT( pxTCB )    taskRANKS_ABOVE( ( pxTCB ), pxCurrentTCB )
+
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -151,6 +253,57 @@
         uxTopReadyPriority = uxTopPriority;                                                   \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_RM == 1 )
+
+/* Without a port optimised bit scan the period bitmap is searched from the
+ * shortest period down, which is bounded by configRM_MAX_DISTINCT_PERIODS
+ * rather than by the number of ready tasks. */
+        #define taskSELECT_TASK_RM()                                                                            \
+    {                                                                                                           \
+        UBaseType_t uxTopPriority = uxTopReadyPriority;                                                         \
+        UBaseType_t uxTopPeriod = ( UBaseType_t ) ( configRM_MAX_DISTINCT_PERIODS - 1 );                        \
+                                                                                                                \
+        /* Find the highest priority level that contains ready tasks. */                                        \
+        while( uxReadyPeriods[ uxTopPriority ] == ( UBaseType_t ) 0 )                                           \
+        {                                                                                                       \
+            configASSERT( uxTopPriority );                                                                      \
+            --uxTopPriority;                                                                                    \
+        }                                                                                                       \
+                                                                                                                \
+        /* Then the shortest period at that level. */                                                           \
+        while( ( uxReadyPeriods[ uxTopPriority ] & ( ( UBaseType_t ) 1U << uxTopPeriod ) ) == ( UBaseType_t ) 0 ) \
+        {                                                                                                       \
+            --uxTopPeriod;                                                                                      \
+        }                                                                                                       \
+                                                                                                                \
+        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ][ uxTopPeriod ] ) );    \
+        uxTopReadyPriority = uxTopPriority;                                                                     \
+    } /* taskSELECT_TASK_RM */
+
+    #endif /* configUSE_RM */
+
+    #if ( configUSE_EDF == 1 )
+
+/* The ready lists are kept in deadline order, so the first task of the highest
+ * priority list that is not empty has the earliest deadline. */
+        #define taskSELECT_TASK_EDF()                                                     \
+    {                                                                                     \
+        UBaseType_t uxTopPriority = uxTopReadyPriority;                                   \
+                                                                                          \
+        while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopPriority ] ) ) )             \
+        {                                                                                 \
+            configASSERT( uxTopPriority );                                                \
+            --uxTopPriority;                                                              \
+        }                                                                                 \
+                                                                                          \
+        pxCurrentTCB = listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ uxTopPriority ] ) ); \
+        uxTopReadyPriority = uxTopPriority;                                               \
+    } /* taskSELECT_TASK_EDF */
+
+    #endif /* configUSE_EDF */
+
 /*-----------------------------------------------------------*/
 
 /* Define away taskRESET_READY_PRIORITY() and portRESET_READY_PRIORITY() as
@@ -181,40 +334,36 @@
     listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );   \
 } /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
-#define taskSELECT_TASK_RM()                                                                    \
-    {                                                                                           \
-    UBaseType_t uxTopPriority = uxTopReadyPriority;                                             \
-    int overallPriority = 100;       /* Initialize to the maximum value possible. */            \
-    int tempOverallPriority = 0;                                                                \
-    ListItem_t* highestPriorityBurst = NULL;                                                    \
-                                                                                                \
-    /* Find the highest priority queue that contains ready tasks. */                            \
-    portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                              \
-    configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );     \
-                                                                                                \
-    /* Following code obtained and adapted from listGET_OWNER_OF_NEXT_ENTRY */                  \
-    List_t* pxConstList = &(pxReadyTasksLists[uxTopPriority]);                                  \
-                                                                                                \
-    /* We want to start by looking always at the first task => listGET_HEAD_ENTRY */            \
-    /* pxIndex = Used to walk through the List_t, point to a xLIST_ITEM*/                       \
-    /* pvOwner = pointer to the TCB. It is contained in the xLIST_ITEM */                       \
-    ListItem_t* pxListItem = listGET_HEAD_ENTRY(pxConstList); /*return ListItem */              \
-                                                                                                \
-    for(UBaseType_t i = 0; i < listCURRENT_LIST_LENGTH( pxConstList); i++){                     \
-        ( pxCurrentTCB ) = ( pxListItem )->pvOwner;                                             \
-        tempOverallPriority = ( pxCurrentTCB )->period;                                         \
-        if( tempOverallPriority < overallPriority){                                             \
-            overallPriority = tempOverallPriority;                                              \
-            highestPriorityBurst = pxListItem;                                                  \
-        }                                                                                       \
-        pxListItem = ( pxListItem )->pxNext; /* Move to the next list item */                   \
-    }                                                                                           \
-                                                                                                \
-    /* To select the correct task to run */                                                     \
-    if(highestPriorityBurst != NULL) {                                                          \
-        ( pxCurrentTCB ) = ( highestPriorityBurst )->pvOwner;                                   \
-    }                                                                                           \
-}                                              
+    #if ( configUSE_RM == 1 )
+
+/* Find the highest priority level that holds ready tasks, then the shortest
+ * period at that level, using the same find-highest-set-bit instruction that
+ * selects priorities.  Both lookups are constant time. */
+        #define taskSELECT_TASK_RM()                                                                \
+    {                                                                                               \
+        UBaseType_t uxTopPriority;                                                                  \
+        UBaseType_t uxTopPeriod;                                                                    \
+                                                                                                    \
+        portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                              \
+        portGET_HIGHEST_PRIORITY( uxTopPeriod, uxReadyPeriods[ uxTopPriority ] );                   \
+        configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ][ uxTopPeriod ] ) ) > 0 ); \
+        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ][ uxTopPeriod ] ) );   \
+    } /* taskSELECT_TASK_RM() */
+
+    #endif /* configUSE_RM */
+
+    #if ( configUSE_EDF == 1 )
+
+        #define taskSELECT_TASK_EDF()                                                                      \
+    {                                                                                                      \
+        UBaseType_t uxTopPriority;                                                                         \
+                                                                                                           \
+        portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                                     \
+        configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );            \
+        pxCurrentTCB = listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ uxTopPriority ] ) );             \
+    } /* taskSELECT_TASK_EDF() */
+
+    #endif /* configUSE_EDF */
 
 /*-----------------------------------------------------------*/
 
@@ -235,31 +384,72 @@
 
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
  * count overflows. */
-#define taskSWITCH_DELAYED_LISTS()                                                \
-    {                                                                             \
-        List_t * pxTemp;                                                          \
-                                                                                  \
-        /* The delayed tasks list should be empty when the lists are switched. */ \
-        configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );               \
-                                                                                  \
-        pxTemp = pxDelayedTaskList;                                               \
-        pxDelayedTaskList = pxOverflowDelayedTaskList;                            \
-        pxOverflowDelayedTaskList = pxTemp;                                       \
-        xNumOfOverflows++;                                                        \
-        prvResetNextTaskUnblockTime();                                            \
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+/* The delay wheel is indexed by the low bits of the tick count so is not
+ * affected by the overflow, but every level of it starts a new turn on tick 0.
+ * That tick must be processed, so xNextTaskUnblockTime is set to it. */
+    #define taskSWITCH_DELAYED_LISTS()                                                \
+    {                                                                                 \
+        List_t * pxTemp;                                                              \
+                                                                                      \
+        /* The delayed tasks list should be empty when the lists are switched. */     \
+        configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );                   \
+                                                                                      \
+        pxTemp = pxDelayedTaskList;                                                   \
+        pxDelayedTaskList = pxOverflowDelayedTaskList;                                \
+        pxOverflowDelayedTaskList = pxTemp;                                           \
+        xNumOfOverflows++;                                                            \
+        xNextTaskUnblockTime = ( TickType_t ) 0U;                                     \
     }
 
+#else
+
+    #define taskSWITCH_DELAYED_LISTS()                                                \
+    {                                                                                 \
+        List_t * pxTemp;                                                              \
+                                                                                      \
+        /* The delayed tasks list should be empty when the lists are switched. */     \
+        configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );                   \
+                                                                                      \
+        pxTemp = pxDelayedTaskList;                                                   \
+        pxDelayedTaskList = pxOverflowDelayedTaskList;                                \
+        pxOverflowDelayedTaskList = pxTemp;                                           \
+        xNumOfOverflows++;                                                            \
+        prvResetNextTaskUnblockTime();                                                \
+    }
+
+#endif /* configUSE_DELAY_WHEEL */
+
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF == 1 )
+
+/*
+ * Place the task represented by pxTCB into the ready list for its priority,
+ * in order of the deadline of its current job.
+ */
+    #define prvAddTaskToReadyList( pxTCB )                 \
+    traceMOVED_TASK_TO_READY_STATE( pxTCB );               \
+    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );    \
+    prvSetReadyDeadline( pxTCB );                          \
+    prvInsertTaskByDeadline( pxTCB );                      \
+    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+
+#else
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
  */
-#define prvAddTaskToReadyList( pxTCB )                                                                 \
+    #define prvAddTaskToReadyList( pxTCB )                                                                 \
     traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
     taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
-    listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+    taskRECORD_READY_PERIOD( pxTCB );                                                                  \
+    listINSERT_END( taskREADY_LIST( ( pxTCB )->uxPriority, ( pxTCB ) ), &( ( pxTCB )->xStateListItem ) ); \
     tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+
+#endif /* configUSE_EDF */
 /*-----------------------------------------------------------*/
 
 /*
@@ -270,6 +460,197 @@
  */
 #define prvGetTCBFromHandle( pxHandle )    ( ( ( pxHandle ) == NULL ) ? pxCurrentTCB : ( pxHandle ) )
 
+#if ( ( configUSE_EDF == 1 ) && ( configUSE_RM == 1 ) )
+    #error configUSE_EDF and configUSE_RM cannot both be set to 1.
+#endif
+
+#if ( configUSE_RM_AUTO_PRIORITY == 1 )
+
+    #if ( ( configUSE_RM == 1 ) || ( configUSE_EDF == 1 ) )
+        #error configUSE_RM_AUTO_PRIORITY replaces the period ordered ready lists, so configUSE_RM and configUSE_EDF must be set to 0.
+    #endif
+
+    #if ( ( configRM_AUTO_PRIORITY_LOWEST > configRM_AUTO_PRIORITY_HIGHEST ) || ( configRM_AUTO_PRIORITY_HIGHEST >= configMAX_PRIORITIES ) )
+        #error configRM_AUTO_PRIORITY_LOWEST must not be above configRM_AUTO_PRIORITY_HIGHEST, which must be less than configMAX_PRIORITIES.
+    #endif
+
+#endif
+
+#if ( configUSE_RM_ADMISSION_CONTROL == 1 )
+
+    #if ( ( configUSE_RM == 0 ) || ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) || ( INCLUDE_xTaskDelayUntil == 0 ) )
+        #error configUSE_RM_ADMISSION_CONTROL requires configUSE_RM, configSUPPORT_DYNAMIC_ALLOCATION and INCLUDE_xTaskDelayUntil to be set to 1.
+    #endif
+
+/* Utilisation is held in fixed point, taskRM_UTILISATION_SCALE being 100%.
+ * It is rounded up so the sum never under estimates the real load.  The
+ * product is taken in 64 bits as bursts can be long in ticks. */
+    #define taskRM_UTILISATION_SCALE    ( ( uint32_t ) 10000U )
+    #define taskRM_UTILISATION( xBurst, xPeriod )    ( ( uint32_t ) ( ( ( ( uint64_t ) ( xBurst ) * taskRM_UTILISATION_SCALE ) + ( uint64_t ) ( xPeriod ) - 1U ) / ( uint64_t ) ( xPeriod ) ) )
+
+/* pdTRUE if a job of task A can delay a job of task B.  Priority comes first,
+ * then the shorter period.  Tasks with the same priority and period share the
+ * processor, so each can delay the other. */
+    #define taskRM_CAN_DELAY( uxPriorityA, xPeriodA, uxPriorityB, xPeriodB ) \
+    ( ( ( uxPriorityA ) > ( uxPriorityB ) ) || ( ( ( uxPriorityA ) == ( uxPriorityB ) ) && ( ( xPeriodA ) <= ( xPeriodB ) ) ) )
+
+/* How long after its release a job of an admitted task can start and still
+ * run its whole burst before its next release.  An aperiodic server keeps its
+ * budget while it waits for work, so it can run a burst at the end of one
+ * period and another at the start of the next. */
+    #if ( configUSE_APERIODIC_SERVER == 1 )
+        #define taskRM_RELEASE_JITTER( pxTCB )    ( ( ( pxTCB )->pxAperiodicServer != NULL ) ? ( ( pxTCB )->xPeriod - ( pxTCB )->xCpuBurst ) : ( TickType_t ) 0U )
+    #else
+        #define taskRM_RELEASE_JITTER( pxTCB )    ( ( TickType_t ) 0U )
+    #endif
+
+/* pdTRUE if a job can be blocked by a mutex ceiling. */
+    #if ( configUSE_MUTEX_CEILING == 1 )
+        #define taskMUTEX_CEILINGS_IN_USE()    ( ( pxMutexCeilings != NULL ) ? pdTRUE : pdFALSE )
+    #else
+        #define taskMUTEX_CEILINGS_IN_USE()    pdFALSE
+    #endif
+
+#endif /* configUSE_RM_ADMISSION_CONTROL */
+
+#if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) || ( INCLUDE_xTaskDelayUntil == 0 ) )
+        #error configUSE_DEADLINE_MISS_DETECTION requires configSUPPORT_DYNAMIC_ALLOCATION and INCLUDE_xTaskDelayUntil to be set to 1.
+    #endif
+
+    #if ( ( configDEADLINE_MISS_POLICY == pdDEADLINE_MISS_ABORT ) && ( INCLUDE_xTaskAbortDelay == 0 ) )
+        #error configDEADLINE_MISS_POLICY pdDEADLINE_MISS_ABORT requires INCLUDE_xTaskAbortDelay to be set to 1.
+    #endif
+
+#endif /* configUSE_DEADLINE_MISS_DETECTION */
+
+#if ( configUSE_BUDGET_ENFORCEMENT == 1 )
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) || ( INCLUDE_xTaskDelayUntil == 0 ) || ( configGENERATE_RUN_TIME_STATS == 0 ) )
+        #error configUSE_BUDGET_ENFORCEMENT requires configSUPPORT_DYNAMIC_ALLOCATION, INCLUDE_xTaskDelayUntil and configGENERATE_RUN_TIME_STATS to be set to 1.
+    #endif
+
+    #ifndef configRUN_TIME_COUNTS_PER_TICK
+        #error configUSE_BUDGET_ENFORCEMENT requires configRUN_TIME_COUNTS_PER_TICK to be defined as the number of run time counter increments in one tick.
+    #endif
+
+#endif /* configUSE_BUDGET_ENFORCEMENT */
+
+#if ( configUSE_APERIODIC_SERVER == 1 )
+
+    #if ( ( configUSE_BUDGET_ENFORCEMENT == 0 ) || ( configUSE_TASK_NOTIFICATIONS == 0 ) )
+        #error configUSE_APERIODIC_SERVER requires configUSE_BUDGET_ENFORCEMENT and configUSE_TASK_NOTIFICATIONS to be set to 1.
+    #endif
+
+#endif /* configUSE_APERIODIC_SERVER */
+
+#if ( configUSE_SPORADIC_TASKS == 1 )
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) || ( INCLUDE_xTaskDelayUntil == 0 ) || ( configUSE_TASK_NOTIFICATIONS == 0 ) )
+        #error configUSE_SPORADIC_TASKS requires configSUPPORT_DYNAMIC_ALLOCATION, INCLUDE_xTaskDelayUntil and configUSE_TASK_NOTIFICATIONS to be set to 1.
+    #endif
+
+#endif /* configUSE_SPORADIC_TASKS */
+
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+/* Each level of the delay wheel has 32 slots, one bit of a uint32_t bitmap
+ * each.  The span of the whole wheel must fit in TickType_t. */
+    #define taskWHEEL_SLOT_BITS    ( 5U )
+    #define taskWHEEL_SLOTS        ( 1U << taskWHEEL_SLOT_BITS )
+    #define taskWHEEL_SLOT_MASK    ( ( UBaseType_t ) taskWHEEL_SLOTS - ( UBaseType_t ) 1U )
+
+    #if ( configDELAY_WHEEL_LEVELS < 1 )
+        #error configDELAY_WHEEL_LEVELS must be at least 1.
+    #elif ( ( configUSE_16_BIT_TICKS == 1 ) && ( configDELAY_WHEEL_LEVELS > 3 ) )
+        #error configDELAY_WHEEL_LEVELS must be no more than 3 when configUSE_16_BIT_TICKS is 1.
+    #elif ( configDELAY_WHEEL_LEVELS > 6 )
+        #error configDELAY_WHEEL_LEVELS must be no more than 6.
+    #endif
+
+/* The first tick of the span of the slot at uxLevel that holds xTime.  When
+ * uxLevel is configDELAY_WHEEL_LEVELS this is the first tick of the turn of
+ * the whole wheel. */
+    #define taskWHEEL_SPAN_START( xTime, uxLevel ) \
+    ( ( xTime ) & ~( ( TickType_t ) ( ( ( TickType_t ) 1U << ( ( uxLevel ) * taskWHEEL_SLOT_BITS ) ) - ( TickType_t ) 1U ) ) )
+
+/* The slot at uxLevel that holds xTime. */
+    #define taskWHEEL_SLOT( xTime, uxLevel ) \
+    ( ( UBaseType_t ) ( ( xTime ) >> ( ( uxLevel ) * taskWHEEL_SLOT_BITS ) ) & taskWHEEL_SLOT_MASK )
+
+/* pdTRUE if pxList is a slot of the delay wheel. */
+    #define taskIS_DELAY_WHEEL_SLOT( pxList )                                                                  \
+    ( ( ( ( pxList ) >= &( xDelayWheel[ 0 ][ 0 ] ) ) &&                                                        \
+        ( ( pxList ) <= &( xDelayWheel[ configDELAY_WHEEL_LEVELS - 1 ][ taskWHEEL_SLOTS - 1U ] ) ) ) ? pdTRUE : pdFALSE ) /*lint !e946 The pointers are only compared to find whether pxList is in the array. */
+
+#endif /* configUSE_DELAY_WHEEL */
+
+#if ( configUSE_IDLE_TIME_STATS == 1 )
+    #if ( configIDLE_TIME_WINDOW_TICKS < 10 )
+        #error configIDLE_TIME_WINDOW_TICKS must be at least 10 as the idle time window is divided into ten slots.
+    #endif
+#endif /* configUSE_IDLE_TIME_STATS */
+
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
+
+/* A job deadline or release further ahead of the tick count than this is taken
+ * to have already passed, so the deadline of a job must be less than half the
+ * range of TickType_t after its release. */
+    #define taskMAX_JOB_TICKS_AHEAD    ( ( TickType_t ) ( portMAX_DELAY >> 1 ) )
+
+/* The kinds of task created by prvCreatePeriodicTask(). */
+    #define taskJOBS_PERIODIC    ( ( uint8_t ) 0U )
+    #define taskJOBS_SERVER      ( ( uint8_t ) 1U )
+    #define taskJOBS_SPORADIC    ( ( uint8_t ) 2U )
+
+/* pdTRUE if the jobs of pxTCB are released by notifications rather than by
+ * the tick count. */
+    #if ( configUSE_SPORADIC_TASKS == 1 )
+        #define taskIS_SPORADIC( pxTCB )    ( ( BaseType_t ) ( pxTCB )->ucSporadic )
+    #else
+        #define taskIS_SPORADIC( pxTCB )    pdFALSE
+    #endif
+
+/* pdTRUE if the jobs of pxTCB have a deadline set when they are released.  A
+ * sporadic task has its deadline set when a notification releases the job.  An
+ * aperiodic server has none, as its job lasts the whole period so it can run
+ * work submitted at any time in it.  The deadline given to the server is only
+ * used to admit it. */
+    #if ( configUSE_APERIODIC_SERVER == 1 )
+        #define taskHAS_RELEASE_DEADLINE( pxTCB )    ( ( ( taskIS_SPORADIC( pxTCB ) == pdFALSE ) && ( ( pxTCB )->pxAperiodicServer == NULL ) ) ? pdTRUE : pdFALSE )
+    #else
+        #define taskHAS_RELEASE_DEADLINE( pxTCB )    ( ( taskIS_SPORADIC( pxTCB ) == pdFALSE ) ? pdTRUE : pdFALSE )
+    #endif
+
+/* pdTRUE if pxTCB is a periodic task whose next release is still to come,
+ * either because its job is complete or because it was stopped for running
+ * out of budget.  The job that is running or ready was always released at or
+ * before the tick count. */
+    #define taskIS_WAITING_FOR_RELEASE( pxTCB )                                                         \
+    ( ( ( ( pxTCB )->pxJobCode != NULL ) && ( ( pxTCB )->xReleaseTime != xTickCount ) &&                \
+        ( ( TickType_t ) ( ( pxTCB )->xReleaseTime - xTickCount ) <= taskMAX_JOB_TICKS_AHEAD ) ) ? pdTRUE : pdFALSE )
+
+#else
+    #define taskIS_WAITING_FOR_RELEASE( pxTCB )    pdFALSE
+#endif
+
+/* A notification to a sporadic task that is waiting for one releases a job,
+ * so the release time is taken before the task is made ready.  Notifications
+ * given while the task is held back by its minimum inter-arrival time stay
+ * pending, and the job is released at the end of the wait. */
+#if ( configUSE_SPORADIC_TASKS == 1 )
+    #define taskRELEASE_SPORADIC_JOB( pxTCB, uxIndexToNotify )                                                  \
+    do {                                                                                                    \
+        if( ( ( pxTCB )->ucSporadic != pdFALSE ) && ( ( uxIndexToNotify ) == tskDEFAULT_INDEX_TO_NOTIFY ) ) \
+        {                                                                                                   \
+            ( pxTCB )->xReleaseTime = xTickCount;                                                           \
+        }                                                                                                   \
+    } while( 0 )
+#else
+    #define taskRELEASE_SPORADIC_JOB( pxTCB, uxIndexToNotify )
+#endif
+
 /* The item value of the event list item is normally used to hold the priority
  * of the task to which it belongs (coded to allow it to be held in reverse
  * priority order).  However, it is occasionally borrowed for other purposes.  It
@@ -356,10 +737,62 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         int iTaskErrno;
     #endif
 
-    
-    int CpuBurst;
-    int period;
+    TickType_t xCpuBurst; /*< Worst case execution time of one job, in ticks. */
+    TickType_t xPeriod;   /*< Ticks between releases.  portMAX_DELAY for a task without a period. */
+    TickType_t xDeadline; /*< Ticks from a release by which its job must be complete. */
+
+    #if ( configUSE_RM == 1 )
+        UBaseType_t uxPeriodClass; /*< Index of the entry of xPeriodClasses[] that holds the rank of the task's period. */
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
+        TaskFunction_t pxJobCode; /*< The function run once per release by a task created with xTaskCreatePeriodic(), NULL for other tasks. */
+        TickType_t xReleaseTime;  /*< The time at which the current job of a periodic task was released. */
+    #endif
+
+    #if ( configUSE_RM_ADMISSION_CONTROL == 1 )
+        ListItem_t xAdmissionListItem; /*< Used to reference the task from xAdmittedTasksList.  The item value holds the priority the task was admitted at. */
+    #endif
+
+    #if ( configUSE_RM_AUTO_PRIORITY == 1 )
+        ListItem_t xRateListItem; /*< Used to reference a task with a period from xRateOrderedTasksList.  The item value holds the period. */
+    #endif
+
+    #if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+        ListItem_t xDeadlineListItem; /*< Used to reference the task from a deadline list while its current job is running.  The item value holds the absolute deadline of the job. */
+        UBaseType_t uxDeadlineMisses; /*< The number of jobs of the task that have missed their deadline. */
+        uint8_t ucJobMissed;          /*< Set to pdTRUE when the current job has missed its deadline. */
+    #endif
+
+    #if ( configUSE_BUDGET_ENFORCEMENT == 1 )
+        configRUN_TIME_COUNTER_TYPE ulJobRunTime; /*< Run time counter increments used by the current job, up to the last time the task was switched out. */
+    #endif
+
+    #if ( ( configUSE_RM == 1 ) && ( configUSE_MUTEX_CEILING == 1 ) )
+        UBaseType_t uxBasePeriodClass; /*< The period class of the task's own period.  uxPeriodClass differs while the task runs at a mutex ceiling. */
+    #endif
+
+    #if ( configUSE_APERIODIC_SERVER == 1 )
+        struct tskAperiodicServer * pxAperiodicServer; /*< The jobs waiting for the task if it was created by xTaskCreateAperiodicServer(), otherwise NULL. */
+    #endif
+
+    #if ( configUSE_SPORADIC_TASKS == 1 )
+        uint8_t ucSporadic; /*< Set to pdTRUE if the task was created by xTaskCreateSporadic(). */
+    #endif
+
+    #if ( configUSE_RELEASE_JITTER_STATS == 1 )
+        UBaseType_t uxReleases;        /*< The number of releases whose jitter has been recorded. */
+        TickType_t xMinReleaseJitter;  /*< The fewest ticks after its release time a job was made ready. */
+        TickType_t xMaxReleaseJitter;  /*< The most ticks after its release time a job was made ready. */
+        uint64_t ullReleaseJitterSum;  /*< The total of the recorded jitter, for the average. */
+    #endif
 
+    #if ( configUSE_JOB_STATS == 1 )
+        UBaseType_t uxJobsReleased;    /*< Written only where a job is released, with interrupts masked or from the tick interrupt. */
+        UBaseType_t uxJobsCompleted;   /*< Written only by the task itself. */
+        UBaseType_t uxPreemptions;     /*< Written only by vTaskSwitchContext(). */
+        TickType_t xWorstResponseTime; /*< Written only by the task itself. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -374,13 +807,210 @@ portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
  * xDelayedTaskList1 and xDelayedTaskList2 could be moved to function scope but
  * doing so breaks some kernel aware debuggers and debuggers that rely on removing
  * the static qualifier. */
-PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /*< Prioritised ready tasks. */
+#if ( configUSE_RM == 1 )
+
+/* One period in use by at least one task.  Entries are kept in place while in
+ * use so tasks can reference them by index, only the rank moves. */
+    typedef struct tskPeriodClass
+    {
+        TickType_t xPeriod; /*< The period shared by the tasks of this class. */
+        UBaseType_t uxRank; /*< Index into pxReadyTasksLists[ priority ] and bit in uxReadyPeriods[ priority ].  Higher for shorter periods. */
+        UBaseType_t uxTasks; /*< The number of tasks with this period.  The entry is free when zero. */
+    } PeriodClass_t;
+
+    PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ][ configRM_MAX_DISTINCT_PERIODS ]; /*< Ready tasks by priority, then by period rank. */
+    PRIVILEGED_DATA static volatile UBaseType_t uxReadyPeriods[ configMAX_PRIORITIES ];                       /*< Per priority bitmap of the period lists that hold ready tasks. */
+    PRIVILEGED_DATA static PeriodClass_t xPeriodClasses[ configRM_MAX_DISTINCT_PERIODS ];                     /*< The periods in use. */
+    PRIVILEGED_DATA static UBaseType_t uxPeriodClassesInUse = ( UBaseType_t ) 0U;                            /*< The number of used entries in xPeriodClasses[], which is also the number of ranks. */
+#else
+    PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /*< Prioritised ready tasks. */
+#endif
 PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /*< Delayed tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
+#if ( configUSE_RM_AUTO_PRIORITY == 1 )
+
+    PRIVILEGED_DATA static List_t xRateOrderedTasksList; /*< The tasks that have a period, shortest period first. */
+
+#endif
+
+#if ( configUSE_TASK_POOLS == 1 )
+
+/* The stack classes of the task pools. */
+    #define taskPOOL_STACK_CLASSES    ( 3U )
+
+/* The bytes taken by a pooled stack of uxDepth words, rounded up so every
+ * stack starts on a portBYTE_ALIGNMENT boundary. */
+    #define taskPOOL_STACK_BYTES( uxDepth ) \
+    ( ( ( ( size_t ) ( uxDepth ) * sizeof( StackType_t ) ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+    #define taskPOOL_STACK_AREA_BYTES                                                            \
+    ( ( taskPOOL_STACK_BYTES( configTASK_POOL_STACK_DEPTH_1 ) * configTASK_POOL_STACKS_1 ) + \
+      ( taskPOOL_STACK_BYTES( configTASK_POOL_STACK_DEPTH_2 ) * configTASK_POOL_STACKS_2 ) + \
+      ( taskPOOL_STACK_BYTES( configTASK_POOL_STACK_DEPTH_3 ) * configTASK_POOL_STACKS_3 ) )
+
+/* A pool of equal sized blocks.  The free blocks are linked through their
+ * first bytes, so taking and giving back a block does not search. */
+    typedef struct tskBlockPool
+    {
+        void * pvFreeBlocks;     /*< The first free block, or NULL if every block is in use. */
+        uint8_t * pucFirstBlock; /*< The start of the blocks, to recognise a block of the pool when it is given back. */
+        uint8_t * pucEnd;        /*< One past the last block. */
+        size_t xBlockSize;       /*< The bytes in each block. */
+    } BlockPool_t;
+
+    PRIVILEGED_DATA static TCB_t xPooledTCBs[ configTASK_POOL_TCBS ];                                           /*< The blocks of xTCBPool. */
+    PRIVILEGED_DATA static uint8_t ucPooledStacks[ taskPOOL_STACK_AREA_BYTES + ( size_t ) portBYTE_ALIGNMENT ]; /*< The blocks of xStackPools[], with room to align the first one. */
+    PRIVILEGED_DATA static BlockPool_t xTCBPool;                                                                /*< The free TCBs. */
+    PRIVILEGED_DATA static BlockPool_t xStackPools[ taskPOOL_STACK_CLASSES ];                                   /*< The free stacks of each class, smallest first. */
+    PRIVILEGED_DATA static BaseType_t xTaskPoolsInitialised = pdFALSE;                                          /*< Set once the free lists have been built. */
+
+    #define taskALLOCATE_TCB()               ( ( TCB_t * ) prvAllocateFromTaskPool( &xTCBPool, ( size_t ) 1U, sizeof( TCB_t ) ) )
+    #define taskALLOCATE_STACK( usDepth )    ( ( StackType_t * ) prvAllocateFromTaskPool( xStackPools, ( size_t ) taskPOOL_STACK_CLASSES, ( ( size_t ) ( usDepth ) ) * sizeof( StackType_t ) ) )
+    #define taskFREE_TCB( pxTCB )            prvFreeToTaskPool( &xTCBPool, ( size_t ) 1U, ( void * ) ( pxTCB ) )
+    #define taskFREE_STACK( pxStack )        prvFreeToTaskPool( xStackPools, ( size_t ) taskPOOL_STACK_CLASSES, ( void * ) ( pxStack ) )
+
+#else /* configUSE_TASK_POOLS */
+
+    #define taskALLOCATE_TCB()               ( ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ) )
+    #define taskALLOCATE_STACK( usDepth )    ( ( StackType_t * ) pvPortMallocStack( ( ( size_t ) ( usDepth ) ) * sizeof( StackType_t ) ) )
+    #define taskFREE_TCB( pxTCB )            vPortFree( pxTCB )
+    #define taskFREE_STACK( pxStack )        vPortFreeStack( pxStack )
+
+#endif /* configUSE_TASK_POOLS */
+
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+    PRIVILEGED_DATA static List_t xDelayWheel[ configDELAY_WHEEL_LEVELS ][ taskWHEEL_SLOTS ]; /*< Delayed tasks that wake within the span of the wheel, by level then slot.  Longer delays are held in pxDelayedTaskList. */
+    PRIVILEGED_DATA static uint32_t ulDelayWheelSlots[ configDELAY_WHEEL_LEVELS ];           /*< Per level bitmap of the slots that may hold tasks.  A bit can be left set after its slot is emptied. */
+
+#endif
+
+#if ( configUSE_RM_ADMISSION_CONTROL == 1 )
+
+    PRIVILEGED_DATA static List_t xAdmittedTasksList;                         /*< Periodic tasks accepted by admission control. */
+    PRIVILEGED_DATA static uint32_t ulAdmittedUtilisation = 0U;               /*< Sum of the utilisation of the tasks in xAdmittedTasksList. */
+    PRIVILEGED_DATA static UBaseType_t uxAdmittedPriority = tskIDLE_PRIORITY; /*< The priority of the admitted tasks while they all have the same one. */
+    PRIVILEGED_DATA static BaseType_t xAdmittedPrioritiesDiffer = pdFALSE;    /*< Set when the admitted tasks do not all have the same priority. */
+    PRIVILEGED_DATA static UBaseType_t uxAdmittedConstrainedDeadlines = 0U;   /*< The number of admitted tasks with a deadline shorter than their period. */
+    PRIVILEGED_DATA static UBaseType_t uxAdmittedJitteredTasks = 0U;          /*< The number of admitted tasks, aperiodic servers, that can start a job after its release. */
+
+#endif
+
+#if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+
+    PRIVILEGED_DATA static List_t xDeadlineList1;                    /*< Deadlines of running jobs. */
+    PRIVILEGED_DATA static List_t xDeadlineList2;                    /*< Deadlines of running jobs (two lists are used - one for deadlines that have overflowed the current tick count. */
+    PRIVILEGED_DATA static List_t * volatile pxDeadlineList;         /*< Points to the deadline list currently being used. */
+    PRIVILEGED_DATA static List_t * volatile pxOverflowDeadlineList; /*< Points to the deadline list currently being used to hold deadlines that have overflowed the current tick count. */
+
+#endif
+
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) && ( configUSE_DELAY_WHEEL == 0 ) )
+
+    PRIVILEGED_DATA static List_t xJobReleaseList1;                    /*< Periodic tasks waiting for the release of their next job. */
+    PRIVILEGED_DATA static List_t xJobReleaseList2;                    /*< Periodic tasks waiting for the release of their next job (two lists are used - one for releases that have overflowed the current tick count. */
+    PRIVILEGED_DATA static List_t * volatile pxJobReleaseList;         /*< Points to the release list currently being used. */
+    PRIVILEGED_DATA static List_t * volatile pxOverflowJobReleaseList; /*< Points to the release list currently being used to hold releases that have overflowed the current tick count. */
+
+#endif
+
+#if ( configUSE_MUTEX_CEILING == 1 )
+
+/* The ceiling of a mutex created by xQueueCreateMutexWithCeiling(). */
+    typedef struct tskMutexCeiling
+    {
+        struct tskMutexCeiling * pxNext; /*< The next ceiling in pxMutexCeilings. */
+        UBaseType_t uxPriority;          /*< The highest priority of the tasks that take the mutex. */
+        TickType_t xPeriod;              /*< The shortest period of the tasks at uxPriority that take the mutex. */
+        TickType_t xLongestHold;         /*< The longest time the mutex is held, which bounds the blocking it causes. */
+        #if ( configUSE_RM == 1 )
+            UBaseType_t uxPeriodClass;   /*< The period class a holder runs in, taskRM_CEILING_CLASS_UNSET until the mutex is first taken. */
+        #endif
+    } MutexCeiling_t;
+
+    PRIVILEGED_DATA static MutexCeiling_t * pxMutexCeilings = NULL; /*< Every ceiling in use.  Read by admission control. */
+
+#endif
+
+#if ( configUSE_APERIODIC_SERVER == 1 )
+
+/* A job submitted to an aperiodic server. */
+    typedef struct tskAperiodicJob
+    {
+        TaskFunction_t pxJobCode; /*< The function that does the work of the job. */
+        void * pvParameters;      /*< Passed to pxJobCode. */
+    } AperiodicJob_t;
+
+/* The jobs waiting for an aperiodic server.  The ring of jobs is allocated
+ * in the same block, straight after the structure. */
+    typedef struct tskAperiodicServer
+    {
+        AperiodicJob_t * pxJobs; /*< The ring of uxLength jobs. */
+        UBaseType_t uxLength;    /*< The number of jobs the ring can hold. */
+        UBaseType_t uxHead;      /*< The index of the oldest waiting job. */
+        UBaseType_t uxWaiting;   /*< The number of jobs waiting. */
+    } AperiodicServer_t;
+
+#endif
+
+#if ( configUSE_SCHEDULE_TRACE == 1 )
+
+/* Events are timestamped with the tick count unless the application provides
+ * a finer clock. */
+    #ifndef configSCHEDULE_TRACE_TIMESTAMP
+        #define configSCHEDULE_TRACE_TIMESTAMP()    ( ( uint32_t ) xTickCount )
+    #endif
+
+    PRIVILEGED_DATA static ScheduleTraceEntry_t xScheduleTrace[ configSCHEDULE_TRACE_LENGTH ]; /*< The ring of recorded events. */
+    PRIVILEGED_DATA static UBaseType_t uxScheduleTraceNext = ( UBaseType_t ) 0U;              /*< The entry the next event is written to. */
+    PRIVILEGED_DATA static UBaseType_t uxScheduleTraceCount = ( UBaseType_t ) 0U;             /*< The number of events not yet read. */
+    PRIVILEGED_DATA static UBaseType_t uxScheduleTraceLost = ( UBaseType_t ) 0U;              /*< The number of events overwritten before being read. */
+    PRIVILEGED_DATA static TCB_t * pxScheduleTraceSwitchedOut = NULL;                         /*< The task that was running when the current context switch started. */
+
+/* The most events uxTaskGetScheduleTrace() moves inside one critical section. */
+    #define taskSCHEDULE_TRACE_COPY_LENGTH    ( ( UBaseType_t ) 8U )
+
+#endif
+
+#if ( configUSE_IDLE_TIME_STATS == 1 )
+
+/* The idle time window is kept as a ring of slots, so it slides forward one
+ * slot at a time without the per-tick history being stored.  Each slot is
+ * taskIDLE_TIME_SLOT_TICKS long.  The time within it is measured with the run
+ * time counter if configGENERATE_RUN_TIME_STATS is 1, and otherwise in ticks
+ * sampled by the tick interrupt. */
+    #define taskIDLE_TIME_SLOTS         ( 10U )
+    #define taskIDLE_TIME_SLOT_TICKS    ( ( TickType_t ) ( configIDLE_TIME_WINDOW_TICKS / taskIDLE_TIME_SLOTS ) )
+
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        typedef configRUN_TIME_COUNTER_TYPE IdleTime_t;
+    #else
+        typedef TickType_t IdleTime_t;
+    #endif
+
+    PRIVILEGED_DATA static volatile TickType_t xIdleTicks = ( TickType_t ) 0U;       /*< The ticks during which the idle task was running. */
+    PRIVILEGED_DATA static IdleTime_t xIdleSlotIdle[ taskIDLE_TIME_SLOTS ];           /*< The idle time within each completed slot of the window. */
+    PRIVILEGED_DATA static IdleTime_t xIdleSlotLength[ taskIDLE_TIME_SLOTS ];         /*< The time measured in each completed slot of the window. */
+    PRIVILEGED_DATA static UBaseType_t uxIdleSlot = ( UBaseType_t ) 0U;              /*< The slot overwritten when the current slot completes. */
+    PRIVILEGED_DATA static UBaseType_t uxIdleSlotsFilled = ( UBaseType_t ) 0U;       /*< The number of slots completed, up to taskIDLE_TIME_SLOTS. */
+    PRIVILEGED_DATA static TickType_t xIdleSlotElapsed = ( TickType_t ) 0U;          /*< The ticks counted in the current slot. */
+    PRIVILEGED_DATA static IdleTime_t xIdleSlotCurrentIdle = ( IdleTime_t ) 0U;      /*< The idle time measured in the current slot. */
+    PRIVILEGED_DATA static IdleTime_t xIdleSlotCurrentLength = ( IdleTime_t ) 0U;    /*< The time measured in the current slot. */
+    PRIVILEGED_DATA static volatile IdleTime_t xWindowIdle = ( IdleTime_t ) 0U;      /*< The total of xIdleSlotIdle[]. */
+    PRIVILEGED_DATA static volatile IdleTime_t xWindowLength = ( IdleTime_t ) 0U;    /*< The total of xIdleSlotLength[]. */
+
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulIdleRunTime = 0UL;          /*< The run time counter increments during which the idle task was running, up to its last switch out. */
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulIdleSampledRunTime = 0UL;   /*< ulIdleRunTime, including the idle task's current run, when the idle time was last sampled. */
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulIdleSampledTotalTime = 0UL; /*< The run time counter when the idle time was last sampled. */
+    #endif
+
+#endif
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
     PRIVILEGED_DATA static List_t xTasksWaitingTermination; /*< Tasks that have been deleted - but their memory not yet freed. */
@@ -473,90 +1103,501 @@ static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
 static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
 
 /*
- * Utility to free all memory allocated by the scheduler to hold a TCB,
- * including the stack pointed to by the TCB.
- *
- * This does not free memory allocated by the task itself (i.e. memory
- * allocated by calls to pvPortMalloc from within the tasks application code).
+ * The task function of every task created by xTaskCreatePeriodic().  It runs
+ * the task's job function once per release, then blocks until the next one.
  */
-#if ( INCLUDE_vTaskDelete == 1 )
-
-    static void prvDeleteTCB( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
 
-#endif
+    static portTASK_FUNCTION_PROTO( prvPeriodicTask, pvParameters ) PRIVILEGED_FUNCTION;
 
 /*
- * Used only by the idle task.  This checks to see if anything has been placed
- * in the list of tasks waiting to be deleted.  If so the task is cleaned up
- * and its TCB deleted.
+ * Creates a task as xTaskCreatePeriodic() does.  ucKind is one of the
+ * taskJOBS_ values.  If it is taskJOBS_SERVER pvParameters points to the
+ * AperiodicServer_t of the task, and if it is taskJOBS_SPORADIC xPeriod is
+ * the minimum inter-arrival time of its jobs.
  */
-static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvCreatePeriodicTask( TaskFunction_t pxJobCode,
+                                             const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                             const configSTACK_DEPTH_TYPE usStackDepth,
+                                             void * const pvParameters,
+                                             UBaseType_t uxPriority,
+                                             TaskHandle_t * const pxCreatedTask,
+                                             TickType_t xCpuBurst,
+                                             TickType_t xPeriod,
+                                             TickType_t xDeadline,
+                                             uint8_t ucKind ) PRIVILEGED_FUNCTION;
 
 /*
- * The currently executing task is entering the Blocked state.  Add the task to
- * either the current or the overflow delayed task list.
+ * Move the running periodic task from its ready list to a release list, to be
+ * made ready by the tick interrupt on the tick of pxCurrentTCB->xReleaseTime.
+ * If that tick has already been processed the job is released at once and
+ * pdFALSE is returned, otherwise pdTRUE.  Under EDF a job released at once
+ * takes the deadline of its release, which can make the task yield, so that
+ * case is only reached from task level.
+ *
+ * Must be called from within a critical section.
  */
-static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
-                                            const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvAddCurrentTaskToReleaseList( void ) PRIVILEGED_FUNCTION;
 
 /*
- * Fills an TaskStatus_t structure with information on each task that is
- * referenced from the pxList list (which may be a ready list, a delayed list,
- * a suspended list, etc.).
+ * Place pxTCB, which must not be referenced from any state list, in the release
+ * list for pxTCB->xReleaseTime, which must be after the tick count.  When the
+ * delay wheel is used the task is held in the wheel instead, so the release
+ * takes the same time however many tasks are waiting.
  *
- * THIS FUNCTION IS INTENDED FOR DEBUGGING ONLY, AND SHOULD NOT BE CALLED FROM
- * NORMAL APPLICATION CODE.
+ * Must be called from within a critical section.
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+    static void prvAddTaskToReleaseList( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
 
-    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
-                                                     List_t * pxList,
-                                                     eTaskState eState ) PRIVILEGED_FUNCTION;
+/*
+ * Called by the tick interrupt to make ready the periodic tasks whose next
+ * release is due.  Returns pdTRUE if a context switch is required.  When the
+ * delay wheel is used the releases are held in the wheel instead.
+ */
+    #if ( configUSE_DELAY_WHEEL == 0 )
+        static BaseType_t prvReleaseJobs( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Records that a job of pxTCB was released by reaching its release time.  The
+ * end of the wait of a sporadic task is only the earliest time its next job
+ * can be released, so nothing is recorded for one.
+ */
+    static void prvRecordJobRelease( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( configUSE_SPORADIC_TASKS == 1 )
+
 /*
- * Searches pxList for a task with name pcNameToQuery - returning a handle to
- * the task if it is found, or NULL if the task is not found.
+ * The task function of every task created by xTaskCreateSporadic().  It runs
+ * the task's job function once per notification, then blocks for at least
+ * the minimum inter-arrival time.
  */
-#if ( INCLUDE_xTaskGetHandle == 1 )
-
-    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
-                                                     const char pcNameToQuery[] ) PRIVILEGED_FUNCTION;
+    static portTASK_FUNCTION_PROTO( prvSporadicTask, pvParameters ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( configUSE_RELEASE_JITTER_STATS == 1 )
+
 /*
- * When a task is created, the stack of the task is filled with a known value.
- * This function determines the 'high water mark' of the task stack by
- * determining how much of the stack remains at the original preset value.
+ * Record how many ticks after its nominal release time the current job of
+ * pxTCB was made ready.
  */
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
-
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
+    static void prvRecordReleaseJitter( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( configUSE_APERIODIC_SERVER == 1 )
+
 /*
- * Return the amount of time, in ticks, that will pass before the kernel will
- * next move a task from the Blocked state to the Running state.
- *
- * This conditional compilation should use inequality to 0, not equality to 1.
- * This is to ensure portSUPPRESS_TICKS_AND_SLEEP() can be called when user
- * defined low power mode implementations require configUSE_TICKLESS_IDLE to be
- * set to a value other than 1.
+ * The job function of an aperiodic server.  It runs the waiting jobs, and
+ * waits for more while there is time left in the period.  It returns, so the
+ * job of the server completes, when the period ends.
  */
-#if ( configUSE_TICKLESS_IDLE != 0 )
+    static void prvAperiodicServerJob( void * pvParameters ) PRIVILEGED_FUNCTION;
 
-    static TickType_t prvGetExpectedIdleTime( void ) PRIVILEGED_FUNCTION;
+/*
+ * Adds a job to the ring of pxServer.  Returns errQUEUE_FULL if the ring is
+ * full.
+ *
+ * Must be called from within a critical section.
+ */
+    static BaseType_t prvQueueAperiodicJob( AperiodicServer_t * const pxServer,
+                                            TaskFunction_t pxJobCode,
+                                            void * pvParameters ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( configUSE_SCHEDULE_TRACE == 1 )
+
 /*
- * Set xNextTaskUnblockTime to the time at which the next Blocked state task
- * will exit the Blocked state.
+ * Add an event for pxTCB to the schedule trace, overwriting the oldest event
+ * if the trace is full.
+ *
+ * Must be called with interrupts masked.
  */
-static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
+    static void prvRecordScheduleEvent( const TCB_t * const pxTCB,
+                                        const eScheduleTraceEvent eEvent ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_IDLE_TIME_STATS == 1 )
+
+/*
+ * Add xTicks ticks to the idle time window and move the window on by a slot
+ * each time a slot is complete.  The run time counter is read to find the idle
+ * time within the ticks if configGENERATE_RUN_TIME_STATS is 1, otherwise they
+ * are all counted as idle if xIdle is pdTRUE.
+ */
+    static void prvAddIdleTimeTicks( TickType_t xTicks,
+                                     BaseType_t xIdle ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_RM_ADMISSION_CONTROL == 1 )
+
+/*
+ * Returns pdPASS if a periodic task with the given priority, CpuBurst, period,
+ * deadline and release jitter can be added to the admitted tasks without any
+ * of them, or the new task, missing a deadline.  The Liu & Layland utilisation
+ * bound is tried first.  If the set is above the bound, or priorities are
+ * mixed, deadlines are shorter than periods or jobs can start late so the
+ * bound does not apply, exact response time analysis is used instead.
+ *
+ * Must be called with the scheduler suspended.
+ */
+    static BaseType_t prvAdmitPeriodicTask( UBaseType_t uxPriority,
+                                            TickType_t xBurst,
+                                            TickType_t xPeriod,
+                                            TickType_t xDeadline,
+                                            TickType_t xJitter ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if a task with period xPeriod would be given a period class
+ * of its own by prvAcquirePeriodClass(), either the class of another task with
+ * the same period or a free one.  Must be called with the scheduler suspended.
+ */
+    static BaseType_t prvPeriodClassAvailable( TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+
+/*
+ * Response time analysis for one task.  Returns pdTRUE if the worst case
+ * response time of a task with the given priority, burst and period, delayed by
+ * the admitted tasks other than pxTask, is no longer than xDeadline.  pxTask is
+ * NULL when the task being tested is the one asking to be admitted, otherwise
+ * the new task, described by the xNew parameters, is also counted.  A task
+ * whose jobs can start xJitter ticks after their release delays others as if
+ * its releases were that much closer together.
+ */
+    static BaseType_t prvMeetsDeadline( const TCB_t * const pxTask,
+                                        UBaseType_t uxPriority,
+                                        TickType_t xBurst,
+                                        TickType_t xPeriod,
+                                        TickType_t xDeadline,
+                                        UBaseType_t uxNewPriority,
+                                        TickType_t xNewBurst,
+                                        TickType_t xNewPeriod,
+                                        TickType_t xNewJitter ) PRIVILEGED_FUNCTION;
+
+/*
+ * The longest a job of a task with the given priority and period can be
+ * blocked by a lower task holding a mutex.  The kernel does not know which
+ * tasks take each mutex, so every ceiling that can delay the task is counted,
+ * including those of mutexes only the task itself or higher tasks take.
+ */
+    #if ( configUSE_MUTEX_CEILING == 1 )
+        static TickType_t prvBlockingTime( UBaseType_t uxPriority,
+                                           TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+    #endif
+
+#endif
+
+#if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+
+/*
+ * Places pxTCB in the deadline list that matches xDeadlineTime.  A deadline
+ * that has already passed is missed on the next tick.
+ *
+ * Must be called from within a critical section.
+ */
+    static void prvSetJobDeadline( TCB_t * const pxTCB,
+                                   TickType_t xDeadlineTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the tick interrupt to find the jobs whose deadline has passed and
+ * apply configDEADLINE_MISS_POLICY to them.  Returns pdTRUE if a context
+ * switch is required.
+ */
+    static BaseType_t prvCheckJobDeadlines( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_BUDGET_ENFORCEMENT == 1 )
+
+/*
+ * Returns the run time counter increments used by the current job of the
+ * running task, including the time since it was last switched in.
+ *
+ * Must be called from within a critical section.
+ */
+    static configRUN_TIME_COUNTER_TYPE prvGetCurrentJobRunTime( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Starts a new budget for the running task.  The time the task has run since
+ * it was switched in is charged to its run time counter first so it is not
+ * charged to the new job.
+ *
+ * Must be called from within a critical section.
+ */
+    static void prvStartJobBudget( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the tick interrupt.  If the running task is a periodic task whose
+ * current job has used more than its CpuBurst, the task is moved to a release
+ * list until its next release and pdTRUE is returned so the caller
+ * switches context.
+ */
+    static BaseType_t prvEnforceJobBudget( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Utility to free all memory allocated by the scheduler to hold a TCB,
+ * including the stack pointed to by the TCB.
+ *
+ * This does not free memory allocated by the task itself (i.e. memory
+ * allocated by calls to pvPortMalloc from within the tasks application code).
+ */
+#if ( INCLUDE_vTaskDelete == 1 )
+
+    static void prvDeleteTCB( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Used only by the idle task.  This checks to see if anything has been placed
+ * in the list of tasks waiting to be deleted.  If so the task is cleaned up
+ * and its TCB deleted.
+ */
+static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The currently executing task is entering the Blocked state.  Add the task to
+ * either the current or the overflow delayed task list.
+ */
+static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
+                                            const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by prvAddCurrentTaskToDelayedList() to place the calling task, the
+ * state list item of which holds its wake time, in the delay wheel.
+ */
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+    static void prvAddCurrentTaskToDelayWheel( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Fills an TaskStatus_t structure with information on each task that is
+ * referenced from the pxList list (which may be a ready list, a delayed list,
+ * a suspended list, etc.).
+ *
+ * THIS FUNCTION IS INTENDED FOR DEBUGGING ONLY, AND SHOULD NOT BE CALLED FROM
+ * NORMAL APPLICATION CODE.
+ */
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
+                                                     List_t * pxList,
+                                                     eTaskState eState ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Searches pxList for a task with name pcNameToQuery - returning a handle to
+ * the task if it is found, or NULL if the task is not found.
+ */
+#if ( INCLUDE_xTaskGetHandle == 1 )
+
+    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
+                                                     const char pcNameToQuery[] ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * When a task is created, the stack of the task is filled with a known value.
+ * This function determines the 'high water mark' of the task stack by
+ * determining how much of the stack remains at the original preset value.
+ */
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Return the amount of time, in ticks, that will pass before the kernel will
+ * next move a task from the Blocked state to the Running state.
+ *
+ * This conditional compilation should use inequality to 0, not equality to 1.
+ * This is to ensure portSUPPRESS_TICKS_AND_SLEEP() can be called when user
+ * defined low power mode implementations require configUSE_TICKLESS_IDLE to be
+ * set to a value other than 1.
+ */
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    static TickType_t prvGetExpectedIdleTime( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the next tick on which xTaskIncrementTick() has to run, either to
+ * unblock a task, to release a job or to detect a missed job deadline.  No job
+ * budget can run out while the processor sleeps, as a budget is only charged
+ * to the job that is running.
+ */
+    static TickType_t prvGetNextJobEventTime( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Set xNextTaskUnblockTime to the time at which the next Blocked state task
+ * will exit the Blocked state.
+ */
+static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+/*
+ * Place pxTCB, the state list item of which holds its wake time, in the slot
+ * of the delay wheel that spans that time, or in a delayed list if the wake
+ * time is further ahead of xConstTickCount than the wheel spans.  Returns the
+ * tick on which the task will next be looked at: its wake time, or the first
+ * tick of the span of its slot, on which it is moved down the wheel.
+ */
+    static TickType_t prvAddTaskToDelayWheel( TCB_t * const pxTCB,
+                                              const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the tick interrupt when the tick count reaches
+ * xNextTaskUnblockTime.  Moves the tasks in the slots that start on this tick
+ * down the wheel, unblocks the tasks that wake on it, releasing the jobs of the
+ * periodic tasks among them whose release falls on it, then sets
+ * xNextTaskUnblockTime again.  Returns pdTRUE if a context switch is
+ * required.
+ */
+    static BaseType_t prvProcessDelayWheel( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns how many slots after uxFirstSlot the first slot at uxLevel that
+ * holds a task is, counting uxFirstSlot as 0 and wrapping round the level, or
+ * taskWHEEL_SLOTS if no slot at uxLevel holds a task.
+ */
+    static UBaseType_t prvNextDelayWheelSlot( const UBaseType_t uxLevel,
+                                              const UBaseType_t uxFirstSlot ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_POOLS == 1 )
+
+/*
+ * Take a block of at least xSize bytes from the first of the uxPools pools in
+ * pxPools that has blocks that large and one of them free.  The pools must be
+ * in ascending order of block size.  If none has a block the heap is used.
+ */
+    static void * prvAllocateFromTaskPool( BlockPool_t * const pxPools,
+                                           const size_t uxPools,
+                                           const size_t xSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Give back a block taken by prvAllocateFromTaskPool(), to its pool or to the
+ * heap.
+ */
+    static void prvFreeToTaskPool( BlockPool_t * const pxPools,
+                                   const size_t uxPools,
+                                   void * const pv ) PRIVILEGED_FUNCTION;
+
+/*
+ * Link the blocks of every pool into their free lists.  Must be called from a
+ * critical section.
+ */
+    static void prvInitialiseTaskPools( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Set the priority of pxTCB to uxNewPriority, which must differ from its base
+ * priority, moving it to the matching ready list if it is Ready.  An inherited
+ * priority is left in place until the mutex is given back.  Must be called from
+ * a critical section, and does not yield.
+ */
+#if ( ( INCLUDE_vTaskPrioritySet == 1 ) || ( configUSE_RM_AUTO_PRIORITY == 1 ) )
+
+    static void prvSetBasePriority( TCB_t * const pxTCB,
+                                    UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Give each task in xRateOrderedTasksList the priority of its period: the
+ * shortest period runs at configRM_AUTO_PRIORITY_HIGHEST and each longer one a
+ * priority lower, down to configRM_AUTO_PRIORITY_LOWEST.  Asserts if there are
+ * more distinct periods than priorities in that band.  Returns pdTRUE if a
+ * priority changed.  Must be called from a critical section.
+ */
+#if ( configUSE_RM_AUTO_PRIORITY == 1 )
+
+    static BaseType_t prvAssignRatePriorities( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Return the number of Ready state tasks at uxPriority summed across the
+ * period lists of that priority.  Only needed where the idle task checks for
+ * other tasks sharing its priority.
+ */
+#if ( ( configUSE_RM == 1 ) && ( ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) || ( configUSE_TICKLESS_IDLE != 0 ) ) )
+
+    static UBaseType_t prvReadyTasksAtPriority( UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_RM == 1 )
+
+/*
+ * Return the period class of xPeriod, counting one more user of it.  If the
+ * period has no class yet one is taken from the free entries and the ranks of
+ * all shorter periods move up by one, along with their ready lists.  If every
+ * class is in use the class of tasks without a period, taskRM_NO_PERIOD_CLASS,
+ * is returned for a period other than portMAX_DELAY, and the caller decides
+ * whether running out of RM order is acceptable.  Must be called from a
+ * critical section.
+ */
+    static UBaseType_t prvAcquirePeriodClass( TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+
+/*
+ * Drop one user of a period class.  No task may be in a ready list of the
+ * class on behalf of that user.  When the last user goes the class is freed and
+ * the ranks of all shorter periods move down by one.  Must be called from a
+ * critical section.
+ */
+    static void prvReleasePeriodClass( UBaseType_t uxClass ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move every task in the ready list pxFrom to the end of pxTo, keeping their
+ * order.
+ */
+    static void prvMoveReadyList( List_t * const pxFrom,
+                                  List_t * const pxTo ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert the event list item of pxTCB into pxEventList in RM order.  Items are
+ * sorted by value, which encodes the priority, and tasks of the same priority
+ * by the period of their class, so the waiter with the shortest period is
+ * woken first.  Tasks that share both stay in FIFO order.
+ */
+    static void prvInsertTaskByRate( List_t * const pxEventList,
+                                     TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_EDF == 1 )
+
+/*
+ * Record the absolute deadline of the job a task is about to become Ready
+ * for.  A task created by xTaskCreatePeriodic() has the deadline of its
+ * current release.  Any other task with a deadline is treated as released
+ * when it becomes Ready.
+ */
+    static void prvSetReadyDeadline( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert a task in the ready list of its priority behind every task whose
+ * deadline is no later than its own, so tasks with the same deadline take
+ * turns.  The cost is linear in the number of ready tasks at that priority.
+ */
+    static void prvInsertTaskByDeadline( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
 
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
@@ -581,8 +1622,8 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                                   TaskHandle_t * const pxCreatedTask,
                                   TCB_t * pxNewTCB,
                                   const MemoryRegion_t * const xRegions,
-                                  int pxCpuBurst,
-                                  int period ) PRIVILEGED_FUNCTION;
+                                  TickType_t xCpuBurst,
+                                  TickType_t xPeriod ) PRIVILEGED_FUNCTION;
 
 /*
  * Called after a new task has been created and initialised to place the task
@@ -646,7 +1687,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             }
             #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
-            prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL, 1, 1 );
+            prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL, 0, 0 );
             prvAddNewTaskToReadyList( pxNewTCB );
         }
         else
@@ -696,7 +1737,8 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                                   pxTaskDefinition->pvParameters,
                                   pxTaskDefinition->uxPriority,
                                   pxCreatedTask, pxNewTCB,
-                                  pxTaskDefinition->xRegions );
+                                  pxTaskDefinition->xRegions,
+                                  0, 0 );
 
             prvAddNewTaskToReadyList( pxNewTCB );
             xReturn = pdPASS;
@@ -747,7 +1789,8 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                                       pxTaskDefinition->pvParameters,
                                       pxTaskDefinition->uxPriority,
                                       pxCreatedTask, pxNewTCB,
-                                      pxTaskDefinition->xRegions );
+                                      pxTaskDefinition->xRegions,
+                                      0, 0 );
 
                 prvAddNewTaskToReadyList( pxNewTCB );
                 xReturn = pdPASS;
@@ -768,8 +1811,8 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                             void * const pvParameters,
                             UBaseType_t uxPriority,
                             TaskHandle_t * const pxCreatedTask,
-                            int pxCpuBurst,
-                            int period )
+                            TickType_t xCpuBurst,
+                            TickType_t xPeriod )
     {
         TCB_t * pxNewTCB;
         BaseType_t xReturn;
@@ -782,7 +1825,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* Allocate space for the TCB.  Where the memory comes from depends on
              * the implementation of the port malloc function and whether or not static
              * allocation is being used. */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            pxNewTCB = taskALLOCATE_TCB();
 
             if( pxNewTCB != NULL )
             {
@@ -791,12 +1834,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 /* Allocate space for the stack used by the task being created.
                  * The base of the stack memory stored in the TCB so the task can
                  * be deleted later if required. */
-                pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocStack( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                pxNewTCB->pxStack = taskALLOCATE_STACK( usStackDepth ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
                 if( pxNewTCB->pxStack == NULL )
                 {
                     /* Could not allocate the stack.  Delete the allocated TCB. */
-                    vPortFree( pxNewTCB );
+                    taskFREE_TCB( pxNewTCB );
                     pxNewTCB = NULL;
                 }
             }
@@ -806,12 +1849,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             StackType_t * pxStack;
 
             /* Allocate space for the stack used by the task being created. */
-            pxStack = pvPortMallocStack( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
+            pxStack = taskALLOCATE_STACK( usStackDepth ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
 
             if( pxStack != NULL )
             {
                 /* Allocate space for the TCB. */
-                pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+                pxNewTCB = taskALLOCATE_TCB(); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
                 if( pxNewTCB != NULL )
                 {
@@ -824,7 +1867,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 {
                     /* The stack cannot be used as the TCB was not created.  Free
                      * it again. */
-                    vPortFreeStack( pxStack );
+                    taskFREE_STACK( pxStack );
                 }
             }
             else
@@ -844,7 +1887,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             }
             #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
-            prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL, pxCpuBurst, period );
+            prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL, xCpuBurst, xPeriod );
             prvAddNewTaskToReadyList( pxNewTCB );
             xReturn = pdPASS;
         }
@@ -859,948 +1902,914 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
-                                  const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-                                  const uint32_t ulStackDepth,
-                                  void * const pvParameters,
-                                  UBaseType_t uxPriority,
-                                  TaskHandle_t * const pxCreatedTask,
-                                  TCB_t * pxNewTCB,
-                                  const MemoryRegion_t * const xRegions,
-                                  int pxCpuBurst,
-                                  int period )
-{
-    StackType_t * pxTopOfStack;
-    UBaseType_t x;
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
 
-    #if ( portUSING_MPU_WRAPPERS == 1 )
-        /* Should the task be created in privileged mode? */
-        BaseType_t xRunPrivileged;
+    BaseType_t xTaskCreatePeriodic( TaskFunction_t pxJobCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    const configSTACK_DEPTH_TYPE usStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    TaskHandle_t * const pxCreatedTask,
+                                    TickType_t xCpuBurst,
+                                    TickType_t xPeriod,
+                                    TickType_t xDeadline )
+    {
+        return prvCreatePeriodicTask( pxJobCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, xCpuBurst, xPeriod, xDeadline, taskJOBS_PERIODIC );
+    }
+/*-----------------------------------------------------------*/
 
-        if( ( uxPriority & portPRIVILEGE_BIT ) != 0U )
-        {
-            xRunPrivileged = pdTRUE;
-        }
-        else
+    #if ( configUSE_SPORADIC_TASKS == 1 )
+
+        BaseType_t xTaskCreateSporadic( TaskFunction_t pxJobCode,
+                                        const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        const configSTACK_DEPTH_TYPE usStackDepth,
+                                        void * const pvParameters,
+                                        UBaseType_t uxPriority,
+                                        TaskHandle_t * const pxCreatedTask,
+                                        TickType_t xCpuBurst,
+                                        TickType_t xMinInterArrival,
+                                        TickType_t xDeadline )
         {
-            xRunPrivileged = pdFALSE;
+            return prvCreatePeriodicTask( pxJobCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, xCpuBurst, xMinInterArrival, xDeadline, taskJOBS_SPORADIC );
         }
-        uxPriority &= ~portPRIVILEGE_BIT;
-    #endif /* portUSING_MPU_WRAPPERS == 1 */
 
-    /* Avoid dependency on memset() if it is not required. */
-    #if ( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
-    {
-        /* Fill the stack with a known value to assist debugging. */
-        ( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulStackDepth * sizeof( StackType_t ) );
-    }
-    #endif /* tskSET_NEW_STACKS_TO_KNOWN_VALUE */
+    #endif /* configUSE_SPORADIC_TASKS */
+/*-----------------------------------------------------------*/
 
-    /* Calculate the top of stack address.  This depends on whether the stack
-     * grows from high memory to low (as per the 80x86) or vice versa.
-     * portSTACK_GROWTH is used to make the result positive or negative as required
-     * by the port. */
-    #if ( portSTACK_GROWTH < 0 )
+    static BaseType_t prvCreatePeriodicTask( TaskFunction_t pxJobCode,
+                                             const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                             const configSTACK_DEPTH_TYPE usStackDepth,
+                                             void * const pvParameters,
+                                             UBaseType_t uxPriority,
+                                             TaskHandle_t * const pxCreatedTask,
+                                             TickType_t xCpuBurst,
+                                             TickType_t xPeriod,
+                                             TickType_t xDeadline,
+                                             uint8_t ucKind )
     {
-        pxTopOfStack = &( pxNewTCB->pxStack[ ulStackDepth - ( uint32_t ) 1 ] );
-        pxTopOfStack = ( StackType_t * ) ( ( ( portPOINTER_SIZE_TYPE ) pxTopOfStack ) & ( ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) ); /*lint !e923 !e9033 !e9078 MISRA exception.  Avoiding casts between pointers and integers is not practical.  Size differences accounted for using portPOINTER_SIZE_TYPE type.  Checked by assert(). */
-
-        /* Check the alignment of the calculated top of stack is correct. */
-        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pxTopOfStack & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0UL ) );
-
-        #if ( configRECORD_STACK_HIGH_ADDRESS == 1 )
-        {
-            /* Also record the stack's high address, which may assist
-             * debugging. */
-            pxNewTCB->pxEndOfStack = pxTopOfStack;
-        }
-        #endif /* configRECORD_STACK_HIGH_ADDRESS */
-    }
-    #else /* portSTACK_GROWTH */
-    {
-        pxTopOfStack = pxNewTCB->pxStack;
-
-        /* Check the alignment of the stack buffer is correct. */
-        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pxNewTCB->pxStack & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0UL ) );
-
-        /* The other extreme of the stack space is required if stack checking is
-         * performed. */
-        pxNewTCB->pxEndOfStack = pxNewTCB->pxStack + ( ulStackDepth - ( uint32_t ) 1 );
-    }
-    #endif /* portSTACK_GROWTH */
-
-    if(pxCpuBurst < 1){
-        pxNewTCB->CpuBurst = 1;
-    }else{
-        pxNewTCB->CpuBurst = pxCpuBurst;
-    }
-
-    if(period < 1){
-        pxNewTCB->period = 1;
-    }else if(period > 10){
-        pxNewTCB->period = 10;
-    }else{
-       pxNewTCB->period = period; 
-    }
+        TaskHandle_t xHandle = NULL;
+        TaskFunction_t pxTaskCode = prvPeriodicTask;
+        BaseType_t xReturn;
 
+        #if ( configUSE_RM_ADMISSION_CONTROL == 1 )
+            const TickType_t xJitter = ( ( ucKind == taskJOBS_SERVER ) && ( xCpuBurst < xPeriod ) ) ? ( xPeriod - xCpuBurst ) : ( TickType_t ) 0U;
+        #elif ( ( configUSE_APERIODIC_SERVER == 0 ) && ( configUSE_SPORADIC_TASKS == 0 ) )
+            ( void ) ucKind;
+        #endif
 
-    /* Store the task name in the TCB. */
-    if( pcName != NULL )
-    {
-        for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+        #if ( configUSE_SPORADIC_TASKS == 1 )
         {
-            pxNewTCB->pcTaskName[ x ] = pcName[ x ];
-
-            /* Don't copy all configMAX_TASK_NAME_LEN if the string is shorter than
-             * configMAX_TASK_NAME_LEN characters just in case the memory after the
-             * string is not accessible (extremely unlikely). */
-            if( pcName[ x ] == ( char ) 0x00 )
+            if( ucKind == taskJOBS_SPORADIC )
             {
-                break;
+                pxTaskCode = prvSporadicTask;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
+        #endif
 
-        /* Ensure the name string is terminated in the case that the string length
-         * was greater or equal to configMAX_TASK_NAME_LEN. */
-        pxNewTCB->pcTaskName[ configMAX_TASK_NAME_LEN - 1 ] = '\0';
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-
-    /* This is used as an array index so must ensure it's not too large. */
-    configASSERT( uxPriority < configMAX_PRIORITIES );
-
-    if( uxPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
-    {
-        uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-    pxNewTCB->uxPriority = uxPriority;
-    #if ( configUSE_MUTEXES == 1 )
-    {
-        pxNewTCB->uxBasePriority = uxPriority;
-    }
-    #endif /* configUSE_MUTEXES */
-
-    vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
-    vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
-
-    /* Set the pxNewTCB as a link back from the ListItem_t.  This is so we can get
-     * back to  the containing TCB from a generic item in a list. */
-    listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
-
-    /* Event lists are always in priority order. */
-    listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-    listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
-
-    #if ( portUSING_MPU_WRAPPERS == 1 )
-    {
-        vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
-    }
-    #else
-    {
-        /* Avoid compiler warning about unreferenced parameter. */
-        ( void ) xRegions;
-    }
-    #endif
-
-    #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
-    {
-        /* Allocate and initialize memory for the task's TLS Block. */
-        configINIT_TLS_BLOCK( pxNewTCB->xTLSBlock );
-    }
-    #endif
+        configASSERT( pxJobCode );
+        configASSERT( ( xPeriod != ( TickType_t ) 0U ) && ( xPeriod != portMAX_DELAY ) );
 
-    /* Initialize the TCB stack to look as if the task was already running,
-     * but had been interrupted by the scheduler.  The return address is set
-     * to the start of the task function. Once the stack has been initialised
-     * the top of stack variable is updated. */
-    #if ( portUSING_MPU_WRAPPERS == 1 )
-    {
-        /* If the port has capability to detect stack overflow,
-         * pass the stack end address to the stack initialization
-         * function as well. */
-        #if ( portHAS_STACK_OVERFLOW_CHECKING == 1 )
-        {
-            #if ( portSTACK_GROWTH < 0 )
-            {
-                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxStack, pxTaskCode, pvParameters, xRunPrivileged );
-            }
-            #else /* portSTACK_GROWTH */
-            {
-                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxEndOfStack, pxTaskCode, pvParameters, xRunPrivileged );
-            }
-            #endif /* portSTACK_GROWTH */
-        }
-        #else /* portHAS_STACK_OVERFLOW_CHECKING */
-        {
-            pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxTaskCode, pvParameters, xRunPrivileged );
-        }
-        #endif /* portHAS_STACK_OVERFLOW_CHECKING */
-    }
-    #else /* portUSING_MPU_WRAPPERS */
-    {
-        /* If the port has capability to detect stack overflow,
-         * pass the stack end address to the stack initialization
-         * function as well. */
-        #if ( portHAS_STACK_OVERFLOW_CHECKING == 1 )
+        if( xDeadline == ( TickType_t ) 0U )
         {
-            #if ( portSTACK_GROWTH < 0 )
-            {
-                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxStack, pxTaskCode, pvParameters );
-            }
-            #else /* portSTACK_GROWTH */
-            {
-                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxEndOfStack, pxTaskCode, pvParameters );
-            }
-            #endif /* portSTACK_GROWTH */
+            xDeadline = xPeriod;
         }
-        #else /* portHAS_STACK_OVERFLOW_CHECKING */
+        else
         {
-            pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxTaskCode, pvParameters );
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif /* portHAS_STACK_OVERFLOW_CHECKING */
-    }
-    #endif /* portUSING_MPU_WRAPPERS */
-
-    if( pxCreatedTask != NULL )
-    {
-        /* Pass the handle out in an anonymous way.  The handle can be used to
-         * change the created task's priority, delete the created task, etc.*/
-        *pxCreatedTask = ( TaskHandle_t ) pxNewTCB;
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-}
-/*-----------------------------------------------------------*/
-
-static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
-{
-    /* Ensure interrupts don't access the task lists while the lists are being
-     * updated. */
-    taskENTER_CRITICAL();
-    {
-        uxCurrentNumberOfTasks++;
 
-        if( pxCurrentTCB == NULL )
+        /* The scheduler is suspended so the new task cannot start before its
+         * job function and first release time have been recorded. */
+        vTaskSuspendAll();
         {
-            /* There are no other tasks, or all the other tasks are in
-             * the suspended state - make this the current task. */
-            pxCurrentTCB = pxNewTCB;
+            xReturn = pdPASS;
 
-            if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
-            {
-                /* This is the first task to be created so do the preliminary
-                 * initialisation required.  We will not recover if this call
-                 * fails, but we will report the failure. */
-                prvInitialiseTaskLists();
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        else
-        {
-            /* If the scheduler is not already running, make this task the
-             * current task if it is the highest priority task to be created
-             * so far. */
-            if( xSchedulerRunning == pdFALSE )
+            #if ( configUSE_RM_ADMISSION_CONTROL == 1 )
             {
-                if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                if( prvAdmitPeriodicTask( uxPriority, xCpuBurst, xPeriod, xDeadline, xJitter ) == pdFAIL )
                 {
-                    pxCurrentTCB = pxNewTCB;
+                    traceTASK_ADMISSION_FAILED( pcName );
+                    xReturn = errTASK_NOT_SCHEDULABLE;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-
-        uxTaskNumber++;
-
-        #if ( configUSE_TRACE_FACILITY == 1 )
-        {
-            /* Add a counter into the TCB for tracing only. */
-            pxNewTCB->uxTCBNumber = uxTaskNumber;
-        }
-        #endif /* configUSE_TRACE_FACILITY */
-        traceTASK_CREATE( pxNewTCB );
-
-        prvAddTaskToReadyList( pxNewTCB );
-
-        portSETUP_TCB( pxNewTCB );
-    }
-    taskEXIT_CRITICAL();
-
-    if( xSchedulerRunning != pdFALSE )
-    {
-        /* If the created task is of shorter period than the current task
-         * then it should run now. */
-        if( pxCurrentTCB->period > pxNewTCB->period )
-        {
-            taskYIELD_IF_USING_PREEMPTION();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-}
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_vTaskDelete == 1 )
-
-    void vTaskDelete( TaskHandle_t xTaskToDelete )
-    {
-        TCB_t * pxTCB;
-
-        taskENTER_CRITICAL();
-        {
-            /* If null is passed in here then it is the calling task that is
-             * being deleted. */
-            pxTCB = prvGetTCBFromHandle( xTaskToDelete );
+            #endif /* configUSE_RM_ADMISSION_CONTROL */
 
-            /* Remove task from the ready/delayed list. */
-            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            if( xReturn == pdPASS )
             {
-                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+                xReturn = xTaskCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, &xHandle, xCpuBurst, xPeriod );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
 
-            /* Is the task waiting on an event also? */
-            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-            {
-                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
-            }
-            else
+            if( xReturn == pdPASS )
             {
-                mtCOVERAGE_TEST_MARKER();
-            }
+                xHandle->pxJobCode = pxJobCode;
+                xHandle->xReleaseTime = xTickCount;
+                xHandle->xDeadline = xDeadline;
 
-            /* Increment the uxTaskNumber also so kernel aware debuggers can
-             * detect that the task lists need re-generating.  This is done before
-             * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
-             * not return. */
-            uxTaskNumber++;
+                #if ( configUSE_APERIODIC_SERVER == 1 )
+                {
+                    if( ucKind == taskJOBS_SERVER )
+                    {
+                        xHandle->pxAperiodicServer = ( AperiodicServer_t * ) pvParameters;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
 
-            if( pxTCB == pxCurrentTCB )
-            {
-                /* A task is deleting itself.  This cannot complete within the
-                 * task itself, as a context switch to another task is required.
-                 * Place the task in the termination list.  The idle task will
-                 * check the termination list and free up any memory allocated by
-                 * the scheduler for the TCB and stack of the deleted task. */
-                vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+                #if ( configUSE_SPORADIC_TASKS == 1 )
+                {
+                    if( ucKind == taskJOBS_SPORADIC )
+                    {
+                        xHandle->ucSporadic = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
 
-                /* Increment the ucTasksDeleted variable so the idle task knows
-                 * there is a task that has been deleted and that it should therefore
-                 * check the xTasksWaitingTermination list. */
-                ++uxDeletedTasksWaitingCleanUp;
+                #if ( configUSE_RELEASE_JITTER_STATS == 1 )
+                {
+                    xHandle->xMinReleaseJitter = portMAX_DELAY;
+                }
+                #endif
 
-                /* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
-                 * portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
-                traceTASK_DELETE( pxTCB );
+                #if ( configUSE_JOB_STATS == 1 )
+                {
+                    /* The first job is released by creating the task, unless
+                     * the task waits to be notified. */
+                    if( taskIS_SPORADIC( xHandle ) == pdFALSE )
+                    {
+                        xHandle->uxJobsReleased = ( UBaseType_t ) 1U;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
 
-                /* The pre-delete hook is primarily for the Windows simulator,
-                 * in which Windows specific clean up operations are performed,
-                 * after which it is not possible to yield away from this task -
-                 * hence xYieldPending is used to latch that a context switch is
-                 * required. */
-                portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
-            }
-            else
-            {
-                --uxCurrentNumberOfTasks;
-                traceTASK_DELETE( pxTCB );
+                #if ( configUSE_SCHEDULE_TRACE == 1 )
+                {
+                    if( taskIS_SPORADIC( xHandle ) == pdFALSE )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            prvRecordScheduleEvent( xHandle, eTraceJobReleased );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
 
-                /* Reset the next expected unblock time in case it referred to
-                 * the task that has just been deleted. */
-                prvResetNextTaskUnblockTime();
-            }
-        }
-        taskEXIT_CRITICAL();
+                #if ( configUSE_EDF == 1 )
+                {
+                    /* The task was placed in its ready list before its first
+                     * release and deadline were known. */
+                    taskENTER_CRITICAL();
+                    {
+                        ( void ) uxListRemove( &( xHandle->xStateListItem ) );
+                        prvAddTaskToReadyList( xHandle );
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                #endif
 
-        /* If the task is not deleting itself, call prvDeleteTCB from outside of
-         * critical section. If a task deletes itself, prvDeleteTCB is called
-         * from prvCheckTasksWaitingTermination which is called from Idle task. */
-        if( pxTCB != pxCurrentTCB )
-        {
-            prvDeleteTCB( pxTCB );
-        }
+                #if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+                {
+                    if( taskHAS_RELEASE_DEADLINE( xHandle ) != pdFALSE )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            prvSetJobDeadline( xHandle, xHandle->xReleaseTime + xDeadline );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
 
-        /* Force a reschedule if it is the currently running task that has just
-         * been deleted. */
-        if( xSchedulerRunning != pdFALSE )
-        {
-            if( pxTCB == pxCurrentTCB )
-            {
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
+                #if ( configUSE_RM_ADMISSION_CONTROL == 1 )
+                {
+                    if( listLIST_IS_EMPTY( &xAdmittedTasksList ) != pdFALSE )
+                    {
+                        uxAdmittedPriority = xHandle->uxPriority;
+                    }
+                    else if( xHandle->uxPriority != uxAdmittedPriority )
+                    {
+                        xAdmittedPrioritiesDiffer = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xDeadline != xPeriod )
+                    {
+                        uxAdmittedConstrainedDeadlines++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xJitter != ( TickType_t ) 0U )
+                    {
+                        uxAdmittedJitteredTasks++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    listSET_LIST_ITEM_VALUE( &( xHandle->xAdmissionListItem ), ( TickType_t ) xHandle->uxPriority );
+                    vListInsertEnd( &xAdmittedTasksList, &( xHandle->xAdmissionListItem ) );
+                    ulAdmittedUtilisation += taskRM_UTILISATION( xCpuBurst, xPeriod );
+                }
+                #endif /* configUSE_RM_ADMISSION_CONTROL */
+
+                if( pxCreatedTask != NULL )
+                {
+                    *pxCreatedTask = xHandle;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
     }
 
-#endif /* INCLUDE_vTaskDelete */
+#endif /* ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskDelayUntil == 1 )
+#if ( configUSE_RM_ADMISSION_CONTROL == 1 )
 
-    BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
-                                const TickType_t xTimeIncrement )
+    static BaseType_t prvAdmitPeriodicTask( UBaseType_t uxPriority,
+                                            TickType_t xBurst,
+                                            TickType_t xPeriod,
+                                            TickType_t xDeadline,
+                                            TickType_t xJitter )
     {
-        TickType_t xTimeToWake;
-        BaseType_t xAlreadyYielded, xShouldDelay = pdFALSE;
+        /* n( 2^( 1 / n ) - 1 ) for n = 1 to 10 tasks, rounded down.  Larger
+         * sets use the limit ln( 2 ). */
+        static const uint16_t usUtilisationBound[] = { 10000U, 8284U, 7797U, 7568U, 7434U, 7347U, 7286U, 7240U, 7205U, 7177U };
+        const UBaseType_t uxTasks = listCURRENT_LIST_LENGTH( &xAdmittedTasksList ) + ( UBaseType_t ) 1U;
+        const ListItem_t * pxIterator;
+        const ListItem_t * pxEnd;
+        const TCB_t * pxOther;
+        uint32_t ulBound;
+        BaseType_t xReturn;
 
-        configASSERT( pxPreviousWakeTime );
-        configASSERT( ( xTimeIncrement > 0U ) );
-        configASSERT( uxSchedulerSuspended == 0 );
+        /* Same adjustments as prvInitialiseNewTask(). */
+        uxPriority &= ~portPRIVILEGE_BIT;
 
-        vTaskSuspendAll();
+        if( uxPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
         {
-            /* Minor optimisation.  The tick count cannot change in this
-             * block. */
-            const TickType_t xConstTickCount = xTickCount;
+            uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            /* Generate the tick time at which the task wants to wake. */
-            xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
+        /* The burst must be known and fit within the deadline, which must be
+         * no longer than the period. */
+        if( ( xBurst == ( TickType_t ) 0U ) || ( xBurst > xDeadline ) || ( xDeadline > xPeriod ) )
+        {
+            xReturn = pdFAIL;
+        }
+        else if( prvPeriodClassAvailable( xPeriod ) == pdFALSE )
+        {
+            /* The task would run below every task with a period, which the
+             * analysis below does not model. */
+            xReturn = pdFAIL;
+        }
+        else if( uxTasks == ( UBaseType_t ) 1U )
+        {
+            /* Nothing else has been admitted, so only blocking can delay the
+             * task.  The admitted list may not be initialised yet. */
+            #if ( configUSE_MUTEX_CEILING == 1 )
+            {
+                xReturn = ( prvBlockingTime( uxPriority, xPeriod ) <= ( xDeadline - xBurst ) ) ? pdPASS : pdFAIL;
+            }
+            #else
+            {
+                xReturn = pdPASS;
+            }
+            #endif
+        }
+        else
+        {
+            if( uxTasks <= ( UBaseType_t ) ( sizeof( usUtilisationBound ) / sizeof( usUtilisationBound[ 0 ] ) ) )
+            {
+                ulBound = ( uint32_t ) usUtilisationBound[ uxTasks - ( UBaseType_t ) 1U ];
+            }
+            else
+            {
+                ulBound = ( uint32_t ) 6931U;
+            }
 
-            if( xConstTickCount < *pxPreviousWakeTime )
+            /* The bound only holds when the periods alone decide the order in
+             * which the tasks run, every deadline is the end of the period,
+             * every job can start at its release and no task can be blocked. */
+            if( ( xAdmittedPrioritiesDiffer == pdFALSE ) &&
+                ( taskMUTEX_CEILINGS_IN_USE() == pdFALSE ) &&
+                ( uxAdmittedJitteredTasks == ( UBaseType_t ) 0U ) &&
+                ( xJitter == ( TickType_t ) 0U ) &&
+                ( uxPriority == uxAdmittedPriority ) &&
+                ( uxAdmittedConstrainedDeadlines == ( UBaseType_t ) 0U ) &&
+                ( xDeadline == xPeriod ) &&
+                ( ( ulAdmittedUtilisation + taskRM_UTILISATION( xBurst, xPeriod ) ) <= ulBound ) )
             {
-                /* The tick count has overflowed since this function was
-                 * lasted called.  In this case the only time we should ever
-                 * actually delay is if the wake time has also  overflowed,
-                 * and the wake time is greater than the tick time.  When this
-                 * is the case it is as if neither time had overflowed. */
-                if( ( xTimeToWake < *pxPreviousWakeTime ) && ( xTimeToWake > xConstTickCount ) )
-                {
-                    xShouldDelay = pdTRUE;
-                }
-                else
+                xReturn = pdPASS;
+            }
+            else
+            {
+                /* The new task must meet its own deadline, and so must every
+                 * admitted task it can delay. */
+                xReturn = prvMeetsDeadline( NULL, uxPriority, xBurst, xPeriod, xDeadline, uxPriority, xBurst, xPeriod, xJitter );
+
+                pxEnd = listGET_END_MARKER( &xAdmittedTasksList );
+
+                for( pxIterator = listGET_HEAD_ENTRY( &xAdmittedTasksList ); ( pxIterator != pxEnd ) && ( xReturn != pdFALSE ); pxIterator = listGET_NEXT( pxIterator ) )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    pxOther = listGET_LIST_ITEM_OWNER( pxIterator );
+
+                    if( taskRM_CAN_DELAY( uxPriority, xPeriod, ( UBaseType_t ) listGET_LIST_ITEM_VALUE( pxIterator ), pxOther->xPeriod ) != pdFALSE )
+                    {
+                        xReturn = prvMeetsDeadline( pxOther, ( UBaseType_t ) listGET_LIST_ITEM_VALUE( pxIterator ), pxOther->xCpuBurst, pxOther->xPeriod, pxOther->xDeadline, uxPriority, xBurst, xPeriod, xJitter );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
             }
-            else
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvPeriodClassAvailable( TickType_t xPeriod )
+    {
+        UBaseType_t uxClass;
+        BaseType_t xReturn = pdFALSE;
+
+        if( uxPeriodClassesInUse < ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            /* Every class is in use, so the period must already have one. */
+            for( uxClass = ( UBaseType_t ) 1U; uxClass < ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS; uxClass++ )
             {
-                /* The tick time has not overflowed.  In this case we will
-                 * delay if either the wake time has overflowed, and/or the
-                 * tick time is less than the wake time. */
-                if( ( xTimeToWake < *pxPreviousWakeTime ) || ( xTimeToWake > xConstTickCount ) )
+                if( xPeriodClasses[ uxClass ].xPeriod == xPeriod )
                 {
-                    xShouldDelay = pdTRUE;
+                    xReturn = pdTRUE;
+                    break;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
+        }
 
-            /* Update the wake time ready for the next call. */
-            *pxPreviousWakeTime = xTimeToWake;
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-            if( xShouldDelay != pdFALSE )
+    static BaseType_t prvMeetsDeadline( const TCB_t * const pxTask,
+                                        UBaseType_t uxPriority,
+                                        TickType_t xBurst,
+                                        TickType_t xPeriod,
+                                        TickType_t xDeadline,
+                                        UBaseType_t uxNewPriority,
+                                        TickType_t xNewBurst,
+                                        TickType_t xNewPeriod,
+                                        TickType_t xNewJitter )
+    {
+        const ListItem_t * pxIterator;
+        const ListItem_t * const pxEnd = listGET_END_MARKER( &xAdmittedTasksList );
+        const TCB_t * pxOther;
+        TickType_t xResponseTime;
+        TickType_t xNextResponseTime;
+        BaseType_t xReturn = pdTRUE;
+
+        #if ( configUSE_MUTEX_CEILING == 1 )
+            const TickType_t xBlockingTime = prvBlockingTime( uxPriority, xPeriod );
+
+            /* A job is blocked at most once, so the blocking is paid along with
+             * the burst. */
+            if( xBlockingTime > ( xDeadline - xBurst ) )
             {
-                traceTASK_DELAY_UNTIL( xTimeToWake );
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                xBurst += xBlockingTime;
+            }
+        #endif /* configUSE_MUTEX_CEILING */
 
-                /* prvAddCurrentTaskToDelayedList() needs the block time, not
-                 * the time to wake, so subtract the current tick count. */
-                prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
+        xResponseTime = xBurst;
+
+        /* R = C + B + sum( ceil( ( R + Jj ) / Tj ) * Cj ) over the tasks that
+         * can delay this one, where B is the blocking and Jj the release
+         * jitter of task j, iterated from R = C + B until it stops changing or
+         * passes the deadline.  R only grows, so the loop ends.  Each step is
+         * checked against the deadline as it is added so the sum cannot
+         * wrap. */
+        while( xReturn != pdFALSE )
+        {
+            xNextResponseTime = xBurst;
+
+            if( ( pxTask != NULL ) && ( taskRM_CAN_DELAY( uxNewPriority, xNewPeriod, uxPriority, xPeriod ) != pdFALSE ) )
+            {
+                xNextResponseTime += ( ( ( ( xResponseTime + xNewJitter ) - ( TickType_t ) 1U ) / xNewPeriod ) + ( TickType_t ) 1U ) * xNewBurst;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-        }
-        xAlreadyYielded = xTaskResumeAll();
 
-        /* Force a reschedule if xTaskResumeAll has not already done so, we may
-         * have put ourselves to sleep. */
-        if( xAlreadyYielded == pdFALSE )
-        {
-            portYIELD_WITHIN_API();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-
-        return xShouldDelay;
-    }
-
-#endif /* INCLUDE_xTaskDelayUntil */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_vTaskDelay == 1 )
+            for( pxIterator = listGET_HEAD_ENTRY( &xAdmittedTasksList ); ( pxIterator != pxEnd ) && ( xNextResponseTime <= xDeadline ); pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                pxOther = listGET_LIST_ITEM_OWNER( pxIterator );
 
-    void vTaskDelay( const TickType_t xTicksToDelay )
-    {
-        BaseType_t xAlreadyYielded = pdFALSE;
+                if( ( pxOther != pxTask ) && ( taskRM_CAN_DELAY( ( UBaseType_t ) listGET_LIST_ITEM_VALUE( pxIterator ), pxOther->xPeriod, uxPriority, xPeriod ) != pdFALSE ) )
+                {
+                    xNextResponseTime += ( ( ( ( xResponseTime + taskRM_RELEASE_JITTER( pxOther ) ) - ( TickType_t ) 1U ) / pxOther->xPeriod ) + ( TickType_t ) 1U ) * pxOther->xCpuBurst;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
 
-        /* A delay time of zero just forces a reschedule. */
-        if( xTicksToDelay > ( TickType_t ) 0U )
-        {
-            configASSERT( uxSchedulerSuspended == 0 );
-            vTaskSuspendAll();
+            if( xNextResponseTime > xDeadline )
             {
-                traceTASK_DELAY();
-
-                /* A task that is removed from the event list while the
-                 * scheduler is suspended will not get placed in the ready
-                 * list or removed from the blocked list until the scheduler
-                 * is resumed.
-                 *
-                 * This task cannot be in an event list as it is the currently
-                 * executing task. */
-                prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+                xReturn = pdFALSE;
+                break;
+            }
+            else if( xNextResponseTime == xResponseTime )
+            {
+                break;
+            }
+            else
+            {
+                xResponseTime = xNextResponseTime;
             }
-            xAlreadyYielded = xTaskResumeAll();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
         }
 
-        /* Force a reschedule if xTaskResumeAll has not already done so, we may
-         * have put ourselves to sleep. */
-        if( xAlreadyYielded == pdFALSE )
-        {
-            portYIELD_WITHIN_API();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        return xReturn;
     }
-
-#endif /* INCLUDE_vTaskDelay */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
-
-    eTaskState eTaskGetState( TaskHandle_t xTask )
-    {
-        eTaskState eReturn;
-        List_t const * pxStateList;
-        List_t const * pxDelayedList;
-        List_t const * pxOverflowedDelayedList;
-        const TCB_t * const pxTCB = xTask;
-
-        configASSERT( pxTCB );
+    #if ( configUSE_MUTEX_CEILING == 1 )
 
-        if( pxTCB == pxCurrentTCB )
+        static TickType_t prvBlockingTime( UBaseType_t uxPriority,
+                                           TickType_t xPeriod )
         {
-            /* The task calling this function is querying its own state. */
-            eReturn = eRunning;
-        }
-        else
-        {
-            taskENTER_CRITICAL();
-            {
-                pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-                pxDelayedList = pxDelayedTaskList;
-                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
-            }
-            taskEXIT_CRITICAL();
+            const MutexCeiling_t * pxCeiling;
+            TickType_t xBlockingTime = ( TickType_t ) 0U;
 
-            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            for( pxCeiling = pxMutexCeilings; pxCeiling != NULL; pxCeiling = pxCeiling->pxNext )
             {
-                /* The task being queried is referenced from one of the Blocked
-                 * lists. */
-                eReturn = eBlocked;
-            }
-
-            #if ( INCLUDE_vTaskSuspend == 1 )
-                else if( pxStateList == &xSuspendedTaskList )
+                if( ( taskRM_CAN_DELAY( pxCeiling->uxPriority, pxCeiling->xPeriod, uxPriority, xPeriod ) != pdFALSE ) &&
+                    ( pxCeiling->xLongestHold > xBlockingTime ) )
                 {
-                    /* The task being queried is referenced from the suspended
-                     * list.  Is it genuinely suspended or is it blocked
-                     * indefinitely? */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
-                    {
-                        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
-                        {
-                            BaseType_t x;
-
-                            /* The task does not appear on the event list item of
-                             * and of the RTOS objects, but could still be in the
-                             * blocked state if it is waiting on its notification
-                             * rather than waiting on an object.  If not, is
-                             * suspended. */
-                            eReturn = eSuspended;
-
-                            for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
-                            {
-                                if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
-                                {
-                                    eReturn = eBlocked;
-                                    break;
-                                }
-                            }
-                        }
-                        #else /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-                        {
-                            eReturn = eSuspended;
-                        }
-                        #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-                    }
-                    else
-                    {
-                        eReturn = eBlocked;
-                    }
+                    xBlockingTime = pxCeiling->xLongestHold;
                 }
-            #endif /* if ( INCLUDE_vTaskSuspend == 1 ) */
-
-            #if ( INCLUDE_vTaskDelete == 1 )
-                else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
+                else
                 {
-                    /* The task being queried is referenced from the deleted
-                     * tasks list, or it is not referenced from any lists at
-                     * all. */
-                    eReturn = eDeleted;
+                    mtCOVERAGE_TEST_MARKER();
                 }
-            #endif
-
-            else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
-            {
-                /* If the task is not in any other state, it must be in the
-                 * Ready (including pending ready) state. */
-                eReturn = eReady;
             }
+
+            return xBlockingTime;
         }
 
-        return eReturn;
-    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
+    #endif /* configUSE_MUTEX_CEILING */
 
-#endif /* INCLUDE_eTaskGetState */
+#endif /* configUSE_RM_ADMISSION_CONTROL */
 /*-----------------------------------------------------------*/
 
-int uxTaskCpuBurstGet( const TaskHandle_t xTask )
-    {
-        TCB_t const * pxTCB;
-        int uxReturn;
+static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
+                                  const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                  const uint32_t ulStackDepth,
+                                  void * const pvParameters,
+                                  UBaseType_t uxPriority,
+                                  TaskHandle_t * const pxCreatedTask,
+                                  TCB_t * pxNewTCB,
+                                  const MemoryRegion_t * const xRegions,
+                                  TickType_t xCpuBurst,
+                                  TickType_t xPeriod )
+{
+    StackType_t * pxTopOfStack;
+    UBaseType_t x;
 
-        taskENTER_CRITICAL();
+    #if ( portUSING_MPU_WRAPPERS == 1 )
+        /* Should the task be created in privileged mode? */
+        BaseType_t xRunPrivileged;
+
+        if( ( uxPriority & portPRIVILEGE_BIT ) != 0U )
         {
-            /* If null is passed in here then it is the priority of the task
-             * that called uxTaskPriorityGet() that is being queried. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-            uxReturn = pxTCB->CpuBurst;
+            xRunPrivileged = pdTRUE;
         }
-        taskEXIT_CRITICAL();
+        else
+        {
+            xRunPrivileged = pdFALSE;
+        }
+        uxPriority &= ~portPRIVILEGE_BIT;
+    #endif /* portUSING_MPU_WRAPPERS == 1 */
 
-        return uxReturn;
+    /* Avoid dependency on memset() if it is not required. */
+    #if ( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
+    {
+        /* Fill the stack with a known value to assist debugging. */
+        ( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulStackDepth * sizeof( StackType_t ) );
     }
+    #endif /* tskSET_NEW_STACKS_TO_KNOWN_VALUE */
 
-int uxTaskPeriodGet( const TaskHandle_t xTask )
+    /* Calculate the top of stack address.  This depends on whether the stack
+     * grows from high memory to low (as per the 80x86) or vice versa.
+     * portSTACK_GROWTH is used to make the result positive or negative as required
+     * by the port. */
+    #if ( portSTACK_GROWTH < 0 )
     {
-        TCB_t const * pxTCB;
-        int uxReturn;
+        pxTopOfStack = &( pxNewTCB->pxStack[ ulStackDepth - ( uint32_t ) 1 ] );
+        pxTopOfStack = ( StackType_t * ) ( ( ( portPOINTER_SIZE_TYPE ) pxTopOfStack ) & ( ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) ); /*lint !e923 !e9033 !e9078 MISRA exception.  Avoiding casts between pointers and integers is not practical.  Size differences accounted for using portPOINTER_SIZE_TYPE type.  Checked by assert(). */
 
-        taskENTER_CRITICAL();
+        /* Check the alignment of the calculated top of stack is correct. */
+        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pxTopOfStack & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0UL ) );
+
+        #if ( configRECORD_STACK_HIGH_ADDRESS == 1 )
         {
-            /* If null is passed in here then it is the priority of the task
-             * that called uxTaskPriorityGet() that is being queried. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-            uxReturn = pxTCB->period;
+            /* Also record the stack's high address, which may assist
+             * debugging. */
+            pxNewTCB->pxEndOfStack = pxTopOfStack;
         }
-        taskEXIT_CRITICAL();
-
-        return uxReturn;
+        #endif /* configRECORD_STACK_HIGH_ADDRESS */
     }
-
-const char* uxTaskNameGet( const TaskHandle_t xTask )
+    #else /* portSTACK_GROWTH */
     {
-        TCB_t const * pxTCB;
-        const char* uxReturn;
+        pxTopOfStack = pxNewTCB->pxStack;
 
-        taskENTER_CRITICAL();
-        {
-            /* If null is passed in here then it is the priority of the task
-             * that called uxTaskPriorityGet() that is being queried. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-            uxReturn = (char *) pxTCB->pcTaskName;
-        }
-        taskEXIT_CRITICAL();
+        /* Check the alignment of the stack buffer is correct. */
+        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pxNewTCB->pxStack & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0UL ) );
 
-        return uxReturn;
+        /* The other extreme of the stack space is required if stack checking is
+         * performed. */
+        pxNewTCB->pxEndOfStack = pxNewTCB->pxStack + ( ulStackDepth - ( uint32_t ) 1 );
     }
+    #endif /* portSTACK_GROWTH */
 
+    /* A task without a period sorts after every periodic task. */
+    if( xPeriod == ( TickType_t ) 0U )
+    {
+        xPeriod = portMAX_DELAY;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 
-#if ( INCLUDE_uxTaskPriorityGet == 1 )
+    pxNewTCB->xCpuBurst = xCpuBurst;
+    pxNewTCB->xPeriod = xPeriod;
+    pxNewTCB->xDeadline = xPeriod;
 
-    UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask )
+    /* Store the task name in the TCB. */
+    if( pcName != NULL )
     {
-        TCB_t const * pxTCB;
-        UBaseType_t uxReturn;
-
-        taskENTER_CRITICAL();
+        for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
         {
-            /* If null is passed in here then it is the priority of the task
-             * that called uxTaskPriorityGet() that is being queried. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-            uxReturn = pxTCB->uxPriority;
+            pxNewTCB->pcTaskName[ x ] = pcName[ x ];
+
+            /* Don't copy all configMAX_TASK_NAME_LEN if the string is shorter than
+             * configMAX_TASK_NAME_LEN characters just in case the memory after the
+             * string is not accessible (extremely unlikely). */
+            if( pcName[ x ] == ( char ) 0x00 )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        taskEXIT_CRITICAL();
 
-        return uxReturn;
+        /* Ensure the name string is terminated in the case that the string length
+         * was greater or equal to configMAX_TASK_NAME_LEN. */
+        pxNewTCB->pcTaskName[ configMAX_TASK_NAME_LEN - 1 ] = '\0';
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
     }
 
-#endif /* INCLUDE_uxTaskPriorityGet */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_uxTaskPriorityGet == 1 )
+    /* This is used as an array index so must ensure it's not too large. */
+    configASSERT( uxPriority < configMAX_PRIORITIES );
 
-    UBaseType_t uxTaskPriorityGetFromISR( const TaskHandle_t xTask )
+    if( uxPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
     {
-        TCB_t const * pxTCB;
-        UBaseType_t uxReturn, uxSavedInterruptState;
+        uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+    pxNewTCB->uxPriority = uxPriority;
+    #if ( configUSE_MUTEXES == 1 )
+    {
+        pxNewTCB->uxBasePriority = uxPriority;
+    }
+    #endif /* configUSE_MUTEXES */
 
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+    vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
+    vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
-        uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
-        {
-            /* If null is passed in here then it is the priority of the calling
-             * task that is being queried. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-            uxReturn = pxTCB->uxPriority;
-        }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+    /* Set the pxNewTCB as a link back from the ListItem_t.  This is so we can get
+     * back to  the containing TCB from a generic item in a list. */
+    listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
 
-        return uxReturn;
+    /* Event lists are always in priority order. */
+    listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+    listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
+
+    #if ( configUSE_RM_ADMISSION_CONTROL == 1 )
+    {
+        vListInitialiseItem( &( pxNewTCB->xAdmissionListItem ) );
+        listSET_LIST_ITEM_OWNER( &( pxNewTCB->xAdmissionListItem ), pxNewTCB );
     }
+    #endif
 
-#endif /* INCLUDE_uxTaskPriorityGet */
-/*-----------------------------------------------------------*/
+    #if ( configUSE_RM_AUTO_PRIORITY == 1 )
+    {
+        vListInitialiseItem( &( pxNewTCB->xRateListItem ) );
+        listSET_LIST_ITEM_OWNER( &( pxNewTCB->xRateListItem ), pxNewTCB );
+        listSET_LIST_ITEM_VALUE( &( pxNewTCB->xRateListItem ), pxNewTCB->xPeriod );
+    }
+    #endif
 
-#if ( INCLUDE_vTaskPrioritySet == 1 )
+    #if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+    {
+        vListInitialiseItem( &( pxNewTCB->xDeadlineListItem ) );
+        listSET_LIST_ITEM_OWNER( &( pxNewTCB->xDeadlineListItem ), pxNewTCB );
+    }
+    #endif
 
-    void vTaskPrioritySet( TaskHandle_t xTask,
-                           UBaseType_t uxNewPriority )
+    #if ( portUSING_MPU_WRAPPERS == 1 )
     {
-        TCB_t * pxTCB;
-        UBaseType_t uxCurrentBasePriority, uxPriorityUsedOnEntry;
-        BaseType_t xYieldRequired = pdFALSE;
+        vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
+    }
+    #else
+    {
+        /* Avoid compiler warning about unreferenced parameter. */
+        ( void ) xRegions;
+    }
+    #endif
 
-        configASSERT( uxNewPriority < configMAX_PRIORITIES );
+    #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+    {
+        /* Allocate and initialize memory for the task's TLS Block. */
+        configINIT_TLS_BLOCK( pxNewTCB->xTLSBlock );
+    }
+    #endif
 
-        /* Ensure the new priority is valid. */
-        if( uxNewPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+    /* Initialize the TCB stack to look as if the task was already running,
+     * but had been interrupted by the scheduler.  The return address is set
+     * to the start of the task function. Once the stack has been initialised
+     * the top of stack variable is updated. */
+    #if ( portUSING_MPU_WRAPPERS == 1 )
+    {
+        /* If the port has capability to detect stack overflow,
+         * pass the stack end address to the stack initialization
+         * function as well. */
+        #if ( portHAS_STACK_OVERFLOW_CHECKING == 1 )
         {
-            uxNewPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+            #if ( portSTACK_GROWTH < 0 )
+            {
+                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxStack, pxTaskCode, pvParameters, xRunPrivileged );
+            }
+            #else /* portSTACK_GROWTH */
+            {
+                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxEndOfStack, pxTaskCode, pvParameters, xRunPrivileged );
+            }
+            #endif /* portSTACK_GROWTH */
         }
-        else
+        #else /* portHAS_STACK_OVERFLOW_CHECKING */
         {
-            mtCOVERAGE_TEST_MARKER();
+            pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxTaskCode, pvParameters, xRunPrivileged );
         }
-
-        taskENTER_CRITICAL();
+        #endif /* portHAS_STACK_OVERFLOW_CHECKING */
+    }
+    #else /* portUSING_MPU_WRAPPERS */
+    {
+        /* If the port has capability to detect stack overflow,
+         * pass the stack end address to the stack initialization
+         * function as well. */
+        #if ( portHAS_STACK_OVERFLOW_CHECKING == 1 )
         {
-            /* If null is passed in here then it is the priority of the calling
-             * task that is being changed. */
-            pxTCB = prvGetTCBFromHandle( xTask );
+            #if ( portSTACK_GROWTH < 0 )
+            {
+                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxStack, pxTaskCode, pvParameters );
+            }
+            #else /* portSTACK_GROWTH */
+            {
+                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxEndOfStack, pxTaskCode, pvParameters );
+            }
+            #endif /* portSTACK_GROWTH */
+        }
+        #else /* portHAS_STACK_OVERFLOW_CHECKING */
+        {
+            pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxTaskCode, pvParameters );
+        }
+        #endif /* portHAS_STACK_OVERFLOW_CHECKING */
+    }
+    #endif /* portUSING_MPU_WRAPPERS */
 
-            traceTASK_PRIORITY_SET( pxTCB, uxNewPriority );
+    if( pxCreatedTask != NULL )
+    {
+        /* Pass the handle out in an anonymous way.  The handle can be used to
+         * change the created task's priority, delete the created task, etc.*/
+        *pxCreatedTask = ( TaskHandle_t ) pxNewTCB;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
 
-            #if ( configUSE_MUTEXES == 1 )
+static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+{
+    BaseType_t xRatePrioritiesChanged = pdFALSE;
+
+    /* Ensure interrupts don't access the task lists while the lists are being
+     * updated. */
+    taskENTER_CRITICAL();
+    {
+        uxCurrentNumberOfTasks++;
+
+        if( pxCurrentTCB == NULL )
+        {
+            /* There are no other tasks, or all the other tasks are in
+             * the suspended state - make this the current task. */
+            pxCurrentTCB = pxNewTCB;
+
+            if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
             {
-                uxCurrentBasePriority = pxTCB->uxBasePriority;
+                /* This is the first task to be created so do the preliminary
+                 * initialisation required.  We will not recover if this call
+                 * fails, but we will report the failure. */
+                prvInitialiseTaskLists();
             }
-            #else
+            else
             {
-                uxCurrentBasePriority = pxTCB->uxPriority;
+                mtCOVERAGE_TEST_MARKER();
             }
-            #endif
-
-            if( uxCurrentBasePriority != uxNewPriority )
+        }
+        else
+        {
+            /* If the scheduler is not already running, make this task the
+             * current task if it is the highest priority task to be created
+             * so far. */
+            if( xSchedulerRunning == pdFALSE )
             {
-                /* The priority change may have readied a task of higher
-                 * priority than the calling task. */
-                if( uxNewPriority > uxCurrentBasePriority )
-                {
-                    if( pxTCB != pxCurrentTCB )
-                    {
-                        /* The priority of a task other than the currently
-                         * running task is being raised.  Is the priority being
-                         * raised above that of the running task? */
-                        if( uxNewPriority >= pxCurrentTCB->uxPriority )
-                        {
-                            xYieldRequired = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    else
-                    {
-                        /* The priority of the running task is being raised,
-                         * but the running task must already be the highest
-                         * priority task able to run so no yield is required. */
-                    }
-                }
-                else if( pxTCB == pxCurrentTCB )
+                if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
                 {
-                    /* Setting the priority of the running task down means
-                     * there may now be another task of higher priority that
-                     * is ready to execute. */
-                    xYieldRequired = pdTRUE;
+                    pxCurrentTCB = pxNewTCB;
                 }
                 else
                 {
-                    /* Setting the priority of any other task down does not
-                     * require a yield as the running task must be above the
-                     * new priority of the task being modified. */
+                    mtCOVERAGE_TEST_MARKER();
                 }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
 
-                /* Remember the ready list the task might be referenced from
-                 * before its uxPriority member is changed so the
-                 * taskRESET_READY_PRIORITY() macro can function correctly. */
-                uxPriorityUsedOnEntry = pxTCB->uxPriority;
-
-                #if ( configUSE_MUTEXES == 1 )
-                {
-                    /* Only change the priority being used if the task is not
-                     * currently using an inherited priority. */
-                    if( pxTCB->uxBasePriority == pxTCB->uxPriority )
-                    {
-                        pxTCB->uxPriority = uxNewPriority;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* The base priority gets set whatever. */
-                    pxTCB->uxBasePriority = uxNewPriority;
-                }
-                #else /* if ( configUSE_MUTEXES == 1 ) */
-                {
-                    pxTCB->uxPriority = uxNewPriority;
-                }
-                #endif /* if ( configUSE_MUTEXES == 1 ) */
+        uxTaskNumber++;
 
-                /* Only reset the event list item value if the value is not
-                 * being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-                {
-                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+        #if ( configUSE_TRACE_FACILITY == 1 )
+        {
+            /* Add a counter into the TCB for tracing only. */
+            pxNewTCB->uxTCBNumber = uxTaskNumber;
+        }
+        #endif /* configUSE_TRACE_FACILITY */
+        traceTASK_CREATE( pxNewTCB );
 
-                /* If the task is in the blocked or suspended list we need do
-                 * nothing more than change its priority variable. However, if
-                 * the task is in a ready list it needs to be removed and placed
-                 * in the list appropriate to its new priority. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
-                {
-                    /* The task is currently in its ready list - remove before
-                     * adding it to its new ready list.  As we are in a critical
-                     * section we can do this even if the scheduler is suspended. */
-                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                    {
-                        /* It is known that the task is in its ready list so
-                         * there is no need to check again and the port level
-                         * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+        #if ( configUSE_RM == 1 )
+        {
+            pxNewTCB->uxPeriodClass = prvAcquirePeriodClass( pxNewTCB->xPeriod );
 
-                    prvAddTaskToReadyList( pxTCB );
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+            /* A task with a period that has no class of its own would run
+             * below every task with a period, out of RM order.  Raise
+             * configRM_MAX_DISTINCT_PERIODS if this assert fails. */
+            configASSERT( ( pxNewTCB->uxPeriodClass != taskRM_NO_PERIOD_CLASS ) || ( pxNewTCB->xPeriod == portMAX_DELAY ) );
 
-                if( xYieldRequired != pdFALSE )
-                {
-                    taskYIELD_IF_USING_PREEMPTION();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+            #if ( configUSE_MUTEX_CEILING == 1 )
+            {
+                pxNewTCB->uxBasePeriodClass = pxNewTCB->uxPeriodClass;
+            }
+            #endif
+        }
+        #endif
 
-                /* Remove compiler warning about unused variables when the port
-                 * optimised task selection is not being used. */
-                ( void ) uxPriorityUsedOnEntry;
+        #if ( configUSE_RM_AUTO_PRIORITY == 1 )
+        {
+            /* The new task takes the priority of its period, which can move
+             * the tasks with longer periods down.  The scheduler selects again
+             * when it starts, so only a running scheduler has to yield. */
+            if( pxNewTCB->xPeriod != portMAX_DELAY )
+            {
+                vListInsert( &xRateOrderedTasksList, &( pxNewTCB->xRateListItem ) );
+                xRatePrioritiesChanged = prvAssignRatePriorities();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        taskEXIT_CRITICAL();
+        #endif
+
+        prvAddTaskToReadyList( pxNewTCB );
+
+        portSETUP_TCB( pxNewTCB );
     }
+    taskEXIT_CRITICAL();
 
-#endif /* INCLUDE_vTaskPrioritySet */
+    if( xSchedulerRunning != pdFALSE )
+    {
+        /* If the created task comes before the current task then it should
+         * run now.  The same holds if the running task was moved down to make
+         * room for the period of the created task. */
+        if( taskPREEMPTS_CURRENT( pxNewTCB ) || ( xRatePrioritiesChanged != pdFALSE ) )
+        {
+            taskYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if ( INCLUDE_vTaskDelete == 1 )
 
-    void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+    void vTaskDelete( TaskHandle_t xTaskToDelete )
     {
         TCB_t * pxTCB;
 
         taskENTER_CRITICAL();
         {
-            /* If null is passed in here then it is the running task that is
-             * being suspended. */
-            pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
-
-            traceTASK_SUSPEND( pxTCB );
+            /* If null is passed in here then it is the calling task that is
+             * being deleted. */
+            pxTCB = prvGetTCBFromHandle( xTaskToDelete );
 
-            /* Remove task from the ready/delayed list and place in the
-             * suspended list. */
+            /* Remove task from the ready/delayed list. */
             if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
             {
-                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+                taskRESET_READY_TASK( pxTCB, pxTCB->uxPriority );
             }
             else
             {
@@ -1817,154 +2826,81 @@ const char* uxTaskNameGet( const TaskHandle_t xTask )
                 mtCOVERAGE_TEST_MARKER();
             }
 
-            vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
-
-            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+            #if ( ( configUSE_RM == 1 ) && ( configUSE_MUTEX_CEILING == 1 ) )
             {
-                BaseType_t x;
-
-                for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
-                {
-                    if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
-                    {
-                        /* The task was blocked to wait for a notification, but is
-                         * now suspended, so no notification was received. */
-                        pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
-                    }
-                }
+                prvReleasePeriodClass( pxTCB->uxBasePeriodClass );
             }
-            #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-        }
-        taskEXIT_CRITICAL();
-
-        if( xSchedulerRunning != pdFALSE )
-        {
-            /* Reset the next expected unblock time in case it referred to the
-             * task that is now in the Suspended state. */
-            taskENTER_CRITICAL();
+            #elif ( configUSE_RM == 1 )
             {
-                prvResetNextTaskUnblockTime();
+                prvReleasePeriodClass( pxTCB->uxPeriodClass );
             }
-            taskEXIT_CRITICAL();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+            #endif
 
-        if( pxTCB == pxCurrentTCB )
-        {
-            if( xSchedulerRunning != pdFALSE )
-            {
-                /* The current task has just been suspended. */
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
-            }
-            else
+            #if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
             {
-                /* The scheduler is not running, but the task that was pointed
-                 * to by pxCurrentTCB has just been suspended and pxCurrentTCB
-                 * must be adjusted to point to a different task. */
-                if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+                if( listLIST_ITEM_CONTAINER( &( pxTCB->xDeadlineListItem ) ) != NULL )
                 {
-                    /* No other tasks are ready, so set pxCurrentTCB back to
-                     * NULL so when the next task is created pxCurrentTCB will
-                     * be set to point to it no matter what its relative priority
-                     * is. */
-                    pxCurrentTCB = NULL;
+                    ( void ) uxListRemove( &( pxTCB->xDeadlineListItem ) );
                 }
                 else
                 {
-                    vTaskSwitchContext();
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-
-#endif /* INCLUDE_vTaskSuspend */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_vTaskSuspend == 1 )
-
-    static BaseType_t prvTaskIsTaskSuspended( const TaskHandle_t xTask )
-    {
-        BaseType_t xReturn = pdFALSE;
-        const TCB_t * const pxTCB = xTask;
-
-        /* Accesses xPendingReadyList so must be called from a critical
-         * section. */
-
-        /* It does not make sense to check if the calling task is suspended. */
-        configASSERT( xTask );
+            #endif
 
-        /* Is the task being resumed actually in the suspended list? */
-        if( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE )
-        {
-            /* Has the task already been resumed from within an ISR? */
-            if( listIS_CONTAINED_WITHIN( &xPendingReadyList, &( pxTCB->xEventListItem ) ) == pdFALSE )
+            #if ( configUSE_RM_AUTO_PRIORITY == 1 )
             {
-                /* Is it in the suspended list because it is in the Suspended
-                 * state, or because is is blocked with no timeout? */
-                if( listIS_CONTAINED_WITHIN( NULL, &( pxTCB->xEventListItem ) ) != pdFALSE ) /*lint !e961.  The cast is only redundant when NULL is used. */
+                /* The tasks with longer periods move up to close the gap. */
+                if( listIS_CONTAINED_WITHIN( &xRateOrderedTasksList, &( pxTCB->xRateListItem ) ) != pdFALSE )
                 {
-                    xReturn = pdTRUE;
+                    ( void ) uxListRemove( &( pxTCB->xRateListItem ) );
+
+                    if( ( prvAssignRatePriorities() != pdFALSE ) && ( xSchedulerRunning != pdFALSE ) )
+                    {
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-
-        return xReturn;
-    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
-
-#endif /* INCLUDE_vTaskSuspend */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_vTaskSuspend == 1 )
-
-    void vTaskResume( TaskHandle_t xTaskToResume )
-    {
-        TCB_t * const pxTCB = xTaskToResume;
-
-        /* It does not make sense to resume the calling task. */
-        configASSERT( xTaskToResume );
+            #endif /* configUSE_RM_AUTO_PRIORITY */
 
-        /* The parameter cannot be NULL as it is impossible to resume the
-         * currently executing task. */
-        if( ( pxTCB != pxCurrentTCB ) && ( pxTCB != NULL ) )
-        {
-            taskENTER_CRITICAL();
+            #if ( configUSE_RM_ADMISSION_CONTROL == 1 )
             {
-                if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+                /* Return the utilisation of an admitted task. */
+                if( listIS_CONTAINED_WITHIN( &xAdmittedTasksList, &( pxTCB->xAdmissionListItem ) ) != pdFALSE )
                 {
-                    traceTASK_RESUME( pxTCB );
+                    ( void ) uxListRemove( &( pxTCB->xAdmissionListItem ) );
+                    ulAdmittedUtilisation -= taskRM_UTILISATION( pxTCB->xCpuBurst, pxTCB->xPeriod );
 
-                    /* The ready list can be accessed even if the scheduler is
-                     * suspended because this is inside a critical section. */
-                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                    if( pxTCB->xDeadline != pxTCB->xPeriod )
+                    {
+                        uxAdmittedConstrainedDeadlines--;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-                    /* A higher priority task may have just been resumed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    if( taskRM_RELEASE_JITTER( pxTCB ) != ( TickType_t ) 0U )
                     {
-                        /* This yield may not cause the task just resumed to run,
-                         * but will leave the lists in the correct state for the
-                         * next yield. */
-                        taskYIELD_IF_USING_PREEMPTION();
+                        uxAdmittedJitteredTasks--;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( listLIST_IS_EMPTY( &xAdmittedTasksList ) != pdFALSE )
+                    {
+                        xAdmittedPrioritiesDiffer = pdFALSE;
                     }
                     else
                     {
@@ -1976,420 +2912,322 @@ const char* uxTaskNameGet( const TaskHandle_t xTask )
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-            taskEXIT_CRITICAL();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-
-#endif /* INCLUDE_vTaskSuspend */
+            #endif /* configUSE_RM_ADMISSION_CONTROL */
 
-/*-----------------------------------------------------------*/
-
-#if ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
+            /* Increment the uxTaskNumber also so kernel aware debuggers can
+             * detect that the task lists need re-generating.  This is done before
+             * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
+             * not return. */
+            uxTaskNumber++;
 
-    BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
-    {
-        BaseType_t xYieldRequired = pdFALSE;
-        TCB_t * const pxTCB = xTaskToResume;
-        UBaseType_t uxSavedInterruptStatus;
+            if( pxTCB == pxCurrentTCB )
+            {
+                /* A task is deleting itself.  This cannot complete within the
+                 * task itself, as a context switch to another task is required.
+                 * Place the task in the termination list.  The idle task will
+                 * check the termination list and free up any memory allocated by
+                 * the scheduler for the TCB and stack of the deleted task. */
+                vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
 
-        configASSERT( xTaskToResume );
+                /* Increment the ucTasksDeleted variable so the idle task knows
+                 * there is a task that has been deleted and that it should therefore
+                 * check the xTasksWaitingTermination list. */
+                ++uxDeletedTasksWaitingCleanUp;
 
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+                /* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
+                 * portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
+                traceTASK_DELETE( pxTCB );
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
-        {
-            if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+                /* The pre-delete hook is primarily for the Windows simulator,
+                 * in which Windows specific clean up operations are performed,
+                 * after which it is not possible to yield away from this task -
+                 * hence xYieldPending is used to latch that a context switch is
+                 * required. */
+                portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+            }
+            else
             {
-                traceTASK_RESUME_FROM_ISR( pxTCB );
+                --uxCurrentNumberOfTasks;
+                traceTASK_DELETE( pxTCB );
 
-                /* Check the ready lists can be accessed. */
-                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-                {
-                    /* Ready lists can be accessed so move the task from the
-                     * suspended list to the ready list directly. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-                    {
-                        xYieldRequired = pdTRUE;
+                /* Reset the next expected unblock time in case it referred to
+                 * the task that has just been deleted. */
+                prvResetNextTaskUnblockTime();
+            }
+        }
+        taskEXIT_CRITICAL();
 
-                        /* Mark that a yield is pending in case the user is not
-                         * using the return value to initiate a context switch
-                         * from the ISR using portYIELD_FROM_ISR. */
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+        /* If the task is not deleting itself, call prvDeleteTCB from outside of
+         * critical section. If a task deletes itself, prvDeleteTCB is called
+         * from prvCheckTasksWaitingTermination which is called from Idle task. */
+        if( pxTCB != pxCurrentTCB )
+        {
+            prvDeleteTCB( pxTCB );
+        }
 
-                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
-                }
-                else
-                {
-                    /* The delayed or ready lists cannot be accessed so the task
-                     * is held in the pending ready list until the scheduler is
-                     * unsuspended. */
-                    vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
-                }
+        /* Force a reschedule if it is the currently running task that has just
+         * been deleted. */
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( pxTCB == pxCurrentTCB )
+            {
+                configASSERT( uxSchedulerSuspended == 0 );
+                portYIELD_WITHIN_API();
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-
-        return xYieldRequired;
     }
 
-#endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
+#endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-void vTaskStartScheduler( void )
-{
-    BaseType_t xReturn;
+#if ( INCLUDE_xTaskDelayUntil == 1 )
 
-    /* Add the idle task at the lowest priority. */
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
+                                const TickType_t xTimeIncrement )
     {
-        StaticTask_t * pxIdleTaskTCBBuffer = NULL;
-        StackType_t * pxIdleTaskStackBuffer = NULL;
-        uint32_t ulIdleTaskStackSize;
+        TickType_t xTimeToWake;
+        BaseType_t xAlreadyYielded, xShouldDelay = pdFALSE;
 
-        /* The Idle task is created using user provided RAM - obtain the
-         * address of the RAM then create the idle task. */
-        vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
-        xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
-                                             configIDLE_TASK_NAME,
-                                             ulIdleTaskStackSize,
-                                             ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
-                                             portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                                             pxIdleTaskStackBuffer,
-                                             pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+        configASSERT( pxPreviousWakeTime );
+        configASSERT( ( xTimeIncrement > 0U ) );
+        configASSERT( uxSchedulerSuspended == 0 );
 
-        if( xIdleTaskHandle != NULL )
-        {
-            xReturn = pdPASS;
-        }
-        else
+        vTaskSuspendAll();
         {
-            xReturn = pdFAIL;
+            /* Minor optimisation.  The tick count cannot change in this
+             * block. */
+            const TickType_t xConstTickCount = xTickCount;
+
+            /* Generate the tick time at which the task wants to wake. */
+            xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
+
+            if( xConstTickCount < *pxPreviousWakeTime )
+            {
+                /* The tick count has overflowed since this function was
+                 * lasted called.  In this case the only time we should ever
+                 * actually delay is if the wake time has also  overflowed,
+                 * and the wake time is greater than the tick time.  When this
+                 * is the case it is as if neither time had overflowed. */
+                if( ( xTimeToWake < *pxPreviousWakeTime ) && ( xTimeToWake > xConstTickCount ) )
+                {
+                    xShouldDelay = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The tick time has not overflowed.  In this case we will
+                 * delay if either the wake time has overflowed, and/or the
+                 * tick time is less than the wake time. */
+                if( ( xTimeToWake < *pxPreviousWakeTime ) || ( xTimeToWake > xConstTickCount ) )
+                {
+                    xShouldDelay = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            /* Update the wake time ready for the next call. */
+            *pxPreviousWakeTime = xTimeToWake;
+
+            if( xShouldDelay != pdFALSE )
+            {
+                traceTASK_DELAY_UNTIL( xTimeToWake );
+
+                /* prvAddCurrentTaskToDelayedList() needs the block time, not
+                 * the time to wake, so subtract the current tick count. */
+                prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-    }
-    #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
-    {
-        /* The Idle task is being created using dynamically allocated RAM. */
-        xReturn = xTaskCreate( prvIdleTask,
-                               configIDLE_TASK_NAME,
-                               configMINIMAL_STACK_SIZE,
-                               ( void * ) NULL,
-                               portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                               &xIdleTaskHandle, /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
-                               1,
-                               1 );
-    }
-    #endif /* configSUPPORT_STATIC_ALLOCATION */
+        xAlreadyYielded = xTaskResumeAll();
 
-    #if ( configUSE_TIMERS == 1 )
-    {
-        if( xReturn == pdPASS )
+        /* Force a reschedule if xTaskResumeAll has not already done so, we may
+         * have put ourselves to sleep. */
+        if( xAlreadyYielded == pdFALSE )
         {
-            xReturn = xTimerCreateTimerTask();
+            portYIELD_WITHIN_API();
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        return xShouldDelay;
     }
-    #endif /* configUSE_TIMERS */
 
-    if( xReturn == pdPASS )
+#endif /* INCLUDE_xTaskDelayUntil */
+/*-----------------------------------------------------------*/
+
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
+
+    BaseType_t xTaskJobComplete( void )
     {
-        /* freertos_tasks_c_additions_init() should only be called if the user
-         * definable macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is
-         * the only macro called by the function. */
-        #ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
-        {
-            freertos_tasks_c_additions_init();
-        }
-        #endif
+        TCB_t * const pxTCB = pxCurrentTCB;
+        BaseType_t xShouldDelay;
 
-        /* Interrupts are turned off here, to ensure a tick does not occur
-         * before or during the call to xPortStartScheduler().  The stacks of
-         * the created tasks contain a status word with interrupts switched on
-         * so interrupts will automatically get re-enabled when the first task
-         * starts to run. */
-        portDISABLE_INTERRUPTS();
+        /* Only tasks created with xTaskCreatePeriodic() have a release time. */
+        configASSERT( pxTCB->pxJobCode != NULL );
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        traceTASK_JOB_COMPLETE( pxTCB );
+
+        #if ( configUSE_SCHEDULE_TRACE == 1 )
         {
-            /* Switch C-Runtime's TLS Block to point to the TLS
-             * block specific to the task that will run first. */
-            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+            taskENTER_CRITICAL();
+            {
+                prvRecordScheduleEvent( pxTCB, eTraceJobCompleted );
+            }
+            taskEXIT_CRITICAL();
         }
         #endif
 
-        xNextTaskUnblockTime = portMAX_DELAY;
-        xSchedulerRunning = pdTRUE;
-        xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
-
-        /* If configGENERATE_RUN_TIME_STATS is defined then the following
-         * macro must be defined to configure the timer/counter used to generate
-         * the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
-         * is set to 0 and the following line fails to build then ensure you do not
-         * have portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() defined in your
-         * FreeRTOSConfig.h file. */
-        portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
-
-        #if (configUSE_RM == 1)
+        #if ( configUSE_JOB_STATS == 1 )
         {
-            taskSELECT_TASK_RM();
-        }
-        #else
-        {
-            taskSELECT_HIGHEST_PRIORITY_TASK();
-        }
-        #endif
-
-        traceTASK_SWITCHED_IN();
-
-        /* Setting up the timer tick is hardware specific and thus in the
-         * portable interface. */
-        xPortStartScheduler();
-
-        /* In most cases, xPortStartScheduler() will not return. If it
-         * returns pdTRUE then there was not enough heap memory available
-         * to create either the Idle or the Timer task. If it returned
-         * pdFALSE, then the application called xTaskEndScheduler().
-         * Most ports don't implement xTaskEndScheduler() as there is
-         * nothing to return to. */
-    }
-    else
-    {
-        /* This line will only be reached if the kernel could not be started,
-         * because there was not enough FreeRTOS heap to create the idle task
-         * or the timer task. */
-        configASSERT( xReturn != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY );
-    }
-
-    /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
-     * meaning xIdleTaskHandle is not used anywhere else. */
-    ( void ) xIdleTaskHandle;
-
-    /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
-     * from getting optimized out as it is no longer used by the kernel. */
-    ( void ) uxTopUsedPriority;
-}
-/*-----------------------------------------------------------*/
-
-void vTaskEndScheduler( void )
-{
-    /* Stop the scheduler interrupts and call the portable scheduler end
-     * routine so the original ISRs can be restored if necessary.  The port
-     * layer must ensure interrupts enable  bit is left in the correct state. */
-    portDISABLE_INTERRUPTS();
-    xSchedulerRunning = pdFALSE;
-    vPortEndScheduler();
-}
-/*----------------------------------------------------------*/
+            /* Only this task writes these counts, so they are updated without
+             * a critical section.  A reader sees either the old or the new
+             * value of each. */
+            const TickType_t xResponseTime = xTaskGetTickCount() - pxTCB->xReleaseTime;
 
-void vTaskSuspendAll( void )
-{
-    /* A critical section is not required as the variable is of type
-     * BaseType_t.  Please read Richard Barry's reply in the following link to a
-     * post in the FreeRTOS support forum before reporting this as a bug! -
-     * https://goo.gl/wu4acr */
+            if( xResponseTime > pxTCB->xWorstResponseTime )
+            {
+                pxTCB->xWorstResponseTime = xResponseTime;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
-     * do not otherwise exhibit real time behaviour. */
-    portSOFTWARE_BARRIER();
+            ( pxTCB->uxJobsCompleted )++;
+        }
+        #endif /* configUSE_JOB_STATS */
 
-    /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
-     * is used to allow calls to vTaskSuspendAll() to nest. */
-    ++uxSchedulerSuspended;
+        #if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* The job is done so its deadline no longer needs watching. */
+                if( listLIST_ITEM_CONTAINER( &( pxTCB->xDeadlineListItem ) ) != NULL )
+                {
+                    ( void ) uxListRemove( &( pxTCB->xDeadlineListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-    /* Enforces ordering for ports and optimised compilers that may otherwise place
-     * the above increment elsewhere. */
-    portMEMORY_BARRIER();
-}
-/*----------------------------------------------------------*/
+                #if ( configDEADLINE_MISS_POLICY == pdDEADLINE_MISS_SKIP )
+                {
+                    /* Drop the releases that came and went while the late job
+                     * was still running, so the task resumes at its next
+                     * release instead of running a backlog of late jobs. */
+                    if( pxTCB->ucJobMissed != pdFALSE )
+                    {
+                        TickType_t xNextRelease = pxTCB->xReleaseTime + pxTCB->xPeriod;
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+                        while( ( xNextRelease != xTickCount ) && ( ( TickType_t ) ( xTickCount - xNextRelease ) < taskMAX_JOB_TICKS_AHEAD ) )
+                        {
+                            pxTCB->xReleaseTime = xNextRelease;
+                            xNextRelease += pxTCB->xPeriod;
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configDEADLINE_MISS_POLICY */
 
-    static TickType_t prvGetExpectedIdleTime( void )
-    {
-        TickType_t xReturn;
-        UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
+                pxTCB->ucJobMissed = pdFALSE;
 
-        /* uxHigherPriorityReadyTasks takes care of the case where
-         * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
-         * task that are in the Ready state, even though the idle task is
-         * running. */
-        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
-        {
-            if( uxTopReadyPriority > tskIDLE_PRIORITY )
-            {
-                uxHigherPriorityReadyTasks = pdTRUE;
+                /* The deadline of the next job of a sporadic task is set when
+                 * the job is released. */
+                if( taskHAS_RELEASE_DEADLINE( pxTCB ) != pdFALSE )
+                {
+                    prvSetJobDeadline( pxTCB, pxTCB->xReleaseTime + pxTCB->xPeriod + pxTCB->xDeadline );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
+            taskEXIT_CRITICAL();
         }
-        #else
-        {
-            const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
+        #endif /* configUSE_DEADLINE_MISS_DETECTION */
 
-            /* When port optimised task selection is used the uxTopReadyPriority
-             * variable is used as a bit map.  If bits other than the least
-             * significant bit are set then there are tasks that have a priority
-             * above the idle priority that are in the Ready state.  This takes
-             * care of the case where the co-operative scheduler is in use. */
-            if( uxTopReadyPriority > uxLeastSignificantBit )
+        #if ( configUSE_BUDGET_ENFORCEMENT == 1 )
+        {
+            taskENTER_CRITICAL();
             {
-                uxHigherPriorityReadyTasks = pdTRUE;
+                prvStartJobBudget();
             }
+            taskEXIT_CRITICAL();
         }
-        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
+        #endif
 
-        if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
-        {
-            xReturn = 0;
-        }
-        else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1 )
+        /* Block until the next release.  If the job overran its period the
+         * next release is already due and the task does not block.  A
+         * sporadic task blocks until the minimum inter-arrival time has
+         * passed. */
+        taskENTER_CRITICAL();
         {
-            /* There are other idle priority tasks in the ready state.  If
-             * time slicing is used then the very next tick interrupt must be
-             * processed. */
-            xReturn = 0;
+            pxTCB->xReleaseTime += pxTCB->xPeriod;
+            xShouldDelay = prvAddCurrentTaskToReleaseList();
         }
-        else if( uxHigherPriorityReadyTasks != pdFALSE )
+        taskEXIT_CRITICAL();
+
+        if( xShouldDelay != pdFALSE )
         {
-            /* There are tasks in the Ready state that have a priority above the
-             * idle priority.  This path can only be reached if
-             * configUSE_PREEMPTION is 0. */
-            xReturn = 0;
+            portYIELD_WITHIN_API();
         }
         else
         {
-            xReturn = xNextTaskUnblockTime - xTickCount;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        return xReturn;
+        return xShouldDelay;
     }
 
-#endif /* configUSE_TICKLESS_IDLE */
-/*----------------------------------------------------------*/
-
-BaseType_t xTaskResumeAll( void )
-{
-    TCB_t * pxTCB = NULL;
-    BaseType_t xAlreadyYielded = pdFALSE;
+#endif /* ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) ) */
+/*-----------------------------------------------------------*/
 
-    /* If uxSchedulerSuspended is zero then this function does not match a
-     * previous call to vTaskSuspendAll(). */
-    configASSERT( uxSchedulerSuspended );
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
 
-    /* It is possible that an ISR caused a task to be removed from an event
-     * list while the scheduler was suspended.  If this was the case then the
-     * removed task will have been added to the xPendingReadyList.  Once the
-     * scheduler has been resumed it is safe to move all the pending ready
-     * tasks from this list into their appropriate ready list. */
-    taskENTER_CRITICAL();
+    static BaseType_t prvAddCurrentTaskToReleaseList( void )
     {
-        --uxSchedulerSuspended;
+        const TickType_t xReleaseTime = pxCurrentTCB->xReleaseTime;
+        BaseType_t xDelayed;
 
-        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        if( ( xReleaseTime == xTickCount ) || ( ( TickType_t ) ( xReleaseTime - xTickCount ) > taskMAX_JOB_TICKS_AHEAD ) )
         {
-            if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
-            {
-                /* Move any readied tasks from the pending list into the
-                 * appropriate ready list. */
-                while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
-                {
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    portMEMORY_BARRIER();
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
-
-                    /* If the moved task has a priority higher than or equal to
-                     * the current task then a yield must be performed. */
-                    if( pxTCB->period <= pxCurrentTCB->period )
-                    {
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-
-                if( pxTCB != NULL )
-                {
-                    /* A task was unblocked while the scheduler was suspended,
-                     * which may have prevented the next unblock time from being
-                     * re-calculated, in which case re-calculate it now.  Mainly
-                     * important for low power tickless implementations, where
-                     * this can prevent an unnecessary exit from low power
-                     * state. */
-                    prvResetNextTaskUnblockTime();
-                }
-
-                /* If any ticks occurred while the scheduler was suspended then
-                 * they should be processed now.  This ensures the tick count does
-                 * not  slip, and that any delayed tasks are resumed at the correct
-                 * time. */
-                {
-                    TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
-
-                    if( xPendedCounts > ( TickType_t ) 0U )
-                    {
-                        do
-                        {
-                            if( xTaskIncrementTick() != pdFALSE )
-                            {
-                                xYieldPending = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-
-                            --xPendedCounts;
-                        } while( xPendedCounts > ( TickType_t ) 0U );
-
-                        xPendedTicks = 0;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
+            /* The tick of the release has already been processed, so the job
+             * is released late, now. */
+            prvRecordJobRelease( pxCurrentTCB );
+            xDelayed = pdFALSE;
 
-                if( xYieldPending != pdFALSE )
+            #if ( configUSE_EDF == 1 )
+            {
+                /* The task is still in its ready list under the deadline of
+                 * the job that just completed.  Sort it again under the
+                 * deadline of the new job, and let a task whose deadline is
+                 * now earlier run first. */
+                ( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+                prvSetReadyDeadline( pxCurrentTCB );
+                prvInsertTaskByDeadline( pxCurrentTCB );
+
+                if( listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) != pxCurrentTCB )
                 {
-                    #if ( configUSE_PREEMPTION != 0 )
-                    {
-                        xAlreadyYielded = pdTRUE;
-                    }
-                    #endif
                     taskYIELD_IF_USING_PREEMPTION();
                 }
                 else
@@ -2397,1760 +3235,4921 @@ BaseType_t xTaskResumeAll( void )
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
+            #endif /* configUSE_EDF */
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                taskRESET_READY_TASK( pxCurrentTCB, pxCurrentTCB->uxPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvAddTaskToReleaseList( pxCurrentTCB );
+            xDelayed = pdTRUE;
         }
-    }
-    taskEXIT_CRITICAL();
 
-    return xAlreadyYielded;
-}
+        return xDelayed;
+    }
 /*-----------------------------------------------------------*/
 
-TickType_t xTaskGetTickCount( void )
-{
-    TickType_t xTicks;
-
-    /* Critical section required if running on a 16 bit processor. */
-    portTICK_TYPE_ENTER_CRITICAL();
+    static void prvAddTaskToReleaseList( TCB_t * const pxTCB )
     {
-        xTicks = xTickCount;
-    }
-    portTICK_TYPE_EXIT_CRITICAL();
+        const TickType_t xReleaseTime = pxTCB->xReleaseTime;
 
-    return xTicks;
-}
-/*-----------------------------------------------------------*/
-
-TickType_t xTaskGetTickCountFromISR( void )
-{
-    TickType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call  interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
-
-    uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
-    {
-        xReturn = xTickCount;
-    }
-    portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
-
-UBaseType_t uxTaskGetNumberOfTasks( void )
-{
-    /* A critical section is not required because the variables are of type
-     * BaseType_t. */
-    return uxCurrentNumberOfTasks;
-}
-/*-----------------------------------------------------------*/
-
-char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-{
-    TCB_t * pxTCB;
-
-    /* If null is passed in here then the name of the calling task is being
-     * queried. */
-    pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-    configASSERT( pxTCB );
-    return &( pxTCB->pcTaskName[ 0 ] );
-}
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_xTaskGetHandle == 1 )
-
-    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
-                                                     const char pcNameToQuery[] )
-    {
-        TCB_t * pxNextTCB;
-        TCB_t * pxFirstTCB;
-        TCB_t * pxReturn = NULL;
-        UBaseType_t x;
-        char cNextChar;
-        BaseType_t xBreakLoop;
-
-        /* This function is called with the scheduler suspended. */
+        listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xReleaseTime );
 
-        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        #if ( configUSE_DELAY_WHEEL == 1 )
         {
-            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-
-            do
-            {
-                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-
-                /* Check each character in the name looking for a match or
-                 * mismatch. */
-                xBreakLoop = pdFALSE;
-
-                for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
-                {
-                    cNextChar = pxNextTCB->pcTaskName[ x ];
-
-                    if( cNextChar != pcNameToQuery[ x ] )
-                    {
-                        /* Characters didn't match. */
-                        xBreakLoop = pdTRUE;
-                    }
-                    else if( cNextChar == ( char ) 0x00 )
-                    {
-                        /* Both strings terminated, a match must have been
-                         * found. */
-                        pxReturn = pxNextTCB;
-                        xBreakLoop = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+            const TickType_t xConstTickCount = xTickCount;
+            TickType_t xNextLook;
 
-                    if( xBreakLoop != pdFALSE )
-                    {
-                        break;
-                    }
-                }
+            /* The task waits in the wheel like a delayed task that wakes on
+             * its release time, and the job is released when it is unblocked
+             * by prvProcessDelayWheel(). */
+            xNextLook = prvAddTaskToDelayWheel( pxTCB, xConstTickCount );
 
-                if( pxReturn != NULL )
-                {
-                    /* The handle has been found. */
-                    break;
-                }
-            } while( pxNextTCB != pxFirstTCB );
+            /* A look that falls after the tick count wraps is made on tick 0. */
+            if( ( xNextLook > xConstTickCount ) && ( xNextLook < xNextTaskUnblockTime ) )
+            {
+                xNextTaskUnblockTime = xNextLook;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        else
+        #else /* configUSE_DELAY_WHEEL */
         {
-            mtCOVERAGE_TEST_MARKER();
+            if( xReleaseTime < xTickCount )
+            {
+                /* The release is after the tick count wraps. */
+                vListInsert( pxOverflowJobReleaseList, &( pxTCB->xStateListItem ) );
+            }
+            else
+            {
+                vListInsert( pxJobReleaseList, &( pxTCB->xStateListItem ) );
+            }
         }
-
-        return pxReturn;
+        #endif /* configUSE_DELAY_WHEEL */
     }
-
-#endif /* INCLUDE_xTaskGetHandle */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetHandle == 1 )
+    #if ( configUSE_DELAY_WHEEL == 0 )
 
-    TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    static BaseType_t prvReleaseJobs( const TickType_t xConstTickCount )
     {
-        UBaseType_t uxQueue = configMAX_PRIORITIES;
         TCB_t * pxTCB;
+        List_t * pxTemp;
+        BaseType_t xSwitchRequired = pdFALSE;
+        BaseType_t xSwitchLists = ( xConstTickCount == ( TickType_t ) 0U ) ? pdTRUE : pdFALSE;
 
-        /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
-        configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
-
-        vTaskSuspendAll();
+        /* Releases are held in the order they fall, so the search stops at the
+         * first one that is not due.  When the tick count has just wrapped
+         * every release still in the current list was before the wrap, so is
+         * due, and the lists are switched once it is empty. */
+        for( ; ; )
         {
-            /* Search the ready lists. */
-            do
+            if( listLIST_IS_EMPTY( pxJobReleaseList ) != pdFALSE )
             {
-                uxQueue--;
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
-
-                if( pxTCB != NULL )
+                if( xSwitchLists != pdFALSE )
+                {
+                    pxTemp = pxJobReleaseList;
+                    pxJobReleaseList = pxOverflowJobReleaseList;
+                    pxOverflowJobReleaseList = pxTemp;
+                    xSwitchLists = pdFALSE;
+                    continue;
+                }
+                else
                 {
-                    /* Found the handle. */
                     break;
                 }
-            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-
-            /* Search the delayed lists. */
-            if( pxTCB == NULL )
+            }
+            else
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+                mtCOVERAGE_TEST_MARKER();
             }
 
-            if( pxTCB == NULL )
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxJobReleaseList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            if( ( xSwitchLists == pdFALSE ) && ( listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) > xConstTickCount ) )
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                break;
             }
-
-            #if ( INCLUDE_vTaskSuspend == 1 )
+            else
             {
-                if( pxTCB == NULL )
-                {
-                    /* Search the suspended list. */
-                    pxTCB = prvSearchForNameWithinSingleList( &xSuspendedTaskList, pcNameToQuery );
-                }
+                mtCOVERAGE_TEST_MARKER();
             }
-            #endif
 
-            #if ( INCLUDE_vTaskDelete == 1 )
+            listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+            prvRecordJobRelease( pxTCB );
+            prvAddTaskToReadyList( pxTCB );
+
+            #if ( configUSE_PREEMPTION == 1 )
             {
-                if( pxTCB == NULL )
+                if( taskPREEMPTS_CURRENT( pxTCB ) )
                 {
-                    /* Search the deleted list. */
-                    pxTCB = prvSearchForNameWithinSingleList( &xTasksWaitingTermination, pcNameToQuery );
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
-            #endif
+            #endif /* configUSE_PREEMPTION */
         }
-        ( void ) xTaskResumeAll();
 
-        return pxTCB;
+        return xSwitchRequired;
     }
 
-#endif /* INCLUDE_xTaskGetHandle */
+    #endif /* configUSE_DELAY_WHEEL */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
-                                      const UBaseType_t uxArraySize,
-                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+    static void prvRecordJobRelease( TCB_t * const pxTCB )
     {
-        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+        /* Prevent compiler warnings when nothing is recorded. */
+        ( void ) pxTCB;
 
-        vTaskSuspendAll();
+        if( taskIS_SPORADIC( pxTCB ) == pdFALSE )
         {
-            /* Is there a space in the array for each task in the system? */
-            if( uxArraySize >= uxCurrentNumberOfTasks )
+            #if ( configUSE_RELEASE_JITTER_STATS == 1 )
             {
-                /* Fill in an TaskStatus_t structure with information on each
-                 * task in the Ready state. */
-                do
-                {
-                    uxQueue--;
-                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady );
-                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-
-                /* Fill in an TaskStatus_t structure with information on each
-                 * task in the Blocked state. */
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
-
-                #if ( INCLUDE_vTaskDelete == 1 )
-                {
-                    /* Fill in an TaskStatus_t structure with information on
-                     * each task that has been deleted but not yet cleaned up. */
-                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
-                }
-                #endif
-
-                #if ( INCLUDE_vTaskSuspend == 1 )
-                {
-                    /* Fill in an TaskStatus_t structure with information on
-                     * each task in the Suspended state. */
-                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
-                }
-                #endif
+                prvRecordReleaseJitter( pxTCB );
+            }
+            #endif
 
-                #if ( configGENERATE_RUN_TIME_STATS == 1 )
-                {
-                    if( pulTotalRunTime != NULL )
-                    {
-                        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                            portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
-                        #else
-                            *pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-                        #endif
-                    }
-                }
-                #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
-                {
-                    if( pulTotalRunTime != NULL )
-                    {
-                        *pulTotalRunTime = 0;
-                    }
-                }
-                #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+            #if ( configUSE_JOB_STATS == 1 )
+            {
+                ( pxTCB->uxJobsReleased )++;
             }
-            else
+            #endif
+
+            #if ( configUSE_SCHEDULE_TRACE == 1 )
             {
-                mtCOVERAGE_TEST_MARKER();
+                prvRecordScheduleEvent( pxTCB, eTraceJobReleased );
             }
-        }
-        ( void ) xTaskResumeAll();
+            #endif
 
-        return uxTask;
+            traceTASK_JOB_RELEASED( pxTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
 
-#endif /* configUSE_TRACE_FACILITY */
-/*----------------------------------------------------------*/
+#endif /* ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) ) */
+/*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+#if ( configUSE_RELEASE_JITTER_STATS == 1 )
 
-    TaskHandle_t xTaskGetIdleTaskHandle( void )
+    static void prvRecordReleaseJitter( TCB_t * const pxTCB )
     {
-        /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+        const TickType_t xJitter = xTickCount - pxTCB->xReleaseTime;
+
+        if( xJitter < pxTCB->xMinReleaseJitter )
+        {
+            pxTCB->xMinReleaseJitter = xJitter;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xJitter > pxTCB->xMaxReleaseJitter )
+        {
+            pxTCB->xMaxReleaseJitter = xJitter;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTCB->ullReleaseJitterSum += ( uint64_t ) xJitter;
+        ( pxTCB->uxReleases )++;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetReleaseJitter( const TaskHandle_t xTask,
+                                TaskReleaseJitter_t * pxReleaseJitter )
+    {
+        TCB_t const * pxTCB;
+
+        configASSERT( pxReleaseJitter );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            pxReleaseJitter->uxReleases = pxTCB->uxReleases;
+            pxReleaseJitter->xMinJitter = pxTCB->xMinReleaseJitter;
+            pxReleaseJitter->xMaxJitter = pxTCB->xMaxReleaseJitter;
+
+            if( pxTCB->uxReleases != ( UBaseType_t ) 0U )
+            {
+                pxReleaseJitter->xAverageJitter = ( TickType_t ) ( pxTCB->ullReleaseJitterSum / ( uint64_t ) pxTCB->uxReleases );
+            }
+            else
+            {
+                pxReleaseJitter->xAverageJitter = ( TickType_t ) 0U;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_RELEASE_JITTER_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+
+    BaseType_t xTaskJobDeadlineMissed( void )
+    {
+        /* The flag is only written by the tick interrupt and by the task
+         * itself, and a single byte is read atomically. */
+        return ( pxCurrentTCB->ucJobMissed != pdFALSE ) ? pdTRUE : pdFALSE;
+    }
+
+#endif /* configUSE_DEADLINE_MISS_DETECTION */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+
+    UBaseType_t uxTaskGetDeadlineMisses( const TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        UBaseType_t uxReturn;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = pxTCB->uxDeadlineMisses;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_DEADLINE_MISS_DETECTION */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelay == 1 )
+
+    void vTaskDelay( const TickType_t xTicksToDelay )
+    {
+        BaseType_t xAlreadyYielded = pdFALSE;
+
+        /* A delay time of zero just forces a reschedule. */
+        if( xTicksToDelay > ( TickType_t ) 0U )
+        {
+            configASSERT( uxSchedulerSuspended == 0 );
+            vTaskSuspendAll();
+            {
+                traceTASK_DELAY();
+
+                /* A task that is removed from the event list while the
+                 * scheduler is suspended will not get placed in the ready
+                 * list or removed from the blocked list until the scheduler
+                 * is resumed.
+                 *
+                 * This task cannot be in an event list as it is the currently
+                 * executing task. */
+                prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+            }
+            xAlreadyYielded = xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Force a reschedule if xTaskResumeAll has not already done so, we may
+         * have put ourselves to sleep. */
+        if( xAlreadyYielded == pdFALSE )
+        {
+            portYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* INCLUDE_vTaskDelay */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
+
+    eTaskState eTaskGetState( TaskHandle_t xTask )
+    {
+        eTaskState eReturn;
+        List_t const * pxStateList;
+        List_t const * pxDelayedList;
+        List_t const * pxOverflowedDelayedList;
+        const TCB_t * const pxTCB = xTask;
+
+        configASSERT( pxTCB );
+
+        if( pxTCB == pxCurrentTCB )
+        {
+            /* The task calling this function is querying its own state. */
+            eReturn = eRunning;
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+            {
+                pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+                pxDelayedList = pxDelayedTaskList;
+                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+            }
+            taskEXIT_CRITICAL();
+
+            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            {
+                /* The task being queried is referenced from one of the Blocked
+                 * lists. */
+                eReturn = eBlocked;
+            }
+
+            #if ( configUSE_DELAY_WHEEL == 1 )
+                else if( taskIS_DELAY_WHEEL_SLOT( pxStateList ) != pdFALSE )
+                {
+                    /* The task is blocked with a timeout that falls within the
+                     * span of the delay wheel. */
+                    eReturn = eBlocked;
+                }
+            #endif
+
+            #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) && ( configUSE_DELAY_WHEEL == 0 ) )
+                else if( ( pxStateList == &xJobReleaseList1 ) || ( pxStateList == &xJobReleaseList2 ) )
+                {
+                    /* The task is a periodic task waiting for its next
+                     * release. */
+                    eReturn = eBlocked;
+                }
+            #endif
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+                else if( pxStateList == &xSuspendedTaskList )
+                {
+                    /* The task being queried is referenced from the suspended
+                     * list.  Is it genuinely suspended or is it blocked
+                     * indefinitely? */
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
+                    {
+                        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+                        {
+                            BaseType_t x;
+
+                            /* The task does not appear on the event list item of
+                             * and of the RTOS objects, but could still be in the
+                             * blocked state if it is waiting on its notification
+                             * rather than waiting on an object.  If not, is
+                             * suspended. */
+                            eReturn = eSuspended;
+
+                            for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                            {
+                                if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                                {
+                                    eReturn = eBlocked;
+                                    break;
+                                }
+                            }
+                        }
+                        #else /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+                        {
+                            eReturn = eSuspended;
+                        }
+                        #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+                    }
+                    else
+                    {
+                        eReturn = eBlocked;
+                    }
+                }
+            #endif /* if ( INCLUDE_vTaskSuspend == 1 ) */
+
+            #if ( INCLUDE_vTaskDelete == 1 )
+                else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
+                {
+                    /* The task being queried is referenced from the deleted
+                     * tasks list, or it is not referenced from any lists at
+                     * all. */
+                    eReturn = eDeleted;
+                }
+            #endif
+
+            else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
+            {
+                /* If the task is not in any other state, it must be in the
+                 * Ready (including pending ready) state. */
+                eReturn = eReady;
+            }
+        }
+
+        return eReturn;
+    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
+
+#endif /* INCLUDE_eTaskGetState */
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskCpuBurstGet( const TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        TickType_t xReturn;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the burst of the task
+             * that called xTaskCpuBurstGet() that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            xReturn = pxTCB->xCpuBurst;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+TickType_t xTaskPeriodGet( const TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        TickType_t xReturn;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the period of the task
+             * that called xTaskPeriodGet() that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            xReturn = pxTCB->xPeriod;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+TickType_t xTaskDeadlineGet( const TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        TickType_t xReturn;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the deadline of the task
+             * that called xTaskDeadlineGet() that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            xReturn = pxTCB->xDeadline;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+const char* uxTaskNameGet( const TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        const char* uxReturn;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the priority of the task
+             * that called uxTaskPriorityGet() that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = (char *) pxTCB->pcTaskName;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxReturn;
+    }
+
+
+#if ( INCLUDE_uxTaskPriorityGet == 1 )
+
+    UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        UBaseType_t uxReturn;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the priority of the task
+             * that called uxTaskPriorityGet() that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = pxTCB->uxPriority;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskPriorityGet */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskPriorityGet == 1 )
+
+    UBaseType_t uxTaskPriorityGetFromISR( const TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        UBaseType_t uxReturn, uxSavedInterruptState;
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            /* If null is passed in here then it is the priority of the calling
+             * task that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = pxTCB->uxPriority;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskPriorityGet */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskPrioritySet == 1 )
+
+    void vTaskPrioritySet( TaskHandle_t xTask,
+                           UBaseType_t uxNewPriority )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxCurrentBasePriority;
+        BaseType_t xYieldRequired = pdFALSE;
+
+        configASSERT( uxNewPriority < configMAX_PRIORITIES );
+
+        /* Ensure the new priority is valid. */
+        if( uxNewPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+        {
+            uxNewPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the priority of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            traceTASK_PRIORITY_SET( pxTCB, uxNewPriority );
+
+            #if ( configUSE_MUTEXES == 1 )
+            {
+                uxCurrentBasePriority = pxTCB->uxBasePriority;
+            }
+            #else
+            {
+                uxCurrentBasePriority = pxTCB->uxPriority;
+            }
+            #endif
+
+            if( uxCurrentBasePriority != uxNewPriority )
+            {
+                /* The priority change may have readied a task of higher
+                 * priority than the calling task. */
+                if( uxNewPriority > uxCurrentBasePriority )
+                {
+                    if( pxTCB != pxCurrentTCB )
+                    {
+                        /* The priority of a task other than the currently
+                         * running task is being raised.  Is the priority being
+                         * raised above that of the running task? */
+                        if( uxNewPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        /* The priority of the running task is being raised,
+                         * but the running task must already be the highest
+                         * priority task able to run so no yield is required. */
+                    }
+                }
+                else if( pxTCB == pxCurrentTCB )
+                {
+                    /* Setting the priority of the running task down means
+                     * there may now be another task of higher priority that
+                     * is ready to execute. */
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    /* Setting the priority of any other task down does not
+                     * require a yield as the running task must be above the
+                     * new priority of the task being modified. */
+                }
+
+                prvSetBasePriority( pxTCB, uxNewPriority );
+
+                if( xYieldRequired != pdFALSE )
+                {
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* INCLUDE_vTaskPrioritySet */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_vTaskPrioritySet == 1 ) || ( configUSE_RM_AUTO_PRIORITY == 1 ) )
+
+    static void prvSetBasePriority( TCB_t * const pxTCB,
+                                    UBaseType_t uxNewPriority )
+    {
+        UBaseType_t uxPriorityUsedOnEntry;
+
+        /* Remember the ready list the task might be referenced from
+         * before its uxPriority member is changed so the
+         * taskRESET_READY_PRIORITY() macro can function correctly. */
+        uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+        #if ( configUSE_MUTEXES == 1 )
+        {
+            /* Only change the priority being used if the task is not
+             * currently using an inherited priority. */
+            if( pxTCB->uxBasePriority == pxTCB->uxPriority )
+            {
+                pxTCB->uxPriority = uxNewPriority;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The base priority gets set whatever. */
+            pxTCB->uxBasePriority = uxNewPriority;
+        }
+        #else /* if ( configUSE_MUTEXES == 1 ) */
+        {
+            pxTCB->uxPriority = uxNewPriority;
+        }
+        #endif /* if ( configUSE_MUTEXES == 1 ) */
+
+        /* Only reset the event list item value if the value is not
+         * being used for anything else. */
+        if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+        {
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* If the task is in the blocked or suspended list we need do
+         * nothing more than change its priority variable. However, if
+         * the task is in a ready list it needs to be removed and placed
+         * in the list appropriate to its new priority. */
+        if( listIS_CONTAINED_WITHIN( taskREADY_LIST( uxPriorityUsedOnEntry, pxTCB ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+        {
+            /* The task is currently in its ready list - remove before
+             * adding it to its new ready list.  As we are in a critical
+             * section we can do this even if the scheduler is suspended. */
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                /* The ready list the task was removed from is now
+                 * empty. */
+                taskRESET_READY_TASK( pxTCB, uxPriorityUsedOnEntry );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvAddTaskToReadyList( pxTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Remove compiler warning about unused variables when the port
+         * optimised task selection is not being used. */
+        ( void ) uxPriorityUsedOnEntry;
+    }
+
+#endif /* ( ( INCLUDE_vTaskPrioritySet == 1 ) || ( configUSE_RM_AUTO_PRIORITY == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RM_AUTO_PRIORITY == 1 )
+
+    static BaseType_t prvAssignRatePriorities( void )
+    {
+        const ListItem_t * const pxEnd = listGET_END_MARKER( &xRateOrderedTasksList );
+        const ListItem_t * pxIterator;
+        TCB_t * pxTCB;
+        TickType_t xPreviousPeriod = ( TickType_t ) 0U;
+        UBaseType_t uxPriority = ( UBaseType_t ) configRM_AUTO_PRIORITY_HIGHEST;
+        UBaseType_t uxCurrentBasePriority;
+        BaseType_t xChanged = pdFALSE;
+
+        /* The list is in period order, so each new period is one priority
+         * below the one before. */
+        for( pxIterator = listGET_HEAD_ENTRY( &xRateOrderedTasksList ); pxIterator != pxEnd; pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            if( ( pxIterator != listGET_HEAD_ENTRY( &xRateOrderedTasksList ) ) &&
+                ( pxTCB->xPeriod != xPreviousPeriod ) )
+            {
+                /* A period with no priority left in the band would share the
+                 * lowest with a shorter one, out of RM order.  Widen the band or
+                 * use fewer distinct periods if this assert fails. */
+                configASSERT( uxPriority > ( UBaseType_t ) configRM_AUTO_PRIORITY_LOWEST );
+
+                if( uxPriority > ( UBaseType_t ) configRM_AUTO_PRIORITY_LOWEST )
+                {
+                    uxPriority--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xPreviousPeriod = pxTCB->xPeriod;
+
+            #if ( configUSE_MUTEXES == 1 )
+            {
+                uxCurrentBasePriority = pxTCB->uxBasePriority;
+            }
+            #else
+            {
+                uxCurrentBasePriority = pxTCB->uxPriority;
+            }
+            #endif
+
+            if( uxCurrentBasePriority != uxPriority )
+            {
+                traceTASK_PRIORITY_SET( pxTCB, uxPriority );
+                prvSetBasePriority( pxTCB, uxPriority );
+                xChanged = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xChanged;
+    }
+
+#endif /* configUSE_RM_AUTO_PRIORITY */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+    void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+    {
+        TCB_t * pxTCB;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the running task that is
+             * being suspended. */
+            pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+
+            traceTASK_SUSPEND( pxTCB );
+
+            /* Remove task from the ready/delayed list and place in the
+             * suspended list. */
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                taskRESET_READY_TASK( pxTCB, pxTCB->uxPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Is the task waiting on an event also? */
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            {
+                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+
+            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+            {
+                BaseType_t x;
+
+                for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                {
+                    if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                    {
+                        /* The task was blocked to wait for a notification, but is
+                         * now suspended, so no notification was received. */
+                        pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+                    }
+                }
+            }
+            #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+        }
+        taskEXIT_CRITICAL();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* Reset the next expected unblock time in case it referred to the
+             * task that is now in the Suspended state. */
+            taskENTER_CRITICAL();
+            {
+                prvResetNextTaskUnblockTime();
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxTCB == pxCurrentTCB )
+        {
+            if( xSchedulerRunning != pdFALSE )
+            {
+                /* The current task has just been suspended. */
+                configASSERT( uxSchedulerSuspended == 0 );
+                portYIELD_WITHIN_API();
+            }
+            else
+            {
+                /* The scheduler is not running, but the task that was pointed
+                 * to by pxCurrentTCB has just been suspended and pxCurrentTCB
+                 * must be adjusted to point to a different task. */
+                if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+                {
+                    /* No other tasks are ready, so set pxCurrentTCB back to
+                     * NULL so when the next task is created pxCurrentTCB will
+                     * be set to point to it no matter what its relative priority
+                     * is. */
+                    pxCurrentTCB = NULL;
+                }
+                else
+                {
+                    vTaskSwitchContext();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* INCLUDE_vTaskSuspend */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+    static BaseType_t prvTaskIsTaskSuspended( const TaskHandle_t xTask )
+    {
+        BaseType_t xReturn = pdFALSE;
+        const TCB_t * const pxTCB = xTask;
+
+        /* Accesses xPendingReadyList so must be called from a critical
+         * section. */
+
+        /* It does not make sense to check if the calling task is suspended. */
+        configASSERT( xTask );
+
+        /* Is the task being resumed actually in the suspended list? */
+        if( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE )
+        {
+            /* Has the task already been resumed from within an ISR? */
+            if( listIS_CONTAINED_WITHIN( &xPendingReadyList, &( pxTCB->xEventListItem ) ) == pdFALSE )
+            {
+                /* Is it in the suspended list because it is in the Suspended
+                 * state, or because is is blocked with no timeout? */
+                if( listIS_CONTAINED_WITHIN( NULL, &( pxTCB->xEventListItem ) ) != pdFALSE ) /*lint !e961.  The cast is only redundant when NULL is used. */
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
+
+#endif /* INCLUDE_vTaskSuspend */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+    void vTaskResume( TaskHandle_t xTaskToResume )
+    {
+        TCB_t * const pxTCB = xTaskToResume;
+
+        /* It does not make sense to resume the calling task. */
+        configASSERT( xTaskToResume );
+
+        /* The parameter cannot be NULL as it is impossible to resume the
+         * currently executing task. */
+        if( ( pxTCB != pxCurrentTCB ) && ( pxTCB != NULL ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+                {
+                    traceTASK_RESUME( pxTCB );
+
+                    /* The ready list can be accessed even if the scheduler is
+                     * suspended because this is inside a critical section. */
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
+                        if( taskIS_WAITING_FOR_RELEASE( pxTCB ) != pdFALSE )
+                        {
+                            /* The task was suspended between two jobs.  Resuming
+                             * it must not release its next job early, so it goes
+                             * back to waiting for that release. */
+                            prvAddTaskToReleaseList( pxTCB );
+                        }
+                        else
+                    #endif
+                    {
+                        prvAddTaskToReadyList( pxTCB );
+
+                        /* A higher priority task may have just been resumed. */
+                        if( taskPREEMPTS_CURRENT( pxTCB ) )
+                        {
+                            /* This yield may not cause the task just resumed to
+                             * run, but will leave the lists in the correct state
+                             * for the next yield. */
+                            taskYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* INCLUDE_vTaskSuspend */
+
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
+
+    BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
+    {
+        BaseType_t xYieldRequired = pdFALSE;
+        TCB_t * const pxTCB = xTaskToResume;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xTaskToResume );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+            {
+                traceTASK_RESUME_FROM_ISR( pxTCB );
+
+                #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
+                    if( taskIS_WAITING_FOR_RELEASE( pxTCB ) != pdFALSE )
+                    {
+                        /* The task was suspended between two jobs, so it goes
+                         * back to waiting for its next release.  The release
+                         * lists are only changed with interrupts masked, so
+                         * they can be accessed even if the scheduler is
+                         * suspended. */
+                        ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                        prvAddTaskToReleaseList( pxTCB );
+                    }
+                    else
+                #endif
+
+                /* Check the ready lists can be accessed. */
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    /* Ready lists can be accessed so move the task from the
+                     * suspended list to the ready list directly.  The task is
+                     * compared once it is in its ready list, as that is when
+                     * an EDF deadline is set. */
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+
+                    if( taskPREEMPTS_CURRENT( pxTCB ) )
+                    {
+                        xYieldRequired = pdTRUE;
+
+                        /* Mark that a yield is pending in case the user is not
+                         * using the return value to initiate a context switch
+                         * from the ISR using portYIELD_FROM_ISR. */
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The delayed or ready lists cannot be accessed so the task
+                     * is held in the pending ready list until the scheduler is
+                     * unsuspended. */
+                    vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xYieldRequired;
+    }
+
+#endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+void vTaskStartScheduler( void )
+{
+    BaseType_t xReturn;
+
+    /* Add the idle task at the lowest priority. */
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    {
+        StaticTask_t * pxIdleTaskTCBBuffer = NULL;
+        StackType_t * pxIdleTaskStackBuffer = NULL;
+        uint32_t ulIdleTaskStackSize;
+
+        /* The Idle task is created using user provided RAM - obtain the
+         * address of the RAM then create the idle task. */
+        vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+        xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
+                                             configIDLE_TASK_NAME,
+                                             ulIdleTaskStackSize,
+                                             ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
+                                             portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                             pxIdleTaskStackBuffer,
+                                             pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+        if( xIdleTaskHandle != NULL )
+        {
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+    }
+    #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+    {
+        /* The Idle task is being created using dynamically allocated RAM. */
+        xReturn = xTaskCreate( prvIdleTask,
+                               configIDLE_TASK_NAME,
+                               configMINIMAL_STACK_SIZE,
+                               ( void * ) NULL,
+                               portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                               &xIdleTaskHandle, /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+                               0,
+                               0 );
+    }
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+    #if ( configUSE_TIMERS == 1 )
+    {
+        if( xReturn == pdPASS )
+        {
+            xReturn = xTimerCreateTimerTask();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_TIMERS */
+
+    if( xReturn == pdPASS )
+    {
+        /* freertos_tasks_c_additions_init() should only be called if the user
+         * definable macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is
+         * the only macro called by the function. */
+        #ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
+        {
+            freertos_tasks_c_additions_init();
+        }
+        #endif
+
+        /* Interrupts are turned off here, to ensure a tick does not occur
+         * before or during the call to xPortStartScheduler().  The stacks of
+         * the created tasks contain a status word with interrupts switched on
+         * so interrupts will automatically get re-enabled when the first task
+         * starts to run. */
+        portDISABLE_INTERRUPTS();
+
+        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        {
+            /* Switch C-Runtime's TLS Block to point to the TLS
+             * block specific to the task that will run first. */
+            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+        }
+        #endif
+
+        xNextTaskUnblockTime = portMAX_DELAY;
+        xSchedulerRunning = pdTRUE;
+        xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
+
+        /* If configGENERATE_RUN_TIME_STATS is defined then the following
+         * macro must be defined to configure the timer/counter used to generate
+         * the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
+         * is set to 0 and the following line fails to build then ensure you do not
+         * have portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() defined in your
+         * FreeRTOSConfig.h file. */
+        portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
+
+        #if (configUSE_RM == 1)
+        {
+            taskSELECT_TASK_RM();
+        }
+        #elif ( configUSE_EDF == 1 )
+        {
+            taskSELECT_TASK_EDF();
+        }
+        #else
+        {
+            taskSELECT_HIGHEST_PRIORITY_TASK();
+        }
+        #endif
+
+        traceTASK_SWITCHED_IN();
+
+        /* Setting up the timer tick is hardware specific and thus in the
+         * portable interface. */
+        xPortStartScheduler();
+
+        /* In most cases, xPortStartScheduler() will not return. If it
+         * returns pdTRUE then there was not enough heap memory available
+         * to create either the Idle or the Timer task. If it returned
+         * pdFALSE, then the application called xTaskEndScheduler().
+         * Most ports don't implement xTaskEndScheduler() as there is
+         * nothing to return to. */
+    }
+    else
+    {
+        /* This line will only be reached if the kernel could not be started,
+         * because there was not enough FreeRTOS heap to create the idle task
+         * or the timer task. */
+        configASSERT( xReturn != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY );
+    }
+
+    /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
+     * meaning xIdleTaskHandle is not used anywhere else. */
+    ( void ) xIdleTaskHandle;
+
+    /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
+     * from getting optimized out as it is no longer used by the kernel. */
+    ( void ) uxTopUsedPriority;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskEndScheduler( void )
+{
+    /* Stop the scheduler interrupts and call the portable scheduler end
+     * routine so the original ISRs can be restored if necessary.  The port
+     * layer must ensure interrupts enable  bit is left in the correct state. */
+    portDISABLE_INTERRUPTS();
+    xSchedulerRunning = pdFALSE;
+    vPortEndScheduler();
+}
+/*----------------------------------------------------------*/
+
+void vTaskSuspendAll( void )
+{
+    /* A critical section is not required as the variable is of type
+     * BaseType_t.  Please read Richard Barry's reply in the following link to a
+     * post in the FreeRTOS support forum before reporting this as a bug! -
+     * https://goo.gl/wu4acr */
+
+    /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
+     * do not otherwise exhibit real time behaviour. */
+    portSOFTWARE_BARRIER();
+
+    /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
+     * is used to allow calls to vTaskSuspendAll() to nest. */
+    ++uxSchedulerSuspended;
+
+    /* Enforces ordering for ports and optimised compilers that may otherwise place
+     * the above increment elsewhere. */
+    portMEMORY_BARRIER();
+}
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    static TickType_t prvGetExpectedIdleTime( void )
+    {
+        TickType_t xReturn;
+        UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
+
+        /* uxHigherPriorityReadyTasks takes care of the case where
+         * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
+         * task that are in the Ready state, even though the idle task is
+         * running. */
+        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        {
+            if( uxTopReadyPriority > tskIDLE_PRIORITY )
+            {
+                uxHigherPriorityReadyTasks = pdTRUE;
+            }
+        }
+        #else
+        {
+            const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
+
+            /* When port optimised task selection is used the uxTopReadyPriority
+             * variable is used as a bit map.  If bits other than the least
+             * significant bit are set then there are tasks that have a priority
+             * above the idle priority that are in the Ready state.  This takes
+             * care of the case where the co-operative scheduler is in use. */
+            if( uxTopReadyPriority > uxLeastSignificantBit )
+            {
+                uxHigherPriorityReadyTasks = pdTRUE;
+            }
+        }
+        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
+
+        if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
+        {
+            xReturn = 0;
+        }
+        else if( taskREADY_TASKS_AT_PRIORITY( tskIDLE_PRIORITY ) > 1 )
+        {
+            /* There are other idle priority tasks in the ready state.  If
+             * time slicing is used then the very next tick interrupt must be
+             * processed. */
+            xReturn = 0;
+        }
+        else if( uxHigherPriorityReadyTasks != pdFALSE )
+        {
+            /* There are tasks in the Ready state that have a priority above the
+             * idle priority.  This path can only be reached if
+             * configUSE_PREEMPTION is 0. */
+            xReturn = 0;
+        }
+        else
+        {
+            xReturn = prvGetNextJobEventTime() - xTickCount;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvGetNextJobEventTime( void )
+    {
+        const TickType_t xConstTickCount = xTickCount;
+        TickType_t xReturn = xNextTaskUnblockTime;
+
+        /* An event after the tick count wraps is later than
+         * xNextTaskUnblockTime, which is at most portMAX_DELAY, so only the
+         * current release and deadline lists are searched. */
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) && ( configUSE_DELAY_WHEEL == 0 ) )
+        {
+            if( ( listLIST_IS_EMPTY( pxJobReleaseList ) == pdFALSE ) &&
+                ( ( TickType_t ) ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxJobReleaseList ) - xConstTickCount ) < ( TickType_t ) ( xReturn - xConstTickCount ) ) )
+            {
+                xReturn = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxJobReleaseList );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        #if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+        {
+            TickType_t xDeadline;
+
+            /* A job misses its deadline on the tick after the deadline, so
+             * that is the tick the sleep has to end on. */
+            if( listLIST_IS_EMPTY( pxDeadlineList ) == pdFALSE )
+            {
+                xDeadline = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDeadlineList );
+
+                if( ( xDeadline != portMAX_DELAY ) &&
+                    ( ( TickType_t ) ( ( xDeadline + ( TickType_t ) 1U ) - xConstTickCount ) < ( TickType_t ) ( xReturn - xConstTickCount ) ) )
+                {
+                    xReturn = xDeadline + ( TickType_t ) 1U;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_DEADLINE_MISS_DETECTION */
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskResumeAll( void )
+{
+    TCB_t * pxTCB = NULL;
+    BaseType_t xAlreadyYielded = pdFALSE;
+
+    /* If uxSchedulerSuspended is zero then this function does not match a
+     * previous call to vTaskSuspendAll(). */
+    configASSERT( uxSchedulerSuspended );
+
+    /* It is possible that an ISR caused a task to be removed from an event
+     * list while the scheduler was suspended.  If this was the case then the
+     * removed task will have been added to the xPendingReadyList.  Once the
+     * scheduler has been resumed it is safe to move all the pending ready
+     * tasks from this list into their appropriate ready list. */
+    taskENTER_CRITICAL();
+    {
+        --uxSchedulerSuspended;
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        {
+            if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
+            {
+                /* Move any readied tasks from the pending list into the
+                 * appropriate ready list. */
+                while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
+                {
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                    portMEMORY_BARRIER();
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+
+                    /* If the moved task comes before the current task then a
+                     * yield must be performed. */
+                    if( taskPREEMPTS_CURRENT( pxTCB ) )
+                    {
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( pxTCB != NULL )
+                {
+                    /* A task was unblocked while the scheduler was suspended,
+                     * which may have prevented the next unblock time from being
+                     * re-calculated, in which case re-calculate it now.  Mainly
+                     * important for low power tickless implementations, where
+                     * this can prevent an unnecessary exit from low power
+                     * state. */
+                    prvResetNextTaskUnblockTime();
+                }
+
+                /* If any ticks occurred while the scheduler was suspended then
+                 * they should be processed now.  This ensures the tick count does
+                 * not  slip, and that any delayed tasks are resumed at the correct
+                 * time. */
+                {
+                    TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
+
+                    if( xPendedCounts > ( TickType_t ) 0U )
+                    {
+                        do
+                        {
+                            if( xTaskIncrementTick() != pdFALSE )
+                            {
+                                xYieldPending = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            --xPendedCounts;
+                        } while( xPendedCounts > ( TickType_t ) 0U );
+
+                        xPendedTicks = 0;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( xYieldPending != pdFALSE )
+                {
+                    #if ( configUSE_PREEMPTION != 0 )
+                    {
+                        xAlreadyYielded = pdTRUE;
+                    }
+                    #endif
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xAlreadyYielded;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskGetTickCount( void )
+{
+    TickType_t xTicks;
+
+    /* Critical section required if running on a 16 bit processor. */
+    portTICK_TYPE_ENTER_CRITICAL();
+    {
+        xTicks = xTickCount;
+    }
+    portTICK_TYPE_EXIT_CRITICAL();
+
+    return xTicks;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskGetTickCountFromISR( void )
+{
+    TickType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call  interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
+    {
+        xReturn = xTickCount;
+    }
+    portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTaskGetNumberOfTasks( void )
+{
+    /* A critical section is not required because the variables are of type
+     * BaseType_t. */
+    return uxCurrentNumberOfTasks;
+}
+/*-----------------------------------------------------------*/
+
+char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+    TCB_t * pxTCB;
+
+    /* If null is passed in here then the name of the calling task is being
+     * queried. */
+    pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+    configASSERT( pxTCB );
+    return &( pxTCB->pcTaskName[ 0 ] );
+}
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetHandle == 1 )
+
+    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
+                                                     const char pcNameToQuery[] )
+    {
+        TCB_t * pxNextTCB;
+        TCB_t * pxFirstTCB;
+        TCB_t * pxReturn = NULL;
+        UBaseType_t x;
+        char cNextChar;
+        BaseType_t xBreakLoop;
+
+        /* This function is called with the scheduler suspended. */
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            do
+            {
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                /* Check each character in the name looking for a match or
+                 * mismatch. */
+                xBreakLoop = pdFALSE;
+
+                for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+                {
+                    cNextChar = pxNextTCB->pcTaskName[ x ];
+
+                    if( cNextChar != pcNameToQuery[ x ] )
+                    {
+                        /* Characters didn't match. */
+                        xBreakLoop = pdTRUE;
+                    }
+                    else if( cNextChar == ( char ) 0x00 )
+                    {
+                        /* Both strings terminated, a match must have been
+                         * found. */
+                        pxReturn = pxNextTCB;
+                        xBreakLoop = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xBreakLoop != pdFALSE )
+                    {
+                        break;
+                    }
+                }
+
+                if( pxReturn != NULL )
+                {
+                    /* The handle has been found. */
+                    break;
+                }
+            } while( pxNextTCB != pxFirstTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxReturn;
+    }
+
+#endif /* INCLUDE_xTaskGetHandle */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetHandle == 1 )
+
+    TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        UBaseType_t uxQueue = configMAX_PRIORITIES;
+        TCB_t * pxTCB;
+
+        /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
+        configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
+
+        vTaskSuspendAll();
+        {
+            /* Search the ready lists. */
+            do
+            {
+                uxQueue--;
+                #if ( configUSE_RM == 1 )
+                {
+                    UBaseType_t uxPeriod;
+
+                    for( uxPeriod = ( UBaseType_t ) 0U; ( uxPeriod < ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS ) && ( pxTCB == NULL ); uxPeriod++ )
+                    {
+                        pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ][ uxPeriod ] ), pcNameToQuery );
+                    }
+                }
+                #else
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
+                }
+                #endif /* configUSE_RM */
+
+                if( pxTCB != NULL )
+                {
+                    /* Found the handle. */
+                    break;
+                }
+            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+            /* Search the delayed lists. */
+            if( pxTCB == NULL )
+            {
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+            }
+
+            if( pxTCB == NULL )
+            {
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+            }
+
+            #if ( configUSE_DELAY_WHEEL == 1 )
+            {
+                UBaseType_t uxLevel, uxSlot;
+
+                for( uxLevel = ( UBaseType_t ) 0U; ( uxLevel < ( UBaseType_t ) configDELAY_WHEEL_LEVELS ) && ( pxTCB == NULL ); uxLevel++ )
+                {
+                    for( uxSlot = ( UBaseType_t ) 0U; ( uxSlot < ( UBaseType_t ) taskWHEEL_SLOTS ) && ( pxTCB == NULL ); uxSlot++ )
+                    {
+                        pxTCB = prvSearchForNameWithinSingleList( &( xDelayWheel[ uxLevel ][ uxSlot ] ), pcNameToQuery );
+                    }
+                }
+            }
+            #endif /* configUSE_DELAY_WHEEL */
+
+            #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) && ( configUSE_DELAY_WHEEL == 0 ) )
+            {
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( &xJobReleaseList1, pcNameToQuery );
+                }
+
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( &xJobReleaseList2, pcNameToQuery );
+                }
+            }
+            #endif
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+            {
+                if( pxTCB == NULL )
+                {
+                    /* Search the suspended list. */
+                    pxTCB = prvSearchForNameWithinSingleList( &xSuspendedTaskList, pcNameToQuery );
+                }
+            }
+            #endif
+
+            #if ( INCLUDE_vTaskDelete == 1 )
+            {
+                if( pxTCB == NULL )
+                {
+                    /* Search the deleted list. */
+                    pxTCB = prvSearchForNameWithinSingleList( &xTasksWaitingTermination, pcNameToQuery );
+                }
+            }
+            #endif
+        }
+        ( void ) xTaskResumeAll();
+
+        return pxTCB;
+    }
+
+#endif /* INCLUDE_xTaskGetHandle */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
+                                      const UBaseType_t uxArraySize,
+                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+    {
+        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+
+        vTaskSuspendAll();
+        {
+            /* Is there a space in the array for each task in the system? */
+            if( uxArraySize >= uxCurrentNumberOfTasks )
+            {
+                /* Fill in an TaskStatus_t structure with information on each
+                 * task in the Ready state. */
+                do
+                {
+                    uxQueue--;
+                    #if ( configUSE_RM == 1 )
+                    {
+                        UBaseType_t uxPeriod;
+
+                        for( uxPeriod = ( UBaseType_t ) 0U; uxPeriod < ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS; uxPeriod++ )
+                        {
+                            uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ][ uxPeriod ] ), eReady );
+                        }
+                    }
+                    #else
+                    {
+                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady );
+                    }
+                    #endif /* configUSE_RM */
+                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+                /* Fill in an TaskStatus_t structure with information on each
+                 * task in the Blocked state. */
+                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+
+                #if ( configUSE_DELAY_WHEEL == 1 )
+                {
+                    UBaseType_t uxLevel, uxSlot;
+
+                    for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configDELAY_WHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( UBaseType_t ) taskWHEEL_SLOTS; uxSlot++ )
+                        {
+                            uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayWheel[ uxLevel ][ uxSlot ] ), eBlocked );
+                        }
+                    }
+                }
+                #endif /* configUSE_DELAY_WHEEL */
+
+                #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) && ( configUSE_DELAY_WHEEL == 0 ) )
+                {
+                    /* Periodic tasks waiting for their next release are also
+                     * Blocked. */
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xJobReleaseList1, eBlocked );
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xJobReleaseList2, eBlocked );
+                }
+                #endif
+
+                #if ( INCLUDE_vTaskDelete == 1 )
+                {
+                    /* Fill in an TaskStatus_t structure with information on
+                     * each task that has been deleted but not yet cleaned up. */
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
+                }
+                #endif
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    /* Fill in an TaskStatus_t structure with information on
+                     * each task in the Suspended state. */
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
+                }
+                #endif
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    if( pulTotalRunTime != NULL )
+                    {
+                        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                            portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
+                        #else
+                            *pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                        #endif
+                    }
+                }
+                #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+                {
+                    if( pulTotalRunTime != NULL )
+                    {
+                        *pulTotalRunTime = 0;
+                    }
+                }
+                #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+
+    TaskHandle_t xTaskGetIdleTaskHandle( void )
+    {
+        /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
          * started, then xIdleTaskHandle will be NULL. */
         configASSERT( ( xIdleTaskHandle != NULL ) );
         return xIdleTaskHandle;
     }
 
-#endif /* INCLUDE_xTaskGetIdleTaskHandle */
-/*----------------------------------------------------------*/
+#endif /* INCLUDE_xTaskGetIdleTaskHandle */
+/*----------------------------------------------------------*/
+
+/* This conditional compilation should use inequality to 0, not equality to 1.
+ * This is to ensure vTaskStepTick() is available when user defined low power mode
+ * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
+ * 1. */
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    void vTaskStepTick( TickType_t xTicksToJump )
+    {
+        /* Correct the tick count value after a period during which the tick
+         * was suppressed.  Note this does *not* call the tick hook function for
+         * each stepped tick. */
+        const TickType_t xNextEventTime = prvGetNextJobEventTime();
+
+        configASSERT( ( xTickCount + xTicksToJump ) <= xNextEventTime );
+
+        if( ( xTickCount + xTicksToJump ) == xNextEventTime )
+        {
+            /* Arrange for xTickCount to reach xNextEventTime in
+             * xTaskIncrementTick() when the scheduler resumes.  This ensures
+             * that any delayed tasks are resumed, and any jobs released or
+             * checked against their deadlines, at the correct time. */
+            configASSERT( uxSchedulerSuspended );
+            configASSERT( xTicksToJump != ( TickType_t ) 0 );
+
+            /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
+            taskENTER_CRITICAL();
+            {
+                xPendedTicks++;
+            }
+            taskEXIT_CRITICAL();
+            xTicksToJump--;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_IDLE_TIME_STATS == 1 )
+        {
+            /* The tick was suppressed because the processor was idle. */
+            prvAddIdleTimeTicks( xTicksToJump, pdTRUE );
+        }
+        #endif
+
+        xTickCount += xTicksToJump;
+        traceINCREASE_TICK_COUNT( xTicksToJump );
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
+{
+    BaseType_t xYieldOccurred;
+
+    /* Must not be called with the scheduler suspended as the implementation
+     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
+    configASSERT( uxSchedulerSuspended == 0 );
+
+    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
+     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
+    vTaskSuspendAll();
+
+    /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
+    taskENTER_CRITICAL();
+    {
+        xPendedTicks += xTicksToCatchUp;
+    }
+    taskEXIT_CRITICAL();
+    xYieldOccurred = xTaskResumeAll();
+
+    return xYieldOccurred;
+}
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskAbortDelay == 1 )
+
+    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB = xTask;
+        BaseType_t xReturn;
+
+        configASSERT( pxTCB );
+
+        vTaskSuspendAll();
+        {
+            /* A task can only be prematurely removed from the Blocked state if
+             * it is actually in the Blocked state.  A periodic task waiting for
+             * the release of its next job is reported as Blocked, but that
+             * wait is the period of the task, so it is not cut short. */
+            if( ( eTaskGetState( xTask ) == eBlocked ) && ( taskIS_WAITING_FOR_RELEASE( pxTCB ) == pdFALSE ) )
+            {
+                xReturn = pdPASS;
+
+                /* Remove the reference to the task from the blocked list.  An
+                 * interrupt won't touch the xStateListItem because the
+                 * scheduler is suspended. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                /* Is the task waiting on an event also?  If so remove it from
+                 * the event list too.  Interrupts can touch the event list item,
+                 * even though the scheduler is suspended, so a critical section
+                 * is used. */
+                taskENTER_CRITICAL();
+                {
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    {
+                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+
+                        /* This lets the task know it was forcibly removed from the
+                         * blocked state so it should not re-evaluate its block time and
+                         * then block again. */
+                        pxTCB->ucDelayAborted = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                /* Place the unblocked task into the appropriate ready list. */
+                prvAddTaskToReadyList( pxTCB );
+
+                /* A task being unblocked cannot cause an immediate context
+                 * switch if preemption is turned off. */
+                #if ( configUSE_PREEMPTION == 1 )
+                {
+                    /* Preemption is on, but a context switch should only be
+                     * performed if the unblocked task comes before the
+                     * currently executing task. */
+                    if( taskPREEMPTS_CURRENT( pxTCB ) )
+                    {
+                        /* Pend the yield to be performed when the scheduler
+                         * is unsuspended. */
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_PREEMPTION */
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
+    }
+
+#endif /* INCLUDE_xTaskAbortDelay */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskIncrementTick( void )
+{
+    #if ( configUSE_DELAY_WHEEL == 0 )
+        TCB_t * pxTCB;
+        TickType_t xItemValue;
+    #endif
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    /* Called by the portable layer each time a tick interrupt occurs.
+     * Increments the tick then checks to see if the new tick value will cause any
+     * tasks to be unblocked. */
+    traceTASK_INCREMENT_TICK( xTickCount );
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    {
+        /* Minor optimisation.  The tick count cannot change in this
+         * block. */
+        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+
+        /* Increment the RTOS tick, switching the delayed and overflowed
+         * delayed lists if it wraps to 0. */
+        xTickCount = xConstTickCount;
+
+        if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+        {
+            taskSWITCH_DELAYED_LISTS();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_IDLE_TIME_STATS == 1 )
+        {
+            prvAddIdleTimeTicks( ( TickType_t ) 1U, ( pxCurrentTCB == xIdleTaskHandle ) ? pdTRUE : pdFALSE );
+        }
+        #endif
+
+        #if ( configUSE_DELAY_WHEEL == 1 )
+        {
+            /* xNextTaskUnblockTime is the next tick on which a task wakes or
+             * a slot of the wheel holding tasks is moved down it. */
+            if( xConstTickCount >= xNextTaskUnblockTime )
+            {
+                if( prvProcessDelayWheel( xConstTickCount ) != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* configUSE_DELAY_WHEEL */
+        {
+            /* See if this tick has made a timeout expire.  Tasks are stored in
+             * the  queue in the order of their wake time - meaning once one task
+             * has been found whose block time has not expired there is no need to
+             * look any further down the list. */
+            if( xConstTickCount >= xNextTaskUnblockTime )
+            {
+                for( ; ; )
+                {
+                    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                    {
+                        /* The delayed list is empty.  Set xNextTaskUnblockTime
+                         * to the maximum possible value so it is extremely
+                         * unlikely that the
+                         * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                         * next time through. */
+                        xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                        break;
+                    }
+                    else
+                    {
+                        /* The delayed list is not empty, get the value of the
+                         * item at the head of the delayed list.  This is the time
+                         * at which the task at the head of the delayed list must
+                         * be removed from the Blocked state. */
+                        pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                        xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+                        if( xConstTickCount < xItemValue )
+                        {
+                            /* It is not time to unblock this item yet, but the
+                             * item value is the time at which the task at the head
+                             * of the blocked list must be removed from the Blocked
+                             * state -  so record the item value in
+                             * xNextTaskUnblockTime. */
+                            xNextTaskUnblockTime = xItemValue;
+                            break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        /* It is time to remove the item from the Blocked state. */
+                        listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+                        /* Is the task waiting on an event also?  If so remove
+                         * it from the event list. */
+                        if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                        {
+                            listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        /* Place the unblocked task into the appropriate ready
+                         * list. */
+                        prvAddTaskToReadyList( pxTCB );
+
+                        /* A task being unblocked cannot cause an immediate
+                         * context switch if preemption is turned off. */
+                        #if ( configUSE_PREEMPTION == 1 )
+                        {
+                            /* Preemption is on, but a context switch should
+                             * only be performed if the unblocked task comes
+                             * before the currently executing task.
+                             * The case of equal priority tasks sharing
+                             * processing time (which happens when both
+                             * preemption and time slicing are on) is
+                             * handled below.*/
+                            if( taskPREEMPTS_CURRENT( pxTCB ) )
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif /* configUSE_PREEMPTION */
+                    }
+                }
+            }
+        }
+        #endif /* configUSE_DELAY_WHEEL */
+
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) && ( configUSE_DELAY_WHEEL == 0 ) )
+        {
+            if( prvReleaseJobs( xConstTickCount ) != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        #if ( configUSE_BUDGET_ENFORCEMENT == 1 )
+        {
+            if( prvEnforceJobBudget() != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_BUDGET_ENFORCEMENT */
+
+        #if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+        {
+            if( prvCheckJobDeadlines( xConstTickCount ) != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_DEADLINE_MISS_DETECTION */
+
+        /* Tasks of equal priority to the currently running task will share
+         * processing time (time slice) if preemption is on, and the application
+         * writer has not explicitly turned time slicing off. */
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+        {
+            if( listCURRENT_LIST_LENGTH( taskREADY_LIST( pxCurrentTCB->uxPriority, pxCurrentTCB ) ) > ( UBaseType_t ) 1 )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+
+        #if ( configUSE_TICK_HOOK == 1 )
+        {
+            /* Guard against the tick hook being called when the pended tick
+             * count is being unwound (when the scheduler is being unlocked). */
+            if( xPendedTicks == ( TickType_t ) 0 )
+            {
+                vApplicationTickHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TICK_HOOK */
+
+        #if ( configUSE_PREEMPTION == 1 )
+        {
+            if( xYieldPending != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_PREEMPTION */
+    }
+    else
+    {
+        ++xPendedTicks;
+
+        /* The tick hook gets called at regular intervals, even if the
+         * scheduler is locked. */
+        #if ( configUSE_TICK_HOOK == 1 )
+        {
+            vApplicationTickHook();
+        }
+        #endif
+    }
+
+    return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+
+    static void prvSetJobDeadline( TCB_t * const pxTCB,
+                                   TickType_t xDeadlineTime )
+    {
+        if( ( TickType_t ) ( xDeadlineTime - xTickCount ) > taskMAX_JOB_TICKS_AHEAD )
+        {
+            /* The deadline is already behind the tick count. */
+            xDeadlineTime = xTickCount;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        listSET_LIST_ITEM_VALUE( &( pxTCB->xDeadlineListItem ), xDeadlineTime );
+
+        if( xDeadlineTime < xTickCount )
+        {
+            /* The deadline is after the tick count wraps. */
+            vListInsert( pxOverflowDeadlineList, &( pxTCB->xDeadlineListItem ) );
+        }
+        else
+        {
+            vListInsert( pxDeadlineList, &( pxTCB->xDeadlineListItem ) );
+        }
+    }
+
+#endif /* configUSE_DEADLINE_MISS_DETECTION */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+
+    static BaseType_t prvCheckJobDeadlines( const TickType_t xConstTickCount )
+    {
+        TCB_t * pxTCB;
+        List_t * pxTemp;
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        /* Deadlines are held in the order they fall, so the search stops at the
+         * first one that has not passed. */
+        while( listLIST_IS_EMPTY( pxDeadlineList ) == pdFALSE )
+        {
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDeadlineList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            /* When the tick count has just wrapped every deadline still in the
+             * current list was before the wrap, so has passed. */
+            if( ( xConstTickCount != ( TickType_t ) 0U ) && ( listGET_LIST_ITEM_VALUE( &( pxTCB->xDeadlineListItem ) ) >= xConstTickCount ) )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            listREMOVE_ITEM( &( pxTCB->xDeadlineListItem ) );
+            ( pxTCB->uxDeadlineMisses )++;
+            pxTCB->ucJobMissed = pdTRUE;
+
+            #if ( configUSE_SCHEDULE_TRACE == 1 )
+            {
+                prvRecordScheduleEvent( pxTCB, eTraceDeadlineMissed );
+            }
+            #endif
+
+            traceTASK_DEADLINE_MISSED( pxTCB );
+
+            #if ( configDEADLINE_MISS_POLICY == pdDEADLINE_MISS_NOTIFY )
+            {
+                vApplicationDeadlineMissedHook( pxTCB );
+            }
+            #elif ( configDEADLINE_MISS_POLICY == pdDEADLINE_MISS_ABORT )
+            {
+                BaseType_t xBlocked;
+
+                /* A running job cannot be unwound from here, so the job is
+                 * expected to poll xTaskJobDeadlineMissed().  A job that is
+                 * blocked is released at once, as xTaskAbortDelay() would, so
+                 * it gets the chance to do so. */
+                xBlocked = ( ( listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) ) == pxDelayedTaskList ) ||
+                             ( listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) ) == pxOverflowDelayedTaskList ) ) ? pdTRUE : pdFALSE;
+
+                #if ( configUSE_DELAY_WHEEL == 1 )
+                {
+                    /* A job stopped for running out of budget waits for its
+                     * next release with the delayed tasks, but is not
+                     * blocked. */
+                    if( taskIS_WAITING_FOR_RELEASE( pxTCB ) != pdFALSE )
+                    {
+                        xBlocked = pdFALSE;
+                    }
+                    else if( taskIS_DELAY_WHEEL_SLOT( listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) ) ) != pdFALSE )
+                    {
+                        xBlocked = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_DELAY_WHEEL */
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    /* A task waiting on an event without a timeout is held in
+                     * the suspended list. */
+                    if( ( listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) ) == &xSuspendedTaskList ) &&
+                        ( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL ) )
+                    {
+                        xBlocked = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* INCLUDE_vTaskSuspend */
+
+                if( xBlocked != pdFALSE )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    {
+                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                        pxTCB->ucDelayAborted = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    prvAddTaskToReadyList( pxTCB );
+
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        if( taskPREEMPTS_CURRENT( pxTCB ) )
+                        {
+                            xSwitchRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configUSE_PREEMPTION */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configDEADLINE_MISS_POLICY */
+        }
+
+        if( xConstTickCount == ( TickType_t ) 0U )
+        {
+            pxTemp = pxDeadlineList;
+            pxDeadlineList = pxOverflowDeadlineList;
+            pxOverflowDeadlineList = pxTemp;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xSwitchRequired;
+    }
+
+#endif /* configUSE_DEADLINE_MISS_DETECTION */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_BUDGET_ENFORCEMENT == 1 )
+
+    static configRUN_TIME_COUNTER_TYPE prvGetCurrentJobRunTime( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulNow;
+        configRUN_TIME_COUNTER_TYPE ulReturn = pxCurrentTCB->ulJobRunTime;
+
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+        #else
+            ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
+
+        /* As in vTaskSwitchContext(), guard against a counter that appears to
+         * go backwards. */
+        if( ulNow > ulTaskSwitchedInTime )
+        {
+            ulReturn += ( ulNow - ulTaskSwitchedInTime );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return ulReturn;
+    }
+
+#endif /* configUSE_BUDGET_ENFORCEMENT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_BUDGET_ENFORCEMENT == 1 )
+
+    static void prvStartJobBudget( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulNow;
+
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+        #else
+            ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
+
+        if( ulNow > ulTaskSwitchedInTime )
+        {
+            pxCurrentTCB->ulRunTimeCounter += ( ulNow - ulTaskSwitchedInTime );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ulTaskSwitchedInTime = ulNow;
+        pxCurrentTCB->ulJobRunTime = 0;
+    }
+
+#endif /* configUSE_BUDGET_ENFORCEMENT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_BUDGET_ENFORCEMENT == 1 )
+
+    static BaseType_t prvEnforceJobBudget( void )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+        TickType_t xNextRelease;
+        BaseType_t xHasBudget;
+        BaseType_t xThrottled = pdFALSE;
+
+        /* Only jobs of periodic tasks that declared a CpuBurst have a budget.
+         * The running task might already have left the ready list, for
+         * example if it blocked and the switch away from it is still
+         * pending. */
+        if( ( pxTCB->pxJobCode != NULL ) &&
+            ( pxTCB->xCpuBurst != ( TickType_t ) 0U ) &&
+            ( listIS_CONTAINED_WITHIN( taskREADY_LIST( pxTCB->uxPriority, pxTCB ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+        {
+            xHasBudget = pdTRUE;
+        }
+        else
+        {
+            xHasBudget = pdFALSE;
+        }
+
+        #if ( configUSE_MUTEXES == 1 )
+        {
+            /* A task holding a mutex is left to run so it cannot keep a higher
+             * priority task waiting while it is throttled.  It is caught on the
+             * first tick after it gives the mutex back. */
+            if( pxTCB->uxMutexesHeld != ( UBaseType_t ) 0U )
+            {
+                xHasBudget = pdFALSE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_MUTEXES */
+
+        /* The budget is checked to tick resolution, so a job is only stopped
+         * once it has run for a whole tick more than its CpuBurst. */
+        if( ( xHasBudget != pdFALSE ) &&
+            ( ( prvGetCurrentJobRunTime() / ( configRUN_TIME_COUNTER_TYPE ) configRUN_TIME_COUNTS_PER_TICK ) > ( configRUN_TIME_COUNTER_TYPE ) pxTCB->xCpuBurst ) )
+        {
+            traceTASK_BUDGET_EXHAUSTED( pxTCB );
+
+            /* The rest of the job runs in place of the job of the next release
+             * that is still to come. */
+            xNextRelease = pxTCB->xReleaseTime + pxTCB->xPeriod;
+
+            while( ( xNextRelease == xTickCount ) || ( ( TickType_t ) ( xNextRelease - xTickCount ) > taskMAX_JOB_TICKS_AHEAD ) )
+            {
+                xNextRelease += pxTCB->xPeriod;
+            }
+
+            pxTCB->xReleaseTime = xNextRelease;
+
+            prvStartJobBudget();
+            ( void ) prvAddCurrentTaskToReleaseList();
+            xThrottled = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xThrottled;
+    }
+
+#endif /* configUSE_BUDGET_ENFORCEMENT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_BUDGET_ENFORCEMENT == 1 )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetJobRunTimeCounter( const TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        configRUN_TIME_COUNTER_TYPE ulReturn;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            if( pxTCB == pxCurrentTCB )
+            {
+                ulReturn = prvGetCurrentJobRunTime();
+            }
+            else
+            {
+                ulReturn = pxTCB->ulJobRunTime;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return ulReturn;
+    }
+
+#endif /* configUSE_BUDGET_ENFORCEMENT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
+                                     TaskHookFunction_t pxHookFunction )
+    {
+        TCB_t * xTCB;
+
+        /* If xTask is NULL then it is the task hook of the calling task that is
+         * getting set. */
+        if( xTask == NULL )
+        {
+            xTCB = ( TCB_t * ) pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xTCB->pxTaskTag = pxHookFunction;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
+                                             void * pvParameter )
+    {
+        TCB_t * xTCB;
+        BaseType_t xReturn;
+
+        /* If xTask is NULL then we are calling our own task hook. */
+        if( xTask == NULL )
+        {
+            xTCB = pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        if( xTCB->pxTaskTag != NULL )
+        {
+            xReturn = xTCB->pxTaskTag( pvParameter );
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+void vTaskSwitchContext( void )
+{
+    #if ( configUSE_JOB_STATS == 1 )
+        TCB_t * const pxPreviousTCB = pxCurrentTCB;
+    #endif
+
+    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+    {
+        /* The scheduler is currently suspended - do not allow a context
+         * switch. */
+        xYieldPending = pdTRUE;
+    }
+    else
+    {
+        xYieldPending = pdFALSE;
+        traceTASK_SWITCHED_OUT();
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+            #else
+                ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+            #endif
+
+            /* Add the amount of time the task has been running to the
+             * accumulated time so far.  The time the task started running was
+             * stored in ulTaskSwitchedInTime.  Note that there is no overflow
+             * protection here so count values are only valid until the timer
+             * overflows.  The guard against negative values is to protect
+             * against suspect run time stat counter implementations - which
+             * are provided by the application, not the kernel. */
+            if( ulTotalRunTime > ulTaskSwitchedInTime )
+            {
+                pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+
+                #if ( configUSE_BUDGET_ENFORCEMENT == 1 )
+                {
+                    pxCurrentTCB->ulJobRunTime += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                }
+                #endif
+
+                #if ( configUSE_IDLE_TIME_STATS == 1 )
+                {
+                    /* The idle time is measured from switch to switch, so it
+                     * does not depend on where the ticks fall. */
+                    if( pxCurrentTCB == xIdleTaskHandle )
+                    {
+                        ulIdleRunTime += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            ulTaskSwitchedInTime = ulTotalRunTime;
+        }
+        #endif /* configGENERATE_RUN_TIME_STATS */
+
+        /* Check for stack overflow, if configured. */
+        taskCHECK_FOR_STACK_OVERFLOW();
+
+        /* Before the currently running task is switched out, save its errno. */
+        #if ( configUSE_POSIX_ERRNO == 1 )
+        {
+            pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+        }
+        #endif
+
+        #if (configUSE_RM == 1)
+            taskSELECT_TASK_RM();
+        #elif ( configUSE_EDF == 1 )
+        {
+            /* A task leaving the processor while still Ready goes behind the
+             * other ready tasks with the same deadline, so they take turns
+             * when it yields or its time slice ends. */
+            if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE )
+            {
+                ( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+                prvInsertTaskByDeadline( pxCurrentTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            taskSELECT_TASK_EDF();
+        }
+        #else
+            /* Select a new task to run using either the generic C or port
+            * optimised asm code. */
+            taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        #endif
+
+        #if ( configUSE_JOB_STATS == 1 )
+        {
+            /* A task that leaves the processor while still in its ready list
+             * was preempted, rather than blocked, suspended or deleted, if the
+             * task selected in its place comes before it.  A yield or time
+             * slice that hands the processor to a task of the same rank is not
+             * counted. */
+            if( ( pxCurrentTCB != pxPreviousTCB ) &&
+                ( listIS_CONTAINED_WITHIN( taskREADY_LIST( pxPreviousTCB->uxPriority, pxPreviousTCB ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) &&
+                taskRANKS_ABOVE( pxCurrentTCB, pxPreviousTCB ) )
+            {
+                ( pxPreviousTCB->uxPreemptions )++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_JOB_STATS */
+
+        traceTASK_SWITCHED_IN();
+
+        /* After the new task is switched in, update the global errno. */
+        #if ( configUSE_POSIX_ERRNO == 1 )
+        {
+            FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+        }
+        #endif
+
+        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        {
+            /* Switch C-Runtime's TLS Block to point to the TLS
+             * Block specific to this task. */
+            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+        }
+        #endif
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventList( List_t * const pxEventList,
+                            const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
+
+    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+    /* Place the event list item of the TCB in the appropriate event list.
+     * This is placed in the list in priority order so the highest priority task
+     * is the first to be woken by the event.
+     *
+     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
+     * Normally, the xItemValue of a TCB's ListItem_t members is:
+     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
+     * Therefore, the event list is sorted in descending priority order.
+     * Under Rate Monotonic scheduling tasks of the same priority are then
+     * sorted by period, shortest first.
+     *
+     * The queue that contains the event list is locked, preventing
+     * simultaneous access from interrupts. */
+    #if ( configUSE_RM == 1 )
+    {
+        prvInsertTaskByRate( pxEventList, pxCurrentTCB );
+    }
+    #else
+    {
+        vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+    }
+    #endif
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
+                                     const TickType_t xItemValue,
+                                     const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
+
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+     * the event groups implementation. */
+    configASSERT( uxSchedulerSuspended != 0 );
+
+    /* Store the item value in the event list item.  It is safe to access the
+     * event list item here as interrupts won't access the event list item of a
+     * task that is not in the Blocked state. */
+    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    /* Place the event list item of the TCB at the end of the appropriate event
+     * list.  It is safe to access the event list here because it is part of an
+     * event group implementation - and interrupts don't access event groups
+     * directly (instead they access them indirectly by pending function calls to
+     * the task level). */
+    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMERS == 1 )
+
+    void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
+                                          TickType_t xTicksToWait,
+                                          const BaseType_t xWaitIndefinitely )
+    {
+        configASSERT( pxEventList );
+
+        /* This function should not be called by application code hence the
+         * 'Restricted' in its name.  It is not part of the public API.  It is
+         * designed for use by kernel code, and has special calling requirements -
+         * it should be called with the scheduler suspended. */
+
+
+        /* Place the event list item of the TCB in the appropriate event list.
+         * In this case it is assume that this is the only task that is going to
+         * be waiting on this event list, so the faster vListInsertEnd() function
+         * can be used in place of vListInsert. */
+        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+        /* If the task should block indefinitely then set the block time to a
+         * value that will be recognised as an indefinite delay inside the
+         * prvAddCurrentTaskToDelayedList() function. */
+        if( xWaitIndefinitely != pdFALSE )
+        {
+            xTicksToWait = portMAX_DELAY;
+        }
+
+        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
+        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+    }
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
 
-/* This conditional compilation should use inequality to 0, not equality to 1.
- * This is to ensure vTaskStepTick() is available when user defined low power mode
- * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
- * 1. */
-#if ( configUSE_TICKLESS_IDLE != 0 )
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+{
+    TCB_t * pxUnblockedTCB;
+    BaseType_t xReturn;
+
+    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+     * called from a critical section within an ISR. */
+
+    /* The event list is sorted in priority order, so the first in the list can
+     * be removed as it is known to be the highest priority.  Remove the TCB from
+     * the delayed list, and add it to the ready list.
+     *
+     * If an event is for a queue that is locked then this function will never
+     * get called - the lock count on the queue will get modified instead.  This
+     * means exclusive access to the event list is guaranteed here.
+     *
+     * This function assumes that a check has already been made to ensure that
+     * pxEventList is not empty. */
+    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    {
+        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+        prvAddTaskToReadyList( pxUnblockedTCB );
+
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+             * might be set to the blocked task's time out time.  If the task is
+             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+             * normally left unchanged, because it is automatically reset to a new
+             * value when the tick count equals xNextTaskUnblockTime.  However if
+             * tickless idling is used it might be more important to enter sleep mode
+             * at the earliest possible time - so reset xNextTaskUnblockTime here to
+             * ensure it is updated at the earliest possible time. */
+            prvResetNextTaskUnblockTime();
+        }
+        #endif
+    }
+    else
+    {
+        /* The delayed and ready lists cannot be accessed, so hold this task
+         * pending until the scheduler is resumed. */
+        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+    }
+
+    /* While the scheduler is suspended an EDF deadline is not set until the
+     * task leaves the pending ready list, and xTaskResumeAll() checks again
+     * then. */
+    if( taskPREEMPTS_CURRENT( pxUnblockedTCB ) )
+    {
+        /* Return true if the task removed from the event list comes before the
+         * calling task.  This allows the calling task to know if it should force
+         * a context switch now. */
+        xReturn = pdTRUE;
+
+        /* Mark that a yield is pending in case the user is not using the
+         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+        xYieldPending = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
+                                        const TickType_t xItemValue )
+{
+    TCB_t * pxUnblockedTCB;
+
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+     * the event flags implementation. */
+    configASSERT( uxSchedulerSuspended != pdFALSE );
+
+    /* Store the new item value in the event list. */
+    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    /* Remove the event list form the event flag.  Interrupts do not access
+     * event flags. */
+    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+    listREMOVE_ITEM( pxEventListItem );
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+    {
+        /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+         * might be set to the blocked task's time out time.  If the task is
+         * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+         * normally left unchanged, because it is automatically reset to a new
+         * value when the tick count equals xNextTaskUnblockTime.  However if
+         * tickless idling is used it might be more important to enter sleep mode
+         * at the earliest possible time - so reset xNextTaskUnblockTime here to
+         * ensure it is updated at the earliest possible time. */
+        prvResetNextTaskUnblockTime();
+    }
+    #endif
+
+    /* Remove the task from the delayed list and add it to the ready list.  The
+     * scheduler is suspended so interrupts will not be accessing the ready
+     * lists. */
+    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+    prvAddTaskToReadyList( pxUnblockedTCB );
+
+    if( taskPREEMPTS_CURRENT( pxUnblockedTCB ) )
+    {
+        /* The unblocked task comes before the calling task, so
+         * a context switch is required.  This function is called with the
+         * scheduler suspended so xYieldPending is set so the context switch
+         * occurs immediately that the scheduler is resumed (unsuspended). */
+        xYieldPending = pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    configASSERT( pxTimeOut );
+    taskENTER_CRITICAL();
+    {
+        pxTimeOut->xOverflowCount = xNumOfOverflows;
+        pxTimeOut->xTimeOnEntering = xTickCount;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    /* For internal use only as it does not use a critical section. */
+    pxTimeOut->xOverflowCount = xNumOfOverflows;
+    pxTimeOut->xTimeOnEntering = xTickCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                 TickType_t * const pxTicksToWait )
+{
+    BaseType_t xReturn;
+
+    configASSERT( pxTimeOut );
+    configASSERT( pxTicksToWait );
+
+    taskENTER_CRITICAL();
+    {
+        /* Minor optimisation.  The tick count cannot change in this block. */
+        const TickType_t xConstTickCount = xTickCount;
+        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+
+        #if ( INCLUDE_xTaskAbortDelay == 1 )
+            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+            {
+                /* The delay was aborted, which is not the same as a time out,
+                 * but has the same result. */
+                pxCurrentTCB->ucDelayAborted = pdFALSE;
+                xReturn = pdTRUE;
+            }
+            else
+        #endif
+
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            if( *pxTicksToWait == portMAX_DELAY )
+            {
+                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
+                 * specified is the maximum block time then the task should block
+                 * indefinitely, and therefore never time out. */
+                xReturn = pdFALSE;
+            }
+            else
+        #endif
+
+        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
+        {
+            /* The tick count is greater than the time at which
+             * vTaskSetTimeout() was called, but has also overflowed since
+             * vTaskSetTimeOut() was called.  It must have wrapped all the way
+             * around and gone past again. This passed since vTaskSetTimeout()
+             * was called. */
+            xReturn = pdTRUE;
+            *pxTicksToWait = ( TickType_t ) 0;
+        }
+        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+        {
+            /* Not a genuine timeout. Adjust parameters for time remaining. */
+            *pxTicksToWait -= xElapsedTime;
+            vTaskInternalSetTimeOutState( pxTimeOut );
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            *pxTicksToWait = ( TickType_t ) 0;
+            xReturn = pdTRUE;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskMissedYield( void )
+{
+    xYieldPending = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-    void vTaskStepTick( TickType_t xTicksToJump )
+    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
     {
-        /* Correct the tick count value after a period during which the tick
-         * was suppressed.  Note this does *not* call the tick hook function for
-         * each stepped tick. */
-        configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+        UBaseType_t uxReturn;
+        TCB_t const * pxTCB;
 
-        if( ( xTickCount + xTicksToJump ) == xNextTaskUnblockTime )
+        if( xTask != NULL )
         {
-            /* Arrange for xTickCount to reach xNextTaskUnblockTime in
-             * xTaskIncrementTick() when the scheduler resumes.  This ensures
-             * that any delayed tasks are resumed at the correct time. */
-            configASSERT( uxSchedulerSuspended );
-            configASSERT( xTicksToJump != ( TickType_t ) 0 );
-
-            /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
-            taskENTER_CRITICAL();
-            {
-                xPendedTicks++;
-            }
-            taskEXIT_CRITICAL();
-            xTicksToJump--;
+            pxTCB = xTask;
+            uxReturn = pxTCB->uxTaskNumber;
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            uxReturn = 0U;
         }
 
-        xTickCount += xTicksToJump;
-        traceINCREASE_TICK_COUNT( xTicksToJump );
+        return uxReturn;
     }
 
-#endif /* configUSE_TICKLESS_IDLE */
-/*----------------------------------------------------------*/
-
-BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
-{
-    BaseType_t xYieldOccurred;
-
-    /* Must not be called with the scheduler suspended as the implementation
-     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-    configASSERT( uxSchedulerSuspended == 0 );
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
 
-    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
-     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
-    vTaskSuspendAll();
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
 
-    /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
-    taskENTER_CRITICAL();
+    static portTASK_FUNCTION( prvPeriodicTask, pvParameters )
     {
-        xPendedTicks += xTicksToCatchUp;
+        /* The task memory is allocated once, at creation.  Each iteration of
+         * this loop is one job, and releasing the next job only moves the task
+         * from the release list back to its ready list. */
+        for( ; ; )
+        {
+            pxCurrentTCB->pxJobCode( pvParameters );
+            ( void ) xTaskJobComplete();
+        }
     }
-    taskEXIT_CRITICAL();
-    xYieldOccurred = xTaskResumeAll();
 
-    return xYieldOccurred;
-}
-/*----------------------------------------------------------*/
+#endif /* ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) ) */
+/*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskAbortDelay == 1 )
+#if ( configUSE_SPORADIC_TASKS == 1 )
 
-    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+    static portTASK_FUNCTION( prvSporadicTask, pvParameters )
     {
-        TCB_t * pxTCB = xTask;
-        BaseType_t xReturn;
-
-        configASSERT( pxTCB );
-
-        vTaskSuspendAll();
-        {
-            /* A task can only be prematurely removed from the Blocked state if
-             * it is actually in the Blocked state. */
-            if( eTaskGetState( xTask ) == eBlocked )
+        TCB_t * const pxTCB = pxCurrentTCB;
+
+        for( ; ; )
+        {
+            /* Each notification requests one job.  If the request was made
+             * while the task was waiting for it, taskRELEASE_SPORADIC_JOB()
+             * took the release time.  Otherwise the job is released at the
+             * earliest time it could be, the end of the wait in
+             * xTaskJobComplete().  The wait can also end without a request,
+             * for example through xTaskAbortDelay() or a notification that
+             * does not increment the value, so it is repeated until one job
+             * has been taken. */
+            while( ulTaskNotifyTake( pdFALSE, portMAX_DELAY ) == ( uint32_t ) 0UL )
             {
-                xReturn = pdPASS;
-
-                /* Remove the reference to the task from the blocked list.  An
-                 * interrupt won't touch the xStateListItem because the
-                 * scheduler is suspended. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                /* No job was requested, so wait again. */
+            }
 
-                /* Is the task waiting on an event also?  If so remove it from
-                 * the event list too.  Interrupts can touch the event list item,
-                 * even though the scheduler is suspended, so a critical section
-                 * is used. */
-                taskENTER_CRITICAL();
+            taskENTER_CRITICAL();
+            {
+                #if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
                 {
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                    {
-                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                    prvSetJobDeadline( pxTCB, pxTCB->xReleaseTime + pxTCB->xDeadline );
+                }
+                #endif
 
-                        /* This lets the task know it was forcibly removed from the
-                         * blocked state so it should not re-evaluate its block time and
-                         * then block again. */
-                        pxTCB->ucDelayAborted = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                #if ( configUSE_BUDGET_ENFORCEMENT == 1 )
+                {
+                    prvStartJobBudget();
                 }
-                taskEXIT_CRITICAL();
+                #endif
 
-                /* Place the unblocked task into the appropriate ready list. */
-                prvAddTaskToReadyList( pxTCB );
+                #if ( configUSE_JOB_STATS == 1 )
+                {
+                    ( pxTCB->uxJobsReleased )++;
+                }
+                #endif
 
-                /* A task being unblocked cannot cause an immediate context
-                 * switch if preemption is turned off. */
-                #if ( configUSE_PREEMPTION == 1 )
+                #if ( configUSE_SCHEDULE_TRACE == 1 )
                 {
-                    /* Preemption is on, but a context switch should only be
-                     * performed if the unblocked task has a priority that is
-                     * higher than the currently executing task. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                    {
-                        /* Pend the yield to be performed when the scheduler
-                         * is unsuspended. */
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    prvRecordScheduleEvent( pxTCB, eTraceJobReleased );
                 }
-                #endif /* configUSE_PREEMPTION */
-            }
-            else
-            {
-                xReturn = pdFAIL;
+                #endif
+
+                traceTASK_JOB_RELEASED( pxTCB );
             }
-        }
-        ( void ) xTaskResumeAll();
+            taskEXIT_CRITICAL();
 
-        return xReturn;
+            pxTCB->pxJobCode( pvParameters );
+            ( void ) xTaskJobComplete();
+        }
     }
 
-#endif /* INCLUDE_xTaskAbortDelay */
-/*----------------------------------------------------------*/
-
-BaseType_t xTaskIncrementTick( void )
-{
-    TCB_t * pxTCB;
-    TickType_t xItemValue;
-    BaseType_t xSwitchRequired = pdFALSE;
+#endif /* configUSE_SPORADIC_TASKS */
+/*-----------------------------------------------------------*/
 
-    /* Called by the portable layer each time a tick interrupt occurs.
-     * Increments the tick then checks to see if the new tick value will cause any
-     * tasks to be unblocked. */
-    traceTASK_INCREMENT_TICK( xTickCount );
+#if ( configUSE_APERIODIC_SERVER == 1 )
 
-    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    BaseType_t xTaskCreateAperiodicServer( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                           const configSTACK_DEPTH_TYPE usStackDepth,
+                                           UBaseType_t uxPriority,
+                                           TaskHandle_t * const pxCreatedTask,
+                                           TickType_t xBudget,
+                                           TickType_t xPeriod,
+                                           UBaseType_t uxQueueLength )
     {
-        /* Minor optimisation.  The tick count cannot change in this
-         * block. */
-        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+        AperiodicServer_t * pxServer;
+        BaseType_t xReturn;
 
-        /* Increment the RTOS tick, switching the delayed and overflowed
-         * delayed lists if it wraps to 0. */
-        xTickCount = xConstTickCount;
+        configASSERT( uxQueueLength > ( UBaseType_t ) 0U );
+        configASSERT( ( xBudget != ( TickType_t ) 0U ) && ( xBudget <= xPeriod ) );
 
-        if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
-        {
-            taskSWITCH_DELAYED_LISTS();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        /* The ring of jobs follows the structure in the same allocation, as
+         * the storage area of a queue does. */
+        pxServer = ( AperiodicServer_t * ) pvPortMalloc( sizeof( AperiodicServer_t ) + ( ( size_t ) uxQueueLength * sizeof( AperiodicJob_t ) ) ); /*lint !e9087 !e9079 The structure and the ring it is followed by are aligned as the structure is. */
 
-        /* See if this tick has made a timeout expire.  Tasks are stored in
-         * the  queue in the order of their wake time - meaning once one task
-         * has been found whose block time has not expired there is no need to
-         * look any further down the list. */
-        if( xConstTickCount >= xNextTaskUnblockTime )
+        if( pxServer != NULL )
         {
-            for( ; ; )
-            {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-                {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    break;
-                }
-                else
-                {
-                    /* The delayed list is not empty, get the value of the
-                     * item at the head of the delayed list.  This is the time
-                     * at which the task at the head of the delayed list must
-                     * be removed from the Blocked state. */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
-
-                    if( xConstTickCount < xItemValue )
-                    {
-                        /* It is not time to unblock this item yet, but the
-                         * item value is the time at which the task at the head
-                         * of the blocked list must be removed from the Blocked
-                         * state -  so record the item value in
-                         * xNextTaskUnblockTime. */
-                        xNextTaskUnblockTime = xItemValue;
-                        break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* It is time to remove the item from the Blocked state. */
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-
-                    /* Is the task waiting on an event also?  If so remove
-                     * it from the event list. */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                    {
-                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* Place the unblocked task into the appropriate ready
-                     * list. */
-                    prvAddTaskToReadyList( pxTCB );
+            pxServer->pxJobs = ( AperiodicJob_t * ) &( pxServer[ 1 ] ); /*lint !e9087 !e9079 See above. */
+            pxServer->uxLength = uxQueueLength;
+            pxServer->uxHead = ( UBaseType_t ) 0U;
+            pxServer->uxWaiting = ( UBaseType_t ) 0U;
 
-                    /* A task being unblocked cannot cause an immediate
-                     * context switch if preemption is turned off. */
-                    #if ( configUSE_PREEMPTION == 1 )
-                    {
-                        /* Preemption is on, but a context switch should
-                         * only be performed if the unblocked task's
-                         * priority is higher than the currently executing
-                         * task.
-                         * The case of equal priority tasks sharing
-                         * processing time (which happens when both
-                         * preemption and time slicing are on) is
-                         * handled below.*/
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                        {
-                            xSwitchRequired = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    #endif /* configUSE_PREEMPTION */
-                }
-            }
-        }
+            /* Every period is a job of the server, and its budget is the
+             * CpuBurst that budget enforcement holds it to. */
+            xReturn = prvCreatePeriodicTask( prvAperiodicServerJob, pcName, usStackDepth, ( void * ) pxServer, uxPriority, pxCreatedTask, xBudget, xPeriod, xPeriod, taskJOBS_SERVER );
 
-        /* Tasks of equal priority to the currently running task will share
-         * processing time (time slice) if preemption is on, and the application
-         * writer has not explicitly turned time slicing off. */
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
-        {
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+            if( xReturn != pdPASS )
             {
-                xSwitchRequired = pdTRUE;
+                vPortFree( pxServer );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+        else
+        {
+            xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+        }
 
-        #if ( configUSE_TICK_HOOK == 1 )
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAperiodicServerJob( void * pvParameters )
+    {
+        AperiodicServer_t * const pxServer = ( AperiodicServer_t * ) pvParameters;
+        AperiodicJob_t xJob;
+        TickType_t xTicksToRelease;
+        BaseType_t xHaveJob;
+
+        for( ; ; )
         {
-            /* Guard against the tick hook being called when the pended tick
-             * count is being unwound (when the scheduler is being unlocked). */
-            if( xPendedTicks == ( TickType_t ) 0 )
+            taskENTER_CRITICAL();
             {
-                vApplicationTickHook();
+                /* Budget enforcement moves the release on when the budget runs
+                 * out, so the end of the period is found again each time. */
+                xTicksToRelease = ( pxCurrentTCB->xReleaseTime + pxCurrentTCB->xPeriod ) - xTickCount;
+
+                if( ( xTicksToRelease == ( TickType_t ) 0U ) || ( xTicksToRelease > taskMAX_JOB_TICKS_AHEAD ) )
+                {
+                    /* The period is over.  Completing the job of the server
+                     * refills its budget, and a waiting job is run after
+                     * that. */
+                    xTicksToRelease = ( TickType_t ) 0U;
+                    xHaveJob = pdFALSE;
+                }
+                else if( pxServer->uxWaiting > ( UBaseType_t ) 0U )
+                {
+                    xJob = pxServer->pxJobs[ pxServer->uxHead ];
+                    pxServer->uxHead = ( pxServer->uxHead + ( UBaseType_t ) 1U ) % pxServer->uxLength;
+                    ( pxServer->uxWaiting )--;
+                    xHaveJob = pdTRUE;
+                }
+                else
+                {
+                    xHaveJob = pdFALSE;
+                }
             }
-            else
+            taskEXIT_CRITICAL();
+
+            if( xHaveJob != pdFALSE )
             {
-                mtCOVERAGE_TEST_MARKER();
+                xJob.pxJobCode( xJob.pvParameters );
             }
-        }
-        #endif /* configUSE_TICK_HOOK */
-
-        #if ( configUSE_PREEMPTION == 1 )
-        {
-            if( xYieldPending != pdFALSE )
+            else if( xTicksToRelease == ( TickType_t ) 0U )
             {
-                xSwitchRequired = pdTRUE;
+                break;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* Keep what is left of the budget and wait for a job to be
+                 * submitted, or for the period to end. */
+                ( void ) ulTaskNotifyTake( pdTRUE, xTicksToRelease );
             }
         }
-        #endif /* configUSE_PREEMPTION */
-    }
-    else
-    {
-        ++xPendedTicks;
-
-        /* The tick hook gets called at regular intervals, even if the
-         * scheduler is locked. */
-        #if ( configUSE_TICK_HOOK == 1 )
-        {
-            vApplicationTickHook();
-        }
-        #endif
     }
-
-    return xSwitchRequired;
-}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
-
-    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
-                                     TaskHookFunction_t pxHookFunction )
+    static BaseType_t prvQueueAperiodicJob( AperiodicServer_t * const pxServer,
+                                            TaskFunction_t pxJobCode,
+                                            void * pvParameters )
     {
-        TCB_t * xTCB;
+        UBaseType_t uxTail;
+        BaseType_t xReturn;
 
-        /* If xTask is NULL then it is the task hook of the calling task that is
-         * getting set. */
-        if( xTask == NULL )
+        if( pxServer->uxWaiting < pxServer->uxLength )
         {
-            xTCB = ( TCB_t * ) pxCurrentTCB;
+            uxTail = ( pxServer->uxHead + pxServer->uxWaiting ) % pxServer->uxLength;
+            pxServer->pxJobs[ uxTail ].pxJobCode = pxJobCode;
+            pxServer->pxJobs[ uxTail ].pvParameters = pvParameters;
+            ( pxServer->uxWaiting )++;
+            xReturn = pdPASS;
         }
         else
         {
-            xTCB = xTask;
+            xReturn = errQUEUE_FULL;
         }
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        taskENTER_CRITICAL();
-        {
-            xTCB->pxTaskTag = pxHookFunction;
-        }
-        taskEXIT_CRITICAL();
+        return xReturn;
     }
-
-#endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
-
-    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+    BaseType_t xTaskSubmitAperiodicJob( TaskHandle_t xServer,
+                                        TaskFunction_t pxJobCode,
+                                        void * pvParameters )
     {
-        TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
+        TCB_t * const pxTCB = xServer;
+        BaseType_t xReturn;
 
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxTCB );
+        configASSERT( pxTCB->pxAperiodicServer != NULL );
+        configASSERT( pxJobCode );
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
         taskENTER_CRITICAL();
         {
-            xReturn = pxTCB->pxTaskTag;
+            xReturn = prvQueueAperiodicJob( pxTCB->pxAperiodicServer, pxJobCode, pvParameters );
         }
         taskEXIT_CRITICAL();
 
+        if( xReturn == pdPASS )
+        {
+            /* Wake the server if it is waiting for work.  It only runs the job
+             * now if it outranks the calling task. */
+            ( void ) xTaskNotifyGive( xServer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
         return xReturn;
     }
-
-#endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
-
-    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+    BaseType_t xTaskSubmitAperiodicJobFromISR( TaskHandle_t xServer,
+                                               TaskFunction_t pxJobCode,
+                                               void * pvParameters,
+                                               BaseType_t * pxHigherPriorityTaskWoken )
     {
-        TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
+        TCB_t * const pxTCB = xServer;
         UBaseType_t uxSavedInterruptStatus;
+        BaseType_t xReturn;
 
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxTCB );
+        configASSERT( pxTCB->pxAperiodicServer != NULL );
+        configASSERT( pxJobCode );
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
         {
-            xReturn = pxTCB->pxTaskTag;
+            xReturn = prvQueueAperiodicJob( pxTCB->pxAperiodicServer, pxJobCode, pvParameters );
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        if( xReturn == pdPASS )
+        {
+            vTaskNotifyGiveFromISR( xServer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
         return xReturn;
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* configUSE_APERIODIC_SERVER */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
-                                             void * pvParameter )
+    void vTaskSetTaskNumber( TaskHandle_t xTask,
+                             const UBaseType_t uxHandle )
     {
-        TCB_t * xTCB;
-        BaseType_t xReturn;
+        TCB_t * pxTCB;
 
-        /* If xTask is NULL then we are calling our own task hook. */
-        if( xTask == NULL )
+        if( xTask != NULL )
         {
-            xTCB = pxCurrentTCB;
+            pxTCB = xTask;
+            pxTCB->uxTaskNumber = uxHandle;
         }
-        else
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+
+/*
+ * -----------------------------------------------------------
+ * The Idle task.
+ * ----------------------------------------------------------
+ *
+ * The portTASK_FUNCTION() macro is used to allow port/compiler specific
+ * language extensions.  The equivalent prototype for this function is:
+ *
+ * void prvIdleTask( void *pvParameters );
+ *
+ */
+static portTASK_FUNCTION( prvIdleTask, pvParameters )
+{
+    /* Stop warnings. */
+    ( void ) pvParameters;
+
+
+    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
+     * SCHEDULER IS STARTED. **/
+
+    /* In case a task that has a secure context deletes itself, in which case
+     * the idle task is responsible for deleting the task's secure context, if
+     * any. */
+    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
+
+    for( ; ; )
+    {
+        /* See if any tasks have deleted themselves - if so then the idle task
+         * is responsible for freeing the deleted task's TCB and stack. */
+        prvCheckTasksWaitingTermination();
+
+        #if ( configUSE_PREEMPTION == 0 )
         {
-            xTCB = xTask;
+            /* If we are not using preemption we keep forcing a task switch to
+             * see if any other task has become available.  If we are using
+             * preemption we don't need to do this as any task becoming available
+             * will automatically get the processor anyway. */
+            taskYIELD();
         }
+        #endif /* configUSE_PREEMPTION */
 
-        if( xTCB->pxTaskTag != NULL )
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
         {
-            xReturn = xTCB->pxTaskTag( pvParameter );
+            /* When using preemption tasks of equal priority will be
+             * timesliced.  If a task that is sharing the idle priority is ready
+             * to run then the idle task should yield before the end of the
+             * timeslice.
+             *
+             * A critical region is not required here as we are just reading from
+             * the list, and an occasional incorrect value will not matter.  If
+             * the ready list at the idle priority contains more than one task
+             * then a task other than the idle task is ready to execute. */
+            if( taskREADY_TASKS_AT_PRIORITY( tskIDLE_PRIORITY ) > ( UBaseType_t ) 1 )
+            {
+                taskYIELD();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        else
+        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+
+        #if ( configUSE_IDLE_HOOK == 1 )
         {
-            xReturn = pdFAIL;
+            extern void vApplicationIdleHook( void );
+
+            /* Call the user defined function from within the idle task.  This
+             * allows the application designer to add background functionality
+             * without the overhead of a separate task.
+             * NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
+             * CALL A FUNCTION THAT MIGHT BLOCK. */
+            vApplicationIdleHook();
         }
+        #endif /* configUSE_IDLE_HOOK */
 
-        return xReturn;
-    }
+        /* This conditional compilation should use inequality to 0, not equality
+         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
+         * user defined low power mode  implementations require
+         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            TickType_t xExpectedIdleTime;
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
+            /* It is not desirable to suspend then resume the scheduler on
+             * each iteration of the idle task.  Therefore, a preliminary
+             * test of the expected idle time is performed without the
+             * scheduler suspended.  The result here is not necessarily
+             * valid. */
+            xExpectedIdleTime = prvGetExpectedIdleTime();
 
-void vTaskSwitchContext( void )
-{
-    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
-    {
-        /* The scheduler is currently suspended - do not allow a context
-         * switch. */
-        xYieldPending = pdTRUE;
-    }
-    else
-    {
-        xYieldPending = pdFALSE;
-        traceTASK_SWITCHED_OUT();
+            if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+            {
+                vTaskSuspendAll();
+                {
+                    /* Now the scheduler is suspended, the expected idle
+                     * time can be sampled again, and this time its value can
+                     * be used. */
+                    configASSERT( xNextTaskUnblockTime >= xTickCount );
+                    xExpectedIdleTime = prvGetExpectedIdleTime();
 
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
-        {
-            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-            #else
-                ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-            #endif
+                    /* Define the following macro to set xExpectedIdleTime to 0
+                     * if the application does not want
+                     * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
+                    configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
 
-            /* Add the amount of time the task has been running to the
-             * accumulated time so far.  The time the task started running was
-             * stored in ulTaskSwitchedInTime.  Note that there is no overflow
-             * protection here so count values are only valid until the timer
-             * overflows.  The guard against negative values is to protect
-             * against suspect run time stat counter implementations - which
-             * are provided by the application, not the kernel. */
-            if( ulTotalRunTime > ulTaskSwitchedInTime )
-            {
-                pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                    if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+                    {
+                        traceLOW_POWER_IDLE_BEGIN();
+                        portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+                        traceLOW_POWER_IDLE_END();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                ( void ) xTaskResumeAll();
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-
-            ulTaskSwitchedInTime = ulTotalRunTime;
         }
-        #endif /* configGENERATE_RUN_TIME_STATS */
+        #endif /* configUSE_TICKLESS_IDLE */
+    }
+}
+/*-----------------------------------------------------------*/
 
-        /* Check for stack overflow, if configured. */
-        taskCHECK_FOR_STACK_OVERFLOW();
+#if ( configUSE_TICKLESS_IDLE != 0 )
 
-        /* Before the currently running task is switched out, save its errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
+    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+    {
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            /* The idle task exists in addition to the application tasks. */
+            const UBaseType_t uxNonApplicationTasks = 1;
+        #endif /* INCLUDE_vTaskSuspend */
+
+        eSleepModeStatus eReturn = eStandardSleep;
+
+        /* This function must be called from a critical section. */
+
+        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+        {
+            /* A task was made ready while the scheduler was suspended. */
+            eReturn = eAbortSleep;
+        }
+        else if( xYieldPending != pdFALSE )
         {
-            pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+            /* A yield was pended while the scheduler was suspended. */
+            eReturn = eAbortSleep;
         }
-        #endif
-
-        #if (configUSE_RM == 1)
-            taskSELECT_TASK_RM();
-        #else
-            /* Select a new task to run using either the generic C or port
-            * optimised asm code. */
-            taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-        #endif
-        traceTASK_SWITCHED_IN();
-
-        /* After the new task is switched in, update the global errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
+        else if( xPendedTicks != 0 )
         {
-            FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+            /* A tick interrupt has already occurred but was held pending
+             * because the scheduler is suspended. */
+            eReturn = eAbortSleep;
         }
-        #endif
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            else if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+            {
+                /* If all the tasks are in the suspended list (which might mean they
+                 * have an infinite block time rather than actually being suspended)
+                 * then it is safe to turn all clocks off and just wait for external
+                 * interrupts. */
+                eReturn = eNoTasksWaitingTimeout;
+            }
+        #endif /* INCLUDE_vTaskSuspend */
+        else
         {
-            /* Switch C-Runtime's TLS Block to point to the TLS
-             * Block specific to this task. */
-            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif
+
+        return eReturn;
     }
-}
+
+#endif /* configUSE_TICKLESS_IDLE */
 /*-----------------------------------------------------------*/
 
-void vTaskPlaceOnEventList( List_t * const pxEventList,
-                            const TickType_t xTicksToWait )
-{
-    configASSERT( pxEventList );
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
 
-    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
-     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
+                                            BaseType_t xIndex,
+                                            void * pvValue )
+    {
+        TCB_t * pxTCB;
 
-    /* Place the event list item of the TCB in the appropriate event list.
-     * This is placed in the list in priority order so the highest priority task
-     * is the first to be woken by the event.
-     *
-     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
-     * Normally, the xItemValue of a TCB's ListItem_t members is:
-     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
-     * Therefore, the event list is sorted in descending priority order.
-     *
-     * The queue that contains the event list is locked, preventing
-     * simultaneous access from interrupts. */
-    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        if( ( xIndex >= 0 ) &&
+            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        {
+            pxTCB = prvGetTCBFromHandle( xTaskToSet );
+            configASSERT( pxTCB != NULL );
+            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+        }
+    }
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
-void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
-                                     const TickType_t xItemValue,
-                                     const TickType_t xTicksToWait )
-{
-    configASSERT( pxEventList );
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
 
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event groups implementation. */
-    configASSERT( uxSchedulerSuspended != 0 );
+    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
+                                               BaseType_t xIndex )
+    {
+        void * pvReturn = NULL;
+        TCB_t * pxTCB;
 
-    /* Store the item value in the event list item.  It is safe to access the
-     * event list item here as interrupts won't access the event list item of a
-     * task that is not in the Blocked state. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+        if( ( xIndex >= 0 ) &&
+            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        {
+            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
+        }
+        else
+        {
+            pvReturn = NULL;
+        }
 
-    /* Place the event list item of the TCB at the end of the appropriate event
-     * list.  It is safe to access the event list here because it is part of an
-     * event group implementation - and interrupts don't access event groups
-     * directly (instead they access them indirectly by pending function calls to
-     * the task level). */
-    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        return pvReturn;
+    }
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TIMERS == 1 )
+#if ( portUSING_MPU_WRAPPERS == 1 )
 
-    void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
-                                          TickType_t xTicksToWait,
-                                          const BaseType_t xWaitIndefinitely )
+    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
+                                  const MemoryRegion_t * const xRegions )
     {
-        configASSERT( pxEventList );
-
-        /* This function should not be called by application code hence the
-         * 'Restricted' in its name.  It is not part of the public API.  It is
-         * designed for use by kernel code, and has special calling requirements -
-         * it should be called with the scheduler suspended. */
-
-
-        /* Place the event list item of the TCB in the appropriate event list.
-         * In this case it is assume that this is the only task that is going to
-         * be waiting on this event list, so the faster vListInsertEnd() function
-         * can be used in place of vListInsert. */
-        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        TCB_t * pxTCB;
 
-        /* If the task should block indefinitely then set the block time to a
-         * value that will be recognised as an indefinite delay inside the
-         * prvAddCurrentTaskToDelayedList() function. */
-        if( xWaitIndefinitely != pdFALSE )
-        {
-            xTicksToWait = portMAX_DELAY;
-        }
+        /* If null is passed in here then we are modifying the MPU settings of
+         * the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTaskToModify );
 
-        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
-        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
     }
 
-#endif /* configUSE_TIMERS */
+#endif /* portUSING_MPU_WRAPPERS */
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+static void prvInitialiseTaskLists( void )
 {
-    TCB_t * pxUnblockedTCB;
-    BaseType_t xReturn;
-
-    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
-     * called from a critical section within an ISR. */
-
-    /* The event list is sorted in priority order, so the first in the list can
-     * be removed as it is known to be the highest priority.  Remove the TCB from
-     * the delayed list, and add it to the ready list.
-     *
-     * If an event is for a queue that is locked then this function will never
-     * get called - the lock count on the queue will get modified instead.  This
-     * means exclusive access to the event list is guaranteed here.
-     *
-     * This function assumes that a check has already been made to ensure that
-     * pxEventList is not empty. */
-    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+    UBaseType_t uxPriority;
 
-    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
     {
-        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-        prvAddTaskToReadyList( pxUnblockedTCB );
+        #if ( configUSE_RM == 1 )
+        {
+            UBaseType_t uxPeriod;
 
-        #if ( configUSE_TICKLESS_IDLE != 0 )
+            for( uxPeriod = ( UBaseType_t ) 0U; uxPeriod < ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS; uxPeriod++ )
+            {
+                vListInitialise( &( pxReadyTasksLists[ uxPriority ][ uxPeriod ] ) );
+            }
+
+            uxReadyPeriods[ uxPriority ] = ( UBaseType_t ) 0U;
+        }
+        #else
         {
-            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-             * might be set to the blocked task's time out time.  If the task is
-             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-             * normally left unchanged, because it is automatically reset to a new
-             * value when the tick count equals xNextTaskUnblockTime.  However if
-             * tickless idling is used it might be more important to enter sleep mode
-             * at the earliest possible time - so reset xNextTaskUnblockTime here to
-             * ensure it is updated at the earliest possible time. */
-            prvResetNextTaskUnblockTime();
+            vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
         }
-        #endif
+        #endif /* configUSE_RM */
     }
-    else
+
+    #if ( configUSE_RM == 1 )
     {
-        /* The delayed and ready lists cannot be accessed, so hold this task
-         * pending until the scheduler is resumed. */
-        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+        /* Only the class of tasks without a period exists to begin with. */
+        xPeriodClasses[ taskRM_NO_PERIOD_CLASS ].xPeriod = portMAX_DELAY;
+        xPeriodClasses[ taskRM_NO_PERIOD_CLASS ].uxRank = ( UBaseType_t ) 0U;
+        uxPeriodClassesInUse = ( UBaseType_t ) 1U;
     }
+    #endif
+
+    vListInitialise( &xDelayedTaskList1 );
+    vListInitialise( &xDelayedTaskList2 );
+    vListInitialise( &xPendingReadyList );
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #if ( configUSE_DELAY_WHEEL == 1 )
     {
-        /* Return true if the task removed from the event list has a higher
-         * priority than the calling task.  This allows the calling task to know if
-         * it should force a context switch now. */
-        xReturn = pdTRUE;
+        UBaseType_t uxLevel, uxSlot;
 
-        /* Mark that a yield is pending in case the user is not using the
-         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-        xYieldPending = pdTRUE;
+        for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configDELAY_WHEEL_LEVELS; uxLevel++ )
+        {
+            for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( UBaseType_t ) taskWHEEL_SLOTS; uxSlot++ )
+            {
+                vListInitialise( &( xDelayWheel[ uxLevel ][ uxSlot ] ) );
+            }
+        }
     }
-    else
+    #endif /* configUSE_DELAY_WHEEL */
+
+    #if ( INCLUDE_vTaskDelete == 1 )
     {
-        xReturn = pdFALSE;
+        vListInitialise( &xTasksWaitingTermination );
     }
+    #endif /* INCLUDE_vTaskDelete */
 
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
-
-void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
-                                        const TickType_t xItemValue )
-{
-    TCB_t * pxUnblockedTCB;
-
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event flags implementation. */
-    configASSERT( uxSchedulerSuspended != pdFALSE );
-
-    /* Store the new item value in the event list. */
-    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
-
-    /* Remove the event list form the event flag.  Interrupts do not access
-     * event flags. */
-    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( pxEventListItem );
+    #if ( configUSE_RM_ADMISSION_CONTROL == 1 )
+    {
+        vListInitialise( &xAdmittedTasksList );
+    }
+    #endif
 
-    #if ( configUSE_TICKLESS_IDLE != 0 )
+    #if ( configUSE_RM_AUTO_PRIORITY == 1 )
     {
-        /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-         * might be set to the blocked task's time out time.  If the task is
-         * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-         * normally left unchanged, because it is automatically reset to a new
-         * value when the tick count equals xNextTaskUnblockTime.  However if
-         * tickless idling is used it might be more important to enter sleep mode
-         * at the earliest possible time - so reset xNextTaskUnblockTime here to
-         * ensure it is updated at the earliest possible time. */
-        prvResetNextTaskUnblockTime();
+        vListInitialise( &xRateOrderedTasksList );
+    }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) && ( configUSE_DELAY_WHEEL == 0 ) )
+    {
+        vListInitialise( &xJobReleaseList1 );
+        vListInitialise( &xJobReleaseList2 );
+        pxJobReleaseList = &xJobReleaseList1;
+        pxOverflowJobReleaseList = &xJobReleaseList2;
     }
     #endif
 
-    /* Remove the task from the delayed list and add it to the ready list.  The
-     * scheduler is suspended so interrupts will not be accessing the ready
-     * lists. */
-    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-    prvAddTaskToReadyList( pxUnblockedTCB );
+    #if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
+    {
+        vListInitialise( &xDeadlineList1 );
+        vListInitialise( &xDeadlineList2 );
+        pxDeadlineList = &xDeadlineList1;
+        pxOverflowDeadlineList = &xDeadlineList2;
+    }
+    #endif
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #if ( INCLUDE_vTaskSuspend == 1 )
     {
-        /* The unblocked task has a priority above that of the calling task, so
-         * a context switch is required.  This function is called with the
-         * scheduler suspended so xYieldPending is set so the context switch
-         * occurs immediately that the scheduler is resumed (unsuspended). */
-        xYieldPending = pdTRUE;
+        vListInitialise( &xSuspendedTaskList );
     }
+    #endif /* INCLUDE_vTaskSuspend */
+
+    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+     * using list2. */
+    pxDelayedTaskList = &xDelayedTaskList1;
+    pxOverflowDelayedTaskList = &xDelayedTaskList2;
 }
 /*-----------------------------------------------------------*/
 
-void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+static void prvCheckTasksWaitingTermination( void )
 {
-    configASSERT( pxTimeOut );
-    taskENTER_CRITICAL();
+    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+
+    #if ( INCLUDE_vTaskDelete == 1 )
     {
-        pxTimeOut->xOverflowCount = xNumOfOverflows;
-        pxTimeOut->xTimeOnEntering = xTickCount;
+        TCB_t * pxTCB;
+
+        /* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
+         * being called too often in the idle task. */
+        while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                --uxCurrentNumberOfTasks;
+                --uxDeletedTasksWaitingCleanUp;
+            }
+            taskEXIT_CRITICAL();
+
+            prvDeleteTCB( pxTCB );
+        }
     }
-    taskEXIT_CRITICAL();
+    #endif /* INCLUDE_vTaskDelete */
 }
 /*-----------------------------------------------------------*/
 
-void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    /* For internal use only as it does not use a critical section. */
-    pxTimeOut->xOverflowCount = xNumOfOverflows;
-    pxTimeOut->xTimeOnEntering = xTickCount;
-}
-/*-----------------------------------------------------------*/
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
-                                 TickType_t * const pxTicksToWait )
-{
-    BaseType_t xReturn;
+    void vTaskGetInfo( TaskHandle_t xTask,
+                       TaskStatus_t * pxTaskStatus,
+                       BaseType_t xGetFreeStackSpace,
+                       eTaskState eState )
+    {
+        TCB_t * pxTCB;
 
-    configASSERT( pxTimeOut );
-    configASSERT( pxTicksToWait );
+        /* xTask is NULL then get the state of the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTask );
 
-    taskENTER_CRITICAL();
-    {
-        /* Minor optimisation.  The tick count cannot change in this block. */
-        const TickType_t xConstTickCount = xTickCount;
-        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+        pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
+        pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
+        pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
+        pxTaskStatus->pxStackBase = pxTCB->pxStack;
+        #if ( ( portSTACK_GROWTH > 0 ) && ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+            pxTaskStatus->pxTopOfStack = pxTCB->pxTopOfStack;
+            pxTaskStatus->pxEndOfStack = pxTCB->pxEndOfStack;
+        #endif
+        pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
 
-        #if ( INCLUDE_xTaskAbortDelay == 1 )
-            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+        #if ( configUSE_MUTEXES == 1 )
+        {
+            pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+        }
+        #else
+        {
+            pxTaskStatus->uxBasePriority = 0;
+        }
+        #endif
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+        }
+        #else
+        {
+            pxTaskStatus->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+        }
+        #endif
+
+        #if ( configUSE_JOB_STATS == 1 )
+        {
+            pxTaskStatus->uxJobsReleased = pxTCB->uxJobsReleased;
+            pxTaskStatus->uxJobsCompleted = pxTCB->uxJobsCompleted;
+            pxTaskStatus->uxPreemptions = pxTCB->uxPreemptions;
+            pxTaskStatus->xWorstResponseTime = pxTCB->xWorstResponseTime;
+
+            #if ( configUSE_DEADLINE_MISS_DETECTION == 1 )
             {
-                /* The delay was aborted, which is not the same as a time out,
-                 * but has the same result. */
-                pxCurrentTCB->ucDelayAborted = pdFALSE;
-                xReturn = pdTRUE;
+                pxTaskStatus->uxDeadlineMisses = pxTCB->uxDeadlineMisses;
             }
-            else
-        #endif
+            #else
+            {
+                pxTaskStatus->uxDeadlineMisses = ( UBaseType_t ) 0U;
+            }
+            #endif
+        }
+        #endif /* configUSE_JOB_STATS */
 
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            if( *pxTicksToWait == portMAX_DELAY )
+        /* Obtaining the task state is a little fiddly, so is only done if the
+         * value of eState passed into this function is eInvalid - otherwise the
+         * state is just set to whatever is passed in. */
+        if( eState != eInvalid )
+        {
+            if( pxTCB == pxCurrentTCB )
             {
-                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
-                 * specified is the maximum block time then the task should block
-                 * indefinitely, and therefore never time out. */
-                xReturn = pdFALSE;
+                pxTaskStatus->eCurrentState = eRunning;
             }
             else
-        #endif
+            {
+                pxTaskStatus->eCurrentState = eState;
 
-        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    /* If the task is in the suspended list then there is a
+                     *  chance it is actually just blocked indefinitely - so really
+                     *  it should be reported as being in the Blocked state. */
+                    if( eState == eSuspended )
+                    {
+                        vTaskSuspendAll();
+                        {
+                            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                            {
+                                pxTaskStatus->eCurrentState = eBlocked;
+                            }
+                        }
+                        ( void ) xTaskResumeAll();
+                    }
+                }
+                #endif /* INCLUDE_vTaskSuspend */
+            }
+        }
+        else
         {
-            /* The tick count is greater than the time at which
-             * vTaskSetTimeout() was called, but has also overflowed since
-             * vTaskSetTimeOut() was called.  It must have wrapped all the way
-             * around and gone past again. This passed since vTaskSetTimeout()
-             * was called. */
-            xReturn = pdTRUE;
-            *pxTicksToWait = ( TickType_t ) 0;
+            pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
         }
-        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+
+        /* Obtaining the stack space takes some time, so the xGetFreeStackSpace
+         * parameter is provided to allow it to be skipped. */
+        if( xGetFreeStackSpace != pdFALSE )
         {
-            /* Not a genuine timeout. Adjust parameters for time remaining. */
-            *pxTicksToWait -= xElapsedTime;
-            vTaskInternalSetTimeOutState( pxTimeOut );
-            xReturn = pdFALSE;
+            #if ( portSTACK_GROWTH > 0 )
+            {
+                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+            }
+            #else
+            {
+                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+            }
+            #endif
         }
         else
         {
-            *pxTicksToWait = ( TickType_t ) 0;
-            xReturn = pdTRUE;
+            pxTaskStatus->usStackHighWaterMark = 0;
         }
     }
-    taskEXIT_CRITICAL();
 
-    return xReturn;
-}
+#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-void vTaskMissedYield( void )
-{
-    xYieldPending = pdTRUE;
-}
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
+                                                     List_t * pxList,
+                                                     eTaskState eState )
+    {
+        configLIST_VOLATILE TCB_t * pxNextTCB;
+        configLIST_VOLATILE TCB_t * pxFirstTCB;
+        UBaseType_t uxTask = 0;
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            /* Populate an TaskStatus_t structure within the
+             * pxTaskStatusArray array for each task that is referenced from
+             * pxList.  See the definition of TaskStatus_t in task.h for the
+             * meaning of each TaskStatus_t structure member. */
+            do
+            {
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
+                uxTask++;
+            } while( pxNextTCB != pxFirstTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    {
+        uint32_t ulCount = 0U;
+
+        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        {
+            pucStackByte -= portSTACK_GROWTH;
+            ulCount++;
+        }
+
+        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+
+        return ( configSTACK_DEPTH_TYPE ) ulCount;
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+
+/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
+ * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
+ * user to determine the return type.  It gets around the problem of the value
+ * overflowing on 8-bit types without breaking backward compatibility for
+ * applications that expect an 8-bit return type. */
+    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        uint8_t * pucEndOfStack;
+        configSTACK_DEPTH_TYPE uxReturn;
+
+        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
+         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
+         * allows the user to determine the return type.  It gets around the
+         * problem of the value overflowing on 8-bit types without breaking
+         * backward compatibility for applications that expect an 8-bit return
+         * type. */
 
-    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
-    {
-        UBaseType_t uxReturn;
-        TCB_t const * pxTCB;
+        pxTCB = prvGetTCBFromHandle( xTask );
 
-        if( xTask != NULL )
+        #if portSTACK_GROWTH < 0
         {
-            pxTCB = xTask;
-            uxReturn = pxTCB->uxTaskNumber;
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
         }
-        else
+        #else
         {
-            uxReturn = 0U;
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
         }
+        #endif
+
+        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
 
         return uxReturn;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
 
-    void vTaskSetTaskNumber( TaskHandle_t xTask,
-                             const UBaseType_t uxHandle )
+    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
     {
         TCB_t * pxTCB;
+        uint8_t * pucEndOfStack;
+        UBaseType_t uxReturn;
 
-        if( xTask != NULL )
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        #if portSTACK_GROWTH < 0
         {
-            pxTCB = xTask;
-            pxTCB->uxTaskNumber = uxHandle;
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
         }
-    }
+        #else
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+        }
+        #endif
 
-#endif /* configUSE_TRACE_FACILITY */
+        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
 
-/*
- * -----------------------------------------------------------
- * The Idle task.
- * ----------------------------------------------------------
- *
- * The portTASK_FUNCTION() macro is used to allow port/compiler specific
- * language extensions.  The equivalent prototype for this function is:
- *
- * void prvIdleTask( void *pvParameters );
- *
- */
-static portTASK_FUNCTION( prvIdleTask, pvParameters )
-{
-    /* Stop warnings. */
-    ( void ) pvParameters;
+        return uxReturn;
+    }
 
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+/*-----------------------------------------------------------*/
 
-    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
-     * SCHEDULER IS STARTED. **/
+#if ( configUSE_TASK_POOLS == 1 )
 
-    /* In case a task that has a secure context deletes itself, in which case
-     * the idle task is responsible for deleting the task's secure context, if
-     * any. */
-    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
-    int i = 0;
-    for( ; ; )
+    static void prvInitialiseTaskPools( void )
     {
-        if(i % 10000000 == 0){
-        printf("Idle starts: %d.\n", xTaskGetTickCount()/1000);
-        }
-        i++;
-            
-        /* See if any tasks have deleted themselves - if so then the idle task
-         * is responsible for freeing the deleted task's TCB and stack. */
-        prvCheckTasksWaitingTermination();
+        const size_t xStacks[ taskPOOL_STACK_CLASSES ] = { configTASK_POOL_STACKS_1, configTASK_POOL_STACKS_2, configTASK_POOL_STACKS_3 };
+        const size_t xDepths[ taskPOOL_STACK_CLASSES ] = { configTASK_POOL_STACK_DEPTH_1, configTASK_POOL_STACK_DEPTH_2, configTASK_POOL_STACK_DEPTH_3 };
+        BlockPool_t * pxPool;
+        uint8_t * pucBlock;
+        size_t xClass, xBlock, xBlocks;
 
-        #if ( configUSE_PREEMPTION == 0 )
-        {
-            /* If we are not using preemption we keep forcing a task switch to
-             * see if any other task has become available.  If we are using
-             * preemption we don't need to do this as any task becoming available
-             * will automatically get the processor anyway. */
-            taskYIELD();
-        }
-        #endif /* configUSE_PREEMPTION */
+        /* Align the first stack the way the heap would. */
+        pucBlock = &( ucPooledStacks[ 0 ] );
 
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+        if( ( ( portPOINTER_SIZE_TYPE ) pucBlock & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) != 0U )
         {
-            /* When using preemption tasks of equal priority will be
-             * timesliced.  If a task that is sharing the idle priority is ready
-             * to run then the idle task should yield before the end of the
-             * timeslice.
-             *
-             * A critical region is not required here as we are just reading from
-             * the list, and an occasional incorrect value will not matter.  If
-             * the ready list at the idle priority contains more than one task
-             * then a task other than the idle task is ready to execute. */
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
-            {
-                taskYIELD();
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            pucBlock += ( size_t ) portBYTE_ALIGNMENT - ( size_t ) ( ( portPOINTER_SIZE_TYPE ) pucBlock & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
         }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
-
-        #if ( configUSE_IDLE_HOOK == 1 )
+        else
         {
-            extern void vApplicationIdleHook( void );
-
-            /* Call the user defined function from within the idle task.  This
-             * allows the application designer to add background functionality
-             * without the overhead of a separate task.
-             * NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
-             * CALL A FUNCTION THAT MIGHT BLOCK. */
-            vApplicationIdleHook();
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif /* configUSE_IDLE_HOOK */
 
-        /* This conditional compilation should use inequality to 0, not equality
-         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
-         * user defined low power mode  implementations require
-         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
-        #if ( configUSE_TICKLESS_IDLE != 0 )
+        /* The stack classes follow each other in ucPooledStacks[], then the
+         * TCBs are set up the same way as one more pool. */
+        for( xClass = ( size_t ) 0U; xClass <= ( size_t ) taskPOOL_STACK_CLASSES; xClass++ )
         {
-            TickType_t xExpectedIdleTime;
-
-            /* It is not desirable to suspend then resume the scheduler on
-             * each iteration of the idle task.  Therefore, a preliminary
-             * test of the expected idle time is performed without the
-             * scheduler suspended.  The result here is not necessarily
-             * valid. */
-            xExpectedIdleTime = prvGetExpectedIdleTime();
-
-            if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+            if( xClass < ( size_t ) taskPOOL_STACK_CLASSES )
             {
-                vTaskSuspendAll();
-                {
-                    /* Now the scheduler is suspended, the expected idle
-                     * time can be sampled again, and this time its value can
-                     * be used. */
-                    configASSERT( xNextTaskUnblockTime >= xTickCount );
-                    xExpectedIdleTime = prvGetExpectedIdleTime();
-
-                    /* Define the following macro to set xExpectedIdleTime to 0
-                     * if the application does not want
-                     * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
-                    configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+                /* A task is given the first class deep enough, so the classes
+                 * must be in ascending order of depth. */
+                configASSERT( ( xClass == ( size_t ) 0U ) || ( xDepths[ xClass - ( size_t ) 1U ] <= xDepths[ xClass ] ) );
 
-                    if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
-                    {
-                        traceLOW_POWER_IDLE_BEGIN();
-                        portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
-                        traceLOW_POWER_IDLE_END();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                ( void ) xTaskResumeAll();
+                pxPool = &( xStackPools[ xClass ] );
+                pxPool->xBlockSize = taskPOOL_STACK_BYTES( xDepths[ xClass ] );
+                xBlocks = xStacks[ xClass ];
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                pxPool = &xTCBPool;
+                pxPool->xBlockSize = sizeof( TCB_t );
+                pucBlock = ( uint8_t * ) xPooledTCBs;
+                xBlocks = ( size_t ) configTASK_POOL_TCBS;
             }
-        }
-        #endif /* configUSE_TICKLESS_IDLE */
-    }
-}
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TICKLESS_IDLE != 0 )
-
-    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
-    {
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            /* The idle task exists in addition to the application tasks. */
-            const UBaseType_t uxNonApplicationTasks = 1;
-        #endif /* INCLUDE_vTaskSuspend */
-
-        eSleepModeStatus eReturn = eStandardSleep;
-
-        /* This function must be called from a critical section. */
 
-        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
-        {
-            /* A task was made ready while the scheduler was suspended. */
-            eReturn = eAbortSleep;
-        }
-        else if( xYieldPending != pdFALSE )
-        {
-            /* A yield was pended while the scheduler was suspended. */
-            eReturn = eAbortSleep;
-        }
-        else if( xPendedTicks != 0 )
-        {
-            /* A tick interrupt has already occurred but was held pending
-             * because the scheduler is suspended. */
-            eReturn = eAbortSleep;
-        }
+            pxPool->pucFirstBlock = pucBlock;
+            pxPool->pvFreeBlocks = NULL;
 
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            else if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+            for( xBlock = ( size_t ) 0U; xBlock < xBlocks; xBlock++ )
             {
-                /* If all the tasks are in the suspended list (which might mean they
-                 * have an infinite block time rather than actually being suspended)
-                 * then it is safe to turn all clocks off and just wait for external
-                 * interrupts. */
-                eReturn = eNoTasksWaitingTimeout;
+                *( ( void ** ) pucBlock ) = pxPool->pvFreeBlocks; /*lint !e9087 !e826 Every block is aligned to hold a pointer. */
+                pxPool->pvFreeBlocks = ( void * ) pucBlock;
+                pucBlock += pxPool->xBlockSize;
             }
-        #endif /* INCLUDE_vTaskSuspend */
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
+
+            pxPool->pucEnd = pucBlock;
         }
 
-        return eReturn;
+        xTaskPoolsInitialised = pdTRUE;
     }
-
-#endif /* configUSE_TICKLESS_IDLE */
 /*-----------------------------------------------------------*/
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
-
-    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
-                                            BaseType_t xIndex,
-                                            void * pvValue )
+    static void * prvAllocateFromTaskPool( BlockPool_t * const pxPools,
+                                           const size_t uxPools,
+                                           const size_t xSize )
     {
-        TCB_t * pxTCB;
+        void * pvReturn = NULL;
+        size_t x;
 
-        if( ( xIndex >= 0 ) &&
-            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        taskENTER_CRITICAL();
         {
-            pxTCB = prvGetTCBFromHandle( xTaskToSet );
-            configASSERT( pxTCB != NULL );
-            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
-        }
-    }
-
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
-/*-----------------------------------------------------------*/
-
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+            if( xTaskPoolsInitialised == pdFALSE )
+            {
+                prvInitialiseTaskPools();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
-                                               BaseType_t xIndex )
-    {
-        void * pvReturn = NULL;
-        TCB_t * pxTCB;
+            for( x = ( size_t ) 0U; ( x < uxPools ) && ( pvReturn == NULL ); x++ )
+            {
+                if( ( pxPools[ x ].xBlockSize >= xSize ) && ( pxPools[ x ].pvFreeBlocks != NULL ) )
+                {
+                    pvReturn = pxPools[ x ].pvFreeBlocks;
+                    pxPools[ x ].pvFreeBlocks = *( ( void ** ) pvReturn );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
 
-        if( ( xIndex >= 0 ) &&
-            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        if( pvReturn == NULL )
         {
-            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
+            /* The pools are exhausted or have no block this large. */
+            if( pxPools == xStackPools )
+            {
+                pvReturn = pvPortMallocStack( xSize );
+            }
+            else
+            {
+                pvReturn = pvPortMalloc( xSize );
+            }
         }
         else
         {
-            pvReturn = NULL;
+            mtCOVERAGE_TEST_MARKER();
         }
 
         return pvReturn;
     }
-
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
-#if ( portUSING_MPU_WRAPPERS == 1 )
-
-    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
-                                  const MemoryRegion_t * const xRegions )
+    static void prvFreeToTaskPool( BlockPool_t * const pxPools,
+                                   const size_t uxPools,
+                                   void * const pv )
     {
-        TCB_t * pxTCB;
+        uint8_t * const pucBlock = ( uint8_t * ) pv;
+        BaseType_t xPooled = pdFALSE;
+        size_t x;
 
-        /* If null is passed in here then we are modifying the MPU settings of
-         * the calling task. */
-        pxTCB = prvGetTCBFromHandle( xTaskToModify );
+        taskENTER_CRITICAL();
+        {
+            for( x = ( size_t ) 0U; ( x < uxPools ) && ( xPooled == pdFALSE ); x++ )
+            {
+                if( ( pucBlock >= pxPools[ x ].pucFirstBlock ) && ( pucBlock < pxPools[ x ].pucEnd ) ) /*lint !e946 The pointers are only compared to find whether the block is in the pool. */
+                {
+                    *( ( void ** ) pucBlock ) = pxPools[ x ].pvFreeBlocks; /*lint !e9087 !e826 Every block is aligned to hold a pointer. */
+                    pxPools[ x ].pvFreeBlocks = pv;
+                    xPooled = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
 
-        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+        if( xPooled == pdFALSE )
+        {
+            /* The block came from the heap. */
+            if( pxPools == xStackPools )
+            {
+                vPortFreeStack( pv );
+            }
+            else
+            {
+                vPortFree( pv );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
 
-#endif /* portUSING_MPU_WRAPPERS */
+#endif /* configUSE_TASK_POOLS */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseTaskLists( void )
-{
-    UBaseType_t uxPriority;
+#if ( INCLUDE_vTaskDelete == 1 )
 
-    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+    static void prvDeleteTCB( TCB_t * pxTCB )
     {
-        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
-    }
+        /* This call is required specifically for the TriCore port.  It must be
+         * above the vPortFree() calls.  The call is also used by ports/demos that
+         * want to allocate and clean RAM statically. */
+        portCLEAN_UP_TCB( pxTCB );
 
-    vListInitialise( &xDelayedTaskList1 );
-    vListInitialise( &xDelayedTaskList2 );
-    vListInitialise( &xPendingReadyList );
+        #if ( configUSE_APERIODIC_SERVER == 1 )
+        {
+            /* Jobs still waiting for a deleted server are dropped. */
+            if( pxTCB->pxAperiodicServer != NULL )
+            {
+                vPortFree( pxTCB->pxAperiodicServer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
 
-    #if ( INCLUDE_vTaskDelete == 1 )
-    {
-        vListInitialise( &xTasksWaitingTermination );
-    }
-    #endif /* INCLUDE_vTaskDelete */
+        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        {
+            /* Free up the memory allocated for the task's TLS Block. */
+            configDEINIT_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+        }
+        #endif
 
-    #if ( INCLUDE_vTaskSuspend == 1 )
-    {
-        vListInitialise( &xSuspendedTaskList );
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+        {
+            /* The task can only have been allocated dynamically - free both
+             * the stack and TCB. */
+            taskFREE_STACK( pxTCB->pxStack );
+            taskFREE_TCB( pxTCB );
+        }
+        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+        {
+            /* The task could have been allocated statically or dynamically, so
+             * check what was statically allocated before trying to free the
+             * memory. */
+            if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+            {
+                /* Both the stack and TCB were allocated dynamically, so both
+                 * must be freed. */
+                taskFREE_STACK( pxTCB->pxStack );
+                taskFREE_TCB( pxTCB );
+            }
+            else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+            {
+                /* Only the stack was statically allocated, so the TCB is the
+                 * only memory that must be freed. */
+                vPortFree( pxTCB );
+            }
+            else
+            {
+                /* Neither the stack nor the TCB were allocated dynamically, so
+                 * nothing needs to be freed. */
+                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
     }
-    #endif /* INCLUDE_vTaskSuspend */
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
-}
+#endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-static void prvCheckTasksWaitingTermination( void )
+static void prvResetNextTaskUnblockTime( void )
 {
-    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
-
-    #if ( INCLUDE_vTaskDelete == 1 )
+    #if ( configUSE_DELAY_WHEEL == 1 )
     {
-        TCB_t * pxTCB;
+        const TickType_t xConstTickCount = xTickCount;
+        TickType_t xSpan, xNextLook;
+        UBaseType_t uxLevel, uxSlots;
 
-        /* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
-         * being called too often in the idle task. */
-        while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+        xNextTaskUnblockTime = portMAX_DELAY;
+
+        /* The slots of a level are looked at in turn, each on the first tick
+         * of its span, so the first to be looked at is the one after the slot
+         * that spans the current tick.  A look that falls after the tick count
+         * wraps is left to tick 0, which is always processed. */
+        for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configDELAY_WHEEL_LEVELS; uxLevel++ )
         {
-            taskENTER_CRITICAL();
+            xSpan = ( xConstTickCount >> ( uxLevel * taskWHEEL_SLOT_BITS ) ) + ( TickType_t ) 1U;
+            uxSlots = prvNextDelayWheelSlot( uxLevel, ( UBaseType_t ) xSpan & taskWHEEL_SLOT_MASK );
+
+            if( uxSlots < ( UBaseType_t ) taskWHEEL_SLOTS )
             {
-                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                --uxCurrentNumberOfTasks;
-                --uxDeletedTasksWaitingCleanUp;
+                xNextLook = ( TickType_t ) ( ( xSpan + ( TickType_t ) uxSlots ) << ( uxLevel * taskWHEEL_SLOT_BITS ) );
+
+                if( ( xNextLook > xConstTickCount ) && ( xNextLook < xNextTaskUnblockTime ) )
+                {
+                    xNextTaskUnblockTime = xNextLook;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            taskEXIT_CRITICAL();
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
 
-            prvDeleteTCB( pxTCB );
+        /* The task at the head of the delayed list is moved into the wheel at
+         * the start of the turn of the wheel in which it wakes. */
+        if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+        {
+            xNextLook = taskWHEEL_SPAN_START( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList ), ( UBaseType_t ) configDELAY_WHEEL_LEVELS );
+
+            if( xNextLook < xNextTaskUnblockTime )
+            {
+                xNextTaskUnblockTime = xNextLook;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
     }
-    #endif /* INCLUDE_vTaskDelete */
+    #else /* configUSE_DELAY_WHEEL */
+    {
+        if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+        {
+            /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+             * the maximum possible value so it is  extremely unlikely that the
+             * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+             * there is an item in the delayed list. */
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            /* The new current delayed list is not empty, get the value of
+             * the item at the head of the delayed list.  This is the time at
+             * which the task at the head of the delayed list should be removed
+             * from the Blocked state. */
+            xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        }
+    }
+    #endif /* configUSE_DELAY_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_DELAY_WHEEL == 1 )
 
-    void vTaskGetInfo( TaskHandle_t xTask,
-                       TaskStatus_t * pxTaskStatus,
-                       BaseType_t xGetFreeStackSpace,
-                       eTaskState eState )
+    static TickType_t prvAddTaskToDelayWheel( TCB_t * const pxTCB,
+                                              const TickType_t xConstTickCount )
     {
-        TCB_t * pxTCB;
+        const TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+        const TickType_t xTicksToWake = xTimeToWake - xConstTickCount;
+        UBaseType_t uxLevel = ( UBaseType_t ) 0U;
+        UBaseType_t uxSlot;
 
-        /* xTask is NULL then get the state of the calling task. */
-        pxTCB = prvGetTCBFromHandle( xTask );
-
-        pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
-        pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
-        pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
-        pxTaskStatus->pxStackBase = pxTCB->pxStack;
-        #if ( ( portSTACK_GROWTH > 0 ) && ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
-            pxTaskStatus->pxTopOfStack = pxTCB->pxTopOfStack;
-            pxTaskStatus->pxEndOfStack = pxTCB->pxEndOfStack;
-        #endif
-        pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+        /* The task is held at the lowest level the slots of which, together,
+         * span the time to its wake time. */
+        while( ( uxLevel < ( UBaseType_t ) configDELAY_WHEEL_LEVELS ) &&
+               ( ( xTicksToWake >> ( ( uxLevel + ( UBaseType_t ) 1U ) * taskWHEEL_SLOT_BITS ) ) != ( TickType_t ) 0U ) )
+        {
+            uxLevel++;
+        }
 
-        #if ( configUSE_MUTEXES == 1 )
+        if( uxLevel < ( UBaseType_t ) configDELAY_WHEEL_LEVELS )
         {
-            pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+            uxSlot = taskWHEEL_SLOT( xTimeToWake, uxLevel );
+            listINSERT_END( &( xDelayWheel[ uxLevel ][ uxSlot ] ), &( pxTCB->xStateListItem ) );
+            ulDelayWheelSlots[ uxLevel ] |= ( uint32_t ) 1U << uxSlot;
         }
-        #else
+        else if( xTimeToWake < xConstTickCount )
         {
-            pxTaskStatus->uxBasePriority = 0;
+            /* Wake time has overflowed.  Place this item in the overflow
+             * list. */
+            vListInsert( pxOverflowDelayedTaskList, &( pxTCB->xStateListItem ) );
         }
-        #endif
-
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        else
         {
-            pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+            vListInsert( pxDelayedTaskList, &( pxTCB->xStateListItem ) );
         }
-        #else
+
+        return taskWHEEL_SPAN_START( xTimeToWake, uxLevel );
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvProcessDelayWheel( const TickType_t xConstTickCount )
+    {
+        List_t * pxSlot;
+        TCB_t * pxTCB;
+        UBaseType_t uxLevel = ( UBaseType_t ) 0U;
+        UBaseType_t uxSlot;
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        /* A slot at level n spans the ticks that share all but their lowest
+         * n * taskWHEEL_SLOT_BITS bits, so the slots whose span starts on this
+         * tick are those of the levels up to the number of whole groups of
+         * low bits of the tick count that are zero. */
+        while( ( uxLevel < ( UBaseType_t ) configDELAY_WHEEL_LEVELS ) &&
+               ( taskWHEEL_SLOT( xConstTickCount, uxLevel ) == ( UBaseType_t ) 0U ) )
         {
-            pxTaskStatus->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+            uxLevel++;
         }
-        #endif
 
-        /* Obtaining the task state is a little fiddly, so is only done if the
-         * value of eState passed into this function is eInvalid - otherwise the
-         * state is just set to whatever is passed in. */
-        if( eState != eInvalid )
+        if( uxLevel == ( UBaseType_t ) configDELAY_WHEEL_LEVELS )
         {
-            if( pxTCB == pxCurrentTCB )
-            {
-                pxTaskStatus->eCurrentState = eRunning;
-            }
-            else
+            /* A new turn of the whole wheel starts, so the tasks of the
+             * delayed list that wake within it are moved into it.  The list
+             * is in wake time order. */
+            while( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
             {
-                pxTaskStatus->eCurrentState = eState;
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-                #if ( INCLUDE_vTaskSuspend == 1 )
+                if( taskWHEEL_SPAN_START( listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ), uxLevel ) != xConstTickCount )
                 {
-                    /* If the task is in the suspended list then there is a
-                     *  chance it is actually just blocked indefinitely - so really
-                     *  it should be reported as being in the Blocked state. */
-                    if( eState == eSuspended )
-                    {
-                        vTaskSuspendAll();
-                        {
-                            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                            {
-                                pxTaskStatus->eCurrentState = eBlocked;
-                            }
-                        }
-                        ( void ) xTaskResumeAll();
-                    }
+                    break;
                 }
-                #endif /* INCLUDE_vTaskSuspend */
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                ( void ) prvAddTaskToDelayWheel( pxTCB, xConstTickCount );
             }
+
+            uxLevel--;
         }
         else
         {
-            pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Move the tasks down from the highest level first, as they can pass
+         * through the slot of a lower level that is also moved down on this
+         * tick. */
+        while( uxLevel > ( UBaseType_t ) 0U )
+        {
+            uxSlot = taskWHEEL_SLOT( xConstTickCount, uxLevel );
+            pxSlot = &( xDelayWheel[ uxLevel ][ uxSlot ] );
+            ulDelayWheelSlots[ uxLevel ] &= ~( ( uint32_t ) 1U << uxSlot );
+
+            while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+            {
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                ( void ) prvAddTaskToDelayWheel( pxTCB, xConstTickCount );
+            }
+
+            uxLevel--;
         }
 
-        /* Obtaining the stack space takes some time, so the xGetFreeStackSpace
-         * parameter is provided to allow it to be skipped. */
-        if( xGetFreeStackSpace != pdFALSE )
+        /* Every task in the level 0 slot of this tick wakes now. */
+        uxSlot = taskWHEEL_SLOT( xConstTickCount, 0U );
+        pxSlot = &( xDelayWheel[ 0 ][ uxSlot ] );
+        ulDelayWheelSlots[ 0 ] &= ~( ( uint32_t ) 1U << uxSlot );
+
+        while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
         {
-            #if ( portSTACK_GROWTH > 0 )
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+            /* Is the task waiting on an event also?  If so remove it from the
+             * event list. */
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+                listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
             }
-            #else
+            else
             {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
+            {
+                /* A job runs from its release until its next release, so a
+                 * periodic task that wakes on its release time was waiting for
+                 * the release, not blocked by its job. */
+                if( ( pxTCB->pxJobCode != NULL ) && ( pxTCB->xReleaseTime == xConstTickCount ) )
+                {
+                    prvRecordJobRelease( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             #endif
+
+            prvAddTaskToReadyList( pxTCB );
+
+            #if ( configUSE_PREEMPTION == 1 )
+            {
+                if( taskPREEMPTS_CURRENT( pxTCB ) )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_PREEMPTION */
         }
-        else
-        {
-            pxTaskStatus->usStackHighWaterMark = 0;
-        }
-    }
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+        prvResetNextTaskUnblockTime();
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+        return xSwitchRequired;
+    }
+/*-----------------------------------------------------------*/
 
-    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
-                                                     List_t * pxList,
-                                                     eTaskState eState )
+    static UBaseType_t prvNextDelayWheelSlot( const UBaseType_t uxLevel,
+                                              const UBaseType_t uxFirstSlot )
     {
-        configLIST_VOLATILE TCB_t * pxNextTCB;
-        configLIST_VOLATILE TCB_t * pxFirstTCB;
-        UBaseType_t uxTask = 0;
+        /* Maps the top five bits of a single set bit multiplied by a de Bruijn
+         * sequence to the position of that bit. */
+        static const uint8_t ucBitPositions[ taskWHEEL_SLOTS ] =
+        {
+            0U,  1U,  28U, 2U,  29U, 14U, 24U, 3U,  30U, 22U, 20U, 15U, 25U, 17U, 4U,  8U,
+            31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U,  26U, 12U, 18U, 6U,  11U, 5U,  10U, 9U
+        };
+        uint32_t ulSlots;
+        UBaseType_t uxSlots;
+        UBaseType_t uxSlot;
 
-        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        for( ; ; )
         {
-            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            /* Rotate the bitmap so bit 0 is uxFirstSlot. */
+            ulSlots = ulDelayWheelSlots[ uxLevel ];
+            ulSlots = ( ulSlots >> uxFirstSlot ) | ( ulSlots << ( ( taskWHEEL_SLOTS - uxFirstSlot ) & taskWHEEL_SLOT_MASK ) );
 
-            /* Populate an TaskStatus_t structure within the
-             * pxTaskStatusArray array for each task that is referenced from
-             * pxList.  See the definition of TaskStatus_t in task.h for the
-             * meaning of each TaskStatus_t structure member. */
-            do
+            if( ulSlots == 0U )
             {
-                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
-                uxTask++;
-            } while( pxNextTCB != pxFirstTCB );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
+                uxSlots = ( UBaseType_t ) taskWHEEL_SLOTS;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxSlots = ( UBaseType_t ) ucBitPositions[ ( uint32_t ) ( ( ulSlots & ( ~ulSlots + 1U ) ) * 0x077CB531UL ) >> 27U ];
+            uxSlot = ( uxFirstSlot + uxSlots ) & taskWHEEL_SLOT_MASK;
+
+            if( listLIST_IS_EMPTY( &( xDelayWheel[ uxLevel ][ uxSlot ] ) ) == pdFALSE )
+            {
+                break;
+            }
+            else
+            {
+                /* The tasks in the slot left the Blocked state before their
+                 * timeout, so the bit was not cleared. */
+                ulDelayWheelSlots[ uxLevel ] &= ~( ( uint32_t ) 1U << uxSlot );
+            }
         }
 
-        return uxTask;
+        return uxSlots;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_DELAY_WHEEL */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( ( configUSE_RM == 1 ) && ( ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) || ( configUSE_TICKLESS_IDLE != 0 ) ) )
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    static UBaseType_t prvReadyTasksAtPriority( UBaseType_t uxPriority )
     {
-        uint32_t ulCount = 0U;
+        UBaseType_t uxPeriod, uxReturn = ( UBaseType_t ) 0U;
 
-        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        for( uxPeriod = ( UBaseType_t ) 0U; uxPeriod < uxPeriodClassesInUse; uxPeriod++ )
         {
-            pucStackByte -= portSTACK_GROWTH;
-            ulCount++;
+            uxReturn += listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxPriority ][ uxPeriod ] ) );
         }
 
-        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
-
-        return ( configSTACK_DEPTH_TYPE ) ulCount;
+        return uxReturn;
     }
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+#endif /* configUSE_RM */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+#if ( configUSE_RM == 1 )
 
-/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
- * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
- * user to determine the return type.  It gets around the problem of the value
- * overflowing on 8-bit types without breaking backward compatibility for
- * applications that expect an 8-bit return type. */
-    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+    static UBaseType_t prvAcquirePeriodClass( TickType_t xPeriod )
     {
-        TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        configSTACK_DEPTH_TYPE uxReturn;
-
-        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
-         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
-         * allows the user to determine the return type.  It gets around the
-         * problem of the value overflowing on 8-bit types without breaking
-         * backward compatibility for applications that expect an 8-bit return
-         * type. */
+        UBaseType_t uxClass, uxFreeClass = ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS;
+        UBaseType_t uxRank = ( UBaseType_t ) 1U, uxPriority, uxLowerRanks;
 
-        pxTCB = prvGetTCBFromHandle( xTask );
+        uxClass = taskRM_NO_PERIOD_CLASS;
 
-        #if portSTACK_GROWTH < 0
+        if( xPeriod != portMAX_DELAY )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            /* Look for the class of this period, noting a free entry and how
+             * many classes have a longer period on the way.  Class 0 is longer
+             * than any period so the count starts at 1. */
+            for( uxClass = ( UBaseType_t ) 1U; uxClass < ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS; uxClass++ )
+            {
+                if( xPeriodClasses[ uxClass ].uxTasks == ( UBaseType_t ) 0U )
+                {
+                    if( uxFreeClass == ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS )
+                    {
+                        uxFreeClass = uxClass;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( xPeriodClasses[ uxClass ].xPeriod == xPeriod )
+                {
+                    break;
+                }
+                else if( xPeriodClasses[ uxClass ].xPeriod > xPeriod )
+                {
+                    uxRank++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( uxClass == ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS )
+            {
+                if( uxFreeClass == ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS )
+                {
+                    /* Every class is in use.  The caller is told by the class
+                     * returned. */
+                    traceRM_PERIOD_CLASSES_FULL( xPeriod );
+                    uxClass = taskRM_NO_PERIOD_CLASS;
+                }
+                else
+                {
+                    /* Open a class at uxRank.  Shorter periods move up one rank,
+                     * highest first so each list moves into an empty one. */
+                    for( uxClass = ( UBaseType_t ) 1U; uxClass < ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS; uxClass++ )
+                    {
+                        if( ( xPeriodClasses[ uxClass ].uxTasks != ( UBaseType_t ) 0U ) && ( xPeriodClasses[ uxClass ].uxRank >= uxRank ) )
+                        {
+                            ( xPeriodClasses[ uxClass ].uxRank )++;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+
+                    uxLowerRanks = ( ( UBaseType_t ) 1U << uxRank ) - ( UBaseType_t ) 1U;
+
+                    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+                    {
+                        if( ( uxReadyPeriods[ uxPriority ] & ~uxLowerRanks ) != ( UBaseType_t ) 0U )
+                        {
+                            for( uxClass = uxPeriodClassesInUse; uxClass > uxRank; uxClass-- )
+                            {
+                                prvMoveReadyList( &( pxReadyTasksLists[ uxPriority ][ uxClass - ( UBaseType_t ) 1U ] ), &( pxReadyTasksLists[ uxPriority ][ uxClass ] ) );
+                            }
+
+                            uxReadyPeriods[ uxPriority ] = ( uxReadyPeriods[ uxPriority ] & uxLowerRanks ) | ( ( uxReadyPeriods[ uxPriority ] & ~uxLowerRanks ) << 1 );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+
+                    uxClass = uxFreeClass;
+                    xPeriodClasses[ uxClass ].xPeriod = xPeriod;
+                    xPeriodClasses[ uxClass ].uxRank = uxRank;
+                    uxPeriodClassesInUse++;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        #else
+        else
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif
 
-        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+        ( xPeriodClasses[ uxClass ].uxTasks )++;
 
-        return uxReturn;
+        return uxClass;
     }
-
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
-
-    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    static void prvReleasePeriodClass( UBaseType_t uxClass )
     {
-        TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        UBaseType_t uxReturn;
+        PeriodClass_t * const pxClass = &( xPeriodClasses[ uxClass ] );
+        UBaseType_t uxOther, uxRank, uxPriority, uxLowerRanks;
 
-        pxTCB = prvGetTCBFromHandle( xTask );
+        ( pxClass->uxTasks )--;
 
-        #if portSTACK_GROWTH < 0
+        if( ( uxClass != taskRM_NO_PERIOD_CLASS ) && ( pxClass->uxTasks == ( UBaseType_t ) 0U ) )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            /* Close the class.  Its ready lists are empty, so shorter periods
+             * move down one rank, lowest first. */
+            uxRank = pxClass->uxRank;
+
+            for( uxOther = ( UBaseType_t ) 1U; uxOther < ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS; uxOther++ )
+            {
+                if( ( xPeriodClasses[ uxOther ].uxTasks != ( UBaseType_t ) 0U ) && ( xPeriodClasses[ uxOther ].uxRank > uxRank ) )
+                {
+                    ( xPeriodClasses[ uxOther ].uxRank )--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            uxLowerRanks = ( ( UBaseType_t ) 1U << uxRank ) - ( UBaseType_t ) 1U;
+
+            for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+            {
+                if( ( uxReadyPeriods[ uxPriority ] & ~uxLowerRanks ) != ( UBaseType_t ) 0U )
+                {
+                    for( uxOther = uxRank + ( UBaseType_t ) 1U; uxOther < uxPeriodClassesInUse; uxOther++ )
+                    {
+                        prvMoveReadyList( &( pxReadyTasksLists[ uxPriority ][ uxOther ] ), &( pxReadyTasksLists[ uxPriority ][ uxOther - ( UBaseType_t ) 1U ] ) );
+                    }
+
+                    uxReadyPeriods[ uxPriority ] = ( uxReadyPeriods[ uxPriority ] & uxLowerRanks ) | ( ( uxReadyPeriods[ uxPriority ] >> 1 ) & ~uxLowerRanks );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            uxPeriodClassesInUse--;
         }
-        #else
+        else
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif
+    }
+/*-----------------------------------------------------------*/
 
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+    static void prvInsertTaskByRate( List_t * const pxEventList,
+                                     TCB_t * const pxTCB )
+    {
+        ListItem_t * const pxNewListItem = &( pxTCB->xEventListItem );
+        const TickType_t xValue = listGET_LIST_ITEM_VALUE( pxNewListItem );
+        const TickType_t xPeriod = xPeriodClasses[ pxTCB->uxPeriodClass ].xPeriod;
+        const TCB_t * pxOther;
+        ListItem_t * pxIterator;
+
+        /* The period is that of the class the task runs in, so a task at a
+         * mutex ceiling waits with the ceiling period.  Periods are compared
+         * rather than ranks because ranks move as classes open and close, while
+         * the order of the periods does not. */
+        for( pxIterator = listGET_HEAD_ENTRY( pxEventList ); pxIterator != listGET_END_MARKER( pxEventList ); pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            pxOther = listGET_LIST_ITEM_OWNER( pxIterator );
+
+            if( ( listGET_LIST_ITEM_VALUE( pxIterator ) > xValue ) ||
+                ( ( listGET_LIST_ITEM_VALUE( pxIterator ) == xValue ) && ( xPeriodClasses[ pxOther->uxPeriodClass ].xPeriod > xPeriod ) ) )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
 
-        return uxReturn;
-    }
+        /* Link the new item in front of pxIterator. */
+        pxNewListItem->pxNext = pxIterator;
+        pxNewListItem->pxPrevious = pxIterator->pxPrevious;
+        pxIterator->pxPrevious->pxNext = pxNewListItem;
+        pxIterator->pxPrevious = pxNewListItem;
+        pxNewListItem->pxContainer = pxEventList;
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+        ( pxEventList->uxNumberOfItems )++;
+    }
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelete == 1 )
-
-    static void prvDeleteTCB( TCB_t * pxTCB )
+    static void prvMoveReadyList( List_t * const pxFrom,
+                                  List_t * const pxTo )
     {
-        /* This call is required specifically for the TriCore port.  It must be
-         * above the vPortFree() calls.  The call is also used by ports/demos that
-         * want to allocate and clean RAM statically. */
-        portCLEAN_UP_TCB( pxTCB );
+        ListItem_t * pxListItem;
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        while( listLIST_IS_EMPTY( pxFrom ) == pdFALSE )
         {
-            /* Free up the memory allocated for the task's TLS Block. */
-            configDEINIT_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+            pxListItem = listGET_HEAD_ENTRY( pxFrom );
+            ( void ) uxListRemove( pxListItem );
+            listINSERT_END( pxTo, pxListItem );
         }
-        #endif
+    }
 
-        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
-        {
-            /* The task can only have been allocated dynamically - free both
-             * the stack and TCB. */
-            vPortFreeStack( pxTCB->pxStack );
-            vPortFree( pxTCB );
-        }
-        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+#endif /* configUSE_RM */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF == 1 )
+
+    static void prvSetReadyDeadline( TCB_t * const pxTCB )
+    {
+        if( pxTCB->xDeadline != portMAX_DELAY )
         {
-            /* The task could have been allocated statically or dynamically, so
-             * check what was statically allocated before trying to free the
-             * memory. */
-            if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+            #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
+                if( pxTCB->pxJobCode != NULL )
+                {
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), pxTCB->xReleaseTime + pxTCB->xDeadline );
+                }
+                else
+            #endif
             {
-                /* Both the stack and TCB were allocated dynamically, so both
-                 * must be freed. */
-                vPortFreeStack( pxTCB->pxStack );
-                vPortFree( pxTCB );
+                listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xTickCount + pxTCB->xDeadline );
             }
-            else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInsertTaskByDeadline( TCB_t * const pxTCB )
+    {
+        List_t * const pxList = &( pxReadyTasksLists[ pxTCB->uxPriority ] );
+        ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+        const TickType_t xKey = taskEDF_SORT_KEY( pxTCB );
+        ListItem_t * pxIterator;
+
+        for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != listGET_END_MARKER( pxList ); pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            if( taskEDF_SORT_KEY( ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) ) > xKey )
             {
-                /* Only the stack was statically allocated, so the TCB is the
-                 * only memory that must be freed. */
-                vPortFree( pxTCB );
+                break;
             }
             else
             {
-                /* Neither the stack nor the TCB were allocated dynamically, so
-                 * nothing needs to be freed. */
-                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-    }
 
-#endif /* INCLUDE_vTaskDelete */
-/*-----------------------------------------------------------*/
+        /* Link the new item in front of pxIterator. */
+        pxNewListItem->pxNext = pxIterator;
+        pxNewListItem->pxPrevious = pxIterator->pxPrevious;
+        pxIterator->pxPrevious->pxNext = pxNewListItem;
+        pxIterator->pxPrevious = pxNewListItem;
+        pxNewListItem->pxContainer = pxList;
 
-static void prvResetNextTaskUnblockTime( void )
-{
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-    {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
-        xNextTaskUnblockTime = portMAX_DELAY;
-    }
-    else
-    {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        ( pxList->uxNumberOfItems )++;
     }
-}
+
+#endif /* configUSE_EDF */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
@@ -4229,14 +8228,13 @@ static void prvResetNextTaskUnblockTime( void )
 
                 /* If the task being modified is in the ready state it will need
                  * to be moved into a new list. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+                if( listIS_CONTAINED_WITHIN( taskREADY_LIST( pxMutexHolderTCB->uxPriority, pxMutexHolderTCB ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
                 {
                     if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                     {
-                        /* It is known that the task is in its ready list so
-                         * there is no need to check again and the port level
-                         * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
+                        /* The ready list the task was removed from is now
+                         * empty. */
+                        taskRESET_READY_TASK( pxMutexHolderTCB, pxMutexHolderTCB->uxPriority );
                     }
                     else
                     {
@@ -4306,8 +8304,12 @@ static void prvResetNextTaskUnblockTime( void )
             ( pxTCB->uxMutexesHeld )--;
 
             /* Has the holder of the mutex inherited the priority of another
-             * task? */
-            if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+             * task, or been raised to a ceiling? */
+            #if ( ( configUSE_RM == 1 ) && ( configUSE_MUTEX_CEILING == 1 ) )
+                if( ( pxTCB->uxPriority != pxTCB->uxBasePriority ) || ( pxTCB->uxPeriodClass != pxTCB->uxBasePeriodClass ) )
+            #else
+                if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+            #endif
             {
                 /* Only disinherit if no other mutexes are held. */
                 if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
@@ -4319,7 +8321,7 @@ static void prvResetNextTaskUnblockTime( void )
                      * the holding task from the ready list. */
                     if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                     {
-                        portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                        taskRESET_READY_TASK( pxTCB, pxTCB->uxPriority );
                     }
                     else
                     {
@@ -4331,6 +8333,12 @@ static void prvResetNextTaskUnblockTime( void )
                     traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
                     pxTCB->uxPriority = pxTCB->uxBasePriority;
 
+                    #if ( ( configUSE_RM == 1 ) && ( configUSE_MUTEX_CEILING == 1 ) )
+                    {
+                        pxTCB->uxPeriodClass = pxTCB->uxBasePeriodClass;
+                    }
+                    #endif
+
                     /* Reset the event list item value.  It cannot be in use for
                      * any other purpose if this task is running, and it must be
                      * running to give back the mutex. */
@@ -4434,14 +8442,13 @@ static void prvResetNextTaskUnblockTime( void )
                      * from its current state list if it is in the Ready state as
                      * the task's priority is going to change and there is one
                      * Ready list per priority. */
-                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                    if( listIS_CONTAINED_WITHIN( taskREADY_LIST( uxPriorityUsedOnEntry, pxTCB ), &( pxTCB->xStateListItem ) ) != pdFALSE )
                     {
                         if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                         {
-                            /* It is known that the task is in its ready list so
-                             * there is no need to check again and the port level
-                             * reset macro can be called directly. */
-                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                            /* The ready list the task was removed from is now
+                             * empty. */
+                            taskRESET_READY_TASK( pxTCB, uxPriorityUsedOnEntry );
                         }
                         else
                         {
@@ -4770,17 +8777,342 @@ static void prvResetNextTaskUnblockTime( void )
                         #endif
                     }
 
-                    pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                    pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxTaskStatusArray );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+/*-----------------------------------------------------------*/
+
+TickType_t uxTaskResetEventItemValue( void )
+{
+    TickType_t uxReturn;
+
+    uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+
+    /* Reset the event list item to its normal value - so it can be used with
+     * queues and semaphores. */
+    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    TaskHandle_t pvTaskIncrementMutexHeldCount( void )
+    {
+        /* If xSemaphoreCreateMutex() is called before any tasks have been created
+         * then pxCurrentTCB will be NULL. */
+        if( pxCurrentTCB != NULL )
+        {
+            ( pxCurrentTCB->uxMutexesHeld )++;
+        }
+
+        return pxCurrentTCB;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_CEILING == 1 )
+
+    void * pvTaskCreateMutexCeiling( UBaseType_t uxCeilingPriority,
+                                     TickType_t xCeilingPeriod,
+                                     TickType_t xLongestHold )
+    {
+        MutexCeiling_t * pxCeiling;
+
+        #if ( configUSE_RM_ADMISSION_CONTROL == 1 )
+            const ListItem_t * pxIterator;
+            const ListItem_t * pxEnd;
+            const TCB_t * pxOther;
+            BaseType_t xSchedulable = pdTRUE;
+        #endif
+
+        /* Same adjustments as prvInitialiseNewTask(). */
+        uxCeilingPriority &= ~portPRIVILEGE_BIT;
+
+        if( uxCeilingPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+        {
+            uxCeilingPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxCeiling = ( MutexCeiling_t * ) pvPortMalloc( sizeof( MutexCeiling_t ) );
+
+        if( pxCeiling != NULL )
+        {
+            pxCeiling->uxPriority = uxCeilingPriority;
+            pxCeiling->xPeriod = xCeilingPeriod;
+            pxCeiling->xLongestHold = xLongestHold;
+
+            #if ( configUSE_RM == 1 )
+            {
+                pxCeiling->uxPeriodClass = taskRM_CEILING_CLASS_UNSET;
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                pxCeiling->pxNext = pxMutexCeilings;
+                pxMutexCeilings = pxCeiling;
+
+                #if ( configUSE_RM_ADMISSION_CONTROL == 1 )
+                {
+                    /* Every admitted task the ceiling can delay must still meet
+                     * its deadline with the new blocking.  The admitted list is
+                     * set up along with the first task, and is empty until
+                     * then. */
+                    if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
+                    {
+                        pxEnd = listGET_END_MARKER( &xAdmittedTasksList );
+
+                        for( pxIterator = listGET_HEAD_ENTRY( &xAdmittedTasksList ); ( pxIterator != pxEnd ) && ( xSchedulable != pdFALSE ); pxIterator = listGET_NEXT( pxIterator ) )
+                        {
+                            pxOther = listGET_LIST_ITEM_OWNER( pxIterator );
+
+                            if( taskRM_CAN_DELAY( uxCeilingPriority, xCeilingPeriod, ( UBaseType_t ) listGET_LIST_ITEM_VALUE( pxIterator ), pxOther->xPeriod ) != pdFALSE )
+                            {
+                                /* There is no new task, so pass one that adds
+                                 * nothing. */
+                                xSchedulable = prvMeetsDeadline( pxOther, ( UBaseType_t ) listGET_LIST_ITEM_VALUE( pxIterator ), pxOther->xCpuBurst, pxOther->xPeriod, pxOther->xDeadline, tskIDLE_PRIORITY, ( TickType_t ) 0U, portMAX_DELAY, ( TickType_t ) 0U );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xSchedulable == pdFALSE )
+                    {
+                        pxMutexCeilings = pxCeiling->pxNext;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_RM_ADMISSION_CONTROL */
+            }
+            ( void ) xTaskResumeAll();
+
+            #if ( configUSE_RM_ADMISSION_CONTROL == 1 )
+            {
+                if( xSchedulable == pdFALSE )
+                {
+                    vPortFree( pxCeiling );
+                    pxCeiling = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxCeiling;
+    }
+
+#endif /* configUSE_MUTEX_CEILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_CEILING == 1 )
+
+    void vTaskDeleteMutexCeiling( void * pvCeiling )
+    {
+        MutexCeiling_t * const pxCeiling = pvCeiling;
+        MutexCeiling_t ** ppxLink;
+
+        vTaskSuspendAll();
+        {
+            for( ppxLink = &pxMutexCeilings; *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNext ) )
+            {
+                if( *ppxLink == pxCeiling )
+                {
+                    *ppxLink = pxCeiling->pxNext;
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            #if ( configUSE_RM == 1 )
+            {
+                if( pxCeiling->uxPeriodClass != taskRM_CEILING_CLASS_UNSET )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        prvReleasePeriodClass( pxCeiling->uxPeriodClass );
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_RM */
+        }
+        ( void ) xTaskResumeAll();
+
+        vPortFree( pxCeiling );
+    }
+
+#endif /* configUSE_MUTEX_CEILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_CEILING == 1 )
+
+    void vTaskRaiseToMutexCeiling( void * pvCeiling )
+    {
+        MutexCeiling_t * const pxCeiling = pvCeiling;
+        TCB_t * const pxTCB = pxCurrentTCB;
+        UBaseType_t uxPriority;
+
+        #if ( configUSE_RM == 1 )
+            UBaseType_t uxClass, uxOther;
+        #endif
+
+        /* Called from a critical section by the task that has just taken the
+         * mutex, which is NULL if the scheduler has not started. */
+        if( pxTCB != NULL )
+        {
+            configASSERT( pxTCB->uxBasePriority <= pxCeiling->uxPriority );
+
+            #if ( configUSE_RM == 1 )
+            {
+                if( pxCeiling->uxPeriodClass == taskRM_CEILING_CLASS_UNSET )
+                {
+                    pxCeiling->uxPeriodClass = prvAcquirePeriodClass( pxCeiling->xPeriod );
+
+                    if( ( pxCeiling->uxPeriodClass == taskRM_NO_PERIOD_CLASS ) && ( pxCeiling->xPeriod != portMAX_DELAY ) )
+                    {
+                        /* Every class is in use.  Running below the ceiling
+                         * would let the tasks that share the mutex preempt the
+                         * holder, so use the shortest period in use instead. */
+                        for( uxOther = ( UBaseType_t ) 1U; uxOther < ( UBaseType_t ) configRM_MAX_DISTINCT_PERIODS; uxOther++ )
+                        {
+                            if( ( xPeriodClasses[ uxOther ].uxTasks != ( UBaseType_t ) 0U ) && ( xPeriodClasses[ uxOther ].uxRank > xPeriodClasses[ pxCeiling->uxPeriodClass ].uxRank ) )
+                            {
+                                pxCeiling->uxPeriodClass = uxOther;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+
+                        ( xPeriodClasses[ taskRM_NO_PERIOD_CLASS ].uxTasks )--;
+                        ( xPeriodClasses[ pxCeiling->uxPeriodClass ].uxTasks )++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxClass = pxTCB->uxPeriodClass;
+            }
+            #endif /* configUSE_RM */
+
+            /* Only ever raise the task, as it may already be running above
+             * this ceiling because of another mutex.  The period class only
+             * orders tasks of the same priority. */
+            uxPriority = pxTCB->uxPriority;
+
+            if( pxCeiling->uxPriority > uxPriority )
+            {
+                uxPriority = pxCeiling->uxPriority;
+
+                #if ( configUSE_RM == 1 )
+                {
+                    uxClass = pxCeiling->uxPeriodClass;
+                }
+                #endif
+            }
+            else
+            {
+                #if ( configUSE_RM == 1 )
+                {
+                    if( ( pxCeiling->uxPriority == uxPriority ) && ( xPeriodClasses[ pxCeiling->uxPeriodClass ].uxRank > taskRM_PERIOD_INDEX( pxTCB ) ) )
+                    {
+                        uxClass = pxCeiling->uxPeriodClass;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_RM */
+            }
+
+            #if ( configUSE_RM == 1 )
+                if( ( uxPriority != pxTCB->uxPriority ) || ( uxClass != pxTCB->uxPeriodClass ) )
+            #else
+                if( uxPriority != pxTCB->uxPriority )
+            #endif
+            {
+                traceTASK_PRIORITY_CEILING( pxTCB, uxPriority );
+
+                /* The task is running, so it is in a ready list. */
+                if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                {
+                    taskRESET_READY_TASK( pxTCB, pxTCB->uxPriority );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxTCB->uxPriority = uxPriority;
+
+                #if ( configUSE_RM == 1 )
+                {
+                    pxTCB->uxPeriodClass = uxClass;
                 }
+                #endif
+
+                listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                prvAddTaskToReadyList( pxTCB );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-
-            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-             * is 0 then vPortFree() will be #defined to nothing. */
-            vPortFree( pxTaskStatusArray );
         }
         else
         {
@@ -4788,38 +9120,7 @@ static void prvResetNextTaskUnblockTime( void )
         }
     }
 
-#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
-/*-----------------------------------------------------------*/
-
-TickType_t uxTaskResetEventItemValue( void )
-{
-    TickType_t uxReturn;
-
-    uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
-
-    /* Reset the event list item to its normal value - so it can be used with
-     * queues and semaphores. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-
-    return uxReturn;
-}
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_MUTEXES == 1 )
-
-    TaskHandle_t pvTaskIncrementMutexHeldCount( void )
-    {
-        /* If xSemaphoreCreateMutex() is called before any tasks have been created
-         * then pxCurrentTCB will be NULL. */
-        if( pxCurrentTCB != NULL )
-        {
-            ( pxCurrentTCB->uxMutexesHeld )++;
-        }
-
-        return pxCurrentTCB;
-    }
-
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_MUTEX_CEILING */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
@@ -5057,6 +9358,7 @@ TickType_t uxTaskResetEventItemValue( void )
              * notification then unblock it now. */
             if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
             {
+                taskRELEASE_SPORADIC_JOB( pxTCB, uxIndexToNotify );
                 listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
                 prvAddTaskToReadyList( pxTCB );
 
@@ -5079,10 +9381,10 @@ TickType_t uxTaskResetEventItemValue( void )
                 }
                 #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPREEMPTS_CURRENT( pxTCB ) )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
+                    /* The notified task comes before the currently executing
+                     * task so a yield is required. */
                     taskYIELD_IF_USING_PREEMPTION();
                 }
                 else
@@ -5201,6 +9503,7 @@ TickType_t uxTaskResetEventItemValue( void )
             {
                 /* The task should not have been on an event list. */
                 configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+                taskRELEASE_SPORADIC_JOB( pxTCB, uxIndexToNotify );
 
                 if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                 {
@@ -5214,10 +9517,10 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPREEMPTS_CURRENT( pxTCB ) )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
+                    /* The notified task comes before the currently executing
+                     * task so a yield is required. */
                     if( pxHigherPriorityTaskWoken != NULL )
                     {
                         *pxHigherPriorityTaskWoken = pdTRUE;
@@ -5292,6 +9595,7 @@ TickType_t uxTaskResetEventItemValue( void )
             {
                 /* The task should not have been on an event list. */
                 configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+                taskRELEASE_SPORADIC_JOB( pxTCB, uxIndexToNotify );
 
                 if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                 {
@@ -5305,10 +9609,10 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPREEMPTS_CURRENT( pxTCB ) )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
+                    /* The notified task comes before the currently executing
+                     * task so a yield is required. */
                     if( pxHigherPriorityTaskWoken != NULL )
                     {
                         *pxHigherPriorityTaskWoken = pdTRUE;
@@ -5430,6 +9734,327 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_IDLE_TIME_STATS == 1 )
+
+    static void prvAddIdleTimeTicks( TickType_t xTicks,
+                                     BaseType_t xIdle )
+    {
+        TickType_t xStep;
+        IdleTime_t xIdleTime, xLength, xStepIdle, xStepLength;
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            configRUN_TIME_COUNTER_TYPE ulNow, ulIdleNow;
+
+            ( void ) xIdle;
+
+            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+            #else
+                ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+            #endif
+
+            /* The run of the idle task that is in progress has not been added
+             * to ulIdleRunTime yet. */
+            ulIdleNow = ulIdleRunTime;
+
+            if( ( pxCurrentTCB == xIdleTaskHandle ) && ( ulNow > ulTaskSwitchedInTime ) )
+            {
+                ulIdleNow += ( ulNow - ulTaskSwitchedInTime );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xIdleTime = ulIdleNow - ulIdleSampledRunTime;
+            xLength = ulNow - ulIdleSampledTotalTime;
+            ulIdleSampledRunTime = ulIdleNow;
+            ulIdleSampledTotalTime = ulNow;
+        }
+        #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+        {
+            xIdleTime = ( xIdle != pdFALSE ) ? xTicks : ( TickType_t ) 0U;
+            xLength = xTicks;
+        }
+        #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+
+        while( xTicks > ( TickType_t ) 0U )
+        {
+            xStep = taskIDLE_TIME_SLOT_TICKS - xIdleSlotElapsed;
+
+            if( xStep >= xTicks )
+            {
+                xStep = xTicks;
+                xStepIdle = xIdleTime;
+                xStepLength = xLength;
+            }
+            else
+            {
+                /* The ticks cross the end of the slot, as after tickless
+                 * idle, so the time measured over them is shared out in
+                 * proportion. */
+                xStepIdle = ( IdleTime_t ) ( ( ( uint64_t ) xIdleTime * xStep ) / xTicks );
+                xStepLength = ( IdleTime_t ) ( ( ( uint64_t ) xLength * xStep ) / xTicks );
+            }
+
+            xIdleSlotCurrentIdle += xStepIdle;
+            xIdleSlotCurrentLength += xStepLength;
+            xIdleTime -= xStepIdle;
+            xLength -= xStepLength;
+            xIdleSlotElapsed += xStep;
+            xTicks -= xStep;
+
+            #if ( configGENERATE_RUN_TIME_STATS == 0 )
+            {
+                xIdleTicks += xStepIdle;
+            }
+            #endif
+
+            if( xIdleSlotElapsed == taskIDLE_TIME_SLOT_TICKS )
+            {
+                /* The slot is complete, so it replaces the oldest slot in the
+                 * window. */
+                xWindowIdle = ( xWindowIdle - xIdleSlotIdle[ uxIdleSlot ] ) + xIdleSlotCurrentIdle;
+                xWindowLength = ( xWindowLength - xIdleSlotLength[ uxIdleSlot ] ) + xIdleSlotCurrentLength;
+                xIdleSlotIdle[ uxIdleSlot ] = xIdleSlotCurrentIdle;
+                xIdleSlotLength[ uxIdleSlot ] = xIdleSlotCurrentLength;
+                uxIdleSlot = ( uxIdleSlot + ( UBaseType_t ) 1U ) % taskIDLE_TIME_SLOTS;
+
+                if( uxIdleSlotsFilled < taskIDLE_TIME_SLOTS )
+                {
+                    uxIdleSlotsFilled++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    /* The idle time is converted to ticks a slot at a time,
+                     * once the length of the slot in run time counter
+                     * increments is known. */
+                    if( xIdleSlotCurrentLength != ( IdleTime_t ) 0U )
+                    {
+                        xIdleTicks += ( TickType_t ) ( ( ( uint64_t ) xIdleSlotCurrentIdle * taskIDLE_TIME_SLOT_TICKS ) / xIdleSlotCurrentLength );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
+
+                xIdleSlotCurrentIdle = ( IdleTime_t ) 0U;
+                xIdleSlotCurrentLength = ( IdleTime_t ) 0U;
+                xIdleSlotElapsed = ( TickType_t ) 0U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetIdleTime( TaskIdleTime_t * pxIdleTime )
+    {
+        IdleTime_t xIdle, xLength;
+
+        configASSERT( pxIdleTime );
+
+        taskENTER_CRITICAL();
+        {
+            pxIdleTime->xIdleTicks = xIdleTicks;
+            pxIdleTime->xWindowTicks = ( TickType_t ) uxIdleSlotsFilled * taskIDLE_TIME_SLOT_TICKS;
+            xIdle = xWindowIdle;
+            xLength = xWindowLength;
+        }
+        taskEXIT_CRITICAL();
+
+        if( xLength != ( IdleTime_t ) 0U )
+        {
+            pxIdleTime->xWindowIdleTicks = ( TickType_t ) ( ( ( uint64_t ) xIdle * pxIdleTime->xWindowTicks ) / xLength );
+            pxIdleTime->uxLoadPercent = ( UBaseType_t ) ( ( ( uint64_t ) ( xLength - xIdle ) * 100U ) / ( uint64_t ) xLength );
+        }
+        else
+        {
+            pxIdleTime->xWindowIdleTicks = ( TickType_t ) 0U;
+            pxIdleTime->uxLoadPercent = ( UBaseType_t ) 0U;
+        }
+    }
+
+#endif /* configUSE_IDLE_TIME_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SCHEDULE_TRACE == 1 )
+
+    static void prvRecordScheduleEvent( const TCB_t * const pxTCB,
+                                        const eScheduleTraceEvent eEvent )
+    {
+        ScheduleTraceEntry_t * const pxEntry = &( xScheduleTrace[ uxScheduleTraceNext ] );
+
+        pxEntry->ulTimestamp = configSCHEDULE_TRACE_TIMESTAMP();
+        pxEntry->usTaskNumber = ( uint16_t ) pxTCB->uxTCBNumber;
+        pxEntry->ucEvent = ( uint8_t ) eEvent;
+        pxEntry->ucReserved = ( uint8_t ) 0U;
+
+        uxScheduleTraceNext++;
+
+        if( uxScheduleTraceNext == ( UBaseType_t ) configSCHEDULE_TRACE_LENGTH )
+        {
+            uxScheduleTraceNext = ( UBaseType_t ) 0U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( uxScheduleTraceCount < ( UBaseType_t ) configSCHEDULE_TRACE_LENGTH )
+        {
+            uxScheduleTraceCount++;
+        }
+        else
+        {
+            /* The oldest event was overwritten. */
+            uxScheduleTraceLost++;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskScheduleTraceSwitchedOut( void )
+    {
+        pxScheduleTraceSwitchedOut = pxCurrentTCB;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskScheduleTraceSwitchedIn( void )
+    {
+        /* A yield that selects the same task again is not a switch.  Nothing
+         * was switched out when the scheduler starts. */
+        if( pxCurrentTCB != pxScheduleTraceSwitchedOut )
+        {
+            if( pxScheduleTraceSwitchedOut != NULL )
+            {
+                prvRecordScheduleEvent( pxScheduleTraceSwitchedOut, eTraceSwitchedOut );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvRecordScheduleEvent( pxCurrentTCB, eTraceSwitchedIn );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTaskGetScheduleTrace( ScheduleTraceEntry_t * const pxTraceArray,
+                                        const UBaseType_t uxArraySize,
+                                        UBaseType_t * const puxEntriesLost )
+    {
+        UBaseType_t uxCopied = ( UBaseType_t ) 0U;
+        UBaseType_t uxOldest, uxCopyEnd;
+        BaseType_t xDone = pdFALSE;
+
+        configASSERT( ( pxTraceArray != NULL ) || ( uxArraySize == ( UBaseType_t ) 0U ) );
+
+        /* The events are moved a few at a time so interrupts are not masked
+         * for longer as the trace grows.  Events recorded between two groups
+         * are added after the ones still to be moved, or overwrite the oldest
+         * of them, as they would between two calls. */
+        while( xDone == pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            {
+                uxOldest = ( ( uxScheduleTraceNext + ( UBaseType_t ) configSCHEDULE_TRACE_LENGTH ) - uxScheduleTraceCount ) % ( UBaseType_t ) configSCHEDULE_TRACE_LENGTH;
+                uxCopyEnd = uxCopied + taskSCHEDULE_TRACE_COPY_LENGTH;
+
+                if( ( uxCopyEnd > uxArraySize ) || ( uxCopyEnd < uxCopied ) )
+                {
+                    uxCopyEnd = uxArraySize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                while( ( uxCopied < uxCopyEnd ) && ( uxScheduleTraceCount > ( UBaseType_t ) 0U ) )
+                {
+                    pxTraceArray[ uxCopied ] = xScheduleTrace[ uxOldest ];
+                    uxCopied++;
+                    uxScheduleTraceCount--;
+                    uxOldest = ( uxOldest + ( UBaseType_t ) 1U ) % ( UBaseType_t ) configSCHEDULE_TRACE_LENGTH;
+                }
+
+                if( ( uxCopied == uxArraySize ) || ( uxScheduleTraceCount == ( UBaseType_t ) 0U ) )
+                {
+                    /* The events overwritten while the earlier groups were
+                     * moved are counted as lost too. */
+                    if( puxEntriesLost != NULL )
+                    {
+                        *puxEntriesLost = uxScheduleTraceLost;
+                        uxScheduleTraceLost = ( UBaseType_t ) 0U;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xDone = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        return uxCopied;
+    }
+
+#endif /* configUSE_SCHEDULE_TRACE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+    static void prvAddCurrentTaskToDelayWheel( const TickType_t xConstTickCount )
+    {
+        TickType_t xNextLook;
+
+        /* The slot of the current tick has already been processed, so a task
+         * that would wake on it wakes on the next tick, as it would if it
+         * were placed in the delayed list. */
+        if( listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ) ) == xConstTickCount )
+        {
+            listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xConstTickCount + ( TickType_t ) 1U );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xNextLook = prvAddTaskToDelayWheel( pxCurrentTCB, xConstTickCount );
+
+        /* A look that falls after the tick count wraps is made on tick 0. */
+        if( ( xNextLook > xConstTickCount ) && ( xNextLook < xNextTaskUnblockTime ) )
+        {
+            xNextTaskUnblockTime = xNextLook;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_DELAY_WHEEL */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely )
 {
@@ -5449,9 +10074,9 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
      * as the same list item is used for both lists. */
     if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
     {
-        /* The current task must be in a ready list, so there is no need to
-         * check, and the port reset macro can be called directly. */
-        portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority ); /*lint !e931 pxCurrentTCB cannot change as it is the calling task.  pxCurrentTCB->uxPriority and uxTopReadyPriority cannot change as called with scheduler suspended or in a critical section. */
+        /* The current task must be in a ready list, and that list is now
+         * empty. */
+        taskRESET_READY_TASK( pxCurrentTCB, pxCurrentTCB->uxPriority ); /*lint !e931 pxCurrentTCB cannot change as it is the calling task.  pxCurrentTCB->uxPriority and uxTopReadyPriority cannot change as called with scheduler suspended or in a critical section. */
     }
     else
     {
@@ -5477,30 +10102,38 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             /* The list item will be inserted in wake time order. */
             listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-            if( xTimeToWake < xConstTickCount )
+            #if ( configUSE_DELAY_WHEEL == 1 )
             {
-                /* Wake time has overflowed.  Place this item in the overflow
-                 * list. */
-                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                prvAddCurrentTaskToDelayWheel( xConstTickCount );
             }
-            else
+            #else /* configUSE_DELAY_WHEEL */
             {
-                /* The wake time has not overflowed, so the current block list
-                 * is used. */
-                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-                /* If the task entering the blocked state was placed at the
-                 * head of the list of blocked tasks then xNextTaskUnblockTime
-                 * needs to be updated too. */
-                if( xTimeToWake < xNextTaskUnblockTime )
+                if( xTimeToWake < xConstTickCount )
                 {
-                    xNextTaskUnblockTime = xTimeToWake;
+                    /* Wake time has overflowed.  Place this item in the overflow
+                     * list. */
+                    vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The wake time has not overflowed, so the current block list
+                     * is used. */
+                    vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+                    /* If the task entering the blocked state was placed at the
+                     * head of the list of blocked tasks then xNextTaskUnblockTime
+                     * needs to be updated too. */
+                    if( xTimeToWake < xNextTaskUnblockTime )
+                    {
+                        xNextTaskUnblockTime = xTimeToWake;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
             }
+            #endif /* configUSE_DELAY_WHEEL */
         }
     }
     #else /* INCLUDE_vTaskSuspend */
@@ -5513,28 +10146,36 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         /* The list item will be inserted in wake time order. */
         listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-        if( xTimeToWake < xConstTickCount )
+        #if ( configUSE_DELAY_WHEEL == 1 )
         {
-            /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            prvAddCurrentTaskToDelayWheel( xConstTickCount );
         }
-        else
+        #else /* configUSE_DELAY_WHEEL */
         {
-            /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-            /* If the task entering the blocked state was placed at the head of the
-             * list of blocked tasks then xNextTaskUnblockTime needs to be updated
-             * too. */
-            if( xTimeToWake < xNextTaskUnblockTime )
+            if( xTimeToWake < xConstTickCount )
             {
-                xNextTaskUnblockTime = xTimeToWake;
+                /* Wake time has overflowed.  Place this item in the overflow list. */
+                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* The wake time has not overflowed, so the current block list is used. */
+                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+                /* If the task entering the blocked state was placed at the head of the
+                 * list of blocked tasks then xNextTaskUnblockTime needs to be updated
+                 * too. */
+                if( xTimeToWake < xNextTaskUnblockTime )
+                {
+                    xNextTaskUnblockTime = xTimeToWake;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
+        #endif /* configUSE_DELAY_WHEEL */
 
         /* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
         ( void ) xCanBlockIndefinitely;
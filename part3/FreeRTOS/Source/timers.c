@@ -270,7 +270,8 @@
                                        NULL,
                                        ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
                                        &xTimerTaskHandle,
-                                       1 );
+                                       0,
+                                       0 );
             }
             #endif /* configSUPPORT_STATIC_ALLOCATION */
         }
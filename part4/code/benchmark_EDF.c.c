@@ -0,0 +1,444 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/******************************************************************************
+ * See https://www.freertos.org/freertos-on-qemu-mps2-an385-model.html for
+ * instructions.
+ *
+ * This benchmark runs a task set that Rate Monotonic scheduling cannot
+ * guarantee, and that Earliest Deadline First scheduling can.
+ *
+ * vTaskA: CpuBurst 3 s, period 6 s (utilisation 0.50)
+ * vTaskB: CpuBurst 4 s, period 9 s (utilisation 0.44)
+ *
+ * The total utilisation of 0.94 is above the Liu & Layland bound of 0.83 for
+ * two tasks, and under RM the first job of vTaskB finishes at 10 s, after its
+ * deadline at 9 s.  EDF meets every deadline of any set with a utilisation of
+ * at most 1.
+ *
+ * Build it twice with the FreeRTOSConfig.h of the demo:
+ * - configUSE_RM 1 and configUSE_RM_ADMISSION_CONTROL 1: xTaskCreatePeriodic()
+ *   rejects vTaskB with errTASK_NOT_SCHEDULABLE.
+ * - configUSE_RM 0, configUSE_RM_ADMISSION_CONTROL 0 and configUSE_EDF 1: both
+ *   tasks run, and with configUSE_DEADLINE_MISS_DETECTION 1 no "missed its
+ *   deadline" line is printed.
+ *
+ * Running in QEMU:
+ * Use the following commands to start the application running in a way that
+ * enables the debugger to connect, omit the "-s -S" to run the project without
+ * the debugger:
+ * qemu-system-arm -machine mps2-an385 -cpu cortex-m3 -kernel [path-to]/RTOSDemo.out -nographic -serial stdio -semihosting -semihosting-config enable=on,target=native -s -S
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* This project provides two demo applications.  A simple blinky style demo
+application, and a more comprehensive test and demo application.  The
+mainCREATE_SIMPLE_BLINKY_DEMO_ONLY setting is used to select between the two.
+
+If mainCREATE_SIMPLE_BLINKY_DEMO_ONLY is 1 then the blinky demo will be built.
+The blinky demo is implemented and described in main_blinky.c.
+
+If mainCREATE_SIMPLE_BLINKY_DEMO_ONLY is not 1 then the comprehensive test and
+demo application will be built.  The comprehensive test and demo application is
+implemented and described in main_full.c. */
+#define mainCREATE_SIMPLE_BLINKY_DEMO_ONLY 1
+
+/* printf() output uses the UART.  These constants define the addresses of the
+required UART registers. */
+#define UART0_ADDRESS (0x40004000UL)
+#define UART0_DATA (*(((volatile uint32_t *)(UART0_ADDRESS + 0UL))))
+#define UART0_STATE (*(((volatile uint32_t *)(UART0_ADDRESS + 4UL))))
+#define UART0_CTRL (*(((volatile uint32_t *)(UART0_ADDRESS + 8UL))))
+#define UART0_BAUDDIV (*(((volatile uint32_t *)(UART0_ADDRESS + 16UL))))
+#define TX_BUFFER_MASK (1UL)
+
+// Standard includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "timers.h"
+
+/*********************************************************************************************************
+ *												MACROS
+ *********************************************************************************************************/
+#define mainCREATE_SIMPLE_BLINKY_DEMO_ONLY 1
+
+/* Priority levels for tasks.
+	Note that: low priority numbers denote low priority tasks. */
+#define TASK_PRIORITY tskIDLE_PRIORITY + 1U
+
+/* The CpuBurst and period of each task. The times are converted from
+milliseconds to ticks using the pdMS_TO_TICKS() macro. */
+#define mainTASK_A_BURST_MS pdMS_TO_TICKS(3000UL)
+#define mainTASK_A_PERIOD_MS pdMS_TO_TICKS(6000UL)
+#define mainTASK_B_BURST_MS pdMS_TO_TICKS(4000UL)
+#define mainTASK_B_PERIOD_MS pdMS_TO_TICKS(9000UL)
+#define mainTIMER_FREQUENCY_MS pdMS_TO_TICKS(120000UL)
+
+/* Dimensions of the buffer that the task being created will use as its stack.
+	NOTE:  This is the number of words the stack will hold, not the number of bytes.
+	For example, if each stack item is 32-bits, and this is set to 100, then 400 bytes (100 * 32-bits) will be allocated. */
+#define STACK_SIZE 200
+
+/*********************************************************************************************************
+ *										UART: printf handling
+ *********************************************************************************************************/
+// printf() output uses the UART.  These constants define the addresses of the required UART registers.
+#define UART0_ADDRESS (0x40004000UL)									 // Base address of the UART peripheral
+#define UART0_DATA (*(((volatile uint32_t *)(UART0_ADDRESS + 0UL))))	 // Register to write data to for transmission
+#define UART0_STATE (*(((volatile uint32_t *)(UART0_ADDRESS + 4UL))))	 // Register that holds the status of the UART
+#define UART0_CTRL (*(((volatile uint32_t *)(UART0_ADDRESS + 8UL))))	 // Control register for configuring the UART
+#define UART0_BAUDDIV (*(((volatile uint32_t *)(UART0_ADDRESS + 16UL)))) // Register for configuring the baud rate
+#define TX_BUFFER_MASK (1UL)											 // Constant used for masking the transmission buffer
+
+// Initialization function to set up the UART peripheral => Printf() output is sent to the serial port
+static void prvUARTInit(void);
+
+/*********************************************************************************************************
+ *										  APPLICATION GLOBALS
+ *********************************************************************************************************/
+TaskHandle_t xHandle_A = NULL;
+TaskHandle_t xHandle_B = NULL;
+
+/* The number of jobs each task has completed, and the number of deadlines
+	missed by all jobs. */
+static volatile UBaseType_t uxJobsA = 0;
+static volatile UBaseType_t uxJobsB = 0;
+static volatile UBaseType_t uxDeadlinesMissed = 0;
+
+/*
+ * The callback function executed when the software timer expires.
+ */
+static void timerCallback(TimerHandle_t xTimerHandle);
+
+/* A software timer that prints the results at the end of the run. */
+static TimerHandle_t xTimer = NULL;
+
+/*********************************************************************************************************
+ *									   LOCAL FUNCTION PROTOTYPES
+ *********************************************************************************************************/
+static void vPeriodicJob(void *pvParameters);
+/**********************************************************************************************************/
+void main(void)
+{
+	prvUARTInit();
+
+	BaseType_t xReturned_A, xReturned_B;
+
+	// One job of each task is released every period, and must finish by the end of it.
+	xReturned_A = xTaskCreatePeriodic(vPeriodicJob,					// The function run once per period
+									  "vTaskA",						// Name for the task
+									  STACK_SIZE,					// The number of words (not bytes!) to allocate for use as the task's stack
+									  (void *)&uxJobsA,				// Counter of the completed jobs
+									  TASK_PRIORITY,				// Priority at which the task is created
+									  &xHandle_A,					// Used to pass out the created task's handle
+									  mainTASK_A_BURST_MS,			// Estimation of task's CPU Burst in ticks
+									  mainTASK_A_PERIOD_MS,			// Period of a task in ticks
+									  0);							// The deadline is the end of the period
+	xReturned_B = xTaskCreatePeriodic(vPeriodicJob, "vTaskB", STACK_SIZE, (void *)&uxJobsB, TASK_PRIORITY, &xHandle_B, mainTASK_B_BURST_MS, mainTASK_B_PERIOD_MS, 0);
+
+	if (xReturned_A == pdPASS && xReturned_B == pdPASS)
+	{
+		xTimer = xTimerCreate("Timer", mainTIMER_FREQUENCY_MS, pdFALSE, NULL, timerCallback);
+		xTimerStart(xTimer, 0);
+		vTaskStartScheduler();
+	}
+	else if (xReturned_B == errTASK_NOT_SCHEDULABLE)
+		printf("vTaskB was rejected: the task set cannot be guaranteed under Rate Monotonic scheduling.\r\n");
+	else
+		printf("Error creating tasks. Code A: %ld, Code B: %ld \r\n", xReturned_A, xReturned_B);
+
+	for (;;)
+		;
+}
+
+/**********************************************************************************************************/
+void vPeriodicJob(void *pvParameters)
+{
+	const TickType_t xBurst = xTaskCpuBurstGet(NULL);
+	TickType_t xUsed = 0;
+	TickType_t xLastTick = xTaskGetTickCount();
+
+	printf("%s is running. Start time: %d\n", uxTaskNameGet(NULL), xTaskGetTickCount()/1000);
+
+	/* Busy-wait until the job has run for its CpuBurst.  Only ticks that pass
+	one at a time are counted, so time spent preempted by the other task is not
+	counted as work done. */
+	while (xUsed < xBurst)
+	{
+		TickType_t xNow = xTaskGetTickCount();
+
+		if ((xNow - xLastTick) == 1)
+			xUsed++;
+
+		xLastTick = xNow;
+	}
+
+	printf("%s finished at time %d.\n", uxTaskNameGet(NULL), xTaskGetTickCount()/1000);
+
+	(*(volatile UBaseType_t *)pvParameters)++;
+
+	/* Returning ends the job.  The kernel blocks the task until its next release. */
+}
+/* -------------------------------------------------- */
+static void timerCallback(TimerHandle_t xTimerHandle)
+{
+	(void)xTimerHandle;
+	printf("Jobs completed: vTaskA %lu, vTaskB %lu. Deadlines missed: %lu.\n", (unsigned long)uxJobsA, (unsigned long)uxJobsB, (unsigned long)uxDeadlinesMissed);
+}
+
+#if (configUSE_DEADLINE_MISS_DETECTION == 1) && (configDEADLINE_MISS_POLICY == pdDEADLINE_MISS_NOTIFY)
+void vApplicationDeadlineMissedHook(TaskHandle_t xTask)
+{
+	/* Called from the tick interrupt when a job of xTask is still running
+	after its deadline. */
+	uxDeadlinesMissed++;
+	printf("%s missed its deadline at time %d.\n", uxTaskNameGet(xTask), xTaskGetTickCountFromISR()/1000);
+}
+#endif
+
+/**********************************************************************************************************
+ *											Already defined Functions
+ *********************************************************************************************************/
+void vApplicationMallocFailedHook(void)
+{
+	/* vApplicationMallocFailedHook() will only be called if
+	configUSE_MALLOC_FAILED_HOOK is set to 1 in FreeRTOSConfig.h.  It is a hook
+	function that will get called if a call to pvPortMalloc() fails.
+	pvPortMalloc() is called internally by the kernel whenever a task, queue,
+	timer or semaphore is created using the dynamic allocation (as opposed to
+	static allocation) option.  It is also called by various parts of the
+	demo application.  If heap_1.c, heap_2.c or heap_4.c is being used, then the
+	size of the	heap available to pvPortMalloc() is defined by
+	configTOTAL_HEAP_SIZE in FreeRTOSConfig.h, and the xPortGetFreeHeapSize()
+	API function can be used to query the size of free heap space that remains
+	(although it does not provide information on how the remaining heap might be
+	fragmented).  See http://www.freertos.org/a00111.html for more
+	information. */
+	printf("\r\n\r\nMalloc failed\r\n");
+	portDISABLE_INTERRUPTS();
+	for (;;)
+		;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook(void)
+{
+	/* vApplicationIdleHook() will only be called if configUSE_IDLE_HOOK is set
+	to 1 in FreeRTOSConfig.h.  It will be called on each iteration of the idle
+	task.  It is essential that code added to this hook function never attempts
+	to block in any way (for example, call xQueueReceive() with a block time
+	specified, or call vTaskDelay()).  If application tasks make use of the
+	vTaskDelete() API function to delete themselves then it is also important
+	that vApplicationIdleHook() is permitted to return to its calling function,
+	because it is the responsibility of the idle task to clean up memory
+	allocated by the kernel to any task that has since deleted itself. */
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook(TaskHandle_t pxTask, char *pcTaskName)
+{
+	(void)pcTaskName;
+	(void)pxTask;
+
+	/* Run time stack overflow checking is performed if
+	configCHECK_FOR_STACK_OVERFLOW is defined to 1 or 2.  This hook
+	function is called if a stack overflow is detected. */
+	printf("\r\n\r\nStack overflow in %s\r\n", pcTaskName);
+	portDISABLE_INTERRUPTS();
+	for (;;)
+		;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook(void)
+{
+	/* This function will be called by each tick interrupt if
+	configUSE_TICK_HOOK is set to 1 in FreeRTOSConfig.h.  User code can be
+	added here, but the tick hook is called from an interrupt context, so
+	code must not attempt to block, and only the interrupt safe FreeRTOS API
+	functions can be used (those that end in FromISR()). */
+
+#if (mainCREATE_SIMPLE_BLINKY_DEMO_ONLY != 1)
+	{
+		extern void vFullDemoTickHookFunction(void);
+
+		vFullDemoTickHookFunction();
+	}
+#endif /* mainCREATE_SIMPLE_BLINKY_DEMO_ONLY */
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationDaemonTaskStartupHook(void)
+{
+	/* This function will be called once only, when the daemon task starts to
+	execute (sometimes called the timer task).  This is useful if the
+	application includes initialisation code that would benefit from executing
+	after the scheduler has been started. */
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled(const char *pcFileName, uint32_t ulLine)
+{
+	volatile uint32_t ulSetToNonZeroInDebuggerToContinue = 0;
+
+	/* Called if an assertion passed to configASSERT() fails.  See
+	http://www.freertos.org/a00110.html#configASSERT for more information. */
+
+	printf("ASSERT! Line %d, file %s\r\n", (int)ulLine, pcFileName);
+
+	taskENTER_CRITICAL();
+	{
+		/* You can step out of this function to debug the assertion by using
+		the debugger to set ulSetToNonZeroInDebuggerToContinue to a non-zero
+		value. */
+		while (ulSetToNonZeroInDebuggerToContinue == 0)
+		{
+			__asm volatile("NOP");
+			__asm volatile("NOP");
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/* configUSE_STATIC_ALLOCATION is set to 1, so the application must provide an
+implementation of vApplicationGetIdleTaskMemory() to provide the memory that is
+used by the Idle task. */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize)
+{
+	/* If the buffers to be provided to the Idle task are declared inside this
+	function then they must be declared static - otherwise they will be allocated on
+	the stack and so not exists after this function exits. */
+	static StaticTask_t xIdleTaskTCB;
+	static StackType_t uxIdleTaskStack[configMINIMAL_STACK_SIZE];
+
+	/* Pass out a pointer to the StaticTask_t structure in which the Idle task's
+	state will be stored. */
+	*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+
+	/* Pass out the array that will be used as the Idle task's stack. */
+	*ppxIdleTaskStackBuffer = uxIdleTaskStack;
+
+	/* Pass out the size of the array pointed to by *ppxIdleTaskStackBuffer.
+	Note that, as the array is necessarily of type StackType_t,
+	configMINIMAL_STACK_SIZE is specified in words, not bytes. */
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+/* configUSE_STATIC_ALLOCATION and configUSE_TIMERS are both set to 1, so the
+application must provide an implementation of vApplicationGetTimerTaskMemory()
+to provide the memory that is used by the Timer service task. */
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize)
+{
+	/* If the buffers to be provided to the Timer task are declared inside this
+	function then they must be declared static - otherwise they will be allocated on
+	the stack and so not exists after this function exits. */
+	static StaticTask_t xTimerTaskTCB;
+	static StackType_t uxTimerTaskStack[configTIMER_TASK_STACK_DEPTH];
+
+	/* Pass out a pointer to the StaticTask_t structure in which the Timer
+	task's state will be stored. */
+	*ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+
+	/* Pass out the array that will be used as the Timer task's stack. */
+	*ppxTimerTaskStackBuffer = uxTimerTaskStack;
+
+	/* Pass out the size of the array pointed to by *ppxTimerTaskStackBuffer.
+	Note that, as the array is necessarily of type StackType_t,
+	configMINIMAL_STACK_SIZE is specified in words, not bytes. */
+	*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUARTInit(void)
+{
+	UART0_BAUDDIV = 16;
+	UART0_CTRL = 1;
+}
+/*-----------------------------------------------------------*/
+
+int _write(int file, char *ptr, int len)
+{
+	(void)file; // Ignore the file parameter
+
+	int i;
+	for (i = 0; i < len; i++)
+	{
+		while (!(UART0_STATE & (1 << 5)))
+			;				 // Wait for UART0 TX buffer to be empty
+		UART0_DATA = ptr[i]; // Send character to UART0
+	}
+
+	return i; // Return number of characters written
+}
+
+int __write(int iFile, char *pcString, int iStringLength)
+{
+	int iNextChar;
+
+	/* Avoid compiler warnings about unused parameters.*/
+	(void)iFile;
+
+	/* Output the formatted string to the UART. */
+	for (iNextChar = 0; iNextChar < iStringLength; iNextChar++)
+	{
+		while ((UART0_STATE & TX_BUFFER_MASK) != 0)
+			;
+		UART0_DATA = *pcString;
+		pcString++;
+	}
+
+	return iStringLength;
+}
+/*-----------------------------------------------------------*/
+
+void *malloc(size_t size)
+{
+	(void)size;
+	return pvPortMalloc(size);
+
+	/* This project uses heap_4 so doesn't set up a heap for use by the C
+	library - but something is calling the C library malloc().  See
+	https://freertos.org/a00111.html for more information. */
+	// printf( "\r\n\r\nUnexpected call to malloc() - should be usine pvPortMalloc()\r\n" );
+	// portDISABLE_INTERRUPTS();
+	// for( ;; );
+}
\ No newline at end of file
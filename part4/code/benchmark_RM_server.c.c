@@ -0,0 +1,536 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/******************************************************************************
+ * See https://www.freertos.org/freertos-on-qemu-mps2-an385-model.html for
+ * instructions.
+ *
+ * This benchmark measures the response time of aperiodic jobs under Rate
+ * Monotonic Scheduling, served either by an aperiodic server or in the
+ * background.  Two periodic tasks load the processor to 50%.  The tick hook
+ * submits an aperiodic job at pseudo-random intervals, as an interrupt
+ * handler would, and the job records the time from its arrival to its
+ * completion.
+ *
+ * With mainUSE_APERIODIC_SERVER set to 1 the jobs are submitted to a
+ * deferrable server created by xTaskCreateAperiodicServer().  Its period is
+ * the shortest, so it runs a job as soon as one arrives while it has budget,
+ * and admission control has checked the periodic tasks still meet their
+ * deadlines.  With mainUSE_APERIODIC_SERVER set to 0 the jobs are sent to a
+ * task without a period, which only runs when no periodic task is ready.
+ *
+ * Times combine the tick count with the SysTick current value register, so
+ * they are in CPU cycles.  The results are printed as CSV lines:
+ * mode,samples,dropped,min_cycles,avg_cycles,max_cycles,deadlines_missed
+ *
+ * The server needs budget enforcement, which needs a run time counter.  Add
+ * to FreeRTOSConfig.h:
+ *	#define configUSE_APERIODIC_SERVER 1
+ *	#define configUSE_BUDGET_ENFORCEMENT 1
+ *	#define configGENERATE_RUN_TIME_STATS 1
+ *	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+ *	#define portGET_RUN_TIME_COUNTER_VALUE() xTaskGetTickCount()
+ *	#define configRUN_TIME_COUNTS_PER_TICK 1
+ *
+ * Running in QEMU:
+ * qemu-system-arm -machine mps2-an385 -cpu cortex-m3 -kernel [path-to]/RTOSDemo.out -nographic -serial stdio -semihosting -semihosting-config enable=on,target=native
+ */
+
+// Standard includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/*********************************************************************************************************
+ *												MACROS
+ *********************************************************************************************************/
+#define mainCREATE_SIMPLE_BLINKY_DEMO_ONLY 1
+
+/* 1 to serve the aperiodic jobs with an aperiodic server, 0 to run them in the
+	background. */
+#define mainUSE_APERIODIC_SERVER 1
+
+#if (mainUSE_APERIODIC_SERVER == 1) && (configUSE_APERIODIC_SERVER != 1)
+#error Set configUSE_APERIODIC_SERVER to 1 in FreeRTOSConfig.h, or mainUSE_APERIODIC_SERVER to 0.
+#endif
+
+/* Priority levels for tasks.
+	Note that: low priority numbers denote low priority tasks. */
+#define TASK_PRIORITY tskIDLE_PRIORITY + 1U
+
+/* Stack of each task, in words. */
+#define STACK_SIZE 200
+
+/* The periodic load, in ticks: 3/10 + 5/25 = 50%. */
+#define TASK_A_BURST 3
+#define TASK_A_PERIOD 10
+#define TASK_B_BURST 5
+#define TASK_B_PERIOD 25
+
+/* The server may use 2 ticks in every 8, and outranks both periodic tasks. */
+#define SERVER_BUDGET 2
+#define SERVER_PERIOD 8
+
+/* Aperiodic jobs waiting for the server or the background task. */
+#define QUEUE_LENGTH 8
+
+/* Number of aperiodic jobs, and so of response times measured. */
+#define NUM_SAMPLES 2000
+
+/* An aperiodic job arrives after 1 to MAX_INTERARRIVAL ticks, 20 on average. */
+#define MAX_INTERARRIVAL 39
+
+/* The work of one aperiodic job, in iterations of an empty loop. */
+#define APERIODIC_WORK 2000
+
+/* SysTick registers.  The current value counts down from the reload value to
+	zero once per tick. */
+#define SYSTICK_LOAD (*((volatile uint32_t *)0xE000E014UL))
+#define SYSTICK_VAL (*((volatile uint32_t *)0xE000E018UL))
+
+/*********************************************************************************************************
+ *										UART: printf handling
+ *********************************************************************************************************/
+// printf() output uses the UART.  These constants define the addresses of the required UART registers.
+#define UART0_ADDRESS (0x40004000UL)									 // Base address of the UART peripheral
+#define UART0_DATA (*(((volatile uint32_t *)(UART0_ADDRESS + 0UL))))	 // Register to write data to for transmission
+#define UART0_STATE (*(((volatile uint32_t *)(UART0_ADDRESS + 4UL))))	 // Register that holds the status of the UART
+#define UART0_CTRL (*(((volatile uint32_t *)(UART0_ADDRESS + 8UL))))	 // Control register for configuring the UART
+#define UART0_BAUDDIV (*(((volatile uint32_t *)(UART0_ADDRESS + 16UL)))) // Register for configuring the baud rate
+#define TX_BUFFER_MASK (1UL)											 // Constant used for masking the transmission buffer
+
+// Initialization function to set up the UART peripheral => Printf() output is sent to the serial port
+static void prvUARTInit(void);
+
+/*********************************************************************************************************
+ *										  APPLICATION GLOBALS
+ *********************************************************************************************************/
+/* The burst of each periodic task, passed to its job. */
+static const TickType_t xBurstA = TASK_A_BURST;
+static const TickType_t xBurstB = TASK_B_BURST;
+
+/* The time each aperiodic job arrived, indexed by the job's sample number. */
+static uint64_t ullArrival[NUM_SAMPLES];
+
+/* Response time statistics, updated by the job that completes. */
+static uint64_t ullTotal = 0, ullMin = UINT64_MAX, ullMax = 0;
+static UBaseType_t uxCompleted = 0;
+
+/* Arrivals the queue had no room for, and the next sample number. */
+static volatile UBaseType_t uxDropped = 0;
+static volatile UBaseType_t uxSubmitted = 0;
+
+static volatile UBaseType_t uxDeadlinesMissed = 0;
+
+#if (mainUSE_APERIODIC_SERVER == 1)
+static TaskHandle_t xServer = NULL;
+#else
+static QueueHandle_t xQueue = NULL;
+#endif
+
+/*********************************************************************************************************
+ *									   LOCAL FUNCTION PROTOTYPES
+ *********************************************************************************************************/
+static void vPeriodicJob(void *pvParameters);
+static void vAperiodicJob(void *pvParameters);
+static void vArrivalTickHook(void);
+static uint64_t ullTimestamp(void);
+#if (mainUSE_APERIODIC_SERVER != 1)
+static void vBackgroundTask(void *pvParameters);
+#endif
+/**********************************************************************************************************/
+void main(void)
+{
+	prvUARTInit();
+
+	BaseType_t xReturned_A, xReturned_B, xReturned_S;
+
+	xReturned_A = xTaskCreatePeriodic(vPeriodicJob, "TaskA", STACK_SIZE, (void *)&xBurstA, TASK_PRIORITY, NULL, TASK_A_BURST, TASK_A_PERIOD, 0);
+	xReturned_B = xTaskCreatePeriodic(vPeriodicJob, "TaskB", STACK_SIZE, (void *)&xBurstB, TASK_PRIORITY, NULL, TASK_B_BURST, TASK_B_PERIOD, 0);
+
+#if (mainUSE_APERIODIC_SERVER == 1)
+	xReturned_S = xTaskCreateAperiodicServer("Server", STACK_SIZE, TASK_PRIORITY, &xServer, SERVER_BUDGET, SERVER_PERIOD, QUEUE_LENGTH);
+#else
+	xQueue = xQueueCreate(QUEUE_LENGTH, sizeof(UBaseType_t));
+	xReturned_S = (xQueue != NULL) ? xTaskCreate(vBackgroundTask, "Backgrnd", STACK_SIZE, NULL, TASK_PRIORITY, NULL, 0, 0) : pdFAIL;
+#endif
+
+	if (xReturned_A == pdPASS && xReturned_B == pdPASS && xReturned_S == pdPASS)
+	{
+		vTaskStartScheduler();
+	}
+	else
+		printf("Error creating tasks. Code A: %ld, Code B: %ld, Code S: %ld \r\n", xReturned_A, xReturned_B, xReturned_S);
+
+	for (;;)
+		;
+}
+
+/**********************************************************************************************************/
+static uint64_t ullTimestamp(void)
+{
+	const uint32_t ulReload = SYSTICK_LOAD + 1UL;
+	TickType_t xTick;
+	uint32_t ulValue;
+
+	/* Read the tick count on both sides of the SysTick value, so a tick that
+	arrives in between is not paired with the count of the previous one. */
+	do
+	{
+		xTick = xTaskGetTickCount();
+		ulValue = SYSTICK_VAL;
+	} while (xTick != xTaskGetTickCount());
+
+	return ((uint64_t)xTick * ulReload) + (ulReload - 1UL - ulValue);
+}
+/*-----------------------------------------------------------*/
+
+static void vPeriodicJob(void *pvParameters)
+{
+	const TickType_t xBurst = *(const TickType_t *)pvParameters;
+
+	/* Use most of the burst, leaving a tick of margin so budget enforcement
+	never stops the job. */
+	while (ulTaskGetJobRunTimeCounter(NULL) < (configRUN_TIME_COUNTER_TYPE)((xBurst - 1) * configRUN_TIME_COUNTS_PER_TICK))
+	{
+	}
+
+	/* Returning ends the job.  The kernel blocks the task until its next release. */
+}
+/*-----------------------------------------------------------*/
+
+static void vAperiodicJob(void *pvParameters)
+{
+	const UBaseType_t uxSample = (UBaseType_t)pvParameters;
+	uint64_t ullResponse;
+
+	for (volatile uint32_t i = 0; i < APERIODIC_WORK; i++)
+	{
+	}
+
+	ullResponse = ullTimestamp() - ullArrival[uxSample];
+	ullTotal += ullResponse;
+
+	if (ullResponse < ullMin)
+		ullMin = ullResponse;
+
+	if (ullResponse > ullMax)
+		ullMax = ullResponse;
+
+	uxCompleted++;
+
+	if (uxCompleted == NUM_SAMPLES - uxDropped)
+	{
+		printf("mode,samples,dropped,min_cycles,avg_cycles,max_cycles,deadlines_missed\n");
+		printf("%s,%lu,%lu,%lu,%lu,%lu,%lu\n", (mainUSE_APERIODIC_SERVER == 1) ? "server" : "background", (unsigned long)uxCompleted, (unsigned long)uxDropped,
+			   (unsigned long)ullMin, (unsigned long)(ullTotal / uxCompleted), (unsigned long)ullMax, (unsigned long)uxDeadlinesMissed);
+		printf("Benchmark finished.\n");
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if (mainUSE_APERIODIC_SERVER != 1)
+static void vBackgroundTask(void *pvParameters)
+{
+	(void)pvParameters;
+
+	UBaseType_t uxSample;
+
+	/* The task has no period, so it is ranked below every periodic task. */
+	for (;;)
+	{
+		xQueueReceive(xQueue, &uxSample, portMAX_DELAY);
+		vAperiodicJob((void *)uxSample);
+	}
+}
+#endif
+/*-----------------------------------------------------------*/
+
+static void vArrivalTickHook(void)
+{
+	static uint32_t ulSeed = 1UL;
+	static TickType_t xTicksToArrival = 1;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	BaseType_t xQueued;
+	UBaseType_t uxSample;
+
+	if (uxSubmitted >= NUM_SAMPLES || --xTicksToArrival != 0)
+		return;
+
+	uxSample = uxSubmitted++;
+
+	/* The tick interrupt has just reloaded SysTick, so the arrival is at the
+	start of this tick. */
+	ullArrival[uxSample] = (uint64_t)xTaskGetTickCountFromISR() * (SYSTICK_LOAD + 1UL);
+
+#if (mainUSE_APERIODIC_SERVER == 1)
+	xQueued = xTaskSubmitAperiodicJobFromISR(xServer, vAperiodicJob, (void *)uxSample, &xHigherPriorityTaskWoken);
+#else
+	xQueued = xQueueSendFromISR(xQueue, &uxSample, &xHigherPriorityTaskWoken);
+#endif
+
+	if (xQueued != pdPASS)
+		uxDropped++;
+
+	/* xTaskIncrementTick() checks for a pending yield after calling the tick
+	hook, so a task woken here runs as soon as the tick interrupt ends. */
+	(void)xHigherPriorityTaskWoken;
+
+	/* Linear congruential generator for the next interarrival time. */
+	ulSeed = (ulSeed * 1103515245UL) + 12345UL;
+	xTicksToArrival = (TickType_t)(((ulSeed >> 16) % MAX_INTERARRIVAL) + 1);
+}
+/* -------------------------------------------------- */
+
+#if (configUSE_DEADLINE_MISS_DETECTION == 1) && (configDEADLINE_MISS_POLICY == pdDEADLINE_MISS_NOTIFY)
+void vApplicationDeadlineMissedHook(TaskHandle_t xTask)
+{
+	/* Called from the tick interrupt when a job of xTask is still running
+	after its deadline. */
+	(void)xTask;
+	uxDeadlinesMissed++;
+}
+#endif
+
+/**********************************************************************************************************
+ *											Already defined Functions
+ *********************************************************************************************************/
+void vApplicationMallocFailedHook(void)
+{
+	/* vApplicationMallocFailedHook() will only be called if
+	configUSE_MALLOC_FAILED_HOOK is set to 1 in FreeRTOSConfig.h.  It is a hook
+	function that will get called if a call to pvPortMalloc() fails.
+	pvPortMalloc() is called internally by the kernel whenever a task, queue,
+	timer or semaphore is created using the dynamic allocation (as opposed to
+	static allocation) option.  It is also called by various parts of the
+	demo application.  If heap_1.c, heap_2.c or heap_4.c is being used, then the
+	size of the	heap available to pvPortMalloc() is defined by
+	configTOTAL_HEAP_SIZE in FreeRTOSConfig.h, and the xPortGetFreeHeapSize()
+	API function can be used to query the size of free heap space that remains
+	(although it does not provide information on how the remaining heap might be
+	fragmented).  See http://www.freertos.org/a00111.html for more
+	information. */
+	printf("\r\n\r\nMalloc failed\r\n");
+	portDISABLE_INTERRUPTS();
+	for (;;)
+		;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook(void)
+{
+	/* vApplicationIdleHook() will only be called if configUSE_IDLE_HOOK is set
+	to 1 in FreeRTOSConfig.h.  It will be called on each iteration of the idle
+	task.  It is essential that code added to this hook function never attempts
+	to block in any way (for example, call xQueueReceive() with a block time
+	specified, or call vTaskDelay()).  If application tasks make use of the
+	vTaskDelete() API function to delete themselves then it is also important
+	that vApplicationIdleHook() is permitted to return to its calling function,
+	because it is the responsibility of the idle task to clean up memory
+	allocated by the kernel to any task that has since deleted itself. */
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook(TaskHandle_t pxTask, char *pcTaskName)
+{
+	(void)pcTaskName;
+	(void)pxTask;
+
+	/* Run time stack overflow checking is performed if
+	configCHECK_FOR_STACK_OVERFLOW is defined to 1 or 2.  This hook
+	function is called if a stack overflow is detected. */
+	printf("\r\n\r\nStack overflow in %s\r\n", pcTaskName);
+	portDISABLE_INTERRUPTS();
+	for (;;)
+		;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook(void)
+{
+	/* This function will be called by each tick interrupt if
+	configUSE_TICK_HOOK is set to 1 in FreeRTOSConfig.h.  User code can be
+	added here, but the tick hook is called from an interrupt context, so
+	code must not attempt to block, and only the interrupt safe FreeRTOS API
+	functions can be used (those that end in FromISR()). */
+
+	/* Aperiodic requests arrive from here, as they would from a UART or
+	network interrupt. */
+	vArrivalTickHook();
+
+#if (mainCREATE_SIMPLE_BLINKY_DEMO_ONLY != 1)
+	{
+		extern void vFullDemoTickHookFunction(void);
+
+		vFullDemoTickHookFunction();
+	}
+#endif /* mainCREATE_SIMPLE_BLINKY_DEMO_ONLY */
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationDaemonTaskStartupHook(void)
+{
+	/* This function will be called once only, when the daemon task starts to
+	execute (sometimes called the timer task).  This is useful if the
+	application includes initialisation code that would benefit from executing
+	after the scheduler has been started. */
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled(const char *pcFileName, uint32_t ulLine)
+{
+	volatile uint32_t ulSetToNonZeroInDebuggerToContinue = 0;
+
+	/* Called if an assertion passed to configASSERT() fails.  See
+	http://www.freertos.org/a00110.html#configASSERT for more information. */
+
+	printf("ASSERT! Line %d, file %s\r\n", (int)ulLine, pcFileName);
+
+	taskENTER_CRITICAL();
+	{
+		/* You can step out of this function to debug the assertion by using
+		the debugger to set ulSetToNonZeroInDebuggerToContinue to a non-zero
+		value. */
+		while (ulSetToNonZeroInDebuggerToContinue == 0)
+		{
+			__asm volatile("NOP");
+			__asm volatile("NOP");
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/* configUSE_STATIC_ALLOCATION is set to 1, so the application must provide an
+implementation of vApplicationGetIdleTaskMemory() to provide the memory that is
+used by the Idle task. */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize)
+{
+	/* If the buffers to be provided to the Idle task are declared inside this
+	function then they must be declared static - otherwise they will be allocated on
+	the stack and so not exists after this function exits. */
+	static StaticTask_t xIdleTaskTCB;
+	static StackType_t uxIdleTaskStack[configMINIMAL_STACK_SIZE];
+
+	/* Pass out a pointer to the StaticTask_t structure in which the Idle task's
+	state will be stored. */
+	*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+
+	/* Pass out the array that will be used as the Idle task's stack. */
+	*ppxIdleTaskStackBuffer = uxIdleTaskStack;
+
+	/* Pass out the size of the array pointed to by *ppxIdleTaskStackBuffer.
+	Note that, as the array is necessarily of type StackType_t,
+	configMINIMAL_STACK_SIZE is specified in words, not bytes. */
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+/* configUSE_STATIC_ALLOCATION and configUSE_TIMERS are both set to 1, so the
+application must provide an implementation of vApplicationGetTimerTaskMemory()
+to provide the memory that is used by the Timer service task. */
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize)
+{
+	/* If the buffers to be provided to the Timer task are declared inside this
+	function then they must be declared static - otherwise they will be allocated on
+	the stack and so not exists after this function exits. */
+	static StaticTask_t xTimerTaskTCB;
+	static StackType_t uxTimerTaskStack[configTIMER_TASK_STACK_DEPTH];
+
+	/* Pass out a pointer to the StaticTask_t structure in which the Timer
+	task's state will be stored. */
+	*ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+
+	/* Pass out the array that will be used as the Timer task's stack. */
+	*ppxTimerTaskStackBuffer = uxTimerTaskStack;
+
+	/* Pass out the size of the array pointed to by *ppxTimerTaskStackBuffer.
+	Note that, as the array is necessarily of type StackType_t,
+	configMINIMAL_STACK_SIZE is specified in words, not bytes. */
+	*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUARTInit(void)
+{
+	UART0_BAUDDIV = 16;
+	UART0_CTRL = 1;
+}
+/*-----------------------------------------------------------*/
+
+int _write(int file, char *ptr, int len)
+{
+	(void)file; // Ignore the file parameter
+
+	int i;
+	for (i = 0; i < len; i++)
+	{
+		while (!(UART0_STATE & (1 << 5)))
+			;				 // Wait for UART0 TX buffer to be empty
+		UART0_DATA = ptr[i]; // Send character to UART0
+	}
+
+	return i; // Return number of characters written
+}
+
+int __write(int iFile, char *pcString, int iStringLength)
+{
+	int iNextChar;
+
+	/* Avoid compiler warnings about unused parameters.*/
+	(void)iFile;
+
+	/* Output the formatted string to the UART. */
+	for (iNextChar = 0; iNextChar < iStringLength; iNextChar++)
+	{
+		while ((UART0_STATE & TX_BUFFER_MASK) != 0)
+			;
+		UART0_DATA = *pcString;
+		pcString++;
+	}
+
+	return iStringLength;
+}
+/*-----------------------------------------------------------*/
+
+void *malloc(size_t size)
+{
+	(void)size;
+	return pvPortMalloc(size);
+
+	/* This project uses heap_4 so doesn't set up a heap for use by the C
+	library - but something is calling the C library malloc().  See
+	https://freertos.org/a00111.html for more information. */
+	// printf( "\r\n\r\nUnexpected call to malloc() - should be usine pvPortMalloc()\r\n" );
+	// portDISABLE_INTERRUPTS();
+	// for( ;; );
+}
\ No newline at end of file
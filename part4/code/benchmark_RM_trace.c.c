@@ -0,0 +1,426 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/******************************************************************************
+ * See https://www.freertos.org/freertos-on-qemu-mps2-an385-model.html for
+ * instructions.
+ *
+ * This benchmark records the schedule of three periodic tasks with the
+ * schedule trace, then prints it so trace_to_gantt.py can draw it as a Gantt
+ * chart.  The tasks are created with the same priority, so under standard
+ * scheduling they share the processor by time slicing, while Rate Monotonic
+ * Scheduling runs the task with the shortest period first.  Build once as the
+ * demo is configured and once with configUSE_RM set to 0, and pass both
+ * outputs to trace_to_gantt.py to compare them.
+ *
+ * The demo configuration needs these added to FreeRTOSConfig.h:
+ *	#undef configUSE_TRACE_FACILITY
+ *	#define configUSE_TRACE_FACILITY 1
+ *	#define configUSE_SCHEDULE_TRACE 1
+ *
+ * Events are timestamped in ticks.  For a finer resolution define
+ * configSCHEDULE_TRACE_TIMESTAMP() to read a free running counter, for example
+ * the DWT cycle counter on hardware.
+ *
+ * After RUN_TICKS the reporting task prints a line per task and a line per
+ * event, each event being the eight bytes of its ScheduleTraceEntry_t in hex:
+ * task,<number>,<name>
+ * trace,<hex>
+ *
+ * Running in QEMU:
+ * qemu-system-arm -machine mps2-an385 -cpu cortex-m3 -kernel [path-to]/RTOSDemo.out -nographic -serial stdio -semihosting -semihosting-config enable=on,target=native > outputs/trace_RM.txt
+ * python3 trace_to_gantt.py --plot outputs/trace_RM.txt outputs/trace_freertos.txt
+ */
+
+// Standard includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/*********************************************************************************************************
+ *												MACROS
+ *********************************************************************************************************/
+#define mainCREATE_SIMPLE_BLINKY_DEMO_ONLY 1
+
+#if (configUSE_SCHEDULE_TRACE != 1)
+#error Set configUSE_SCHEDULE_TRACE and configUSE_TRACE_FACILITY to 1 in FreeRTOSConfig.h, this benchmark prints the schedule trace.
+#endif
+
+/* Priority levels for tasks.
+	Note that: low priority numbers denote low priority tasks. */
+#define TASK_PRIORITY tskIDLE_PRIORITY + 1U
+#define REPORT_PRIORITY configMAX_PRIORITIES - 1U
+
+/* Stack of each task, in words. */
+#define STACK_SIZE 200
+
+/* The periodic load, in ticks: 2/10 + 3/15 + 4/30 = 53%. */
+#define TASK_A_BURST 2
+#define TASK_A_PERIOD 10
+#define TASK_B_BURST 3
+#define TASK_B_PERIOD 15
+#define TASK_C_BURST 4
+#define TASK_C_PERIOD 30
+
+/* Ticks to trace, four hyperperiods.  The trace holds configSCHEDULE_TRACE_LENGTH
+	events, which is enough for this load. */
+#define RUN_TICKS 120
+
+/* The most tasks reported by name. */
+#define MAX_TASKS 10
+
+/*********************************************************************************************************
+ *										UART: printf handling
+ *********************************************************************************************************/
+// printf() output uses the UART.  These constants define the addresses of the required UART registers.
+#define UART0_ADDRESS (0x40004000UL)									 // Base address of the UART peripheral
+#define UART0_DATA (*(((volatile uint32_t *)(UART0_ADDRESS + 0UL))))	 // Register to write data to for transmission
+#define UART0_STATE (*(((volatile uint32_t *)(UART0_ADDRESS + 4UL))))	 // Register that holds the status of the UART
+#define UART0_CTRL (*(((volatile uint32_t *)(UART0_ADDRESS + 8UL))))	 // Control register for configuring the UART
+#define UART0_BAUDDIV (*(((volatile uint32_t *)(UART0_ADDRESS + 16UL)))) // Register for configuring the baud rate
+#define TX_BUFFER_MASK (1UL)											 // Constant used for masking the transmission buffer
+
+// Initialization function to set up the UART peripheral => Printf() output is sent to the serial port
+static void prvUARTInit(void);
+
+/*********************************************************************************************************
+ *										  APPLICATION GLOBALS
+ *********************************************************************************************************/
+/* The work of each periodic task, passed to its job.  It is one tick short of
+	the burst, as a job rarely starts at the beginning of a tick. */
+static const TickType_t xWorkA = TASK_A_BURST - 1;
+static const TickType_t xWorkB = TASK_B_BURST - 1;
+static const TickType_t xWorkC = TASK_C_BURST - 1;
+
+/* Copied out of the kernel before printing, so printing is not traced. */
+static ScheduleTraceEntry_t xTrace[configSCHEDULE_TRACE_LENGTH];
+static TaskStatus_t xTaskStatus[MAX_TASKS];
+
+/*********************************************************************************************************
+ *									   LOCAL FUNCTION PROTOTYPES
+ *********************************************************************************************************/
+static void vPeriodicJob(void *pvParameters);
+static void vReportingTask(void *pvParameters);
+/**********************************************************************************************************/
+void main(void)
+{
+	prvUARTInit();
+
+	BaseType_t xReturned_A, xReturned_B, xReturned_C, xReturned_R;
+
+	xReturned_A = xTaskCreatePeriodic(vPeriodicJob, "TaskA", STACK_SIZE, (void *)&xWorkA, TASK_PRIORITY, NULL, TASK_A_BURST, TASK_A_PERIOD, 0);
+	xReturned_B = xTaskCreatePeriodic(vPeriodicJob, "TaskB", STACK_SIZE, (void *)&xWorkB, TASK_PRIORITY, NULL, TASK_B_BURST, TASK_B_PERIOD, 0);
+	xReturned_C = xTaskCreatePeriodic(vPeriodicJob, "TaskC", STACK_SIZE, (void *)&xWorkC, TASK_PRIORITY, NULL, TASK_C_BURST, TASK_C_PERIOD, 0);
+	xReturned_R = xTaskCreate(vReportingTask, "Report", STACK_SIZE * 2, NULL, REPORT_PRIORITY, NULL, 0, 0);
+
+	if (xReturned_A == pdPASS && xReturned_B == pdPASS && xReturned_C == pdPASS && xReturned_R == pdPASS)
+	{
+		vTaskStartScheduler();
+	}
+	else
+		printf("Error creating tasks. Code A: %ld, Code B: %ld, Code C: %ld, Code R: %ld \r\n", xReturned_A, xReturned_B, xReturned_C, xReturned_R);
+
+	for (;;)
+		;
+}
+
+/**********************************************************************************************************/
+static void vPeriodicJob(void *pvParameters)
+{
+	const TickType_t xWork = *(const TickType_t *)pvParameters;
+	const TickType_t xStart = xTaskGetTickCount();
+
+	/* The tick keeps running while a task runs, so the job can time its work
+	with the tick count. */
+	while ((TickType_t)(xTaskGetTickCount() - xStart) < xWork)
+	{
+	}
+
+	/* Returning ends the job.  The kernel blocks the task until its next release. */
+}
+/*-----------------------------------------------------------*/
+
+static void vReportingTask(void *pvParameters)
+{
+	UBaseType_t uxTasks, uxEvents, uxLost, i;
+	const uint8_t *pucEntry;
+
+	(void)pvParameters;
+
+	vTaskDelay(RUN_TICKS);
+
+	/* Stop the periodic tasks, so the trace ends here.  The scheduler stays
+	suspended while printing. */
+	vTaskSuspendAll();
+	uxEvents = uxTaskGetScheduleTrace(xTrace, configSCHEDULE_TRACE_LENGTH, &uxLost);
+	uxTasks = uxTaskGetSystemState(xTaskStatus, MAX_TASKS, NULL);
+
+	printf("scheduler,%s,events,%lu,lost,%lu\n", configUSE_RM == 1 ? "RM" : "FreeRTOS", (unsigned long)uxEvents, (unsigned long)uxLost);
+
+	for (i = 0; i < uxTasks; i++)
+	{
+		printf("task,%lu,%s\n", (unsigned long)xTaskStatus[i].xTaskNumber, xTaskStatus[i].pcTaskName);
+	}
+
+	for (i = 0; i < uxEvents; i++)
+	{
+		/* The raw bytes, decoded by trace_to_gantt.py. */
+		pucEntry = (const uint8_t *)&xTrace[i];
+		printf("trace,%02x%02x%02x%02x%02x%02x%02x%02x\n", pucEntry[0], pucEntry[1], pucEntry[2], pucEntry[3],
+			   pucEntry[4], pucEntry[5], pucEntry[6], pucEntry[7]);
+	}
+
+	printf("Benchmark finished.\n");
+
+	for (;;)
+	{
+	}
+}
+/* -------------------------------------------------- */
+
+#if (configUSE_DEADLINE_MISS_DETECTION == 1) && (configDEADLINE_MISS_POLICY == pdDEADLINE_MISS_NOTIFY)
+void vApplicationDeadlineMissedHook(TaskHandle_t xTask)
+{
+	/* Deadline misses are in the trace. */
+	(void)xTask;
+}
+#endif
+
+/**********************************************************************************************************
+ *											Already defined Functions
+ *********************************************************************************************************/
+void vApplicationMallocFailedHook(void)
+{
+	/* vApplicationMallocFailedHook() will only be called if
+	configUSE_MALLOC_FAILED_HOOK is set to 1 in FreeRTOSConfig.h.  It is a hook
+	function that will get called if a call to pvPortMalloc() fails.
+	pvPortMalloc() is called internally by the kernel whenever a task, queue,
+	timer or semaphore is created using the dynamic allocation (as opposed to
+	static allocation) option.  It is also called by various parts of the
+	demo application.  If heap_1.c, heap_2.c or heap_4.c is being used, then the
+	size of the	heap available to pvPortMalloc() is defined by
+	configTOTAL_HEAP_SIZE in FreeRTOSConfig.h, and the xPortGetFreeHeapSize()
+	API function can be used to query the size of free heap space that remains
+	(although it does not provide information on how the remaining heap might be
+	fragmented).  See http://www.freertos.org/a00111.html for more
+	information. */
+	printf("\r\n\r\nMalloc failed\r\n");
+	portDISABLE_INTERRUPTS();
+	for (;;)
+		;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook(void)
+{
+	/* vApplicationIdleHook() will only be called if configUSE_IDLE_HOOK is set
+	to 1 in FreeRTOSConfig.h.  It will be called on each iteration of the idle
+	task.  It is essential that code added to this hook function never attempts
+	to block in any way (for example, call xQueueReceive() with a block time
+	specified, or call vTaskDelay()).  If application tasks make use of the
+	vTaskDelete() API function to delete themselves then it is also important
+	that vApplicationIdleHook() is permitted to return to its calling function,
+	because it is the responsibility of the idle task to clean up memory
+	allocated by the kernel to any task that has since deleted itself. */
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook(TaskHandle_t pxTask, char *pcTaskName)
+{
+	(void)pcTaskName;
+	(void)pxTask;
+
+	/* Run time stack overflow checking is performed if
+	configCHECK_FOR_STACK_OVERFLOW is defined to 1 or 2.  This hook
+	function is called if a stack overflow is detected. */
+	printf("\r\n\r\nStack overflow in %s\r\n", pcTaskName);
+	portDISABLE_INTERRUPTS();
+	for (;;)
+		;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook(void)
+{
+	/* This function will be called by each tick interrupt if
+	configUSE_TICK_HOOK is set to 1 in FreeRTOSConfig.h.  User code can be
+	added here, but the tick hook is called from an interrupt context, so
+	code must not attempt to block, and only the interrupt safe FreeRTOS API
+	functions can be used (those that end in FromISR()). */
+
+#if (mainCREATE_SIMPLE_BLINKY_DEMO_ONLY != 1)
+	{
+		extern void vFullDemoTickHookFunction(void);
+
+		vFullDemoTickHookFunction();
+	}
+#endif /* mainCREATE_SIMPLE_BLINKY_DEMO_ONLY */
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationDaemonTaskStartupHook(void)
+{
+	/* This function will be called once only, when the daemon task starts to
+	execute (sometimes called the timer task).  This is useful if the
+	application includes initialisation code that would benefit from executing
+	after the scheduler has been started. */
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled(const char *pcFileName, uint32_t ulLine)
+{
+	volatile uint32_t ulSetToNonZeroInDebuggerToContinue = 0;
+
+	/* Called if an assertion passed to configASSERT() fails.  See
+	http://www.freertos.org/a00110.html#configASSERT for more information. */
+
+	printf("ASSERT! Line %d, file %s\r\n", (int)ulLine, pcFileName);
+
+	taskENTER_CRITICAL();
+	{
+		/* You can step out of this function to debug the assertion by using
+		the debugger to set ulSetToNonZeroInDebuggerToContinue to a non-zero
+		value. */
+		while (ulSetToNonZeroInDebuggerToContinue == 0)
+		{
+			__asm volatile("NOP");
+			__asm volatile("NOP");
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/* configUSE_STATIC_ALLOCATION is set to 1, so the application must provide an
+implementation of vApplicationGetIdleTaskMemory() to provide the memory that is
+used by the Idle task. */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize)
+{
+	/* If the buffers to be provided to the Idle task are declared inside this
+	function then they must be declared static - otherwise they will be allocated on
+	the stack and so not exists after this function exits. */
+	static StaticTask_t xIdleTaskTCB;
+	static StackType_t uxIdleTaskStack[configMINIMAL_STACK_SIZE];
+
+	/* Pass out a pointer to the StaticTask_t structure in which the Idle task's
+	state will be stored. */
+	*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+
+	/* Pass out the array that will be used as the Idle task's stack. */
+	*ppxIdleTaskStackBuffer = uxIdleTaskStack;
+
+	/* Pass out the size of the array pointed to by *ppxIdleTaskStackBuffer.
+	Note that, as the array is necessarily of type StackType_t,
+	configMINIMAL_STACK_SIZE is specified in words, not bytes. */
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+/* configUSE_STATIC_ALLOCATION and configUSE_TIMERS are both set to 1, so the
+application must provide an implementation of vApplicationGetTimerTaskMemory()
+to provide the memory that is used by the Timer service task. */
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize)
+{
+	/* If the buffers to be provided to the Timer task are declared inside this
+	function then they must be declared static - otherwise they will be allocated on
+	the stack and so not exists after this function exits. */
+	static StaticTask_t xTimerTaskTCB;
+	static StackType_t uxTimerTaskStack[configTIMER_TASK_STACK_DEPTH];
+
+	/* Pass out a pointer to the StaticTask_t structure in which the Timer
+	task's state will be stored. */
+	*ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+
+	/* Pass out the array that will be used as the Timer task's stack. */
+	*ppxTimerTaskStackBuffer = uxTimerTaskStack;
+
+	/* Pass out the size of the array pointed to by *ppxTimerTaskStackBuffer.
+	Note that, as the array is necessarily of type StackType_t,
+	configMINIMAL_STACK_SIZE is specified in words, not bytes. */
+	*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUARTInit(void)
+{
+	UART0_BAUDDIV = 16;
+	UART0_CTRL = 1;
+}
+/*-----------------------------------------------------------*/
+
+int _write(int file, char *ptr, int len)
+{
+	(void)file; // Ignore the file parameter
+
+	int i;
+	for (i = 0; i < len; i++)
+	{
+		while (!(UART0_STATE & (1 << 5)))
+			;				 // Wait for UART0 TX buffer to be empty
+		UART0_DATA = ptr[i]; // Send character to UART0
+	}
+
+	return i; // Return number of characters written
+}
+
+int __write(int iFile, char *pcString, int iStringLength)
+{
+	int iNextChar;
+
+	/* Avoid compiler warnings about unused parameters.*/
+	(void)iFile;
+
+	/* Output the formatted string to the UART. */
+	for (iNextChar = 0; iNextChar < iStringLength; iNextChar++)
+	{
+		while ((UART0_STATE & TX_BUFFER_MASK) != 0)
+			;
+		UART0_DATA = *pcString;
+		pcString++;
+	}
+
+	return iStringLength;
+}
+/*-----------------------------------------------------------*/
+
+void *malloc(size_t size)
+{
+	(void)size;
+	return pvPortMalloc(size);
+
+	/* This project uses heap_4 so doesn't set up a heap for use by the C
+	library - but something is calling the C library malloc().  See
+	https://freertos.org/a00111.html for more information. */
+	// printf( "\r\n\r\nUnexpected call to malloc() - should be usine pvPortMalloc()\r\n" );
+	// portDISABLE_INTERRUPTS();
+	// for( ;; );
+}
\ No newline at end of file
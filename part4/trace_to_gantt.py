@@ -0,0 +1,140 @@
+"""Turn schedule traces recorded with configUSE_SCHEDULE_TRACE into Gantt charts.
+
+Each input is either the serial output of code/benchmark_RM_trace.c.c, which
+holds "task,<number>,<name>" and "trace,<hex>" lines, or a raw dump of the
+array filled by uxTaskGetScheduleTrace(), for example written by a debugger,
+with a .bin extension.  Tasks are then shown by number.
+
+    python3 trace_to_gantt.py outputs/trace_RM.txt outputs/trace_freertos.txt
+    python3 trace_to_gantt.py --plot outputs/trace_RM.txt outputs/trace_freertos.txt
+
+For every input a CSV file is written next to it with one line per run of a
+task and per job event:
+    task,event,start,end
+where event is run, release, complete or deadline_miss, and start and end are
+timestamps (ticks unless the trace was recorded with a finer clock).  With
+--plot the inputs are drawn one above the other, so traces of the same tasks
+under Rate Monotonic and standard scheduling can be compared.
+"""
+import argparse
+import os
+import struct
+
+# Matches ScheduleTraceEntry_t on a little endian target, such as the
+# Cortex-M3 of the QEMU benchmarks.
+ENTRY_FORMAT = '<IHBB'
+ENTRY_SIZE = struct.calcsize(ENTRY_FORMAT)
+
+# Matches eScheduleTraceEvent.
+SWITCHED_IN, SWITCHED_OUT, JOB_RELEASED, JOB_COMPLETED, DEADLINE_MISSED = range(5)
+JOB_EVENTS = {JOB_RELEASED: 'release', JOB_COMPLETED: 'complete', DEADLINE_MISSED: 'deadline_miss'}
+
+
+def decode_entries(data):
+    entries = []
+    for offset in range(0, len(data) - ENTRY_SIZE + 1, ENTRY_SIZE):
+        timestamp, task, event, _ = struct.unpack_from(ENTRY_FORMAT, data, offset)
+        entries.append((timestamp, task, event))
+    return entries
+
+
+def read_trace(filename):
+    """Returns the task names by number and the decoded entries of a trace."""
+    names = {}
+    data = bytearray()
+
+    with open(filename, 'rb') as file:
+        raw = file.read()
+
+    if filename.endswith('.bin'):
+        return names, decode_entries(raw)
+
+    for line in raw.decode('latin-1').splitlines():
+        fields = line.strip().split(',')
+        if fields[0] == 'task' and len(fields) == 3:
+            names[int(fields[1])] = fields[2]
+        elif fields[0] == 'trace' and len(fields) == 2:
+            data += bytes.fromhex(fields[1])
+
+    return names, decode_entries(data)
+
+
+def build_gantt(names, entries):
+    """Pairs each switch in with the next switch out of the same task."""
+    rows = []
+    running = {}
+
+    for timestamp, task, event in entries:
+        name = names.get(task, str(task))
+        if event == SWITCHED_IN:
+            running[task] = timestamp
+        elif event == SWITCHED_OUT:
+            # A trace that was overwritten can start with a task already
+            # running, whose start is unknown.
+            if task in running:
+                rows.append((name, 'run', running.pop(task), timestamp))
+        elif event in JOB_EVENTS:
+            rows.append((name, JOB_EVENTS[event], timestamp, timestamp))
+
+    # The task running when the trace was read runs to the last event.
+    if entries:
+        last = entries[-1][0]
+        for task, start in running.items():
+            rows.append((names.get(task, str(task)), 'run', start, last))
+
+    return rows
+
+
+def write_csv(filename, rows):
+    with open(filename, 'w') as file:
+        file.write('task,event,start,end\n')
+        for row in rows:
+            file.write('%s,%s,%d,%d\n' % row)
+
+
+def plot_gantt(charts):
+    import matplotlib.pyplot as plt
+
+    markers = {'release': ('^', 'green'), 'complete': ('v', 'blue'), 'deadline_miss': ('x', 'red')}
+    fig, axes = plt.subplots(len(charts), 1, sharex=True, squeeze=False)
+
+    for ax, (title, rows) in zip(axes[:, 0], charts):
+        tasks = sorted({row[0] for row in rows})
+        for index, task in enumerate(tasks):
+            runs = [(start, max(end - start, 0.2)) for name, event, start, end in rows if name == task and event == 'run']
+            ax.broken_barh(runs, (index - 0.3, 0.6), color='tab:orange')
+            for event, (marker, colour) in markers.items():
+                times = [start for name, kind, start, _ in rows if name == task and kind == event]
+                ax.scatter(times, [index + 0.4] * len(times), marker=marker, color=colour, s=20, label=event if index == 0 else None)
+        ax.set_yticks(range(len(tasks)))
+        ax.set_yticklabels(tasks)
+        ax.set_title(title)
+
+    axes[0, 0].legend(loc='upper right')
+    axes[-1, 0].set_xlabel('Time (ticks)')
+    plt.tight_layout()
+    plt.show()
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert schedule traces to Gantt charts.')
+    parser.add_argument('traces', nargs='+', help='serial output of benchmark_RM_trace.c.c, or a raw .bin dump')
+    parser.add_argument('--plot', action='store_true', help='draw the charts with matplotlib')
+    args = parser.parse_args()
+
+    charts = []
+    for filename in args.traces:
+        names, entries = read_trace(filename)
+        rows = build_gantt(names, entries)
+        output = os.path.splitext(filename)[0] + '_gantt.csv'
+        write_csv(output, rows)
+        print(f"{filename}: {len(entries)} events, {sum(1 for row in rows if row[1] == 'run')} runs, "
+              f"{sum(1 for row in rows if row[1] == 'deadline_miss')} deadline misses -> {output}")
+        charts.append((os.path.basename(filename), rows))
+
+    if args.plot:
+        plot_gantt(charts)
+
+
+if __name__ == '__main__':
+    main()